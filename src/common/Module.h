@@ -51,6 +51,7 @@ class Module : public Object
 		M_MATH,
 		M_MOUSE,
 		M_PHYSICS,
+		M_PROFILER,
 		M_SENSOR,
 		M_SOUND,
 		M_SYSTEM,
@@ -27,12 +27,18 @@ namespace love
 love::Type Object::type("Object", nullptr);
 
 Object::Object()
-	: count(1)
+	: proxyOwner(nullptr)
+	, proxyShared(false)
+	, proxyRef(0)
+	, count(1)
 {
 }
 
 Object::Object(const Object & /*other*/)
-	: count(1) // Always start with a reference count of 1.
+	: proxyOwner(nullptr)
+	, proxyShared(false)
+	, proxyRef(0)
+	, count(1) // Always start with a reference count of 1.
 {
 }
 
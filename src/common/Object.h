@@ -71,6 +71,17 @@ class Object
 	 **/
 	void release();
 
+	/**
+	 * The Lua Proxy for this Object is cached by the first Lua state which
+	 * pushes it (see luax_pushtype). proxyOwner identifies that state's proxy
+	 * table, and proxyRef is the index of the Proxy in it. Only the owning
+	 * Lua state reads or writes proxyRef. proxyShared is set once any other
+	 * Lua state has pushed the Object.
+	 **/
+	std::atomic<const void *> proxyOwner;
+	std::atomic<bool> proxyShared;
+	int proxyRef;
+
 private:
 
 	// The reference count.
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+
+namespace love
+{
+
+/**
+ * Fixed-capacity FIFO queue. Once full, pushing overwrites the oldest item.
+ **/
+template <typename T>
+class RingBuffer
+{
+public:
+
+	RingBuffer(size_t capacity)
+		: items(std::max(capacity, (size_t) 1))
+		, head(0)
+		, count(0)
+	{}
+
+	void push(const T &item)
+	{
+		items[(head + count) % items.size()] = item;
+
+		if (count < items.size())
+			count++;
+		else
+			head = (head + 1) % items.size();
+	}
+
+	/**
+	 * Removes up to maxcount of the oldest items, copying them into dst.
+	 * @return The number of items copied.
+	 **/
+	size_t pop(T *dst, size_t maxcount)
+	{
+		size_t n = std::min(count, maxcount);
+
+		for (size_t i = 0; i < n; i++)
+			dst[i] = items[(head + i) % items.size()];
+
+		head = (head + n) % items.size();
+		count -= n;
+		return n;
+	}
+
+	void clear()
+	{
+		head = 0;
+		count = 0;
+	}
+
+	size_t size() const { return count; }
+	size_t capacity() const { return items.size(); }
+
+private:
+
+	std::vector<T> items;
+	size_t head;
+	size_t count;
+
+}; // RingBuffer
+
+} // love
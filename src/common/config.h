@@ -69,6 +69,11 @@
 #	endif
 #endif
 
+// SSE2 instructions (always available on x86-64.)
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define LOVE_SIMD_SSE2
+#endif
+
 // NEON instructions.
 #if defined(__ARM_NEON) || defined(_M_ARM64)
 #	define LOVE_SIMD_NEON
@@ -156,6 +161,7 @@
 #	define LOVE_ENABLE_MATH
 #	define LOVE_ENABLE_MOUSE
 #	define LOVE_ENABLE_PHYSICS
+#	define LOVE_ENABLE_PROFILER
 #	define LOVE_ENABLE_SENSOR
 #	define LOVE_ENABLE_SOUND
 #	define LOVE_ENABLE_SYSTEM
@@ -0,0 +1,340 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "profiler.h"
+#include "Exception.h"
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace love
+{
+namespace profiler
+{
+
+std::atomic<bool> enabled(false);
+
+namespace
+{
+
+// Per-thread ring buffer size, in zones. Older zones are overwritten once a
+// thread records more than this during a single capture.
+const size_t BUFFER_CAPACITY = 1 << 16;
+
+// Limits runaway nesting when beginZone calls aren't matched by endZone.
+const size_t MAX_ZONE_DEPTH = 256;
+
+struct Zone
+{
+	const char *name;
+	uint64 start;
+	uint64 end;
+};
+
+struct ThreadBuffer
+{
+	// Guards everything the exporting thread reads. It's only contended while
+	// a trace is being exported.
+	std::mutex mutex;
+
+	std::vector<Zone> zones;
+	size_t next = 0;
+	bool wrapped = false;
+
+	std::string name;
+	uint64 id = 0;
+	std::atomic<bool> alive {true};
+
+	// Only ever touched by the owning thread.
+	std::vector<std::pair<const char *, uint64>> stack;
+};
+
+struct Registry
+{
+	std::mutex mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	uint64 nextID = 1;
+};
+
+struct ThreadState
+{
+	std::shared_ptr<ThreadBuffer> buffer;
+
+	~ThreadState()
+	{
+		// The buffer outlives the thread so its zones can still be exported.
+		if (buffer)
+			buffer->alive = false;
+	}
+};
+
+Registry &getRegistry()
+{
+	static Registry registry;
+	return registry;
+}
+
+thread_local ThreadState threadState;
+
+std::atomic<int> frameLimit(0);
+std::atomic<int> capturedFrames(0);
+std::atomic<uint64> captureStart(0);
+std::atomic<uint64> lastFrame(0);
+
+ThreadBuffer *getThreadBuffer()
+{
+	if (!threadState.buffer)
+	{
+		auto buffer = std::make_shared<ThreadBuffer>();
+
+		Registry &registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		buffer->id = registry.nextID++;
+		registry.buffers.push_back(buffer);
+
+		threadState.buffer = buffer;
+	}
+
+	return threadState.buffer.get();
+}
+
+void appendEscaped(std::string &out, const char *str)
+{
+	for (const char *c = str; *c != '\0'; c++)
+	{
+		switch (*c)
+		{
+		case '"':
+			out += "\\\"";
+			break;
+		case '\\':
+			out += "\\\\";
+			break;
+		default:
+			if ((unsigned char) *c < 0x20)
+			{
+				char hex[8];
+				snprintf(hex, sizeof(hex), "\\u%04x", (unsigned) *c);
+				out += hex;
+			}
+			else
+				out += *c;
+			break;
+		}
+	}
+}
+
+} // anonymous namespace
+
+uint64 getTimestamp()
+{
+	using namespace std::chrono;
+	return (uint64) duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void recordZone(const char *name, uint64 start, uint64 end)
+{
+	ThreadBuffer *buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer->mutex);
+
+	if (buffer->zones.empty())
+		buffer->zones.resize(BUFFER_CAPACITY);
+
+	buffer->zones[buffer->next] = {name, start, end};
+
+	if (++buffer->next == BUFFER_CAPACITY)
+	{
+		buffer->next = 0;
+		buffer->wrapped = true;
+	}
+}
+
+const char *internName(const std::string &name)
+{
+	static std::mutex mutex;
+	static std::unordered_set<std::string> names;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// Elements of an unordered_set are never moved, so the pointer stays valid.
+	return names.insert(name).first->c_str();
+}
+
+void beginZone(const char *name)
+{
+	ThreadBuffer *buffer = getThreadBuffer();
+
+	if (buffer->stack.size() >= MAX_ZONE_DEPTH)
+		throw love::Exception("Too many nested profiler zones (the maximum is %d.)", (int) MAX_ZONE_DEPTH);
+
+	// Zones are always pushed so begin/end pairs stay matched when a capture
+	// starts or stops in between them.
+	buffer->stack.emplace_back(name, isEnabled() ? getTimestamp() : 0);
+}
+
+void endZone()
+{
+	ThreadBuffer *buffer = getThreadBuffer();
+
+	if (buffer->stack.empty())
+		throw love::Exception("No profiler zone to end. Every endZone call must match a beginZone call.");
+
+	auto zone = buffer->stack.back();
+	buffer->stack.pop_back();
+
+	if (zone.second != 0 && isEnabled())
+		recordZone(zone.first, zone.second, getTimestamp());
+}
+
+void setThreadName(const std::string &name)
+{
+	ThreadBuffer *buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer->mutex);
+	buffer->name = name;
+}
+
+void startCapture(int frames)
+{
+	enabled = false;
+
+	{
+		Registry &registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		// Threads which have exited have nothing left to record.
+		registry.buffers.erase(std::remove_if(registry.buffers.begin(), registry.buffers.end(), [](const std::shared_ptr<ThreadBuffer> &b)
+		{
+			return !b->alive;
+		}), registry.buffers.end());
+
+		for (const auto &buffer : registry.buffers)
+		{
+			std::lock_guard<std::mutex> bufferlock(buffer->mutex);
+			buffer->next = 0;
+			buffer->wrapped = false;
+		}
+	}
+
+	uint64 now = getTimestamp();
+
+	frameLimit = std::max(frames, 0);
+	capturedFrames = 0;
+	captureStart = now;
+	lastFrame = now;
+
+	enabled = true;
+}
+
+void stopCapture()
+{
+	enabled = false;
+}
+
+bool isCapturing()
+{
+	return isEnabled();
+}
+
+int getCapturedFrames()
+{
+	return capturedFrames;
+}
+
+void markFrame()
+{
+	if (!isEnabled())
+		return;
+
+	uint64 now = getTimestamp();
+	recordZone("Frame", lastFrame.exchange(now), now);
+
+	int limit = frameLimit;
+	if (++capturedFrames >= limit && limit > 0)
+		enabled = false;
+}
+
+std::string exportTrace()
+{
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+	{
+		Registry &registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		buffers = registry.buffers;
+	}
+
+	uint64 origin = captureStart;
+
+	std::string json = "{\"traceEvents\":[";
+	bool first = true;
+	char buf[128];
+
+	for (const auto &buffer : buffers)
+	{
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+
+		size_t count = buffer->wrapped ? BUFFER_CAPACITY : buffer->next;
+		if (count == 0 && buffer->name.empty())
+			continue;
+
+		if (!first)
+			json += ",";
+		first = false;
+
+		json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,";
+		snprintf(buf, sizeof(buf), "\"tid\":%llu,\"args\":{\"name\":\"", (unsigned long long) buffer->id);
+		json += buf;
+		if (buffer->name.empty())
+			json += "Thread " + std::to_string(buffer->id);
+		else
+			appendEscaped(json, buffer->name.c_str());
+		json += "\"}}";
+
+		// Oldest zones first.
+		size_t begin = buffer->wrapped ? buffer->next : 0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Zone &zone = buffer->zones[(begin + i) % BUFFER_CAPACITY];
+
+			// Zones from a previous capture which ended during this one.
+			if (zone.start < origin || zone.end < zone.start)
+				continue;
+
+			json += ",{\"name\":\"";
+			appendEscaped(json, zone.name);
+			snprintf(buf, sizeof(buf), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+			         (unsigned long long) buffer->id, (zone.start - origin) / 1000.0, (zone.end - zone.start) / 1000.0);
+			json += buf;
+		}
+	}
+
+	json += "],\"displayTimeUnit\":\"ms\"}";
+	return json;
+}
+
+} // profiler
+} // love
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+
+// C++
+#include <atomic>
+#include <string>
+
+namespace love
+{
+namespace profiler
+{
+
+/**
+ * Lightweight CPU instrumentation. Zones are compiled in everywhere but only
+ * record anything while a capture is running, so a disabled zone costs a
+ * single relaxed load and branch. Each thread records completed zones into
+ * its own ring buffer, which can be exported in the Chrome trace-event JSON
+ * format (viewable in chrome://tracing, Perfetto, Speedscope, etc.)
+ **/
+
+extern std::atomic<bool> enabled;
+
+inline bool isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Gets a monotonic timestamp in nanoseconds.
+ **/
+uint64 getTimestamp();
+
+/**
+ * Records a completed zone on the calling thread. The name must stay valid
+ * for the lifetime of the program (a string literal or an interned name.)
+ **/
+void recordZone(const char *name, uint64 start, uint64 end);
+
+/**
+ * Returns a pointer to a copy of the string which stays valid for the
+ * lifetime of the program. Used for zone names which come from Lua.
+ **/
+const char *internName(const std::string &name);
+
+/**
+ * Begins and ends a nested zone on the calling thread's zone stack. Unlike
+ * ScopedZone these can span across function calls (e.g. from Lua code.)
+ **/
+void beginZone(const char *name);
+void endZone();
+
+/**
+ * Sets the name the calling thread is given in exported traces.
+ **/
+void setThreadName(const std::string &name);
+
+/**
+ * Starts recording zones. If frames is greater than 0, the capture stops
+ * automatically after that many calls to markFrame. Previously recorded
+ * zones are discarded.
+ **/
+void startCapture(int frames);
+void stopCapture();
+bool isCapturing();
+int getCapturedFrames();
+
+/**
+ * Marks the end of a frame. Records a zone covering the whole frame.
+ **/
+void markFrame();
+
+/**
+ * Gets every zone recorded by the last (or current) capture, as Chrome
+ * trace-event JSON.
+ **/
+std::string exportTrace();
+
+class ScopedZone
+{
+public:
+
+	ScopedZone(const char *name)
+		: name(isEnabled() ? name : nullptr)
+		, start(this->name != nullptr ? getTimestamp() : 0)
+	{}
+
+	~ScopedZone()
+	{
+		if (name != nullptr)
+			recordZone(name, start, getTimestamp());
+	}
+
+private:
+
+	ScopedZone(const ScopedZone &) = delete;
+	ScopedZone &operator = (const ScopedZone &) = delete;
+
+	const char *name;
+	uint64 start;
+
+}; // ScopedZone
+
+} // profiler
+} // love
+
+#define LOVE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LOVE_PROFILE_CONCAT(a, b) LOVE_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Records the time spent in the enclosing scope as a zone with the given
+ * name, while a capture is running.
+ **/
+#define LOVE_PROFILE_ZONE(name) love::profiler::ScopedZone LOVE_PROFILE_CONCAT(love_profile_zone_, __LINE__)(name)
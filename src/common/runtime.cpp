@@ -39,6 +39,95 @@
 namespace love
 {
 
+// Objects cache their Proxy in a weak-valued array in the registry of the
+// first Lua state which pushes them (see Object::proxyOwner). Index 0 holds the
+// head of a list of freed indices and index -1 holds the number of indices in
+// use, so an index is only reused after the Proxy in it has been collected or
+// released. The array is stored under an integer registry key rather than a
+// string, which avoids a string lookup per luax_pushtype. luaL_ref only uses
+// positive keys.
+static const int PROXIES_REGISTRY_KEY = -0x4C4F5645; // 'LOVE'
+
+// Creates the Proxy cache table, stores it in the registry and leaves it on the
+// stack.
+static void luax_newproxiestable(lua_State *L)
+{
+	lua_newtable(L);
+
+	// metatable.__mode = "v". Weak userdata values, so the cache doesn't keep
+	// any Proxy alive.
+	lua_newtable(L);
+	lua_pushliteral(L, "v");
+	lua_setfield(L, -2, "__mode");
+	lua_setmetatable(L, -2);
+
+	lua_pushvalue(L, -1);
+	lua_rawseti(L, LUA_REGISTRYINDEX, PROXIES_REGISTRY_KEY);
+}
+
+static int luax_allocproxyref(lua_State *L, int proxies)
+{
+	lua_rawgeti(L, proxies, 0);
+	int ref = (int) lua_tointeger(L, -1);
+	lua_pop(L, 1);
+
+	if (ref > 0)
+	{
+		// proxies[0] = proxies[ref]
+		lua_rawgeti(L, proxies, ref);
+		lua_rawseti(L, proxies, 0);
+	}
+	else
+	{
+		lua_rawgeti(L, proxies, -1);
+		ref = (int) lua_tointeger(L, -1) + 1;
+		lua_pop(L, 1);
+
+		lua_pushinteger(L, ref);
+		lua_rawseti(L, proxies, -1);
+	}
+
+	return ref;
+}
+
+static void luax_freeproxyref(lua_State *L, int proxies, int ref)
+{
+	// proxies[ref] = proxies[0]; proxies[0] = ref
+	lua_rawgeti(L, proxies, 0);
+	lua_rawseti(L, proxies, ref);
+	lua_pushinteger(L, ref);
+	lua_rawseti(L, proxies, 0);
+}
+
+// Gives up the object's Proxy cache index if this Lua state owns it and the
+// cached Proxy is the one at idx, or has already been collected.
+static void luax_uncacheproxy(lua_State *L, love::Object *object, int idx)
+{
+	const void *owner = object->proxyOwner.load(std::memory_order_acquire);
+	if (owner == nullptr)
+		return;
+
+	luax_getregistry(L, REGISTRY_PROXIES);
+
+	if (owner == lua_topointer(L, -1))
+	{
+		int proxies = lua_gettop(L);
+
+		lua_rawgeti(L, proxies, object->proxyRef);
+		bool cached = lua_isnil(L, -1) || lua_rawequal(L, -1, idx);
+		lua_pop(L, 1);
+
+		if (cached)
+		{
+			luax_freeproxyref(L, proxies, object->proxyRef);
+			object->proxyRef = 0;
+			object->proxyOwner.store(nullptr, std::memory_order_release);
+		}
+	}
+
+	lua_pop(L, 1);
+}
+
 /**
  * Called when an object is collected. The object is released
  * once in this function, possibly deleting it.
@@ -48,6 +137,7 @@ static int w__gc(lua_State *L)
 	Proxy *p = (Proxy *) lua_touserdata(L, 1);
 	if (p->object != nullptr)
 	{
+		luax_uncacheproxy(L, p->object, 1);
 		p->object->release();
 		p->object = nullptr;
 	}
@@ -174,6 +264,8 @@ static int w__release(lua_State *L)
 
 	if (object != nullptr)
 	{
+		luax_uncacheproxy(L, object, 1);
+
 		p->object = nullptr;
 		object->release();
 
@@ -515,6 +607,11 @@ int luax_register_type(lua_State *L, love::Type *type, ...)
 	else
 		lua_pop(L, 1);
 
+	// Create the Proxy cache table (see luax_allocproxyref) if it doesn't
+	// exist yet.
+	luax_insistregistry(L, REGISTRY_PROXIES);
+	lua_pop(L, 1);
+
 	luaL_newmetatable(L, type->getName());
 
 	// m.__index = m
@@ -655,7 +752,68 @@ void luax_pushtype(lua_State *L, love::Type &type, love::Object *object)
 		return;
 	}
 
-	// Fetch the registry table of instantiated objects.
+	// Fetch the Proxy cache table (see luax_allocproxyref).
+	luax_getregistry(L, REGISTRY_PROXIES);
+
+	if (lua_istable(L, -1))
+	{
+		int proxies = lua_gettop(L);
+		const void *owner = lua_topointer(L, proxies);
+		const void *noowner = nullptr;
+
+		if (object->proxyOwner.load(std::memory_order_acquire) == owner)
+		{
+			// Get the value of proxies[ref] on the stack. It can be nil if the
+			// cached Proxy was collected but hasn't been finalized yet.
+			lua_rawgeti(L, proxies, object->proxyRef);
+
+			if (lua_type(L, -1) == LUA_TUSERDATA && ((Proxy *) lua_touserdata(L, -1))->object == object)
+			{
+				lua_remove(L, proxies);
+				return;
+			}
+
+			lua_pop(L, 1);
+		}
+		else if (object->proxyOwner.compare_exchange_strong(noowner, owner, std::memory_order_acq_rel))
+			object->proxyRef = luax_allocproxyref(L, proxies);
+		else
+			owner = nullptr;
+
+		if (owner != nullptr)
+		{
+			// This Lua state may still have a Proxy for the object from before
+			// it owned the cache.
+			if (object->proxyShared.load(std::memory_order_relaxed))
+			{
+				luax_getregistry(L, REGISTRY_OBJECTS);
+				luax_pushloveobjectkey(L, luax_computeloveobjectkey(L, object));
+				lua_rawget(L, -2);
+				lua_remove(L, -2);
+			}
+			else
+				lua_pushnil(L);
+
+			if (lua_type(L, -1) != LUA_TUSERDATA)
+			{
+				lua_pop(L, 1);
+				luax_rawnewtype(L, type, object);
+			}
+
+			// proxies[ref] = Proxy.
+			lua_pushvalue(L, -1);
+			lua_rawseti(L, proxies, object->proxyRef);
+
+			lua_remove(L, proxies);
+			return;
+		}
+	}
+
+	lua_pop(L, 1);
+
+	// Objects whose Proxy is cached by another Lua state use the registry table
+	// of instantiated objects instead.
+	object->proxyShared.store(true, std::memory_order_relaxed);
 	luax_getregistry(L, REGISTRY_OBJECTS);
 
 	// The table might not exist - it should be insisted in luax_register_type.
@@ -1012,6 +1170,14 @@ int luax_insistregistry(lua_State *L, Registry r)
 		return luax_insistlove(L, "_modules");
 	case REGISTRY_OBJECTS:
 		return luax_insist(L, LUA_REGISTRYINDEX, "_loveobjects");
+	case REGISTRY_PROXIES:
+		lua_rawgeti(L, LUA_REGISTRYINDEX, PROXIES_REGISTRY_KEY);
+		if (!lua_istable(L, -1))
+		{
+			lua_pop(L, 1);
+			luax_newproxiestable(L);
+		}
+		return 1;
 	default:
 		return luaL_error(L, "Attempted to use invalid registry.");
 	}
@@ -1026,6 +1192,9 @@ int luax_getregistry(lua_State *L, Registry r)
 	case REGISTRY_OBJECTS:
 		lua_getfield(L, LUA_REGISTRYINDEX, "_loveobjects");
 		return 1;
+	case REGISTRY_PROXIES:
+		lua_rawgeti(L, LUA_REGISTRYINDEX, PROXIES_REGISTRY_KEY);
+		return 1;
 	default:
 		return luaL_error(L, "Attempted to use invalid registry.");
 	}
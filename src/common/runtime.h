@@ -58,7 +58,8 @@ class StrongRef;
 enum Registry
 {
 	REGISTRY_MODULES,
-	REGISTRY_OBJECTS
+	REGISTRY_OBJECTS,
+	REGISTRY_PROXIES
 };
 
 /**
@@ -45,6 +45,11 @@ class Noise1234 {
     static double pnoise( double x, double y, double z, double w,
                               int px, int py, int pz, int pw );
 
+/** The permutation table used for hashing lattice points (512 entries),
+ *  for code that evaluates the same noise in bulk.
+ */
+    static const unsigned char *getPermutation() { return perm; }
+
   private:
     static unsigned char perm[];
     static double  grad( int hash, double x );
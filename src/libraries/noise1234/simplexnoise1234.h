@@ -39,6 +39,11 @@ class SimplexNoise1234 {
     static double noise( double x, double y, double z );
     static double noise( double x, double y, double z, double w);
 
+/** The permutation table used for hashing lattice points (512 entries),
+ *  for code that evaluates the same noise in bulk.
+ */
+    static const unsigned char *getPermutation() { return perm; }
+
   private:
     static unsigned char perm[];
     static double  grad( int hash, double x );
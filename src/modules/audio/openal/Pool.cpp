@@ -20,6 +20,7 @@
 
 #include "Pool.h"
 
+#include "common/profiler.h"
 #include "event/Event.h"
 #include "Source.h"
 
@@ -114,6 +115,8 @@ bool Pool::isPlaying(Source *s)
 
 void Pool::update()
 {
+	LOVE_PROFILE_ZONE("Pool::update");
+
 #ifndef ALC_CONNECTED
 	constexpr ALCenum ALC_CONNECTED = 0x313;
 #endif
@@ -140,10 +143,9 @@ void Pool::update()
 				std::vector<audio::Source *> sources = getPlayingSources();
 				Source::stop(sources);
 
-				std::vector<Variant> vargs;
-				vargs.emplace_back(putSourcesAsSharedTable(sources));
+				event::Message msg("audiodisconnected");
+				msg.addArg(putSourcesAsSharedTable(sources));
 
-				StrongRef<event::Message> msg(new event::Message("audiodisconnected", vargs), Acquire::NORETAIN);
 				eventModule->push(msg);
 
 				disconnectNotified = true;
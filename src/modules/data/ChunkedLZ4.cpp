@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "ChunkedLZ4.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "thread/ThreadPool.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/lz4/lz4hc.h"
+
+// C++
+#include <string.h>
+#include <algorithm>
+
+namespace love
+{
+namespace data
+{
+namespace chunkedlz4
+{
+
+static const char MAGIC[4] = {'L', 'Z', '4', 'C'};
+
+// Chunks are usually large enough that each one is worth its own task.
+static const size_t CHUNKS_PER_TASK = 1;
+
+static void writeUInt32(char *dst, uint32 v)
+{
+#ifdef LOVE_BIG_ENDIAN
+	v = swapuint32(v);
+#endif
+	memcpy(dst, &v, sizeof(uint32));
+}
+
+static uint32 readUInt32(const char *src)
+{
+	uint32 v;
+	memcpy(&v, src, sizeof(uint32));
+#ifdef LOVE_BIG_ENDIAN
+	v = swapuint32(v);
+#endif
+	return v;
+}
+
+static size_t getChunkBound(size_t rawSize)
+{
+	return CHUNK_HEADER_SIZE + (size_t) LZ4_compressBound((int) rawSize);
+}
+
+static size_t compressChunk(const char *src, size_t size, int level, char *dst)
+{
+	int bound = LZ4_compressBound((int) size);
+	char *payload = dst + CHUNK_HEADER_SIZE;
+
+	// Use LZ4-HC for compression level 9 and higher, like the plain format.
+	int csize = 0;
+	if (level > 8)
+		csize = LZ4_compress_HC(src, payload, (int) size, bound, LZ4HC_CLEVEL_DEFAULT);
+	else
+		csize = LZ4_compress_default(src, payload, (int) size, bound);
+
+	if (csize <= 0)
+		throw love::Exception("Could not LZ4-compress data.");
+
+	writeUInt32(dst, (uint32) size);
+	writeUInt32(dst + 4, (uint32) csize);
+
+	return CHUNK_HEADER_SIZE + (size_t) csize;
+}
+
+void writeHeader(char *dst, size_t chunkSize)
+{
+	memcpy(dst, MAGIC, sizeof(MAGIC));
+	writeUInt32(dst + 4, (uint32) chunkSize);
+}
+
+void writeEndMarker(char *dst)
+{
+	writeUInt32(dst, 0);
+}
+
+bool readHeader(const char *src, size_t size, size_t &chunkSize)
+{
+	if (size < HEADER_SIZE)
+		return false;
+
+	if (memcmp(src, MAGIC, sizeof(MAGIC)) != 0)
+		throw love::Exception("Invalid chunked LZ4 data (missing header.)");
+
+	chunkSize = readUInt32(src + 4);
+	if (chunkSize == 0 || chunkSize > LZ4_MAX_INPUT_SIZE)
+		throw love::Exception("Invalid chunked LZ4 data (bad chunk size.)");
+
+	return true;
+}
+
+size_t getContainerBound(size_t rawSize, size_t chunkSize)
+{
+	size_t fullchunks = rawSize / chunkSize;
+	size_t remainder = rawSize % chunkSize;
+
+	size_t bound = HEADER_SIZE + END_MARKER_SIZE + fullchunks * getChunkBound(chunkSize);
+	if (remainder > 0)
+		bound += getChunkBound(remainder);
+
+	return bound;
+}
+
+size_t compressChunks(const char *src, size_t size, size_t chunkSize, int level, char *dst)
+{
+	if (chunkSize == 0 || chunkSize > LZ4_MAX_INPUT_SIZE)
+		throw love::Exception("Invalid LZ4 chunk size.");
+
+	size_t chunkcount = (size + chunkSize - 1) / chunkSize;
+	if (chunkcount == 0)
+		return 0;
+
+	// Each chunk is compressed into its own worst-case sized slot, and the
+	// slots are compacted afterwards.
+	size_t slotsize = getChunkBound(chunkSize);
+	std::vector<size_t> csizes(chunkcount);
+
+	auto pool = love::thread::ThreadPool::getShared();
+	pool->parallelFor(chunkcount, CHUNKS_PER_TASK, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t offset = i * chunkSize;
+			size_t rawsize = std::min(chunkSize, size - offset);
+			csizes[i] = compressChunk(src + offset, rawsize, level, dst + i * slotsize);
+		}
+	});
+
+	size_t written = csizes[0];
+	for (size_t i = 1; i < chunkcount; i++)
+	{
+		memmove(dst + written, dst + i * slotsize, csizes[i]);
+		written += csizes[i];
+	}
+
+	return written;
+}
+
+bool parseChunks(const char *src, size_t size, size_t chunkSize, std::vector<Chunk> &chunks, size_t &consumed)
+{
+	size_t offset = 0;
+	size_t rawoffset = 0;
+
+	while (size - offset >= END_MARKER_SIZE)
+	{
+		uint32 rawsize = readUInt32(src + offset);
+
+		if (rawsize == 0)
+		{
+			consumed = offset + END_MARKER_SIZE;
+			return true;
+		}
+
+		if (size - offset < CHUNK_HEADER_SIZE)
+			break;
+
+		uint32 csize = readUInt32(src + offset + 4);
+
+		if (rawsize > chunkSize || csize > (uint32) LZ4_compressBound((int) chunkSize))
+			throw love::Exception("Invalid chunked LZ4 data (bad chunk size.)");
+
+		if (size - offset - CHUNK_HEADER_SIZE < csize)
+			break;
+
+		Chunk chunk;
+		chunk.src = src + offset + CHUNK_HEADER_SIZE;
+		chunk.compressedSize = csize;
+		chunk.rawOffset = rawoffset;
+		chunk.rawSize = rawsize;
+		chunks.push_back(chunk);
+
+		offset += CHUNK_HEADER_SIZE + csize;
+		rawoffset += rawsize;
+	}
+
+	consumed = offset;
+	return false;
+}
+
+void decompressChunks(const std::vector<Chunk> &chunks, char *dst)
+{
+	auto pool = love::thread::ThreadPool::getShared();
+	pool->parallelFor(chunks.size(), CHUNKS_PER_TASK, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const Chunk &c = chunks[i];
+			int result = LZ4_decompress_safe(c.src, dst + c.rawOffset, (int) c.compressedSize, (int) c.rawSize);
+			if (result < 0 || (size_t) result != c.rawSize)
+				throw love::Exception("Could not decompress LZ4-compressed data.");
+		}
+	});
+}
+
+} // chunkedlz4
+} // data
+} // love
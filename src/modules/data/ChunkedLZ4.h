@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+
+// C++
+#include <vector>
+#include <stddef.h>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * The chunked LZ4 container ("lz4chunked" format) stores data as a series of
+ * independently compressed LZ4 blocks. Unlike the plain LZ4 format, chunks can
+ * be compressed and decompressed in parallel, and the container can be
+ * written and read incrementally.
+ *
+ * Layout (all integers are little-endian uint32):
+ *   "LZ4C" magic, max chunk size
+ *   per chunk: uncompressed size, compressed size, compressed bytes
+ *   0 (end marker)
+ **/
+namespace chunkedlz4
+{
+
+static const size_t HEADER_SIZE = 8;
+static const size_t CHUNK_HEADER_SIZE = 8;
+static const size_t END_MARKER_SIZE = 4;
+static const size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+struct Chunk
+{
+	const char *src;
+	size_t compressedSize;
+	size_t rawOffset;
+	size_t rawSize;
+};
+
+void writeHeader(char *dst, size_t chunkSize);
+void writeEndMarker(char *dst);
+
+/**
+ * Reads the container header.
+ * @return False if there isn't enough data yet. Throws if the header is
+ *         invalid.
+ **/
+bool readHeader(const char *src, size_t size, size_t &chunkSize);
+
+/**
+ * Gets the maximum size of the complete container (header, chunks and end
+ * marker) for the given amount of input.
+ **/
+size_t getContainerBound(size_t rawSize, size_t chunkSize);
+
+/**
+ * Compresses the input into chunks in parallel, without the container header
+ * or end marker.
+ * @param dst Destination with room for getContainerBound bytes.
+ * @return The number of bytes written.
+ **/
+size_t compressChunks(const char *src, size_t size, size_t chunkSize, int level, char *dst);
+
+/**
+ * Parses as many complete chunks as are available, starting after the
+ * header.
+ * @param[out] chunks Parsed chunks are appended here, with raw offsets
+ *             starting at 0.
+ * @param[out] consumed The number of bytes making up the parsed chunks (and
+ *             the end marker, if it was found.)
+ * @return True if the end marker was reached.
+ **/
+bool parseChunks(const char *src, size_t size, size_t chunkSize, std::vector<Chunk> &chunks, size_t &consumed);
+
+/**
+ * Decompresses parsed chunks in parallel into dst, which must have room for
+ * the sum of their raw sizes.
+ **/
+void decompressChunks(const std::vector<Chunk> &chunks, char *dst);
+
+} // chunkedlz4
+} // data
+} // love
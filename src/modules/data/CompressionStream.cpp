@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "CompressionStream.h"
+#include "ChunkedLZ4.h"
+#include "common/Exception.h"
+
+#include <zlib.h>
+
+// C++
+#include <string.h>
+#include <algorithm>
+
+namespace love
+{
+namespace data
+{
+
+class zlibCompressionStream : public CompressionStream
+{
+public:
+
+	zlibCompressionStream(Compressor::Format format, Mode mode, int level)
+		: CompressionStream(format, mode)
+		, stream()
+	{
+		int err = Z_OK;
+
+		if (mode == MODE_COMPRESS)
+		{
+			if (level < 0)
+				level = Z_DEFAULT_COMPRESSION;
+			else if (level > 9)
+				level = 9;
+
+			int windowbits = 15;
+			if (format == Compressor::FORMAT_GZIP)
+				windowbits += 16; // This tells zlib to use a gzip header.
+			else if (format == Compressor::FORMAT_DEFLATE)
+				windowbits = -windowbits;
+
+			err = deflateInit2(&stream, level, Z_DEFLATED, windowbits, 8, Z_DEFAULT_STRATEGY);
+		}
+		else
+		{
+			// 15 is the default. Adding 32 makes zlib auto-detect the header type.
+			int windowbits = format == Compressor::FORMAT_DEFLATE ? -15 : 15 + 32;
+			err = inflateInit2(&stream, windowbits);
+		}
+
+		if (err != Z_OK)
+			throw love::Exception("Could not initialize zlib stream (error code: %d).", err);
+	}
+
+	virtual ~zlibCompressionStream()
+	{
+		if (mode == MODE_COMPRESS)
+			deflateEnd(&stream);
+		else
+			inflateEnd(&stream);
+	}
+
+	void push(const char *data, size_t size, std::vector<char> &output) override
+	{
+		throwIfFinished();
+
+		// avail_in is only 32 bits, so large inputs are fed in pieces.
+		while (size > 0)
+		{
+			uInt piece = (uInt) std::min(size, (size_t) 0x40000000);
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = piece;
+
+			process(Z_NO_FLUSH, output);
+
+			data += piece;
+			size -= piece;
+		}
+	}
+
+	void flush(bool finish, std::vector<char> &output) override
+	{
+		throwIfFinished();
+
+		stream.next_in = nullptr;
+		stream.avail_in = 0;
+
+		if (mode == MODE_COMPRESS)
+			process(finish ? Z_FINISH : Z_SYNC_FLUSH, output);
+		else
+		{
+			process(Z_SYNC_FLUSH, output);
+			if (finish && !streamEnded)
+				throw love::Exception("Could not decompress zlib/gzip-compressed data (data is truncated.)");
+		}
+
+		if (finish)
+			finished = true;
+	}
+
+private:
+
+	void process(int flush, std::vector<char> &output)
+	{
+		const size_t growsize = 64 * 1024;
+
+		while (true)
+		{
+			size_t oldsize = output.size();
+			output.resize(oldsize + growsize);
+
+			stream.next_out = (Bytef *) output.data() + oldsize;
+			stream.avail_out = (uInt) growsize;
+
+			int err = Z_OK;
+			if (mode == MODE_COMPRESS)
+				err = deflate(&stream, flush);
+			else if (!streamEnded)
+				err = inflate(&stream, flush);
+			else if (stream.avail_in > 0)
+				throw love::Exception("Could not decompress zlib/gzip-compressed data (data after end of stream.)");
+
+			output.resize(oldsize + (growsize - stream.avail_out));
+
+			if (err == Z_STREAM_END)
+			{
+				streamEnded = true;
+				if (mode == MODE_DECOMPRESS && stream.avail_in > 0)
+					throw love::Exception("Could not decompress zlib/gzip-compressed data (data after end of stream.)");
+				break;
+			}
+			else if (err == Z_BUF_ERROR)
+			{
+				// No progress was possible: all input is consumed and there's
+				// nothing left to write.
+				break;
+			}
+			else if (err != Z_OK)
+			{
+				if (mode == MODE_COMPRESS)
+					throw love::Exception("Could not zlib/gzip-compress data (error code: %d).", err);
+				else
+					throw love::Exception("Could not decompress zlib/gzip-compressed data (error code: %d).", err);
+			}
+
+			// zlib fills the output completely when it has more to write.
+			if (stream.avail_out > 0 && stream.avail_in == 0)
+				break;
+		}
+	}
+
+	z_stream stream;
+	bool streamEnded = false;
+
+}; // zlibCompressionStream
+
+class LZ4ChunkedCompressionStream : public CompressionStream
+{
+public:
+
+	LZ4ChunkedCompressionStream(Mode mode, int level)
+		: CompressionStream(Compressor::FORMAT_LZ4_CHUNKED, mode)
+		, level(level)
+		, chunkSize(chunkedlz4::DEFAULT_CHUNK_SIZE)
+		, headerDone(false)
+	{
+	}
+
+	virtual ~LZ4ChunkedCompressionStream() {}
+
+	void push(const char *data, size_t size, std::vector<char> &output) override
+	{
+		throwIfFinished();
+
+		if (mode == MODE_COMPRESS)
+			pushCompress(data, size, output);
+		else
+			pushDecompress(data, size, output);
+	}
+
+	void flush(bool finish, std::vector<char> &output) override
+	{
+		throwIfFinished();
+
+		if (mode == MODE_COMPRESS)
+		{
+			writeHeader(output);
+
+			// A partial chunk is written out as a smaller chunk.
+			if (!pending.empty())
+			{
+				compressInto(pending.data(), pending.size(), output);
+				pending.clear();
+			}
+
+			if (finish)
+			{
+				size_t oldsize = output.size();
+				output.resize(oldsize + chunkedlz4::END_MARKER_SIZE);
+				chunkedlz4::writeEndMarker(output.data() + oldsize);
+			}
+		}
+		else if (finish && !streamEnded)
+			throw love::Exception("Could not decompress LZ4-compressed data (data is truncated.)");
+
+		if (finish)
+			finished = true;
+	}
+
+private:
+
+	void writeHeader(std::vector<char> &output)
+	{
+		if (headerDone)
+			return;
+
+		size_t oldsize = output.size();
+		output.resize(oldsize + chunkedlz4::HEADER_SIZE);
+		chunkedlz4::writeHeader(output.data() + oldsize, chunkSize);
+		headerDone = true;
+	}
+
+	void compressInto(const char *data, size_t size, std::vector<char> &output)
+	{
+		size_t oldsize = output.size();
+		output.resize(oldsize + chunkedlz4::getContainerBound(size, chunkSize));
+		size_t written = chunkedlz4::compressChunks(data, size, chunkSize, level, output.data() + oldsize);
+		output.resize(oldsize + written);
+	}
+
+	void pushCompress(const char *data, size_t size, std::vector<char> &output)
+	{
+		writeHeader(output);
+
+		// Top up a previously pushed partial chunk first.
+		if (!pending.empty())
+		{
+			size_t count = std::min(size, chunkSize - pending.size());
+			pending.insert(pending.end(), data, data + count);
+			data += count;
+			size -= count;
+
+			if (pending.size() < chunkSize)
+				return;
+
+			compressInto(pending.data(), pending.size(), output);
+			pending.clear();
+		}
+
+		// Whole chunks straight from the input are compressed in parallel.
+		size_t wholesize = size - (size % chunkSize);
+		if (wholesize > 0)
+			compressInto(data, wholesize, output);
+
+		pending.insert(pending.end(), data + wholesize, data + size);
+	}
+
+	void pushDecompress(const char *data, size_t size, std::vector<char> &output)
+	{
+		if (streamEnded)
+		{
+			if (size > 0)
+				throw love::Exception("Could not decompress LZ4-compressed data (data after end of stream.)");
+			return;
+		}
+
+		pending.insert(pending.end(), data, data + size);
+
+		size_t offset = 0;
+		if (!headerDone)
+		{
+			if (!chunkedlz4::readHeader(pending.data(), pending.size(), chunkSize))
+				return;
+			headerDone = true;
+			offset = chunkedlz4::HEADER_SIZE;
+		}
+
+		std::vector<chunkedlz4::Chunk> chunks;
+		size_t consumed = 0;
+		streamEnded = chunkedlz4::parseChunks(pending.data() + offset, pending.size() - offset, chunkSize, chunks, consumed);
+
+		if (streamEnded && offset + consumed < pending.size())
+			throw love::Exception("Could not decompress LZ4-compressed data (data after end of stream.)");
+
+		if (!chunks.empty())
+		{
+			size_t oldsize = output.size();
+			output.resize(oldsize + chunks.back().rawOffset + chunks.back().rawSize);
+			chunkedlz4::decompressChunks(chunks, output.data() + oldsize);
+		}
+
+		pending.erase(pending.begin(), pending.begin() + (offset + consumed));
+	}
+
+	int level;
+	size_t chunkSize;
+	bool headerDone;
+	bool streamEnded = false;
+
+	// Compressing: input for a partial chunk. Decompressing: input which
+	// doesn't make up a whole chunk yet.
+	std::vector<char> pending;
+
+}; // LZ4ChunkedCompressionStream
+
+love::Type CompressionStream::type("CompressionStream", &Object::type);
+
+CompressionStream *CompressionStream::create(Compressor::Format format, Mode mode, int level)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+		return new zlibCompressionStream(format, mode, level);
+	case Compressor::FORMAT_LZ4_CHUNKED:
+		return new LZ4ChunkedCompressionStream(mode, level);
+	case Compressor::FORMAT_LZ4:
+		throw love::Exception("The lz4 format can't be streamed, use lz4chunked instead.");
+	default:
+		throw love::Exception("Invalid compression format.");
+	}
+}
+
+CompressionStream::CompressionStream(Compressor::Format format, Mode mode)
+	: format(format)
+	, mode(mode)
+	, finished(false)
+{
+}
+
+void CompressionStream::throwIfFinished() const
+{
+	if (finished)
+		throw love::Exception("The compression stream has already been finished.");
+}
+
+bool CompressionStream::getConstant(const char *in, Mode &out)
+{
+	return modeNames.find(in, out);
+}
+
+bool CompressionStream::getConstant(Mode in, const char *&out)
+{
+	return modeNames.find(in, out);
+}
+
+std::vector<std::string> CompressionStream::getConstants(Mode)
+{
+	return modeNames.getNames();
+}
+
+StringMap<CompressionStream::Mode, CompressionStream::MODE_MAX_ENUM>::Entry CompressionStream::modeEntries[] =
+{
+	{ "compress",   MODE_COMPRESS   },
+	{ "decompress", MODE_DECOMPRESS },
+};
+
+StringMap<CompressionStream::Mode, CompressionStream::MODE_MAX_ENUM> CompressionStream::modeNames(CompressionStream::modeEntries, sizeof(CompressionStream::modeEntries));
+
+} // data
+} // love
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Incrementally compresses or decompresses data which is pushed in pieces,
+ * so large inputs don't have to be held in memory all at once.
+ **/
+class CompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Mode
+	{
+		MODE_COMPRESS,
+		MODE_DECOMPRESS,
+		MODE_MAX_ENUM
+	};
+
+	/**
+	 * Creates a stream for the given format. The plain LZ4 format stores the
+	 * total size up front, so it can't be streamed - use FORMAT_LZ4_CHUNKED.
+	 *
+	 * @param level The amount of compression to apply (between 0 and 9), or
+	 *              -1 for the default. Ignored when decompressing.
+	 **/
+	static CompressionStream *create(Compressor::Format format, Mode mode, int level = -1);
+
+	virtual ~CompressionStream() {}
+
+	/**
+	 * Feeds input into the stream.
+	 * @param[out] output Any output produced is appended here.
+	 **/
+	virtual void push(const char *data, size_t size, std::vector<char> &output) = 0;
+
+	/**
+	 * Writes out all pending output. If finish is true the stream is ended,
+	 * and no more data can be pushed. When decompressing, finishing throws if
+	 * the compressed data was incomplete.
+	 * @param[out] output Any output produced is appended here.
+	 **/
+	virtual void flush(bool finish, std::vector<char> &output) = 0;
+
+	Compressor::Format getFormat() const { return format; }
+	Mode getMode() const { return mode; }
+	bool isFinished() const { return finished; }
+
+	static bool getConstant(const char *in, Mode &out);
+	static bool getConstant(Mode in, const char *&out);
+	static std::vector<std::string> getConstants(Mode);
+
+protected:
+
+	CompressionStream(Compressor::Format format, Mode mode);
+
+	void throwIfFinished() const;
+
+	Compressor::Format format;
+	Mode mode;
+	bool finished;
+
+private:
+
+	static StringMap<Mode, MODE_MAX_ENUM>::Entry modeEntries[];
+	static StringMap<Mode, MODE_MAX_ENUM> modeNames;
+
+}; // CompressionStream
+
+} // data
+} // love
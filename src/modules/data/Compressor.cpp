@@ -20,6 +20,7 @@
 
 // LOVE
 #include "Compressor.h"
+#include "ChunkedLZ4.h"
 #include "common/config.h"
 #include "common/int.h"
 #include "common/Exception.h"
@@ -167,6 +168,110 @@ class LZ4Compressor : public Compressor
 }; // LZ4Compressor
 
 
+class LZ4ChunkedCompressor : public Compressor
+{
+public:
+
+	char *compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize) override
+	{
+		if (format != FORMAT_LZ4_CHUNKED)
+			throw love::Exception("Invalid format (expecting chunked LZ4)");
+
+		size_t chunksize = chunkedlz4::DEFAULT_CHUNK_SIZE;
+		size_t maxsize = chunkedlz4::getContainerBound(dataSize, chunksize);
+		char *compressedbytes = nullptr;
+
+		try
+		{
+			compressedbytes = new char[maxsize];
+		}
+		catch (std::bad_alloc &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+
+		size_t size = chunkedlz4::HEADER_SIZE;
+
+		try
+		{
+			chunkedlz4::writeHeader(compressedbytes, chunksize);
+			size += chunkedlz4::compressChunks(data, dataSize, chunksize, level, compressedbytes + size);
+			chunkedlz4::writeEndMarker(compressedbytes + size);
+			size += chunkedlz4::END_MARKER_SIZE;
+		}
+		catch (love::Exception &)
+		{
+			delete[] compressedbytes;
+			throw;
+		}
+
+		// Shrink the buffer if the worst case estimate was far too large.
+		if ((double) maxsize / (double) size >= 1.2)
+		{
+			char *cbytes = new (std::nothrow) char[size];
+			if (cbytes)
+			{
+				memcpy(cbytes, compressedbytes, size);
+				delete[] compressedbytes;
+				compressedbytes = cbytes;
+			}
+		}
+
+		compressedSize = size;
+		return compressedbytes;
+	}
+
+	char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) override
+	{
+		if (format != FORMAT_LZ4_CHUNKED)
+			throw love::Exception("Invalid format (expecting chunked LZ4)");
+
+		size_t chunksize = 0;
+		if (!chunkedlz4::readHeader(data, dataSize, chunksize))
+			throw love::Exception("Invalid chunked LZ4 data size.");
+
+		std::vector<chunkedlz4::Chunk> chunks;
+		size_t consumed = 0;
+		const char *chunkdata = data + chunkedlz4::HEADER_SIZE;
+		if (!chunkedlz4::parseChunks(chunkdata, dataSize - chunkedlz4::HEADER_SIZE, chunksize, chunks, consumed))
+			throw love::Exception("Could not decompress LZ4-compressed data (data is truncated.)");
+
+		size_t rawsize = chunks.empty() ? 0 : chunks.back().rawOffset + chunks.back().rawSize;
+		char *rawbytes = nullptr;
+
+		try
+		{
+			// Zero-sized allocations are valid, and keep the ownership rules
+			// the same as the other formats.
+			rawbytes = new char[rawsize];
+		}
+		catch (std::bad_alloc &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+
+		try
+		{
+			chunkedlz4::decompressChunks(chunks, rawbytes);
+		}
+		catch (love::Exception &)
+		{
+			delete[] rawbytes;
+			throw;
+		}
+
+		decompressedSize = rawsize;
+		return rawbytes;
+	}
+
+	bool isSupported(Format format) const override
+	{
+		return format == FORMAT_LZ4_CHUNKED;
+	}
+
+}; // LZ4ChunkedCompressor
+
+
 class zlibCompressor : public Compressor
 {
 private:
@@ -362,9 +467,10 @@ class zlibCompressor : public Compressor
 Compressor *Compressor::getCompressor(Format format)
 {
 	static LZ4Compressor lz4compressor;
+	static LZ4ChunkedCompressor lz4chunkedcompressor;
 	static zlibCompressor zlibcompressor;
 
-	Compressor *compressors[] = {&lz4compressor, &zlibcompressor};
+	Compressor *compressors[] = {&lz4compressor, &lz4chunkedcompressor, &zlibcompressor};
 
 	for (Compressor *c : compressors)
 	{
@@ -392,10 +498,11 @@ std::vector<std::string> Compressor::getConstants(Format)
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM>::Entry Compressor::formatEntries[] =
 {
-	{ "lz4",     FORMAT_LZ4     },
-	{ "zlib",    FORMAT_ZLIB    },
-	{ "gzip",    FORMAT_GZIP    },
-	{ "deflate", FORMAT_DEFLATE },
+	{ "lz4",        FORMAT_LZ4         },
+	{ "zlib",       FORMAT_ZLIB        },
+	{ "gzip",       FORMAT_GZIP        },
+	{ "deflate",    FORMAT_DEFLATE     },
+	{ "lz4chunked", FORMAT_LZ4_CHUNKED },
 };
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM> Compressor::formatNames(Compressor::formatEntries, sizeof(Compressor::formatEntries));
@@ -242,6 +242,16 @@ ByteData *DataModule::newByteData(void *d, size_t size, bool own)
 	return new ByteData(d, size, own);
 }
 
+CompressionStream *DataModule::newCompressionStream(Compressor::Format format, CompressionStream::Mode mode, int level)
+{
+	return CompressionStream::create(format, mode, level);
+}
+
+Hasher *DataModule::newHasher(HashFunction::Function function)
+{
+	return new Hasher(function);
+}
+
 static StringMap<EncodeFormat, ENCODE_MAX_ENUM>::Entry encoderEntries[] =
 {
 	{ "base64", ENCODE_BASE64 },
@@ -22,7 +22,9 @@
 
 #include "CompressedData.h"
 #include "Compressor.h"
+#include "CompressionStream.h"
 #include "HashFunction.h"
+#include "Hasher.h"
 #include "DataView.h"
 #include "ByteData.h"
 
@@ -121,6 +123,8 @@ class DataModule : public Module
 	ByteData *newByteData(size_t size);
 	ByteData *newByteData(const void *d, size_t size);
 	ByteData *newByteData(void *d, size_t size, bool own);
+	CompressionStream *newCompressionStream(Compressor::Format format, CompressionStream::Mode mode, int level = -1);
+	Hasher *newHasher(HashFunction::Function function);
 
 }; // DataModule
 
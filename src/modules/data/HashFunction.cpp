@@ -19,13 +19,47 @@
  **/
 
 #include "HashFunction.h"
+#include "common/config.h"
 #include "common/Exception.h"
 
+// zlib
+#include <zlib.h>
+
+// xxHash
+#include "libraries/xxHash/xxhash.h"
+
+// C++
+#include <algorithm>
+
+// C
+#include <string.h>
+
 // FIXME: Probably trivial by having tole and tobe functions, which can be ifdeffed to being identity functions
 #ifdef LOVE_BIG_ENDIAN
 #	error Hashing not yet implemented for big endian
 #endif
 
+// Hardware SHA-1 and SHA-256 instructions. They're detected at runtime on x86,
+// and at compile time on ARMv8 (where they're part of the crypto extensions).
+#if defined(LOVE_SIMD_SSE) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#	define LOVE_HASH_SHA_X86
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#	define LOVE_HASH_SHA_ARM
+#	include <arm_neon.h>
+#endif
+
+#if defined(LOVE_HASH_SHA_X86) && (defined(__GNUC__) || defined(__clang__))
+#	define LOVE_TARGET_SHA __attribute__((target("sha,sse4.1")))
+#else
+#	define LOVE_TARGET_SHA
+#endif
+
 namespace love
 {
 namespace data
@@ -36,6 +70,9 @@ namespace
 namespace impl
 {
 
+typedef HashFunction::Function Function;
+typedef HashFunction::Value Value;
+
 inline uint32 leftrot(uint32 x, uint8 amount)
 {
 	return (x << amount) | (x >> (32 - amount));
@@ -51,63 +88,460 @@ inline uint64 rightrot(uint64 x, uint8 amount)
 	return (x >> amount) | (x << (64 - amount));
 }
 
-// Extend the value of `a` to make it a multiple of `n`.
-inline uint64 extend_multiple(uint64 a, uint64 n)
+inline uint32 loadBE32(const uint8 *p)
+{
+	return ((uint32) p[0] << 24) | ((uint32) p[1] << 16) | ((uint32) p[2] << 8) | (uint32) p[3];
+}
+
+inline uint64 loadBE64(const uint8 *p)
+{
+	return ((uint64) loadBE32(p) << 32) | loadBE32(p + 4);
+}
+
+inline void storeBE32(char *p, uint32 x)
+{
+	p[0] = (x >> 24) & 0xFF;
+	p[1] = (x >> 16) & 0xFF;
+	p[2] = (x >>  8) & 0xFF;
+	p[3] = (x >>  0) & 0xFF;
+}
+
+inline void storeBE64(char *p, uint64 x)
+{
+	storeBE32(p, (uint32) (x >> 32));
+	storeBE32(p + 4, (uint32) x);
+}
+
+#ifdef LOVE_HASH_SHA_X86
+
+static bool hasSHAExtensions()
+{
+	static const bool supported = []()
+	{
+		bool ssse3 = false;
+		bool sse41 = false;
+		bool sha = false;
+#if defined(_MSC_VER)
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuidex(info, 1, 0);
+		ssse3 = (info[2] & (1 << 9)) != 0;
+		sse41 = (info[2] & (1 << 19)) != 0;
+		__cpuidex(info, 7, 0);
+		sha = (info[1] & (1 << 29)) != 0;
+#else
+		unsigned int a = 0, b = 0, c = 0, d = 0;
+		if (__get_cpuid_max(0, nullptr) < 7)
+			return false;
+		__cpuid_count(1, 0, a, b, c, d);
+		ssse3 = (c & (1 << 9)) != 0;
+		sse41 = (c & (1 << 19)) != 0;
+		__cpuid_count(7, 0, a, b, c, d);
+		sha = (b & (1 << 29)) != 0;
+#endif
+		return ssse3 && sse41 && sha;
+	}();
+
+	return supported;
+}
+
+// Each step is 4 rounds. The message schedule for later steps is computed
+// in-place from the previous 4 words. The steps are unrolled through templates
+// so the round constants are immediates and the words stay in registers.
+template <int J>
+LOVE_TARGET_SHA
+static inline void stepSHA1x86(__m128i &abcd, __m128i &e0, __m128i &e1, __m128i msg[4])
+{
+	__m128i &m = msg[J % 4];
+	__m128i &e = (J % 2 == 0) ? e0 : e1;
+
+	if (J == 0)
+		e0 = _mm_add_epi32(e0, m);
+	else
+		e = _mm_sha1nexte_epu32(e, m);
+
+	((J % 2 == 0) ? e1 : e0) = abcd;
+
+	if (J >= 3 && J <= 18)
+		msg[(J + 1) % 4] = _mm_sha1msg2_epu32(msg[(J + 1) % 4], m);
+
+	abcd = _mm_sha1rnds4_epu32(abcd, e, J / 5);
+
+	if (J >= 1 && J <= 16)
+		msg[(J + 3) % 4] = _mm_sha1msg1_epu32(msg[(J + 3) % 4], m);
+
+	if (J >= 2 && J <= 17)
+		msg[(J + 2) % 4] = _mm_xor_si128(msg[(J + 2) % 4], m);
+
+	if constexpr (J < 19)
+		stepSHA1x86<J + 1>(abcd, e0, e1, msg);
+}
+
+LOVE_TARGET_SHA
+static void compressSHA1x86(uint32 state[5], const uint8 *blocks, size_t count)
+{
+	const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) state), 0x1B);
+	__m128i e0 = _mm_set_epi32((int) state[4], 0, 0, 0);
+
+	for (size_t i = 0; i < count; i++, blocks += 64)
+	{
+		__m128i abcdsave = abcd;
+		__m128i e0save = e0;
+		__m128i e1 = _mm_setzero_si128();
+		__m128i msg[4];
+
+		for (int j = 0; j < 4; j++)
+			msg[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + j * 16)), mask);
+
+		stepSHA1x86<0>(abcd, e0, e1, msg);
+
+		e0 = _mm_sha1nexte_epu32(e0, e0save);
+		abcd = _mm_add_epi32(abcd, abcdsave);
+	}
+
+	_mm_storeu_si128((__m128i *) state, _mm_shuffle_epi32(abcd, 0x1B));
+	state[4] = (uint32) _mm_extract_epi32(e0, 3);
+}
+
+template <int J>
+LOVE_TARGET_SHA
+static inline void stepSHA256x86(__m128i &state0, __m128i &state1, __m128i msg[4], const uint32 constants[64])
+{
+	__m128i &m = msg[J % 4];
+	__m128i k = _mm_add_epi32(m, _mm_loadu_si128((const __m128i *) &constants[J * 4]));
+
+	state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+
+	if (J >= 3 && J <= 14)
+	{
+		__m128i &next = msg[(J + 1) % 4];
+		next = _mm_add_epi32(next, _mm_alignr_epi8(m, msg[(J + 3) % 4], 4));
+		next = _mm_sha256msg2_epu32(next, m);
+	}
+
+	state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(k, 0x0E));
+
+	if (J >= 1 && J <= 12)
+		msg[(J + 3) % 4] = _mm_sha256msg1_epu32(msg[(J + 3) % 4], m);
+
+	if constexpr (J < 15)
+		stepSHA256x86<J + 1>(state0, state1, msg, constants);
+}
+
+LOVE_TARGET_SHA
+static void compressSHA256x86(uint32 state[8], const uint32 constants[64], const uint8 *blocks, size_t count)
+{
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// The instructions want the state as ABEF and CDGH.
+	__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[4]), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	for (size_t i = 0; i < count; i++, blocks += 64)
+	{
+		__m128i abefsave = state0;
+		__m128i cdghsave = state1;
+		__m128i msg[4];
+
+		for (int j = 0; j < 4; j++)
+			msg[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + j * 16)), mask);
+
+		stepSHA256x86<0>(state0, state1, msg, constants);
+
+		state0 = _mm_add_epi32(state0, abefsave);
+		state1 = _mm_add_epi32(state1, cdghsave);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	_mm_storeu_si128((__m128i *) &state[0], _mm_blend_epi16(tmp, state1, 0xF0));
+	_mm_storeu_si128((__m128i *) &state[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#endif // LOVE_HASH_SHA_X86
+
+#ifdef LOVE_HASH_SHA_ARM
+
+// Same structure as the x86 version: 4 rounds per step, unrolled.
+template <int J>
+static inline void stepSHA1ARM(uint32x4_t &abcd, uint32 &e, uint32x4_t msg[4])
+{
+	static const uint32 constants[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+	uint32x4_t k = vaddq_u32(msg[J % 4], vdupq_n_u32(constants[J / 5]));
+	uint32 enext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+	if (J / 5 == 0)
+		abcd = vsha1cq_u32(abcd, e, k);
+	else if (J / 5 == 2)
+		abcd = vsha1mq_u32(abcd, e, k);
+	else
+		abcd = vsha1pq_u32(abcd, e, k);
+
+	e = enext;
+
+	if (J >= 2 && J <= 17)
+		msg[(J + 2) % 4] = vsha1su0q_u32(msg[(J + 2) % 4], msg[(J + 3) % 4], msg[J % 4]);
+
+	if (J >= 3 && J <= 18)
+		msg[(J + 1) % 4] = vsha1su1q_u32(msg[(J + 1) % 4], msg[J % 4]);
+
+	if constexpr (J < 19)
+		stepSHA1ARM<J + 1>(abcd, e, msg);
+}
+
+static void compressSHA1ARM(uint32 state[5], const uint8 *blocks, size_t count)
+{
+	uint32x4_t abcd = vld1q_u32(state);
+	uint32 e = state[4];
+
+	for (size_t i = 0; i < count; i++, blocks += 64)
+	{
+		uint32x4_t abcdsave = abcd;
+		uint32 esave = e;
+		uint32x4_t msg[4];
+
+		for (int j = 0; j < 4; j++)
+			msg[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + j * 16)));
+
+		stepSHA1ARM<0>(abcd, e, msg);
+
+		abcd = vaddq_u32(abcd, abcdsave);
+		e += esave;
+	}
+
+	vst1q_u32(state, abcd);
+	state[4] = e;
+}
+
+template <int J>
+static inline void stepSHA256ARM(uint32x4_t &state0, uint32x4_t &state1, uint32x4_t msg[4], const uint32 constants[64])
+{
+	uint32x4_t &m = msg[J % 4];
+	uint32x4_t k = vaddq_u32(m, vld1q_u32(&constants[J * 4]));
+
+	if (J < 12)
+		m = vsha256su0q_u32(m, msg[(J + 1) % 4]);
+
+	uint32x4_t tmp = state0;
+	state0 = vsha256hq_u32(state0, state1, k);
+	state1 = vsha256h2q_u32(state1, tmp, k);
+
+	if (J < 12)
+		m = vsha256su1q_u32(m, msg[(J + 2) % 4], msg[(J + 3) % 4]);
+
+	if constexpr (J < 15)
+		stepSHA256ARM<J + 1>(state0, state1, msg, constants);
+}
+
+static void compressSHA256ARM(uint32 state[8], const uint32 constants[64], const uint8 *blocks, size_t count)
 {
-	uint64 r = a % n;
-	return r == 0 ? a : a + (n-r);
+	uint32x4_t state0 = vld1q_u32(&state[0]);
+	uint32x4_t state1 = vld1q_u32(&state[4]);
+
+	for (size_t i = 0; i < count; i++, blocks += 64)
+	{
+		uint32x4_t abcdsave = state0;
+		uint32x4_t efghsave = state1;
+		uint32x4_t msg[4];
+
+		for (int j = 0; j < 4; j++)
+			msg[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + j * 16)));
+
+		stepSHA256ARM<0>(state0, state1, msg, constants);
+
+		state0 = vaddq_u32(state0, abcdsave);
+		state1 = vaddq_u32(state1, efghsave);
+	}
+
+	vst1q_u32(&state[0], state0);
+	vst1q_u32(&state[4], state1);
 }
 
+#endif // LOVE_HASH_SHA_ARM
+
 /**
- * The following implementation is based on the pseudocode provided by multiple
- * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
- * The pseudocode is licensed under the CC-BY-SA license, but no authorship
- * information is present. I believe this note, and the zlib license of this
- * project satisfy the conditions of the license.
+ * Incremental state for Merkle-Damgard style hash functions, which process
+ * fixed-size blocks and pad the final block with the input's length. The
+ * Engine holds the algorithm's intermediate values and compresses blocks.
  **/
-class MD5 : public HashFunction
+template <typename Engine>
+class BlockState : public HashFunction::State
 {
+public:
+
+	BlockState(Function function)
+		: function(function)
+	{
+		reset();
+	}
+
+	void reset() override
+	{
+		engine.reset(function);
+		buffered = 0;
+		length = 0;
+	}
+
+	void update(const char *input, uint64 size) override
+	{
+		const uint8 *in = (const uint8 *) input;
+		length += size;
+
+		if (buffered > 0)
+		{
+			size_t n = (size_t) std::min((uint64) (Engine::BLOCK_SIZE - buffered), size);
+			memcpy(buffer + buffered, in, n);
+			buffered += n;
+			in += n;
+			size -= n;
+
+			if (buffered < Engine::BLOCK_SIZE)
+				return;
+
+			engine.compress(buffer, 1);
+			buffered = 0;
+		}
+
+		// Whole blocks are compressed straight from the input.
+		uint64 blocks = size / Engine::BLOCK_SIZE;
+		if (blocks > 0)
+		{
+			engine.compress(in, (size_t) blocks);
+			in += blocks * Engine::BLOCK_SIZE;
+			size -= blocks * Engine::BLOCK_SIZE;
+		}
+
+		if (size > 0)
+		{
+			memcpy(buffer, in, (size_t) size);
+			buffered = (size_t) size;
+		}
+	}
+
+	void digest(Value &output) const override
+	{
+		Engine finished = engine;
+
+		// Append the bit, then zeroes, then the length in bits. That may not
+		// fit in the remainder of the current block.
+		uint8 padded[Engine::BLOCK_SIZE * 2];
+		size_t paddedsize = Engine::BLOCK_SIZE;
+		if (buffered + 1 + Engine::LENGTH_SIZE > Engine::BLOCK_SIZE)
+			paddedsize *= 2;
+
+		memcpy(padded, buffer, buffered);
+		padded[buffered] = 0x80;
+		memset(padded + buffered + 1, 0, paddedsize - buffered - 1);
+
+		uint64 bit_length = length * 8;
+		for (int i = 0; i < 8; i++)
+		{
+			uint8 byte = (bit_length >> (i * 8)) & 0xFF;
+			if (Engine::BIG_ENDIAN_LENGTH)
+				padded[paddedsize - 1 - i] = byte;
+			else
+				padded[paddedsize - Engine::LENGTH_SIZE + i] = byte;
+		}
+
+		finished.compress(padded, paddedsize / Engine::BLOCK_SIZE);
+		finished.finish(output);
+	}
+
 private:
-	static const uint8 shifts[64];
-	static const uint32 constants[64];
 
+	Function function;
+	Engine engine;
+
+	uint8 buffer[Engine::BLOCK_SIZE];
+	size_t buffered;
+
+	uint64 length;
+
+}; // BlockState
+
+template <typename Engine>
+class BlockHashFunction : public HashFunction
+{
 public:
+
+	BlockHashFunction(const char *name)
+		: name(name)
+	{}
+
 	bool isSupported(Function function) const override
 	{
-		return function == FUNCTION_MD5;
+		return Engine::isSupported(function);
 	}
 
 	void hash(Function function, const char *input, uint64 length, Value &output) const override
 	{
-		if (function != FUNCTION_MD5)
-			throw love::Exception("Hash function not supported by MD5 implementation");
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by %s implementation", name);
 
-		uint32 a0 = 0x67452301;
-		uint32 b0 = 0xefcdab89;
-		uint32 c0 = 0x98badcfe;
-		uint32 d0 = 0x10325476;
+		BlockState<Engine> state(function);
+		state.update(input, length);
+		state.digest(output);
+	}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by %s implementation", name);
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
+		return new BlockState<Engine>(function);
+	}
 
-		// Append length in bits
-		uint64 bit_length = length * 8;
-		memcpy(((uint8*)padded) + paddedLength - 8, &bit_length, 8);
+private:
+
+	const char *name;
+
+}; // BlockHashFunction
+
+/**
+ * The following implementation is based on the pseudocode provided by multiple
+ * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
+ * The pseudocode is licensed under the CC-BY-SA license, but no authorship
+ * information is present. I believe this note, and the zlib license of this
+ * project satisfy the conditions of the license.
+ **/
+class MD5
+{
+public:
+	static const size_t BLOCK_SIZE = 64;
+	static const size_t LENGTH_SIZE = 8;
+	static const bool BIG_ENDIAN_LENGTH = false;
+
+	static bool isSupported(Function function)
+	{
+		return function == HashFunction::FUNCTION_MD5;
+	}
 
-		// Process chunks
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+	void reset(Function /*function*/)
+	{
+		state[0] = 0x67452301;
+		state[1] = 0xefcdab89;
+		state[2] = 0x98badcfe;
+		state[3] = 0x10325476;
+	}
+
+	void compress(const uint8 *blocks, size_t count)
+	{
+		for (size_t i = 0; i < count; i++, blocks += BLOCK_SIZE)
 		{
-			uint32 *chunk = &padded[i];
+			uint32 chunk[16];
+			memcpy(chunk, blocks, sizeof(chunk));
 
-			uint32 A = a0;
-			uint32 B = b0;
-			uint32 C = c0;
-			uint32 D = d0;
+			uint32 A = state[0];
+			uint32 B = state[1];
+			uint32 C = state[2];
+			uint32 D = state[3];
 			uint32 F;
 			uint32 g;
 
@@ -141,21 +575,25 @@ class MD5 : public HashFunction
 				A = temp;
 			}
 
-			a0 += A;
-			b0 += B;
-			c0 += C;
-			d0 += D;
+			state[0] += A;
+			state[1] += B;
+			state[2] += C;
+			state[3] += D;
 		}
+	}
 
-		delete[] padded;
-
-		memcpy(&output.data[ 0], &a0, 4);
-		memcpy(&output.data[ 4], &b0, 4);
-		memcpy(&output.data[ 8], &c0, 4);
-		memcpy(&output.data[12], &d0, 4);
+	void finish(Value &output) const
+	{
+		memcpy(output.data, state, 16);
 		output.size = 16;
 	}
-} md5;
+
+private:
+	static const uint8 shifts[64];
+	static const uint32 constants[64];
+
+	uint32 state[4];
+};
 
 const uint8 MD5::shifts[64] = {
 	7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
@@ -188,50 +626,45 @@ const uint32 MD5::constants[64] = {
  * in RFC3174. I believe this means no copyright other than that of the L�VE
  * Development Team applies.
  **/
-class SHA1 : public HashFunction
+class SHA1
 {
 public:
-	bool isSupported(Function function) const override
+	static const size_t BLOCK_SIZE = 64;
+	static const size_t LENGTH_SIZE = 8;
+	static const bool BIG_ENDIAN_LENGTH = true;
+
+	static bool isSupported(Function function)
 	{
-		return function == FUNCTION_SHA1;
+		return function == HashFunction::FUNCTION_SHA1;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	void reset(Function /*function*/)
 	{
-		if (function != FUNCTION_SHA1)
-			throw love::Exception("Hash function not supported by SHA1 implementation");
-
-		uint32 intermediate[5] = {
+		static const uint32 initial[5] = {
 			0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
 		};
+		memcpy(intermediate, initial, sizeof(intermediate));
+	}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
-
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
-
+	void compress(const uint8 *blocks, size_t count)
+	{
+#if defined(LOVE_HASH_SHA_ARM)
+		compressSHA1ARM(intermediate, blocks, count);
+#else
+#if defined(LOVE_HASH_SHA_X86)
+		if (hasSHAExtensions())
+		{
+			compressSHA1x86(intermediate, blocks, count);
+			return;
+		}
+#endif
 		// Allocate our extended words
 		uint32 words[80];
 
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		for (size_t i = 0; i < count; i++, blocks += BLOCK_SIZE)
 		{
-			uint32 *chunk = &padded[i];
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE32(blocks + j * 4);
 			for (int j = 16; j < 80; j++)
 				words[j] = leftrot(words[j-3] ^ words[j-8] ^ words[j-14] ^ words[j-16], 1);
 
@@ -267,76 +700,66 @@ class SHA1 : public HashFunction
 			intermediate[3] += D;
 			intermediate[4] += E;
 		}
+#endif
+	}
 
-		delete[] padded;
-
+	void finish(Value &output) const
+	{
 		for (int i = 0; i < 20; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+			storeBE32(&output.data[i], intermediate[i/4]);
 
 		output.size = 20;
 	}
-} sha1;
+
+private:
+	uint32 intermediate[5];
+};
 
 /**
  * This implementation was based on the description in RFC-6234.
  **/
 // SHA-2: SHA-224 and SHA-256
-class SHA256 : public HashFunction
+class SHA256
 {
-private:
-	static const uint32 initial224[8];
-	static const uint32 initial256[8];
-	static const uint32 constants[64];
-
 public:
-	bool isSupported(Function function) const override
+	static const size_t BLOCK_SIZE = 64;
+	static const size_t LENGTH_SIZE = 8;
+	static const bool BIG_ENDIAN_LENGTH = true;
+
+	static bool isSupported(Function function)
 	{
-		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
+		return function == HashFunction::FUNCTION_SHA224 || function == HashFunction::FUNCTION_SHA256;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	void reset(Function function)
 	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
-
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
-
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
+		hashlength = function == HashFunction::FUNCTION_SHA224 ? 28 : 32;
 
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
-
-		uint32 intermediate[8];
-		if (function == FUNCTION_SHA224)
+		if (function == HashFunction::FUNCTION_SHA224)
 			memcpy(intermediate, initial224, sizeof(intermediate));
 		else
 			memcpy(intermediate, initial256, sizeof(intermediate));
+	}
 
+	void compress(const uint8 *blocks, size_t count)
+	{
+#if defined(LOVE_HASH_SHA_ARM)
+		compressSHA256ARM(intermediate, constants, blocks, count);
+#else
+#if defined(LOVE_HASH_SHA_X86)
+		if (hasSHAExtensions())
+		{
+			compressSHA256x86(intermediate, constants, blocks, count);
+			return;
+		}
+#endif
 		// Allocate our extended words
 		uint32 words[64];
 
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		for (size_t i = 0; i < count; i++, blocks += BLOCK_SIZE)
 		{
-			uint32 *chunk = &padded[i];
 			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE32(blocks + j * 4);
 			for (int j = 16; j < 64; j++)
 			{
 				words[j] = rightrot(words[j-2], 17) ^ rightrot(words[j-2], 19) ^ (words[j-2] >> 10);
@@ -380,24 +803,25 @@ class SHA256 : public HashFunction
 			intermediate[6] += G;
 			intermediate[7] += H;
 		}
+#endif
+	}
 
-		delete[] padded;
-
-		int hashlength = 32;
-		if (function == FUNCTION_SHA224)
-			hashlength = 28;
-
+	void finish(Value &output) const
+	{
 		for (int i = 0; i < hashlength; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+			storeBE32(&output.data[i], intermediate[i/4]);
 
 		output.size = hashlength;
 	}
-} sha256;
+
+private:
+	static const uint32 initial224[8];
+	static const uint32 initial256[8];
+	static const uint32 constants[64];
+
+	uint32 intermediate[8];
+	int hashlength;
+};
 
 const uint32 SHA256::initial224[8] = {
 	0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
@@ -432,62 +856,38 @@ const uint32 SHA256::constants[64] = {
  * This implementation was based on the description in RFC-6234.
  **/
 // SHA-2: SHA-384 and SHA-512
-class SHA512 : public HashFunction
+class SHA512
 {
-private:
-	static const uint64 initial384[8];
-	static const uint64 initial512[8];
-	static const uint64 constants[80];
-
 public:
-	bool isSupported(Function function) const override
+	static const size_t BLOCK_SIZE = 128;
+	// Note we only write a 64-bit length, the first 8 bytes are left as zeroes.
+	static const size_t LENGTH_SIZE = 16;
+	static const bool BIG_ENDIAN_LENGTH = true;
+
+	static bool isSupported(Function function)
 	{
-		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
+		return function == HashFunction::FUNCTION_SHA384 || function == HashFunction::FUNCTION_SHA512;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	void reset(Function function)
 	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+		hashlength = function == HashFunction::FUNCTION_SHA384 ? 48 : 64;
 
-		uint64 intermediates[8];
-		if (function == FUNCTION_SHA384)
+		if (function == HashFunction::FUNCTION_SHA384)
 			memcpy(intermediates, initial384, sizeof(intermediates));
 		else
 			memcpy(intermediates, initial512, sizeof(intermediates));
+	}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 16, 128);
-
-		uint64 *padded = new uint64[paddedLength / 8];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian), note we only write a 64-bit int, so
-		// we have filled the first 8 bytes with zeroes
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
-
+	void compress(const uint8 *blocks, size_t count)
+	{
 		// Allocate our extended words
 		uint64 words[80];
 
-		for (uint64 i = 0; i < paddedLength/8; i += 16)
+		for (size_t i = 0; i < count; i++, blocks += BLOCK_SIZE)
 		{
-			uint64 *chunk = &padded[i];
 			for (int j = 0; j < 16; ++j)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 56) & 0xFF;
-				c[1] = (chunk[j] >> 48) & 0xFF;
-				c[2] = (chunk[j] >> 40) & 0xFF;
-				c[3] = (chunk[j] >> 32) & 0xFF;
-				c[4] = (chunk[j] >> 24) & 0xFF;
-				c[5] = (chunk[j] >> 16) & 0xFF;
-				c[6] = (chunk[j] >>  8) & 0xFF;
-				c[7] = (chunk[j] >>  0) & 0xFF;
-			}
+				words[j] = loadBE64(blocks + j * 8);
 			for (int j = 16; j < 80; ++j)
 			{
 				words[j] = words[j-7] + words[j-16];
@@ -530,28 +930,24 @@ class SHA512 : public HashFunction
 			intermediates[6] += G;
 			intermediates[7] += H;
 		}
+	}
 
-		delete[] padded;
-
-		int hashlength = 64;
-		if (function == FUNCTION_SHA384)
-			hashlength = 48;
-
+	void finish(Value &output) const
+	{
 		for (int i = 0; i < hashlength; i += 8)
-		{
-			output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
-			output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
-			output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
-			output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
-			output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
-			output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
-			output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
-			output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
-		}
+			storeBE64(&output.data[i], intermediates[i/8]);
 
 		output.size = hashlength;
 	}
-} sha512;
+
+private:
+	static const uint64 initial384[8];
+	static const uint64 initial512[8];
+	static const uint64 constants[80];
+
+	uint64 intermediates[8];
+	int hashlength;
+};
 
 const uint64 SHA512::initial384[8] = {
 	0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939,
@@ -586,6 +982,194 @@ const uint64 SHA512::constants[80] = {
 	0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
 };
 
+BlockHashFunction<MD5> md5("MD5");
+BlockHashFunction<SHA1> sha1("SHA1");
+BlockHashFunction<SHA256> sha256("SHA-224/SHA-256");
+BlockHashFunction<SHA512> sha512("SHA-384/SHA-512");
+
+// XXH3 output is stored in its canonical (big endian) form, which matches the
+// hex strings printed by xxhsum.
+static void getXXH3Value(Function function, XXH3_state_t *state, Value &output)
+{
+	if (function == HashFunction::FUNCTION_XXH3_64)
+	{
+		XXH64_canonical_t canonical;
+		XXH64_canonicalFromHash(&canonical, XXH3_64bits_digest(state));
+		memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+		output.size = sizeof(canonical.digest);
+	}
+	else
+	{
+		XXH128_canonical_t canonical;
+		XXH128_canonicalFromHash(&canonical, XXH3_128bits_digest(state));
+		memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+		output.size = sizeof(canonical.digest);
+	}
+}
+
+class XXH3State : public HashFunction::State
+{
+public:
+
+	XXH3State(Function function)
+		: function(function)
+		, state(XXH3_createState())
+	{
+		if (state == nullptr)
+			throw love::Exception("Out of memory.");
+
+		reset();
+	}
+
+	virtual ~XXH3State()
+	{
+		XXH3_freeState(state);
+	}
+
+	void reset() override
+	{
+		if (function == HashFunction::FUNCTION_XXH3_64)
+			XXH3_64bits_reset(state);
+		else
+			XXH3_128bits_reset(state);
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		if (function == HashFunction::FUNCTION_XXH3_64)
+			XXH3_64bits_update(state, input, (size_t) length);
+		else
+			XXH3_128bits_update(state, input, (size_t) length);
+	}
+
+	void digest(Value &output) const override
+	{
+		getXXH3Value(function, state, output);
+	}
+
+private:
+
+	Function function;
+	XXH3_state_t *state;
+
+}; // XXH3State
+
+/**
+ * Non-cryptographic, but much faster than the other functions. Useful for
+ * change detection and checksums.
+ **/
+class XXH3 : public HashFunction
+{
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_XXH3_64 || function == FUNCTION_XXH3_128;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function == FUNCTION_XXH3_64)
+		{
+			XXH64_canonical_t canonical;
+			XXH64_canonicalFromHash(&canonical, XXH3_64bits(input, (size_t) length));
+			memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+			output.size = sizeof(canonical.digest);
+		}
+		else if (function == FUNCTION_XXH3_128)
+		{
+			XXH128_canonical_t canonical;
+			XXH128_canonicalFromHash(&canonical, XXH3_128bits(input, (size_t) length));
+			memcpy(output.data, canonical.digest, sizeof(canonical.digest));
+			output.size = sizeof(canonical.digest);
+		}
+		else
+			throw love::Exception("Hash function not supported by XXH3 implementation");
+	}
+
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by XXH3 implementation");
+
+		return new XXH3State(function);
+	}
+} xxh3;
+
+// zlib takes 32 bit lengths.
+static uint32 updateCRC32(uint32 crc, const char *input, uint64 length)
+{
+	while (length > 0)
+	{
+		uInt piece = (uInt) std::min(length, (uint64) 0x40000000);
+		crc = (uint32) ::crc32(crc, (const Bytef *) input, piece);
+		input += piece;
+		length -= piece;
+	}
+
+	return crc;
+}
+
+class CRC32State : public HashFunction::State
+{
+public:
+
+	CRC32State()
+	{
+		reset();
+	}
+
+	void reset() override
+	{
+		crc = (uint32) ::crc32(0L, Z_NULL, 0);
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		crc = updateCRC32(crc, input, length);
+	}
+
+	void digest(Value &output) const override
+	{
+		storeBE32(output.data, crc);
+		output.size = 4;
+	}
+
+private:
+
+	uint32 crc;
+
+}; // CRC32State
+
+/**
+ * The CRC-32 used by zlib, gzip and PNG.
+ **/
+class CRC32 : public HashFunction
+{
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_CRC32;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function != FUNCTION_CRC32)
+			throw love::Exception("Hash function not supported by CRC32 implementation");
+
+		CRC32State state;
+		state.update(input, length);
+		state.digest(output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function != FUNCTION_CRC32)
+			throw love::Exception("Hash function not supported by CRC32 implementation");
+
+		return new CRC32State();
+	}
+} crc32;
+
 } // impl
 }
 
@@ -603,6 +1187,11 @@ HashFunction *HashFunction::getHashFunction(Function function)
 	case FUNCTION_SHA384:
 	case FUNCTION_SHA512:
 		return &impl::sha512;
+	case FUNCTION_XXH3_64:
+	case FUNCTION_XXH3_128:
+		return &impl::xxh3;
+	case FUNCTION_CRC32:
+		return &impl::crc32;
 	case FUNCTION_MAX_ENUM:
 		return nullptr;
 	// No default for compiler warnings
@@ -632,6 +1221,9 @@ StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM>::Entry HashFu
 	{"sha256", FUNCTION_SHA256},
 	{"sha384", FUNCTION_SHA384},
 	{"sha512", FUNCTION_SHA512},
+	{"xxh3_64", FUNCTION_XXH3_64},
+	{"xxh3_128", FUNCTION_XXH3_128},
+	{"crc32", FUNCTION_CRC32},
 };
 
 StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM> HashFunction::functionNames(HashFunction::functionEntries, sizeof(HashFunction::functionEntries));
@@ -42,6 +42,9 @@ class HashFunction
 		FUNCTION_SHA256,
 		FUNCTION_SHA384,
 		FUNCTION_SHA512,
+		FUNCTION_XXH3_64,
+		FUNCTION_XXH3_128,
+		FUNCTION_CRC32,
 		FUNCTION_MAX_ENUM
 	};
 
@@ -51,6 +54,33 @@ class HashFunction
 		size_t size;
 	};
 
+	/**
+	 * Incremental hashing state, for input which isn't available all at once.
+	 **/
+	class State
+	{
+	public:
+
+		virtual ~State() {}
+
+		/**
+		 * Discards all input added so far.
+		 **/
+		virtual void reset() = 0;
+
+		/**
+		 * Adds more input to the hash.
+		 **/
+		virtual void update(const char *input, uint64 length) = 0;
+
+		/**
+		 * Produces the hash of all input added so far. The state is not
+		 * modified, so more input can be added afterwards.
+		 **/
+		virtual void digest(Value &output) const = 0;
+
+	}; // State
+
 	/**
 	 * Get a HashFunction instance for the given function.
 	 *
@@ -72,6 +102,14 @@ class HashFunction
 	 **/
 	virtual void hash(Function function, const char *input, uint64 length, Value &output) const = 0;
 
+	/**
+	 * Create a new incremental hashing state.
+	 *
+	 * @param[in] function The selected hash function.
+	 * @return The new state, which the caller must delete.
+	 **/
+	virtual State *newState(Function function) const = 0;
+
 	/**
 	 * @param[in] function The requested hash function.
 	 * @return Whether this HashFunction instance implements the given function.
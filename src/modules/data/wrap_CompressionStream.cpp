@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_CompressionStream.h"
+#include "common/Data.h"
+
+namespace love
+{
+namespace data
+{
+
+CompressionStream *luax_checkcompressionstream(lua_State *L, int idx)
+{
+	return luax_checktype<CompressionStream>(L, idx);
+}
+
+static void pushOutput(lua_State *L, const std::vector<char> &output)
+{
+	if (output.empty())
+		lua_pushstring(L, "");
+	else
+		lua_pushlstring(L, output.data(), output.size());
+}
+
+int w_CompressionStream_push(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	size_t size = 0;
+	const char *bytes = nullptr;
+
+	if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, 2);
+		bytes = (const char *) data->getData();
+		size = data->getSize();
+	}
+	else
+		bytes = luaL_checklstring(L, 2, &size);
+
+	std::vector<char> output;
+	luax_catchexcept(L, [&](){ t->push(bytes, size, output); });
+
+	pushOutput(L, output);
+	return 1;
+}
+
+int w_CompressionStream_flush(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+	bool finish = luax_optboolean(L, 2, true);
+
+	std::vector<char> output;
+	luax_catchexcept(L, [&](){ t->flush(finish, output); });
+
+	pushOutput(L, output);
+	return 1;
+}
+
+int w_CompressionStream_isFinished(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+	luax_pushboolean(L, t->isFinished());
+	return 1;
+}
+
+int w_CompressionStream_getFormat(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(t->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_CompressionStream_getMode(lua_State *L)
+{
+	CompressionStream *t = luax_checkcompressionstream(L, 1);
+
+	const char *mname = nullptr;
+	if (!CompressionStream::getConstant(t->getMode(), mname))
+		return luax_enumerror(L, "compression stream mode", CompressionStream::getConstants(CompressionStream::MODE_MAX_ENUM), mname);
+
+	lua_pushstring(L, mname);
+	return 1;
+}
+
+static const luaL_Reg w_CompressionStream_functions[] =
+{
+	{ "push", w_CompressionStream_push },
+	{ "flush", w_CompressionStream_flush },
+	{ "isFinished", w_CompressionStream_isFinished },
+	{ "getFormat", w_CompressionStream_getFormat },
+	{ "getMode", w_CompressionStream_getMode },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_compressionstream(lua_State *L)
+{
+	return luax_register_type(L, &CompressionStream::type, w_CompressionStream_functions, nullptr);
+}
+
+} // data
+} // love
@@ -24,6 +24,8 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_CompressionStream.h"
+#include "wrap_Hasher.h"
 #include "DataModule.h"
 #include "common/b64.h"
 
@@ -200,6 +202,34 @@ int w_decompress(lua_State *L)
 	return 1;
 }
 
+static int newCompressionStream(lua_State *L, CompressionStream::Mode mode)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	Compressor::Format format = Compressor::FORMAT_LZ4_CHUNKED;
+
+	if (!Compressor::getConstant(fstr, format))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	int level = mode == CompressionStream::MODE_COMPRESS ? (int) luaL_optinteger(L, 2, -1) : -1;
+
+	CompressionStream *stream = nullptr;
+	luax_catchexcept(L, [&](){ stream = instance()->newCompressionStream(format, mode, level); });
+
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
+int w_newCompressor(lua_State *L)
+{
+	return newCompressionStream(L, CompressionStream::MODE_COMPRESS);
+}
+
+int w_newDecompressor(lua_State *L)
+{
+	return newCompressionStream(L, CompressionStream::MODE_DECOMPRESS);
+}
+
 int w_encode(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -351,6 +381,21 @@ int w_hash(lua_State *L)
 	return 1;
 }
 
+int w_newHasher(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	HashFunction::Function function;
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
+
+	Hasher *hasher = nullptr;
+	luax_catchexcept(L, [&](){ hasher = instance()->newHasher(function); });
+
+	luax_pushtype(L, hasher);
+	hasher->release();
+	return 1;
+}
+
 int w_pack(lua_State *L)
 {
 	if (luax_istype(L, 1, ByteData::type))
@@ -422,9 +467,12 @@ static const luaL_Reg functions[] =
 	{ "newByteData", w_newByteData },
 	{ "compress", w_compress },
 	{ "decompress", w_decompress },
+	{ "newCompressor", w_newCompressor },
+	{ "newDecompressor", w_newDecompressor },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
 	{ "hash", w_hash },
+	{ "newHasher", w_newHasher },
 
 	{ "pack", w_pack },
 	{ "unpack", w_unpack },
@@ -439,6 +487,8 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_compressionstream,
+	luaopen_hasher,
 	nullptr
 };
 
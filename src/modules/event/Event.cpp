@@ -20,6 +20,10 @@
 
 #include "Event.h"
 
+// C++
+#include <algorithm>
+#include <unordered_set>
+
 using love::thread::Mutex;
 using love::thread::Lock;
 
@@ -28,20 +32,146 @@ namespace love
 namespace event
 {
 
-Message::Message(const std::string &name, const std::vector<Variant> &vargs)
+Message::Message(const char *name, Coalesce coalesce)
+	: name(name)
+	, coalesce(coalesce)
+	, argCount(0)
+{
+}
+
+Message::Message(const char *name, const std::vector<Variant> &vargs)
 	: name(name)
-	, args(vargs)
+	, coalesce(COALESCE_NONE)
+	, argCount(0)
 {
+	for (const Variant &v : vargs)
+		addArg(v);
+}
+
+Message::Message(const Message &m)
+	: name(m.name)
+	, coalesce(m.coalesce)
+	, extraArgs(m.extraArgs)
+	, ownedName(m.ownedName)
+	, argCount(m.argCount)
+{
+	if (m.ownsName())
+		name = ownedName.c_str();
+
+	for (int i = 0; i < std::min(argCount, MAX_INLINE_ARGS); i++)
+		inlineArgs[i] = m.inlineArgs[i];
 }
 
 Message::~Message()
 {
 }
 
+Message &Message::operator = (const Message &m)
+{
+	if (this == &m)
+		return *this;
+
+	// Only the slots used by either message need to be touched.
+	int count = std::min(std::max(argCount, m.argCount), MAX_INLINE_ARGS);
+	for (int i = 0; i < count; i++)
+		inlineArgs[i] = i < m.argCount ? m.inlineArgs[i] : Variant();
+
+	if (m.ownsName())
+	{
+		// Reuses this message's string storage when it's large enough.
+		ownedName = m.ownedName;
+		name = ownedName.c_str();
+	}
+	else
+		name = m.name;
+
+	coalesce = m.coalesce;
+	extraArgs = m.extraArgs;
+	argCount = m.argCount;
+	return *this;
+}
+
+void Message::clear()
+{
+	// Releases any objects or strings held by the arguments.
+	for (int i = 0; i < std::min(argCount, MAX_INLINE_ARGS); i++)
+		inlineArgs[i] = Variant();
+
+	extraArgs.clear();
+	argCount = 0;
+	name = nullptr;
+	coalesce = COALESCE_NONE;
+}
+
+const char *Message::internName(const std::string &name)
+{
+	static love::thread::MutexRef mutex;
+	static std::unordered_set<std::string> names;
+
+	Lock lock(mutex);
+
+	auto it = names.find(name);
+	if (it != names.end())
+		return it->c_str();
+
+	// Dynamically generated names would otherwise grow the set forever.
+	if (names.size() >= MAX_INTERNED_NAMES)
+		return nullptr;
+
+	// Elements of an unordered_set are never moved, so the pointer stays valid.
+	return names.insert(name).first->c_str();
+}
+
+void Message::setName(const std::string &newname)
+{
+	name = internName(newname);
+	if (name == nullptr)
+	{
+		ownedName = newname;
+		name = ownedName.c_str();
+	}
+}
+
+static bool isSameKey(const Variant &a, const Variant &b)
+{
+	if (a.getType() != b.getType())
+		return false;
+
+	const Variant::Data &da = a.getData();
+	const Variant::Data &db = b.getData();
+
+	switch (a.getType())
+	{
+	case Variant::BOOLEAN:
+		return da.boolean == db.boolean;
+	case Variant::NUMBER:
+		return da.number == db.number;
+	case Variant::LUSERDATA:
+		return da.userdata == db.userdata;
+	case Variant::LOVEOBJECT:
+		return da.objectproxy.object == db.objectproxy.object;
+	case Variant::SMALLSTRING:
+		return da.smallstring.len == db.smallstring.len && memcmp(da.smallstring.str, db.smallstring.str, da.smallstring.len) == 0;
+	case Variant::STRING:
+		return da.string->len == db.string->len && memcmp(da.string->str, db.string->str, da.string->len) == 0;
+	default:
+		return false;
+	}
+}
+
+static void accumulate(Variant &dst, const Variant &src)
+{
+	if (dst.getType() == Variant::NUMBER && src.getType() == Variant::NUMBER)
+		dst = Variant(dst.getData().number + src.getData().number);
+}
+
 Event::Event(const char *name)
 	: Module(M_EVENT, name)
 	, modalDrawData()
 	, defaultModalDrawData()
+	, queueHead(0)
+	, queueCount(0)
+	, coalescing(false)
 {
 }
 
@@ -54,32 +184,114 @@ Event::~Event()
 		defaultModalDrawData.cleanup(defaultModalDrawData.context);
 }
 
-void Event::push(Message *msg)
+void Event::push(const Message &msg)
 {
 	Lock lock(mutex);
-	msg->retain();
-	queue.push(msg);
+
+	if (coalescing && msg.coalesce != Message::COALESCE_NONE && coalesce(msg))
+		return;
+
+	if (queueCount == queue.size())
+	{
+		// Grow the ring buffer, unwrapping the queued messages as we go.
+		std::vector<Message> newqueue(std::max(queue.size() * 2, (size_t) 64));
+		for (size_t i = 0; i < queueCount; i++)
+			newqueue[i] = queue[(queueHead + i) % queue.size()];
+
+		queue.swap(newqueue);
+		queueHead = 0;
+	}
+
+	queue[(queueHead + queueCount) % queue.size()] = msg;
+	queueCount++;
 }
 
-bool Event::poll(Message *&msg)
+bool Event::poll(Message &msg)
 {
 	Lock lock(mutex);
-	if (queue.empty())
+	if (queueCount == 0)
 		return false;
-	msg = queue.front();
-	queue.pop();
+
+	Message &front = queue[queueHead];
+	msg = front;
+	front.clear();
+
+	queueHead = (queueHead + 1) % queue.size();
+	queueCount--;
 	return true;
 }
 
 void Event::clear()
 {
 	Lock lock(mutex);
-	while (!queue.empty())
+	for (size_t i = 0; i < queueCount; i++)
+		queue[(queueHead + i) % queue.size()].clear();
+
+	queueHead = 0;
+	queueCount = 0;
+}
+
+void Event::setCoalescing(bool enable)
+{
+	Lock lock(mutex);
+	coalescing = enable;
+}
+
+bool Event::isCoalescing() const
+{
+	return coalescing;
+}
+
+bool Event::coalesce(const Message &msg)
+{
+	// Don't look too far back, and never past an event which can't be merged
+	// (e.g. a button press) so ordering relative to those is kept.
+	const size_t maxsearch = 32;
+
+	for (size_t n = 0; n < std::min(queueCount, maxsearch); n++)
 	{
-		// std::queue::pop will remove the first (front) element.
-		queue.front()->release();
-		queue.pop();
+		Message &prev = queue[(queueHead + queueCount - 1 - n) % queue.size()];
+
+		if (prev.coalesce == Message::COALESCE_NONE)
+			return false;
+
+		if (prev.coalesce != msg.coalesce || prev.getArgCount() != msg.getArgCount())
+			continue;
+
+		switch (msg.coalesce)
+		{
+		case Message::COALESCE_MOUSE_MOTION:
+			// x, y, dx, dy, istouch
+			if (!isSameKey(prev.getArg(4), msg.getArg(4)))
+				continue;
+			prev.getArg(0) = msg.getArg(0);
+			prev.getArg(1) = msg.getArg(1);
+			accumulate(prev.getArg(2), msg.getArg(2));
+			accumulate(prev.getArg(3), msg.getArg(3));
+			return true;
+		case Message::COALESCE_TOUCH_MOTION:
+			// id, x, y, dx, dy, pressure, devicetype, mouse
+			if (!isSameKey(prev.getArg(0), msg.getArg(0)))
+				continue;
+			prev.getArg(1) = msg.getArg(1);
+			prev.getArg(2) = msg.getArg(2);
+			accumulate(prev.getArg(3), msg.getArg(3));
+			accumulate(prev.getArg(4), msg.getArg(4));
+			prev.getArg(5) = msg.getArg(5);
+			return true;
+		case Message::COALESCE_JOYSTICK_AXIS:
+		case Message::COALESCE_GAMEPAD_AXIS:
+			// joystick, axis, value
+			if (!isSameKey(prev.getArg(0), msg.getArg(0)) || !isSameKey(prev.getArg(1), msg.getArg(1)))
+				continue;
+			prev.getArg(2) = msg.getArg(2);
+			return true;
+		default:
+			return false;
+		}
 	}
+
+	return false;
 }
 
 void Event::setModalDrawData(const ModalDrawData &data)
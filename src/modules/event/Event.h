@@ -31,7 +31,8 @@
 #include "thread/threads.h"
 
 // C++
-#include <queue>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace love
@@ -39,15 +40,87 @@ namespace love
 namespace event
 {
 
-class Message : public Object
+/**
+ * A single event. Messages are plain values stored directly in the event
+ * queue's ring buffer, so queueing one doesn't allocate memory unless it has
+ * more than MAX_INLINE_ARGS arguments or a long string argument.
+ **/
+class Message
 {
 public:
 
-	Message(const std::string &name, const std::vector<Variant> &vargs = {});
+	static constexpr int MAX_INLINE_ARGS = 8;
+
+	// How a queued message may be merged with a newer message of the same
+	// kind, when coalescing is enabled.
+	enum Coalesce
+	{
+		COALESCE_NONE,
+		COALESCE_MOUSE_MOTION,
+		COALESCE_TOUCH_MOTION,
+		COALESCE_JOYSTICK_AXIS,
+		COALESCE_GAMEPAD_AXIS,
+	};
+
+	/**
+	 * The name must have static storage duration: either a string literal or
+	 * a string returned by internName. Use setName for any other string.
+	 **/
+	Message(const char *name = nullptr, Coalesce coalesce = COALESCE_NONE);
+	Message(const char *name, const std::vector<Variant> &vargs);
+	Message(const Message &m);
 	~Message();
 
-	const std::string name;
-	const std::vector<Variant> args;
+	Message &operator = (const Message &m);
+
+	template <typename... Args>
+	void addArg(Args&&... args)
+	{
+		if (argCount < MAX_INLINE_ARGS)
+			inlineArgs[argCount] = Variant(std::forward<Args>(args)...);
+		else
+			extraArgs.emplace_back(std::forward<Args>(args)...);
+		argCount++;
+	}
+
+	int getArgCount() const { return argCount; }
+	const Variant &getArg(int i) const { return i < MAX_INLINE_ARGS ? inlineArgs[i] : extraArgs[i - MAX_INLINE_ARGS]; }
+	Variant &getArg(int i) { return i < MAX_INLINE_ARGS ? inlineArgs[i] : extraArgs[i - MAX_INLINE_ARGS]; }
+
+	/**
+	 * Removes the name and all arguments.
+	 **/
+	void clear();
+
+	/**
+	 * Sets the name from an arbitrary string. Interned names are shared, and
+	 * any other name is copied into the message.
+	 **/
+	void setName(const std::string &name);
+
+	/**
+	 * Returns a pointer to an interned copy of the string, which stays valid
+	 * for the lifetime of the program. At most MAX_INTERNED_NAMES distinct
+	 * names are kept, after which nullptr is returned for new names.
+	 **/
+	static const char *internName(const std::string &name);
+
+	static constexpr size_t MAX_INTERNED_NAMES = 256;
+
+	const char *name;
+	Coalesce coalesce;
+
+private:
+
+	bool ownsName() const { return name != nullptr && name == ownedName.c_str(); }
+
+	Variant inlineArgs[MAX_INLINE_ARGS];
+	std::vector<Variant> extraArgs;
+
+	// Storage for a name which couldn't be interned.
+	std::string ownedName;
+
+	int argCount;
 
 }; // Message
 
@@ -66,12 +139,21 @@ class Event : public Module
 
 	virtual ~Event();
 
-	void push(Message *msg);
-	bool poll(Message *&msg);
+	void push(const Message &msg);
+	bool poll(Message &msg);
 	virtual void clear();
 
 	virtual void pump(float waitTimeout = 0.0f) = 0;
-	virtual Message *wait() = 0;
+	virtual bool wait(Message &msg) = 0;
+
+	/**
+	 * When enabled, mouse motion, touch motion and joystick axis events are
+	 * merged into a matching event that's already in the queue, as long as
+	 * only other mergeable events were pushed since then. Relative motion is
+	 * accumulated and absolute positions and axis values are replaced.
+	 **/
+	void setCoalescing(bool enable);
+	bool isCoalescing() const;
 
 	void setModalDrawData(const ModalDrawData &data);
 	const ModalDrawData &getModalDrawData() const { return modalDrawData; }
@@ -87,8 +169,17 @@ class Event : public Module
 	ModalDrawData modalDrawData;
 	ModalDrawData defaultModalDrawData;
 
+	bool coalesce(const Message &msg);
+
 	love::thread::MutexRef mutex;
-	std::queue<Message *> queue;
+
+	// Ring buffer of queued messages. It only grows, so pushing doesn't
+	// allocate once the queue has reached its usual size.
+	std::vector<Message> queue;
+	size_t queueHead;
+	size_t queueCount;
+
+	bool coalescing;
 
 }; // Event
 
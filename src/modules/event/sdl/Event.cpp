@@ -24,10 +24,12 @@
 #include "filesystem/Filesystem.h"
 #include "keyboard/sdl/Keyboard.h"
 #include "joystick/JoystickModule.h"
+#include "mouse/Mouse.h"
 #include "touch/sdl/Touch.h"
 #include "graphics/Graphics.h"
 #include "window/Window.h"
 #include "common/Exception.h"
+#include "common/profiler.h"
 #include "audio/Audio.h"
 #include "common/config.h"
 #include "timer/Timer.h"
@@ -59,6 +61,14 @@ static void clampToWindow(love::window::Window *window, double *x, double *y)
 		window->clampPositionInWindow(x, y);
 }
 
+// Converts an SDL event timestamp to love.timer.getTime's timebase.
+static double getEventTime(Uint64 timestamp)
+{
+	Uint64 now = SDL_GetTicksNS();
+	double age = now > timestamp ? (double)(now - timestamp) / 1.0e9 : 0.0;
+	return love::timer::Timer::getTime() - age;
+}
+
 static void normalizedToDPICoords(love::window::Window *window, double *x, double *y)
 {
 	double w = 1.0, h = 1.0;
@@ -127,6 +137,8 @@ void Event::pump(float waitTimeout)
 {
 	exceptionIfInRenderPass("love.event.pump");
 
+	LOVE_PROFILE_ZONE("Event::pump");
+
 	bool shouldPoll = false;
 
 	if (insideEventPump)
@@ -147,12 +159,12 @@ void Event::pump(float waitTimeout)
 		{
 			// Wait for the first event, if requested.
 			SDL_Event e;
+			Message msg;
 			insideEventPump = true;
 			if (SDL_WaitEventTimeout(&e, waitTimeoutMS))
 			{
 				insideEventPump = false;
-				StrongRef<Message> msg(convert(e), Acquire::NORETAIN);
-				if (msg)
+				if (convert(e, msg))
 					push(msg);
 
 				// Fetch any extra events that came in during WaitEvent.
@@ -173,25 +185,25 @@ void Event::pump(float waitTimeout)
 	if (shouldPoll)
 	{
 		SDL_Event e;
+		Message msg;
 		while (SDL_PollEvent(&e))
 		{
-			StrongRef<Message> msg(convert(e), Acquire::NORETAIN);
-			if (msg)
+			if (convert(e, msg))
 				push(msg);
 		}
 	}
 }
 
-Message *Event::wait()
+bool Event::wait(Message &msg)
 {
 	exceptionIfInRenderPass("love.event.wait");
 
 	SDL_Event e;
 
 	if (!SDL_WaitEvent(&e))
-		return nullptr;
+		return false;
 
-	return convert(e);
+	return convert(e, msg);
 }
 
 void Event::clear()
@@ -219,12 +231,10 @@ void Event::exceptionIfInRenderPass(const char *name)
 		throw love::Exception("%s cannot be called while a render target is active in love.graphics.", name);
 }
 
-Message *Event::convert(const SDL_Event &e)
+bool Event::convert(const SDL_Event &e, Message &msg)
 {
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
+	// Reuses the caller's message, so converting doesn't allocate.
+	msg.clear();
 
 	love::filesystem::Filesystem *filesystem = nullptr;
 	love::sensor::Sensor *sensorInstance = nullptr;
@@ -266,10 +276,10 @@ Message *Event::convert(const SDL_Event &e)
 		if (!love::keyboard::Keyboard::getConstant(scancode, txt2))
 			txt2 = "unknown";
 
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back(txt2, strlen(txt2));
-		vargs.emplace_back(e.key.repeat != 0);
-		msg = new Message("keypressed", vargs);
+		msg.addArg(txt, strlen(txt));
+		msg.addArg(txt2, strlen(txt2));
+		msg.addArg(e.key.repeat != 0);
+		msg.name = "keypressed";
 		break;
 	case SDL_EVENT_KEY_UP:
 		love::keyboard::sdl::Keyboard::getConstant(e.key.key, key);
@@ -280,21 +290,21 @@ Message *Event::convert(const SDL_Event &e)
 		if (!love::keyboard::Keyboard::getConstant(scancode, txt2))
 			txt2 = "unknown";
 
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back(txt2, strlen(txt2));
-		msg = new Message("keyreleased", vargs);
+		msg.addArg(txt, strlen(txt));
+		msg.addArg(txt2, strlen(txt2));
+		msg.name = "keyreleased";
 		break;
 	case SDL_EVENT_TEXT_INPUT:
 		txt = e.text.text;
-		vargs.emplace_back(txt, strlen(txt));
-		msg = new Message("textinput", vargs);
+		msg.addArg(txt, strlen(txt));
+		msg.name = "textinput";
 		break;
 	case SDL_EVENT_TEXT_EDITING:
 		txt = e.edit.text;
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back((double) e.edit.start);
-		vargs.emplace_back((double) e.edit.length);
-		msg = new Message("textedited", vargs);
+		msg.addArg(txt, strlen(txt));
+		msg.addArg((double) e.edit.start);
+		msg.addArg((double) e.edit.length);
+		msg.name = "textedited";
 		break;
 	case SDL_EVENT_MOUSE_MOTION:
 		{
@@ -312,12 +322,18 @@ Message *Event::convert(const SDL_Event &e)
 			windowToDPICoords(win, &x, &y);
 			windowToDPICoords(win, &xrel, &yrel);
 
-			vargs.emplace_back(x);
-			vargs.emplace_back(y);
-			vargs.emplace_back(xrel);
-			vargs.emplace_back(yrel);
-			vargs.emplace_back(e.motion.which == SDL_TOUCH_MOUSEID);
-			msg = new Message("mousemoved", vargs);
+			// Every motion event is sampled, even if it's coalesced later.
+			auto mouse = Module::getInstance<love::mouse::Mouse>(Module::M_MOUSE);
+			if (mouse)
+				mouse->addSample({getEventTime(e.motion.timestamp), (float) x, (float) y, (float) xrel, (float) yrel});
+
+			msg.addArg(x);
+			msg.addArg(y);
+			msg.addArg(xrel);
+			msg.addArg(yrel);
+			msg.addArg(e.motion.which == SDL_TOUCH_MOUSEID);
+			msg.name = "mousemoved";
+			msg.coalesce = Message::COALESCE_MOUSE_MOTION;
 		}
 		break;
 	case SDL_EVENT_MOUSE_BUTTON_DOWN:
@@ -341,24 +357,24 @@ Message *Event::convert(const SDL_Event &e)
 			clampToWindow(win, &px, &py);
 			windowToDPICoords(win, &px, &py);
 
-			vargs.emplace_back(px);
-			vargs.emplace_back(py);
-			vargs.emplace_back((double) button);
-			vargs.emplace_back(e.button.which == SDL_TOUCH_MOUSEID);
-			vargs.emplace_back((double) e.button.clicks);
+			msg.addArg(px);
+			msg.addArg(py);
+			msg.addArg((double) button);
+			msg.addArg(e.button.which == SDL_TOUCH_MOUSEID);
+			msg.addArg((double) e.button.clicks);
 
 			bool down = e.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
-			msg = new Message(down ? "mousepressed" : "mousereleased", vargs);
+			msg.name = down ? "mousepressed" : "mousereleased";
 		}
 		break;
 	case SDL_EVENT_MOUSE_WHEEL:
-		vargs.emplace_back((double) e.wheel.x);
-		vargs.emplace_back((double) e.wheel.y);
+		msg.addArg((double) e.wheel.x);
+		msg.addArg((double) e.wheel.y);
 
 		txt = e.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? "flipped" : "standard";
-		vargs.emplace_back(txt, strlen(txt));
+		msg.addArg(txt, strlen(txt));
 
-		msg = new Message("wheelmoved", vargs);
+		msg.name = "wheelmoved";
 		break;
 	case SDL_EVENT_FINGER_DOWN:
 	case SDL_EVENT_FINGER_UP:
@@ -392,22 +408,25 @@ Message *Event::convert(const SDL_Event &e)
 		// bits as can fit in a pointer (for now.)
 		// We use lightuserdata instead of a lua_Number (double) because doubles
 		// can't represent all possible id values on 64-bit systems.
-		vargs.emplace_back((void *)(intptr_t)touchinfo.id);
-		vargs.emplace_back(touchinfo.x);
-		vargs.emplace_back(touchinfo.y);
-		vargs.emplace_back(touchinfo.dx);
-		vargs.emplace_back(touchinfo.dy);
-		vargs.emplace_back(touchinfo.pressure);
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back(touchinfo.mouse);
+		msg.addArg((void *)(intptr_t)touchinfo.id);
+		msg.addArg(touchinfo.x);
+		msg.addArg(touchinfo.y);
+		msg.addArg(touchinfo.dx);
+		msg.addArg(touchinfo.dy);
+		msg.addArg(touchinfo.pressure);
+		msg.addArg(txt, strlen(txt));
+		msg.addArg(touchinfo.mouse);
 
 		if (e.type == SDL_EVENT_FINGER_DOWN)
 			txt = "touchpressed";
 		else if (e.type == SDL_EVENT_FINGER_UP || e.type == SDL_EVENT_FINGER_CANCELED)
 			txt = "touchreleased";
 		else
+		{
 			txt = "touchmoved";
-		msg = new Message(txt, vargs);
+			msg.coalesce = Message::COALESCE_TOUCH_MOTION;
+		}
+		msg.name = txt;
 		break;
 	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
 	case SDL_EVENT_JOYSTICK_BUTTON_UP:
@@ -419,7 +438,7 @@ Message *Event::convert(const SDL_Event &e)
 	case SDL_EVENT_GAMEPAD_BUTTON_UP:
 	case SDL_EVENT_GAMEPAD_AXIS_MOTION:
 	case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
-		msg = convertJoystickEvent(e);
+		convertJoystickEvent(e, msg);
 		break;
 	case SDL_EVENT_WINDOW_FOCUS_GAINED:
 	case SDL_EVENT_WINDOW_FOCUS_LOST:
@@ -433,7 +452,7 @@ Message *Event::convert(const SDL_Event &e)
 	case SDL_EVENT_WINDOW_RESTORED:
 	case SDL_EVENT_WINDOW_EXPOSED:
 	case SDL_EVENT_WINDOW_OCCLUDED:
-		msg = convertWindowEvent(e, win);
+		convertWindowEvent(e, win, msg);
 		break;
 	case SDL_EVENT_DISPLAY_ORIENTATION:
 		{
@@ -473,23 +492,23 @@ Message *Event::convert(const SDL_Event &e)
 				}
 			}
 			SDL_free(displays);
-			vargs.emplace_back((double)(displayindex + 1));
-			vargs.emplace_back(txt, strlen(txt));
+			msg.addArg((double)(displayindex + 1));
+			msg.addArg(txt, strlen(txt));
 
-			msg = new Message("displayrotated", vargs);
+			msg.name = "displayrotated";
 		}
 		break;
 	case SDL_EVENT_DROP_BEGIN:
-		msg = new Message("dropbegan", vargs);
+		msg.name = "dropbegan";
 		break;
 	case SDL_EVENT_DROP_COMPLETE:
 		{
 			double x = e.drop.x;
 			double y = e.drop.y;
 			windowToDPICoords(win, &x, &y);
-			vargs.emplace_back(x);
-			vargs.emplace_back(y);
-			msg = new Message("dropcompleted", vargs);
+			msg.addArg(x);
+			msg.addArg(y);
+			msg.name = "dropcompleted";
 		}
 		break;
 	case SDL_EVENT_DROP_POSITION:
@@ -497,9 +516,9 @@ Message *Event::convert(const SDL_Event &e)
 			double x = e.drop.x;
 			double y = e.drop.y;
 			windowToDPICoords(win, &x, &y);
-			vargs.emplace_back(x);
-			vargs.emplace_back(y);
-			msg = new Message("dropmoved", vargs);
+			msg.addArg(x);
+			msg.addArg(y);
+			msg.name = "dropmoved";
 		}
 		break;
 	case SDL_EVENT_DROP_FILE:
@@ -516,31 +535,31 @@ Message *Event::convert(const SDL_Event &e)
 
 			if (filesystem->isRealDirectory(filepath))
 			{
-				vargs.emplace_back(filepath, strlen(filepath));
-				vargs.emplace_back(x);
-				vargs.emplace_back(y);
-				msg = new Message("directorydropped", vargs);
+				msg.addArg(filepath, strlen(filepath));
+				msg.addArg(x);
+				msg.addArg(y);
+				msg.name = "directorydropped";
 			}
 			else
 			{
 				auto *file = filesystem->openNativeFile(filepath, love::filesystem::File::MODE_CLOSED);
-				vargs.emplace_back(&love::filesystem::File::type, file);
-				vargs.emplace_back(x);
-				vargs.emplace_back(y);
-				msg = new Message("filedropped", vargs);
+				msg.addArg(&love::filesystem::File::type, file);
+				msg.addArg(x);
+				msg.addArg(y);
+				msg.name = "filedropped";
 				file->release();
 			}
 		}
 		break;
 	case SDL_EVENT_QUIT:
 	case SDL_EVENT_TERMINATING:
-		msg = new Message("quit");
+		msg.name = "quit";
 		break;
 	case SDL_EVENT_LOW_MEMORY:
-		msg = new Message("lowmemory");
+		msg.name = "lowmemory";
 		break;
 	case SDL_EVENT_LOCALE_CHANGED:
-		msg = new Message("localechanged");
+		msg.name = "localechanged";
 		break;
 	case SDL_EVENT_SENSOR_UPDATE:
 		sensorInstance = Module::getInstance<sensor::Sensor>(M_SENSOR);
@@ -561,13 +580,13 @@ Message *Event::convert(const SDL_Event &e)
 					if (!sensor::Sensor::getConstant(sensor::sdl::Sensor::convert(sdltype), sensorType))
 						sensorType = "unknown";
 
-					vargs.emplace_back(sensorType, strlen(sensorType));
+					msg.addArg(sensorType, strlen(sensorType));
 					// Both accelerometer and gyroscope only pass up to 3 values.
 					// https://github.com/libsdl-org/SDL/blob/SDL2/include/SDL_sensor.h#L81-L127
-					vargs.emplace_back(e.sensor.data[0]);
-					vargs.emplace_back(e.sensor.data[1]);
-					vargs.emplace_back(e.sensor.data[2]);
-					msg = new Message("sensorupdated", vargs);
+					msg.addArg(e.sensor.data[0]);
+					msg.addArg(e.sensor.data[1]);
+					msg.addArg(e.sensor.data[2]);
+					msg.name = "sensorupdated";
 
 					break;
 				}
@@ -578,19 +597,14 @@ Message *Event::convert(const SDL_Event &e)
 		break;
 	}
 
-	return msg;
+	return msg.name != nullptr;
 }
 
-Message *Event::convertJoystickEvent(const SDL_Event &e) const
+void Event::convertJoystickEvent(const SDL_Event &e, Message &msg) const
 {
 	auto joymodule = Module::getInstance<joystick::JoystickModule>(Module::M_JOYSTICK);
 	if (!joymodule)
-		return nullptr;
-
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
+		return;
 
 	love::Type *joysticktype = &love::joystick::Joystick::type;
 	love::joystick::Joystick *stick = nullptr;
@@ -607,11 +621,9 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (!stick)
 			break;
 
-		vargs.emplace_back(joysticktype, stick);
-		vargs.emplace_back((double)(e.jbutton.button+1));
-		msg = new Message((e.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN) ?
-						  "joystickpressed" : "joystickreleased",
-						  vargs);
+		msg.addArg(joysticktype, stick);
+		msg.addArg((double)(e.jbutton.button+1));
+		msg.name = (e.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN) ? "joystickpressed" : "joystickreleased";
 		break;
 	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
 		{
@@ -619,11 +631,15 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 			if (!stick)
 				break;
 
-			vargs.emplace_back(joysticktype, stick);
-			vargs.emplace_back((double)(e.jaxis.axis+1));
+			msg.addArg(joysticktype, stick);
+			msg.addArg((double)(e.jaxis.axis+1));
 			float value = joystick::Joystick::clampval(e.jaxis.value / 32768.0f);
-			vargs.emplace_back((double) value);
-			msg = new Message("joystickaxis", vargs);
+			msg.addArg((double) value);
+
+			stick->addAxisSample({getEventTime(e.jaxis.timestamp), (float)(e.jaxis.axis+1), value});
+
+			msg.name = "joystickaxis";
+			msg.coalesce = Message::COALESCE_JOYSTICK_AXIS;
 		}
 		break;
 	case SDL_EVENT_JOYSTICK_HAT_MOTION:
@@ -634,10 +650,10 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (!stick)
 			break;
 
-		vargs.emplace_back(joysticktype, stick);
-		vargs.emplace_back((double)(e.jhat.hat+1));
-		vargs.emplace_back(txt, strlen(txt));
-		msg = new Message("joystickhat", vargs);
+		msg.addArg(joysticktype, stick);
+		msg.addArg((double)(e.jhat.hat+1));
+		msg.addArg(txt, strlen(txt));
+		msg.name = "joystickhat";
 		break;
 	case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
 	case SDL_EVENT_GAMEPAD_BUTTON_UP:
@@ -653,10 +669,9 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 			if (!stick)
 				break;
 
-			vargs.emplace_back(joysticktype, stick);
-			vargs.emplace_back(txt, strlen(txt));
-			msg = new Message(e.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ?
-							  "gamepadpressed" : "gamepadreleased", vargs);
+			msg.addArg(joysticktype, stick);
+			msg.addArg(txt, strlen(txt));
+			msg.name = e.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ? "gamepadpressed" : "gamepadreleased";
 		}
 		break;
 	case SDL_EVENT_GAMEPAD_AXIS_MOTION:
@@ -670,11 +685,12 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 			if (!stick)
 				break;
 
-			vargs.emplace_back(joysticktype, stick);
-			vargs.emplace_back(txt, strlen(txt));
+			msg.addArg(joysticktype, stick);
+			msg.addArg(txt, strlen(txt));
 			float value = joystick::Joystick::clampval(a.value / 32768.0f);
-			vargs.emplace_back((double) value);
-			msg = new Message("gamepadaxis", vargs);
+			msg.addArg((double) value);
+			msg.name = "gamepadaxis";
+			msg.coalesce = Message::COALESCE_GAMEPAD_AXIS;
 		}
 		break;
 	case SDL_EVENT_JOYSTICK_ADDED:
@@ -682,8 +698,8 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		stick = joymodule->addJoystick(e.jdevice.which);
 		if (stick)
 		{
-			vargs.emplace_back(joysticktype, stick);
-			msg = new Message("joystickadded", vargs);
+			msg.addArg(joysticktype, stick);
+			msg.name = "joystickadded";
 		}
 		break;
 	case SDL_EVENT_JOYSTICK_REMOVED:
@@ -692,8 +708,8 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (stick)
 		{
 			joymodule->removeJoystick(stick);
-			vargs.emplace_back(joysticktype, stick);
-			msg = new Message("joystickremoved", vargs);
+			msg.addArg(joysticktype, stick);
+			msg.name = "joystickremoved";
 		}
 		break;
 #if defined(LOVE_ENABLE_SENSOR)
@@ -710,12 +726,12 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 				if (!Sensor::getConstant(sensorType, sensorName))
 					sensorName = "unknown";
 
-				vargs.emplace_back(joysticktype, stick);
-				vargs.emplace_back(sensorName, strlen(sensorName));
-				vargs.emplace_back(sens.data[0]);
-				vargs.emplace_back(sens.data[1]);
-				vargs.emplace_back(sens.data[2]);
-				msg = new Message("joysticksensorupdated", vargs);
+				msg.addArg(joysticktype, stick);
+				msg.addArg(sensorName, strlen(sensorName));
+				msg.addArg(sens.data[0]);
+				msg.addArg(sens.data[1]);
+				msg.addArg(sens.data[2]);
+				msg.name = "joysticksensorupdated";
 			}
 		}
 		break;
@@ -723,17 +739,10 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 	default:
 		break;
 	}
-
-	return msg;
 }
 
-Message *Event::convertWindowEvent(const SDL_Event &e, love::window::Window *win)
+void Event::convertWindowEvent(const SDL_Event &e, love::window::Window *win, Message &msg)
 {
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
-
 	graphics::Graphics *gfx = nullptr;
 
 	auto event = e.type;
@@ -742,13 +751,13 @@ Message *Event::convertWindowEvent(const SDL_Event &e, love::window::Window *win
 	{
 	case SDL_EVENT_WINDOW_FOCUS_GAINED:
 	case SDL_EVENT_WINDOW_FOCUS_LOST:
-		vargs.emplace_back(event == SDL_EVENT_WINDOW_FOCUS_GAINED);
-		msg = new Message("focus", vargs);
+		msg.addArg(event == SDL_EVENT_WINDOW_FOCUS_GAINED);
+		msg.name = "focus";
 		break;
 	case SDL_EVENT_WINDOW_MOUSE_ENTER:
 	case SDL_EVENT_WINDOW_MOUSE_LEAVE:
-		vargs.emplace_back(event == SDL_EVENT_WINDOW_MOUSE_ENTER);
-		msg = new Message("mousefocus", vargs);
+		msg.addArg(event == SDL_EVENT_WINDOW_MOUSE_ENTER);
+		msg.name = "mousefocus";
 		break;
 	case SDL_EVENT_WINDOW_SHOWN:
 	case SDL_EVENT_WINDOW_HIDDEN:
@@ -765,14 +774,14 @@ Message *Event::convertWindowEvent(const SDL_Event &e, love::window::Window *win
 #endif
 		// WINDOW_RESTORED can also happen when going from maximized -> unmaximized,
 		// but there isn't a nice way to avoid sending our event in that situation.
-		vargs.emplace_back(event == SDL_EVENT_WINDOW_SHOWN || event == SDL_EVENT_WINDOW_RESTORED);
-		msg = new Message("visible", vargs);
+		msg.addArg(event == SDL_EVENT_WINDOW_SHOWN || event == SDL_EVENT_WINDOW_RESTORED);
+		msg.name = "visible";
 		break;
 	case SDL_EVENT_WINDOW_EXPOSED:
-		msg = new Message("exposed");
+		msg.name = "exposed";
 		break;
 	case SDL_EVENT_WINDOW_OCCLUDED:
-		msg = new Message("occluded");
+		msg.name = "occluded";
 		break;
 	case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
 		{
@@ -797,14 +806,12 @@ Message *Event::convertWindowEvent(const SDL_Event &e, love::window::Window *win
 				windowToDPICoords(win, &width, &height);
 			}
 
-			vargs.emplace_back(width);
-			vargs.emplace_back(height);
-			msg = new Message("resize", vargs);
+			msg.addArg(width);
+			msg.addArg(height);
+			msg.name = "resize";
 		}
 		break;
 	}
-
-	return msg;
 }
 
 } // sdl
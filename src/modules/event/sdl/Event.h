@@ -55,7 +55,7 @@ class Event : public love::event::Event
 	void pump(float waitTimeout = 0.0f) override;
 
 	// Deprecated.
-	Message *wait() override;
+	bool wait(Message &msg) override;
 
 	/**
 	 * Clears the event queue.
@@ -66,9 +66,9 @@ class Event : public love::event::Event
 
 	void exceptionIfInRenderPass(const char *name);
 
-	Message *convert(const SDL_Event &e);
-	Message *convertJoystickEvent(const SDL_Event &e) const;
-	Message *convertWindowEvent(const SDL_Event &e, love::window::Window *win);
+	bool convert(const SDL_Event &e, Message &msg);
+	void convertJoystickEvent(const SDL_Event &e, Message &msg) const;
+	void convertWindowEvent(const SDL_Event &e, love::window::Window *win, Message &msg);
 
 	bool insideEventPump = false;
 
@@ -41,24 +41,35 @@ namespace event
 
 static int luax_pushmessage(lua_State *L, const Message &m)
 {
-	luax_pushstring(L, m.name);
+	lua_pushstring(L, m.name);
 
-	for (const Variant &v : m.args)
-		luax_pushvariant(L, v);
+	for (int i = 0; i < m.getArgCount(); i++)
+		luax_pushvariant(L, m.getArg(i));
 
-	return (int) m.args.size() + 1;
+	return m.getArgCount() + 1;
+}
+
+// Pushed events can be merged like the engine's own, as long as they have the
+// same arguments.
+static Message::Coalesce getCoalesce(const std::string &name, int argcount)
+{
+	if (name == "mousemoved" && argcount == 5)
+		return Message::COALESCE_MOUSE_MOTION;
+	else if (name == "touchmoved" && argcount == 8)
+		return Message::COALESCE_TOUCH_MOTION;
+	else if (name == "joystickaxis" && argcount == 3)
+		return Message::COALESCE_JOYSTICK_AXIS;
+	else if (name == "gamepadaxis" && argcount == 3)
+		return Message::COALESCE_GAMEPAD_AXIS;
+	return Message::COALESCE_NONE;
 }
 
 static int w_poll_i(lua_State *L)
 {
-	Message *m = nullptr;
+	Message m;
 
-	if (instance()->poll(m) && m != nullptr)
-	{
-		int args = luax_pushmessage(L, *m);
-		m->release();
-		return args;
-	}
+	if (instance()->poll(m))
+		return luax_pushmessage(L, m);
 
 	// No pending events.
 	return 0;
@@ -75,14 +86,11 @@ int w_wait(lua_State *L)
 {
 	luax_markdeprecated(L, 1, "love.event.wait", API_FUNCTION, DEPRECATED_REPLACED, "waitTimeout parameter in love.event.pump");
 
-	Message *m = nullptr;
-	luax_catchexcept(L, [&]() { m = instance()->wait(); });
-	if (m != nullptr)
-	{
-		int args = luax_pushmessage(L, *m);
-		m->release();
-		return args;
-	}
+	Message m;
+	bool success = false;
+	luax_catchexcept(L, [&]() { success = instance()->wait(m); });
+	if (success)
+		return luax_pushmessage(L, m);
 
 	return 0;
 }
@@ -90,7 +98,8 @@ int w_wait(lua_State *L)
 int w_push(lua_State *L)
 {
 	std::string name = luax_checkstring(L, 1);
-	std::vector<Variant> vargs;
+	Message m;
+	m.setName(name);
 
 	int nargs = lua_gettop(L);
 	for (int i = 2; i <= nargs; i++)
@@ -98,16 +107,16 @@ int w_push(lua_State *L)
 		if (lua_isnoneornil(L, i))
 			break;
 
-		luax_catchexcept(L, [&]() { vargs.push_back(luax_checkvariant(L, i)); });
+		luax_catchexcept(L, [&]() { m.addArg(luax_checkvariant(L, i)); });
 
-		if (vargs.back().getType() == Variant::UNKNOWN)
+		if (m.getArg(m.getArgCount() - 1).getType() == Variant::UNKNOWN)
 		{
-			vargs.clear();
+			m.clear();
 			return luaL_error(L, "Argument %d can't be stored safely\nExpected boolean, number, string or userdata.", i);
 		}
 	}
 
-	StrongRef<Message> m(new Message(name, vargs), Acquire::NORETAIN);
+	m.coalesce = getCoalesce(name, m.getArgCount());
 
 	instance()->push(m);
 	luax_pushboolean(L, true);
@@ -120,14 +129,25 @@ int w_clear(lua_State *L)
 	return 0;
 }
 
+int w_setCoalescing(lua_State *L)
+{
+	instance()->setCoalescing(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isCoalescing(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isCoalescing());
+	return 1;
+}
+
 int w_quit(lua_State *L)
 {
 	luax_catchexcept(L, [&]() {
-		std::vector<Variant> args;
+		Message m("quit");
 		for (int i = 1; i <= std::max(1, lua_gettop(L)); i++)
-			args.push_back(luax_checkvariant(L, i));
+			m.addArg(luax_checkvariant(L, i));
 
-		StrongRef<Message> m(new Message("quit", args), Acquire::NORETAIN);
 		instance()->push(m);
 	});
 
@@ -138,13 +158,12 @@ int w_quit(lua_State *L)
 int w_restart(lua_State *L)
 {
 	luax_catchexcept(L, [&]() {
-		std::vector<Variant> args;
-		args.emplace_back("restart", strlen("restart"));
+		Message m("quit");
+		m.addArg("restart", strlen("restart"));
 
 		for (int i = 1; i <= lua_gettop(L); i++)
-			args.push_back(luax_checkvariant(L, i));
+			m.addArg(luax_checkvariant(L, i));
 
-		StrongRef<Message> m(new Message("quit", args), Acquire::NORETAIN);
 		instance()->push(m);
 	});
 
@@ -224,6 +243,8 @@ static const luaL_Reg functions[] =
 	{ "wait", w_wait },
 	{ "push", w_push },
 	{ "clear", w_clear },
+	{ "setCoalescing", w_setCoalescing },
+	{ "isCoalescing", w_isCoalescing },
 	{ "quit", w_quit },
 	{ "restart", w_restart },
 	{ "setModalDrawCallback", w_setModalDrawCallback },
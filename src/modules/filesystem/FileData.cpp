@@ -19,11 +19,23 @@
  **/
 
 #include "FileData.h"
+#include "common/config.h"
 
 // C++
 #include <iostream>
 #include <limits>
 
+#if defined(LOVE_WINDOWS)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#	include "common/utf8.h"
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
 namespace love
 {
 namespace filesystem
@@ -33,8 +45,9 @@ love::Type FileData::type("FileData", &Data::type);
 
 FileData::FileData(uint64 size, const std::string &filename)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size((size_t) size)
-	, filename(filename)
 {
 	try
 	{
@@ -45,19 +58,22 @@ FileData::FileData(uint64 size, const std::string &filename)
 		throw love::Exception("Out of memory.");
 	}
 
-	size_t dotpos = filename.rfind('.');
+	setFilename(filename);
+}
 
-	if (dotpos != std::string::npos)
-	{
-		extension = filename.substr(dotpos + 1);
-		name = filename.substr(0, dotpos);
-	}
-	else
-		name = filename;
+FileData::FileData(const std::string &filename)
+	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
+	, size(0)
+{
+	setFilename(filename);
 }
 
 FileData::FileData(const FileData &c)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size(c.size)
 	, filename(c.filename)
 	, extension(c.extension)
@@ -76,7 +92,121 @@ FileData::FileData(const FileData &c)
 
 FileData::~FileData()
 {
-	delete [] data;
+	if (mapping != nullptr)
+	{
+#if defined(LOVE_WINDOWS)
+		UnmapViewOfFile(mapping);
+#else
+		munmap(mapping, mappingSize);
+#endif
+	}
+	else
+		delete [] data;
+}
+
+FileData *FileData::createMapped(const std::string &path, int64 offset, int64 size, const std::string &filename)
+{
+	if (offset < 0)
+		return nullptr;
+
+#if defined(LOVE_WINDOWS)
+	std::wstring wpath = to_widestr(path);
+
+	HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER filesize;
+	if (!GetFileSizeEx(file, &filesize))
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	int64 filelength = (int64) filesize.QuadPart;
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat buf;
+	if (fstat(fd, &buf) != 0 || !S_ISREG(buf.st_mode))
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	int64 filelength = (int64) buf.st_size;
+#endif
+
+	if (size < 0)
+		size = filelength - offset;
+
+	// Empty mappings aren't allowed. Those are cheap to read normally anyway.
+	bool valid = size > 0 && offset + size <= filelength && (uint64) size <= (uint64) std::numeric_limits<size_t>::max();
+	void *mapping = nullptr;
+	int64 delta = 0;
+
+#if defined(LOVE_WINDOWS)
+	if (valid)
+	{
+		// Views have to start at a multiple of the allocation granularity.
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		delta = offset % (int64) info.dwAllocationGranularity;
+
+		HANDLE filemapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		if (filemapping != nullptr)
+		{
+			uint64 start = (uint64) (offset - delta);
+			mapping = MapViewOfFile(filemapping, FILE_MAP_COPY, (DWORD) (start >> 32), (DWORD) start, (SIZE_T) (size + delta));
+
+			// The view keeps the mapping object alive.
+			CloseHandle(filemapping);
+		}
+	}
+
+	CloseHandle(file);
+#else
+	if (valid)
+	{
+		// Mappings have to start at a multiple of the page size.
+		delta = offset % (int64) sysconf(_SC_PAGESIZE);
+
+		mapping = mmap(nullptr, (size_t) (size + delta), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t) (offset - delta));
+		if (mapping == MAP_FAILED)
+			mapping = nullptr;
+	}
+
+	// The mapping stays valid after the file is closed.
+	close(fd);
+#endif
+
+	if (mapping == nullptr)
+		return nullptr;
+
+	FileData *filedata = new FileData(filename);
+	filedata->mapping = mapping;
+	filedata->mappingSize = (size_t) (size + delta);
+	filedata->data = (char *) mapping + delta;
+	filedata->size = (uint64) size;
+
+	return filedata;
+}
+
+void FileData::setFilename(const std::string &filename)
+{
+	this->filename = filename;
+
+	size_t dotpos = filename.rfind('.');
+
+	if (dotpos != std::string::npos)
+	{
+		extension = filename.substr(dotpos + 1);
+		name = filename.substr(0, dotpos);
+	}
+	else
+		name = filename;
 }
 
 FileData *FileData::clone() const
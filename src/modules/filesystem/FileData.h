@@ -43,6 +43,18 @@ class FileData : public Data
 
 	virtual ~FileData();
 
+	/**
+	 * Creates FileData which references a read-only memory mapping of part of
+	 * a file on disk, instead of a copy of its contents. Writes to the data
+	 * are private and never reach the file.
+	 * @param path The full platform-dependent path to the file.
+	 * @param offset The offset in bytes of the data within the file.
+	 * @param size The size in bytes of the data, or -1 for the rest of the file.
+	 * @param filename The filename used for file type identification.
+	 * @return The new FileData, or null if the file couldn't be mapped.
+	 **/
+	static FileData *createMapped(const std::string &path, int64 offset, int64 size, const std::string &filename);
+
 	// Implements Data.
 	FileData *clone() const;
 	void *getData() const;
@@ -52,11 +64,21 @@ class FileData : public Data
 	const std::string &getExtension() const;
 	const std::string &getName() const;
 
+	bool isMemoryMapped() const { return mapping != nullptr; }
+
 private:
 
+	FileData(const std::string &filename);
+
+	void setFilename(const std::string &filename);
+
 	// The actual data.
 	char *data;
 
+	// Start of the page-aligned memory mapping containing the data, if any.
+	void *mapping;
+	size_t mappingSize;
+
 	// Size of the data.
 	uint64 size;
 
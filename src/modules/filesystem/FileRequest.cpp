@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "FileRequest.h"
+#include "Filesystem.h"
+#include "timer/Timer.h"
+
+// STD
+#include <algorithm>
+#include <cstring>
+
+namespace love
+{
+namespace filesystem
+{
+
+love::Type FileRequest::type("FileRequest", &Object::type);
+
+FileRequest::FileRequest(const std::string &filename, int priority)
+	: filename(filename)
+	, priority(priority)
+	, status(STATUS_PENDING)
+	, cancelRequested(false)
+	, submitTime(timer::Timer::getTime())
+	, startTime(0.0)
+	, endTime(0.0)
+{
+}
+
+FileRequest::~FileRequest()
+{
+}
+
+const std::string &FileRequest::getFilename() const
+{
+	return filename;
+}
+
+int FileRequest::getPriority() const
+{
+	return priority;
+}
+
+FileRequest::Status FileRequest::getStatus() const
+{
+	thread::Lock lock(mutex);
+	return status;
+}
+
+bool FileRequest::isComplete() const
+{
+	Status s = getStatus();
+	return s == STATUS_DONE || s == STATUS_ERROR || s == STATUS_CANCELLED;
+}
+
+bool FileRequest::cancel()
+{
+	thread::Lock lock(mutex);
+
+	if (status == STATUS_PENDING)
+	{
+		// The I/O thread skips requests which are no longer pending.
+		double now = timer::Timer::getTime();
+		startTime = now;
+		endTime = now;
+		status = STATUS_CANCELLED;
+		completed->broadcast();
+		return true;
+	}
+	else if (status == STATUS_READING)
+	{
+		cancelRequested = true;
+		return true;
+	}
+
+	return false;
+}
+
+bool FileRequest::wait(double timeout)
+{
+	double start = timer::Timer::getTime();
+
+	thread::Lock lock(mutex);
+
+	while (status == STATUS_PENDING || status == STATUS_READING)
+	{
+		if (timeout < 0.0)
+		{
+			completed->wait(mutex);
+			continue;
+		}
+
+		double remaining = timeout - (timer::Timer::getTime() - start);
+		if (remaining <= 0.0)
+			return false;
+
+		completed->wait(mutex, std::max((int) (remaining * 1000.0), 1));
+	}
+
+	return true;
+}
+
+FileData *FileRequest::getData() const
+{
+	thread::Lock lock(mutex);
+	return data.get();
+}
+
+std::string FileRequest::getError() const
+{
+	thread::Lock lock(mutex);
+	return error;
+}
+
+void FileRequest::getLatency(double &queued, double &reading) const
+{
+	thread::Lock lock(mutex);
+
+	double now = timer::Timer::getTime();
+
+	if (status == STATUS_PENDING)
+	{
+		queued = now - submitTime;
+		reading = 0.0;
+	}
+	else
+	{
+		queued = startTime - submitTime;
+		reading = (status == STATUS_READING ? now : endTime) - startTime;
+	}
+}
+
+void FileRequest::run(const Filesystem *filesystem)
+{
+	{
+		thread::Lock lock(mutex);
+		if (status != STATUS_PENDING)
+			return;
+
+		status = STATUS_READING;
+		startTime = timer::Timer::getTime();
+	}
+
+	try
+	{
+		StrongRef<File> file(filesystem->openFile(filename.c_str(), File::MODE_READ), Acquire::NORETAIN);
+
+		int64 size = file->getSize();
+		if (size < 0)
+			throw love::Exception("Could not determine the size of file %s.", filename.c_str());
+
+		StrongRef<FileData> filedata(new FileData(size, filename), Acquire::NORETAIN);
+		char *dst = (char *) filedata->getData();
+
+		int64 offset = 0;
+		while (offset < size)
+		{
+			if (cancelRequested)
+			{
+				complete(STATUS_CANCELLED, nullptr, "");
+				return;
+			}
+
+			int64 read = file->read(dst + offset, std::min(CHUNK_SIZE, size - offset));
+			if (read < 0)
+				throw love::Exception("Could not read from file %s.", filename.c_str());
+			else if (read == 0)
+				break;
+
+			offset += read;
+		}
+
+		// The file may have been truncated since its size was queried.
+		if (offset < size)
+		{
+			StrongRef<FileData> truncated(new FileData(offset, filename), Acquire::NORETAIN);
+			memcpy(truncated->getData(), dst, (size_t) offset);
+			filedata.set(truncated.get());
+		}
+
+		complete(STATUS_DONE, filedata, "");
+	}
+	catch (love::Exception &e)
+	{
+		complete(STATUS_ERROR, nullptr, e.what());
+	}
+}
+
+void FileRequest::complete(Status status, FileData *data, const std::string &error)
+{
+	thread::Lock lock(mutex);
+
+	this->status = status;
+	this->data.set(data);
+	this->error = error;
+	endTime = timer::Timer::getTime();
+
+	completed->broadcast();
+}
+
+STRINGMAP_CLASS_BEGIN(FileRequest, FileRequest::Status, FileRequest::STATUS_MAX_ENUM, status)
+{
+	{ "pending",   FileRequest::STATUS_PENDING   },
+	{ "reading",   FileRequest::STATUS_READING   },
+	{ "done",      FileRequest::STATUS_DONE      },
+	{ "error",     FileRequest::STATUS_ERROR     },
+	{ "cancelled", FileRequest::STATUS_CANCELLED },
+}
+STRINGMAP_CLASS_END(FileRequest, FileRequest::Status, FileRequest::STATUS_MAX_ENUM, status)
+
+} // filesystem
+} // love
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_FILESYSTEM_FILE_REQUEST_H
+#define LOVE_FILESYSTEM_FILE_REQUEST_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/StringMap.h"
+#include "common/int.h"
+#include "thread/threads.h"
+#include "FileData.h"
+
+// STD
+#include <atomic>
+#include <string>
+
+namespace love
+{
+namespace filesystem
+{
+
+class Filesystem;
+
+/**
+ * A read of a whole file which happens on one of the filesystem module's I/O
+ * threads. The request can be polled or waited on from any thread.
+ **/
+class FileRequest : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Status
+	{
+		STATUS_PENDING,
+		STATUS_READING,
+		STATUS_DONE,
+		STATUS_ERROR,
+		STATUS_CANCELLED,
+		STATUS_MAX_ENUM
+	};
+
+	FileRequest(const std::string &filename, int priority);
+	virtual ~FileRequest();
+
+	const std::string &getFilename() const;
+	int getPriority() const;
+
+	Status getStatus() const;
+	bool isComplete() const;
+
+	/**
+	 * Stops the request if it hasn't completed yet. Reads which have already
+	 * started stop at the next chunk boundary.
+	 * @return False if the request had already completed.
+	 **/
+	bool cancel();
+
+	/**
+	 * Blocks until the request completes.
+	 * @param timeout The maximum time to wait in seconds, or a negative value
+	 *                to wait indefinitely.
+	 * @return Whether the request has completed.
+	 **/
+	bool wait(double timeout = -1.0);
+
+	/**
+	 * Gets the file's contents, or null if the request hasn't completed
+	 * successfully.
+	 **/
+	FileData *getData() const;
+
+	std::string getError() const;
+
+	/**
+	 * Gets the time in seconds the request spent waiting for an I/O thread,
+	 * and the time spent reading once it started. Both keep increasing until
+	 * the respective stage has finished.
+	 **/
+	void getLatency(double &queued, double &reading) const;
+
+	/**
+	 * Performs the read. Called from an I/O thread.
+	 **/
+	void run(const Filesystem *filesystem);
+
+	STRINGMAP_CLASS_DECLARE(Status);
+
+private:
+
+	void complete(Status status, FileData *data, const std::string &error);
+
+	// Files are read in chunks of this size so cancellation is responsive.
+	static const int64 CHUNK_SIZE = 1024 * 1024;
+
+	std::string filename;
+	int priority;
+
+	mutable thread::MutexRef mutex;
+	thread::ConditionalRef completed;
+
+	Status status;
+	std::atomic<bool> cancelRequested;
+
+	StrongRef<FileData> data;
+	std::string error;
+
+	double submitTime;
+	double startTime;
+	double endTime;
+
+}; // FileRequest
+
+} // filesystem
+} // love
+
+#endif // LOVE_FILESYSTEM_FILE_REQUEST_H
@@ -23,6 +23,9 @@
 #include "NativeFile.h"
 #include "common/utf8.h"
 
+// C++
+#include <cstring>
+
 // Assume POSIX or Visual Studio.
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -49,8 +52,12 @@ namespace filesystem
 
 love::Type Filesystem::type("filesystem", &Module::type);
 
+const char *Filesystem::BYTECODE_CACHE_DIRECTORY = ".bytecodecache";
+
 Filesystem::Filesystem(const char *name)
 	: Module(M_FILESYSTEM, name)
+	, memoryMapThreshold(64 * 1024 * 1024)
+	, bytecodeCacheEnabled(false)
 {
 }
 
@@ -80,6 +87,84 @@ FileData *Filesystem::newFileData(const void *data, size_t size, const char *fil
 	return fd;
 }
 
+FileData *Filesystem::readMappedIfLarge(const char *filename) const
+{
+	if (memoryMapThreshold <= 0)
+		return nullptr;
+
+	Info info = {};
+	if (!getInfo(filename, info) || info.type != FILETYPE_FILE || info.size < memoryMapThreshold)
+		return nullptr;
+
+	return readMapped(filename);
+}
+
+void Filesystem::setMemoryMapThreshold(int64 bytes)
+{
+	memoryMapThreshold = bytes;
+}
+
+int64 Filesystem::getMemoryMapThreshold() const
+{
+	return memoryMapThreshold;
+}
+
+bool Filesystem::getCachedRequirePath(const std::string &modulename, std::string &filename) const
+{
+	thread::Lock lock(requirePathCacheMutex);
+
+	auto it = requirePathCache.find(modulename);
+	if (it == requirePathCache.end())
+		return false;
+
+	filename = it->second;
+	return true;
+}
+
+void Filesystem::setCachedRequirePath(const std::string &modulename, const std::string &filename)
+{
+	thread::Lock lock(requirePathCacheMutex);
+	requirePathCache[modulename] = filename;
+}
+
+void Filesystem::removeCachedRequirePath(const std::string &modulename)
+{
+	thread::Lock lock(requirePathCacheMutex);
+	requirePathCache.erase(modulename);
+}
+
+void Filesystem::clearRequirePathCache()
+{
+	thread::Lock lock(requirePathCacheMutex);
+	requirePathCache.clear();
+}
+
+void Filesystem::notifySaveFileChanged(const char *filename)
+{
+	// Writing bytecode to the cache can't change how modules resolve.
+	if (filename != nullptr)
+	{
+		while (*filename == '/')
+			filename++;
+
+		size_t len = strlen(BYTECODE_CACHE_DIRECTORY);
+		if (strncmp(filename, BYTECODE_CACHE_DIRECTORY, len) == 0 && filename[len] == '/')
+			return;
+	}
+
+	clearRequirePathCache();
+}
+
+void Filesystem::setBytecodeCacheEnabled(bool enable)
+{
+	bytecodeCacheEnabled = enable;
+}
+
+bool Filesystem::isBytecodeCacheEnabled() const
+{
+	return bytecodeCacheEnabled;
+}
+
 bool Filesystem::isRealDirectory(const std::string &path) const
 {
 	FileType ftype = FILETYPE_MAX_ENUM;
@@ -26,11 +26,14 @@
 #include "common/Module.h"
 #include "common/int.h"
 #include "common/StringMap.h"
+#include "thread/threads.h"
 #include "FileData.h"
 #include "File.h"
+#include "FileRequest.h"
 
 // C++
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // In Windows, we would like to use "LOVE" as the
@@ -253,6 +256,64 @@ class Filesystem : public Module
 	virtual FileData *read(const char *filename, int64 size) const = 0;
 	virtual FileData *read(const char *filename) const = 0;
 
+	/**
+	 * Memory-maps a file instead of copying its contents. Only files in real
+	 * directories, and entries stored without compression in zip archives, can
+	 * be mapped.
+	 * @param filename The name of the file to map.
+	 * @return The mapped data, or null if the file can't be mapped.
+	 **/
+	virtual FileData *readMapped(const char *filename) const = 0;
+
+	/**
+	 * Memory-maps a file if it's at least as large as the memory map
+	 * threshold, and if it can be mapped.
+	 * @return The mapped data, or null if the file should be read normally.
+	 **/
+	FileData *readMappedIfLarge(const char *filename) const;
+
+	/**
+	 * Starts reading a whole file on one of the filesystem's I/O threads.
+	 * @param filename The name of the file to read.
+	 * @param priority Requests with higher priorities are started first.
+	 **/
+	virtual FileRequest *readAsync(const char *filename, int priority) const = 0;
+
+	/**
+	 * Sets the minimum size in bytes of files which are memory-mapped by
+	 * read(filename) instead of copied. 0 disables automatic mapping.
+	 **/
+	void setMemoryMapThreshold(int64 bytes);
+	int64 getMemoryMapThreshold() const;
+
+	/**
+	 * Remembers which file a module name resolved to in the require loader,
+	 * so later requires of the same module don't search the require path.
+	 * Entries are cleared whenever the search path or the require path
+	 * changes, or a file is written to or removed from the save directory.
+	 **/
+	bool getCachedRequirePath(const std::string &modulename, std::string &filename) const;
+	void setCachedRequirePath(const std::string &modulename, const std::string &filename);
+	void removeCachedRequirePath(const std::string &modulename);
+	void clearRequirePathCache();
+
+	/**
+	 * Called when a file in the save directory is created, written to, or
+	 * removed, since that can change which file a module resolves to.
+	 **/
+	void notifySaveFileChanged(const char *filename);
+
+	/**
+	 * Enables or disables caching of compiled Lua modules in the save
+	 * directory. Cached bytecode is keyed on a hash of the module's source
+	 * and the Lua version, so changed sources are recompiled automatically.
+	 **/
+	void setBytecodeCacheEnabled(bool enable);
+	bool isBytecodeCacheEnabled() const;
+
+	// The directory in the save directory containing cached bytecode.
+	static const char *BYTECODE_CACHE_DIRECTORY;
+
 	/**
 	 * Write data to a file.
 	 * @param filename The name of the file to write to.
@@ -332,6 +393,13 @@ class Filesystem : public Module
 	// Should we save external or internal for Android
 	bool useExternal = false;
 
+	int64 memoryMapThreshold;
+
+	std::unordered_map<std::string, std::string> requirePathCache;
+	mutable thread::MutexRef requirePathCacheMutex;
+
+	bool bytecodeCacheEnabled;
+
 }; // Filesystem
 
 } // filesystem
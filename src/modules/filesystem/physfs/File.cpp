@@ -45,6 +45,13 @@ static bool setupWriteDirectory()
 	return fs != nullptr && fs->setupWriteDirectory();
 }
 
+static void notifySaveFileChanged(const std::string &filename)
+{
+	auto fs = Module::getInstance<love::filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs != nullptr)
+		fs->notifySaveFileChanged(filename.c_str());
+}
+
 File::File(const std::string &filename, Mode mode)
 	: filename(filename)
 	, file(nullptr)
@@ -145,6 +152,9 @@ bool File::open(Mode mode)
 
 	this->mode = mode;
 
+	if (mode == MODE_APPEND || mode == MODE_WRITE)
+		notifySaveFileChanged(filename);
+
 	if (file != nullptr && !setBuffer(bufferMode, bufferSize))
 	{
 		// Revert to buffer defaults if we don't successfully set the buffer.
@@ -142,6 +142,9 @@ Filesystem::Filesystem()
 
 Filesystem::~Filesystem()
 {
+	// In-progress reads have to finish before PhysFS is shut down.
+	ioThreadPool.reset();
+
 #ifdef LOVE_ANDROID
 	love::android::deinitializeVirtualArchive();
 #endif
@@ -267,6 +270,8 @@ bool Filesystem::setSource(const char *source)
 
 	std::string new_search_path = canonicalizeRealPath(source);
 
+	clearRequirePathCache();
+
 #ifdef LOVE_ANDROID
 	if (!love::android::createStorageDirectories())
 		SDL_Log("Error creating storage directories!");
@@ -427,6 +432,8 @@ bool Filesystem::mountFullPath(const char *archive, const char *mountpoint, Moun
 	if (isMounted(canonarchive))
 		return false;
 
+	clearRequirePathCache();
+
 #ifdef LOVE_ANDROID
 	if (strncmp(archive, "content://", 10) == 0)
 	{
@@ -487,6 +494,8 @@ bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoi
 	if (isMounted(archivename))
 		return false;
 
+	clearRequirePathCache();
+
 	if (PHYSFS_mountMemory(data->getData(), data->getSize(), nullptr, archivename, mountpoint, appendToPath) != 0)
 	{
 		mountedData[archivename] = data;
@@ -501,6 +510,8 @@ bool Filesystem::unmount(const char *archive)
 	if (!PHYSFS_isInit() || !archive)
 		return false;
 
+	clearRequirePathCache();
+
 	auto datait = mountedData.find(archive);
 
 	if (datait != mountedData.end() && PHYSFS_unmount(archive) != 0)
@@ -509,6 +520,8 @@ bool Filesystem::unmount(const char *archive)
 		return true;
 	}
 
+	clearZipIndices();
+
 	auto it = std::find(allowedMountPaths.begin(), allowedMountPaths.end(), archive);
 	if (it != allowedMountPaths.end())
 		return unmountFullPath(archive);
@@ -543,6 +556,9 @@ bool Filesystem::unmountFullPath(const char *fullpath)
 
 	std::string canonpath = canonicalizeRealPath(fullpath);
 
+	clearZipIndices();
+	clearRequirePathCache();
+
 	return PHYSFS_unmount(canonpath.c_str()) != 0;
 }
 
@@ -886,6 +902,8 @@ bool Filesystem::remove(const char *file)
 	if (!PHYSFS_delete(file))
 		return false;
 
+	notifySaveFileChanged(file);
+
 	return true;
 }
 
@@ -899,12 +917,119 @@ FileData *Filesystem::read(const char *filename, int64 size) const
 
 FileData* Filesystem::read(const char* filename) const
 {
+	FileData *mapped = readMappedIfLarge(filename);
+	if (mapped != nullptr)
+		return mapped;
+
 	File file(filename, File::MODE_READ);
 
 	// close() is called in the File destructor.
 	return file.read();
 }
 
+FileData *Filesystem::readMapped(const char *filename) const
+{
+	if (!PHYSFS_isInit())
+		return nullptr;
+
+	PHYSFS_Stat stat = {};
+	if (!PHYSFS_stat(filename, &stat) || stat.filetype != PHYSFS_FILETYPE_REGULAR)
+		return nullptr;
+
+	const char *realdir = PHYSFS_getRealDir(filename);
+	if (realdir == nullptr || mountedData.count(realdir) > 0)
+		return nullptr;
+
+	// Files in the save directory (including archives mounted from it) can be
+	// truncated by the game while they're mapped, which would crash instead
+	// of erroring.
+	const char *writedir = PHYSFS_getWriteDir();
+	if (writedir != nullptr && strncmp(realdir, writedir, strlen(writedir)) == 0)
+		return nullptr;
+
+	// Get the path of the file relative to the root of its archive.
+	std::string path = filename;
+	path.erase(0, path.find_first_not_of('/'));
+
+	const char *mountpoint = PHYSFS_getMountPoint(realdir);
+	if (mountpoint != nullptr)
+	{
+		std::string mountdir = mountpoint;
+		mountdir.erase(0, mountdir.find_first_not_of('/'));
+		if (path.compare(0, mountdir.size(), mountdir) == 0)
+			path.erase(0, mountdir.size());
+	}
+
+	try
+	{
+		if (isRealDirectory(realdir))
+		{
+			std::string fullpath = std::string(realdir) + LOVE_PATH_SEPARATOR + path;
+			return FileData::createMapped(fullpath, 0, -1, filename);
+		}
+
+		int64 offset = 0;
+		int64 size = 0;
+
+		love::thread::Lock lock(zipIndexMutex);
+
+		const ZipIndex *index = getZipIndex(realdir);
+		if (index == nullptr || !index->findStoredEntry(path, offset, size))
+			return nullptr;
+
+		return FileData::createMapped(realdir, offset, size, filename);
+	}
+	catch (love::Exception &)
+	{
+		return nullptr;
+	}
+}
+
+FileRequest *Filesystem::readAsync(const char *filename, int priority) const
+{
+	if (!PHYSFS_isInit())
+		throw love::Exception("PhysFS is not initialized.");
+
+	{
+		love::thread::Lock lock(ioThreadPoolMutex);
+		if (!ioThreadPool)
+			ioThreadPool.reset(new love::thread::ThreadPool(ASYNC_IO_THREADS, "love-filesystem-io"));
+	}
+
+	StrongRef<FileRequest> request(new FileRequest(filename, priority), Acquire::NORETAIN);
+
+	ioThreadPool->submit([this, request]() { request->run(this); }, priority);
+
+	request->retain();
+	return request;
+}
+
+const ZipIndex *Filesystem::getZipIndex(const std::string &archive) const
+{
+	auto it = zipIndices.find(archive);
+	if (it != zipIndices.end())
+		return it->second.get();
+
+	ZipIndex *index = nullptr;
+	try
+	{
+		index = new ZipIndex(archive);
+	}
+	catch (love::Exception &)
+	{
+		// Not a zip archive, or a format PhysFS supports but we don't parse.
+	}
+
+	zipIndices[archive].reset(index);
+	return index;
+}
+
+void Filesystem::clearZipIndices()
+{
+	love::thread::Lock lock(zipIndexMutex);
+	zipIndices.clear();
+}
+
 void Filesystem::write(const char *filename, const void *data, int64 size) const
 {
 	File file(filename, File::MODE_WRITE);
@@ -946,6 +1071,7 @@ void Filesystem::setSymlinksEnabled(bool enable)
 		return;
 
 	PHYSFS_permitSymbolicLinks(enable ? 1 : 0);
+	clearRequirePathCache();
 }
 
 bool Filesystem::areSymlinksEnabled() const
@@ -25,9 +25,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <memory>
 
 // LOVE
 #include "filesystem/Filesystem.h"
+#include "thread/threads.h"
+#include "thread/ThreadPool.h"
+#include "ZipIndex.h"
 
 namespace love
 {
@@ -88,6 +92,8 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	FileData *read(const char *filename, int64 size) const override;
 	FileData *read(const char *filename) const override;
+	FileData *readMapped(const char *filename) const override;
+	FileRequest *readAsync(const char *filename, int priority) const override;
 	void write(const char *filename, const void *data, int64 size) const override;
 	void append(const char *filename, const void *data, int64 size) const override;
 
@@ -103,6 +109,10 @@ class Filesystem final : public love::filesystem::Filesystem
 
 private:
 
+	// Reads are mostly waiting on storage, so this doesn't depend on the
+	// number of CPU cores.
+	static const int ASYNC_IO_THREADS = 4;
+
 	struct CommonPathMountInfo
 	{
 		bool mounted;
@@ -112,6 +122,9 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	bool mountCommonPathInternal(CommonPath path, const char *mountpoint, MountPermissions permissions, bool appendToPath, bool createDir);
 
+	const ZipIndex *getZipIndex(const std::string &archive) const;
+	void clearZipIndices();
+
 	// Contains the current working directory (UTF8).
 	std::string cwd;
 
@@ -134,6 +147,15 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	std::map<std::string, StrongRef<Data>> mountedData;
 
+	// Stored entries of mounted zip archives, for memory-mapping. Archives
+	// which can't be indexed have a null entry.
+	mutable std::map<std::string, std::unique_ptr<ZipIndex>> zipIndices;
+	mutable love::thread::MutexRef zipIndexMutex;
+
+	// Services readAsync. Created on first use.
+	mutable std::unique_ptr<love::thread::ThreadPool> ioThreadPool;
+	mutable love::thread::MutexRef ioThreadPoolMutex;
+
 	std::string fullPaths[COMMONPATH_MAX_ENUM];
 
 	CommonPathMountInfo commonPathMountInfo[COMMONPATH_MAX_ENUM];
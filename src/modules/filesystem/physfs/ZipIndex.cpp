@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ZipIndex.h"
+#include "filesystem/NativeFile.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <vector>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+static const uint32 END_OF_CENTRAL_DIR_SIG = 0x06054b50;
+static const uint32 ZIP64_END_OF_CENTRAL_DIR_SIG = 0x06064b50;
+static const uint32 ZIP64_END_OF_CENTRAL_DIR_LOCATOR_SIG = 0x07064b50;
+static const uint32 CENTRAL_DIR_HEADER_SIG = 0x02014b50;
+static const uint32 LOCAL_HEADER_SIG = 0x04034b50;
+
+static const size_t END_OF_CENTRAL_DIR_SIZE = 22;
+static const size_t ZIP64_END_OF_CENTRAL_DIR_SIZE = 56;
+static const size_t ZIP64_LOCATOR_SIZE = 20;
+static const size_t CENTRAL_DIR_HEADER_SIZE = 46;
+static const size_t LOCAL_HEADER_SIZE = 30;
+
+static uint16 readLE16(const uint8 *p)
+{
+	return (uint16) (p[0] | (p[1] << 8));
+}
+
+static uint32 readLE32(const uint8 *p)
+{
+	return (uint32) p[0] | ((uint32) p[1] << 8) | ((uint32) p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+static uint64 readLE64(const uint8 *p)
+{
+	return (uint64) readLE32(p) | ((uint64) readLE32(p + 4) << 32);
+}
+
+static void readAt(NativeFile *file, int64 offset, void *dst, int64 size)
+{
+	if (!file->seek(offset, File::SEEKORIGIN_BEGIN) || file->read(dst, size) != size)
+		throw love::Exception("Could not read zip archive.");
+}
+
+ZipIndex::ZipIndex(const std::string &path)
+	: path(path)
+{
+	StrongRef<NativeFile> file(new NativeFile(path, File::MODE_READ), Acquire::NORETAIN);
+	int64 filesize = file->getSize();
+
+	// The end of central directory record is followed by a comment of up to
+	// 64 KB, so search backwards for its signature.
+	int64 tailsize = std::min(filesize, (int64) (END_OF_CENTRAL_DIR_SIZE + 0xFFFF));
+	if (tailsize < (int64) END_OF_CENTRAL_DIR_SIZE)
+		throw love::Exception("Not a zip archive.");
+
+	std::vector<uint8> tail((size_t) tailsize);
+	readAt(file, filesize - tailsize, tail.data(), tailsize);
+
+	int64 eocdpos = -1;
+	for (int64 i = tailsize - END_OF_CENTRAL_DIR_SIZE; i >= 0; i--)
+	{
+		if (readLE32(&tail[(size_t) i]) == END_OF_CENTRAL_DIR_SIG)
+		{
+			eocdpos = i;
+			break;
+		}
+	}
+
+	if (eocdpos < 0)
+		throw love::Exception("Not a zip archive.");
+
+	const uint8 *eocd = &tail[(size_t) eocdpos];
+	eocdpos += filesize - tailsize;
+
+	uint64 entrycount = readLE16(eocd + 10);
+	uint64 cdsize = readLE32(eocd + 12);
+	uint64 cdoffset = readLE32(eocd + 16);
+
+	// The central directory's offset is relative to the start of the archive,
+	// which isn't the start of the file when it's appended to something else.
+	int64 cdend = eocdpos;
+
+	bool zip64 = entrycount == 0xFFFF || cdsize == 0xFFFFFFFF || cdoffset == 0xFFFFFFFF;
+	if (zip64)
+	{
+		if (eocdpos < (int64) ZIP64_LOCATOR_SIZE)
+			throw love::Exception("Invalid zip64 archive.");
+
+		uint8 locator[ZIP64_LOCATOR_SIZE];
+		readAt(file, eocdpos - ZIP64_LOCATOR_SIZE, locator, ZIP64_LOCATOR_SIZE);
+		if (readLE32(locator) != ZIP64_END_OF_CENTRAL_DIR_LOCATOR_SIG)
+			throw love::Exception("Invalid zip64 archive.");
+
+		// The zip64 record immediately precedes the locator, which lets us
+		// find it even when the archive is appended to another file.
+		cdend = eocdpos - ZIP64_LOCATOR_SIZE - ZIP64_END_OF_CENTRAL_DIR_SIZE;
+		if (cdend < 0)
+			throw love::Exception("Invalid zip64 archive.");
+
+		uint8 eocd64[ZIP64_END_OF_CENTRAL_DIR_SIZE];
+		readAt(file, cdend, eocd64, ZIP64_END_OF_CENTRAL_DIR_SIZE);
+		if (readLE32(eocd64) != ZIP64_END_OF_CENTRAL_DIR_SIG)
+			throw love::Exception("Invalid zip64 archive.");
+
+		entrycount = readLE64(eocd64 + 32);
+		cdsize = readLE64(eocd64 + 40);
+		cdoffset = readLE64(eocd64 + 48);
+	}
+
+	if (cdsize > (uint64) cdend || cdoffset > (uint64) cdend - cdsize)
+		throw love::Exception("Invalid zip archive.");
+
+	int64 base = cdend - (int64) cdsize - (int64) cdoffset;
+
+	std::vector<uint8> cd((size_t) cdsize);
+	if (cdsize > 0)
+		readAt(file, base + (int64) cdoffset, cd.data(), (int64) cdsize);
+
+	size_t pos = 0;
+	for (uint64 i = 0; i < entrycount; i++)
+	{
+		if (pos + CENTRAL_DIR_HEADER_SIZE > cd.size() || readLE32(&cd[pos]) != CENTRAL_DIR_HEADER_SIG)
+			throw love::Exception("Invalid zip archive central directory.");
+
+		const uint8 *header = &cd[pos];
+		uint16 flags = readLE16(header + 8);
+		uint16 method = readLE16(header + 10);
+		uint64 compressedsize = readLE32(header + 20);
+		uint64 rawsize = readLE32(header + 24);
+		size_t namelen = readLE16(header + 28);
+		size_t extralen = readLE16(header + 30);
+		size_t commentlen = readLE16(header + 32);
+		uint64 localoffset = readLE32(header + 42);
+
+		size_t entrysize = CENTRAL_DIR_HEADER_SIZE + namelen + extralen + commentlen;
+		if (pos + entrysize > cd.size())
+			throw love::Exception("Invalid zip archive central directory.");
+
+		// Values which don't fit in 32 bits are in the zip64 extra field, in
+		// this order, but only when the 32 bit field is saturated.
+		const uint8 *extra = header + CENTRAL_DIR_HEADER_SIZE + namelen;
+		for (size_t e = 0; e + 4 <= extralen;)
+		{
+			uint16 id = readLE16(extra + e);
+			size_t len = readLE16(extra + e + 2);
+			if (e + 4 + len > extralen)
+				break;
+
+			if (id == 0x0001)
+			{
+				const uint8 *field = extra + e + 4;
+				const uint8 *fieldend = field + len;
+
+				if (rawsize == 0xFFFFFFFF && field + 8 <= fieldend)
+				{
+					rawsize = readLE64(field);
+					field += 8;
+				}
+				if (compressedsize == 0xFFFFFFFF && field + 8 <= fieldend)
+				{
+					compressedsize = readLE64(field);
+					field += 8;
+				}
+				if (localoffset == 0xFFFFFFFF && field + 8 <= fieldend)
+					localoffset = readLE64(field);
+			}
+
+			e += 4 + len;
+		}
+
+		bool encrypted = (flags & 0x1) != 0;
+		bool directory = namelen > 0 && header[CENTRAL_DIR_HEADER_SIZE + namelen - 1] == '/';
+
+		if (method == 0 && !encrypted && !directory && compressedsize == rawsize)
+		{
+			std::string name((const char *) header + CENTRAL_DIR_HEADER_SIZE, namelen);
+			Entry entry = {base + (int64) localoffset, (int64) rawsize};
+			storedEntries[name] = entry;
+		}
+
+		pos += entrysize;
+	}
+}
+
+bool ZipIndex::findStoredEntry(const std::string &name, int64 &offset, int64 &size) const
+{
+	auto it = storedEntries.find(name);
+	if (it == storedEntries.end())
+		return false;
+
+	// The local header's extra field can differ from the central directory's,
+	// so its length has to be read from the local header itself.
+	StrongRef<NativeFile> file(new NativeFile(path, File::MODE_READ), Acquire::NORETAIN);
+
+	uint8 header[LOCAL_HEADER_SIZE];
+	readAt(file, it->second.localHeaderOffset, header, LOCAL_HEADER_SIZE);
+	if (readLE32(header) != LOCAL_HEADER_SIG)
+		return false;
+
+	offset = it->second.localHeaderOffset + LOCAL_HEADER_SIZE + readLE16(header + 26) + readLE16(header + 28);
+	size = it->second.size;
+	return true;
+}
+
+} // physfs
+} // filesystem
+} // love
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+
+// C++
+#include <string>
+#include <unordered_map>
+
+namespace love
+{
+namespace filesystem
+{
+namespace physfs
+{
+
+/**
+ * Finds entries stored without compression in a zip archive on disk, so they
+ * can be memory-mapped directly instead of being read through PhysFS. Only
+ * the central directory is read, and archives appended to another file (such
+ * as fused games) are supported.
+ **/
+class ZipIndex
+{
+public:
+
+	/**
+	 * Reads the archive's central directory. Throws if the file isn't a zip
+	 * archive which PhysFS would also accept.
+	 **/
+	ZipIndex(const std::string &path);
+
+	/**
+	 * Gets the location of an entry's contents within the archive file.
+	 * @return False if the entry doesn't exist or is compressed or encrypted.
+	 **/
+	bool findStoredEntry(const std::string &name, int64 &offset, int64 &size) const;
+
+private:
+
+	struct Entry
+	{
+		int64 localHeaderOffset;
+		int64 size;
+	};
+
+	std::string path;
+	std::unordered_map<std::string, Entry> storedEntries;
+
+}; // ZipIndex
+
+} // physfs
+} // filesystem
+} // love
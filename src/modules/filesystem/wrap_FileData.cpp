@@ -55,11 +55,19 @@ int w_FileData_getExtension(lua_State *L)
 	return 1;
 }
 
+int w_FileData_isMemoryMapped(lua_State *L)
+{
+	FileData *t = luax_checkfiledata(L, 1);
+	luax_pushboolean(L, t->isMemoryMapped());
+	return 1;
+}
+
 static const luaL_Reg w_FileData_functions[] =
 {
 	{ "clone", w_FileData_clone },
 	{ "getFilename", w_FileData_getFilename },
 	{ "getExtension", w_FileData_getExtension },
+	{ "isMemoryMapped", w_FileData_isMemoryMapped },
 
 	{ 0, 0 }
 };
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_FileRequest.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+FileRequest *luax_checkfilerequest(lua_State *L, int idx)
+{
+	return luax_checktype<FileRequest>(L, idx);
+}
+
+int w_FileRequest_getFilename(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	luax_pushstring(L, t->getFilename());
+	return 1;
+}
+
+int w_FileRequest_getPriority(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	lua_pushinteger(L, t->getPriority());
+	return 1;
+}
+
+int w_FileRequest_getStatus(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	const char *str = nullptr;
+	if (!FileRequest::getConstant(t->getStatus(), str))
+		return luaL_error(L, "Unknown file request status.");
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_FileRequest_isComplete(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_FileRequest_cancel(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	luax_pushboolean(L, t->cancel());
+	return 1;
+}
+
+int w_FileRequest_wait(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	double timeout = luaL_optnumber(L, 2, -1.0);
+	luax_pushboolean(L, t->wait(timeout));
+	return 1;
+}
+
+int w_FileRequest_getData(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+
+	FileData *data = t->getData();
+	if (data != nullptr)
+	{
+		luax_pushtype(L, data);
+		return 1;
+	}
+
+	lua_pushnil(L);
+	if (t->getStatus() == FileRequest::STATUS_ERROR)
+	{
+		luax_pushstring(L, t->getError());
+		return 2;
+	}
+
+	return 1;
+}
+
+int w_FileRequest_getError(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	if (t->getStatus() == FileRequest::STATUS_ERROR)
+		luax_pushstring(L, t->getError());
+	else
+		lua_pushnil(L);
+	return 1;
+}
+
+int w_FileRequest_getLatency(lua_State *L)
+{
+	FileRequest *t = luax_checkfilerequest(L, 1);
+	double queued = 0.0;
+	double reading = 0.0;
+	t->getLatency(queued, reading);
+	lua_pushnumber(L, queued);
+	lua_pushnumber(L, reading);
+	return 2;
+}
+
+static const luaL_Reg w_FileRequest_functions[] =
+{
+	{ "getFilename", w_FileRequest_getFilename },
+	{ "getPriority", w_FileRequest_getPriority },
+	{ "getStatus", w_FileRequest_getStatus },
+	{ "isComplete", w_FileRequest_isComplete },
+	{ "cancel", w_FileRequest_cancel },
+	{ "wait", w_FileRequest_wait },
+	{ "getData", w_FileRequest_getData },
+	{ "getError", w_FileRequest_getError },
+	{ "getLatency", w_FileRequest_getLatency },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_filerequest(lua_State *L)
+{
+	return luax_register_type(L, &FileRequest::type, w_FileRequest_functions, nullptr);
+}
+
+} // filesystem
+} // love
@@ -24,8 +24,11 @@
 #include "wrap_File.h"
 #include "wrap_NativeFile.h"
 #include "wrap_FileData.h"
+#include "wrap_FileRequest.h"
 #include "data/wrap_Data.h"
 #include "data/wrap_DataModule.h"
+#include "data/HashFunction.h"
+#include "common/version.h"
 
 #include "physfs/Filesystem.h"
 
@@ -36,11 +39,16 @@
 // SDL
 #include <SDL3/SDL_loadso.h>
 
+#ifdef LUA_JITLIBNAME
+#include <luajit.h>
+#endif
+
 // STL
 #include <vector>
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <memory>
 
 namespace love
 {
@@ -335,7 +343,14 @@ FileData *luax_getfiledata(lua_State *L, int idx, bool ioerror, int &nresults)
 	File *file = nullptr;
 	nresults = 0;
 
-	if (lua_isstring(L, idx) || luax_istype(L, idx, File::type))
+	if (lua_isstring(L, idx))
+	{
+		// Large files are memory-mapped instead of copied, when possible.
+		data = instance()->readMappedIfLarge(lua_tostring(L, idx));
+		if (data == nullptr)
+			file = luax_getfile(L, idx);
+	}
+	else if (luax_istype(L, idx, File::type))
 	{
 		file = luax_getfile(L, idx);
 	}
@@ -383,7 +398,13 @@ Data *luax_getdata(lua_State *L, int idx)
 	Data *data = nullptr;
 	File *file = nullptr;
 
-	if (lua_isstring(L, idx) || luax_istype(L, idx, File::type))
+	if (lua_isstring(L, idx))
+	{
+		data = instance()->readMappedIfLarge(lua_tostring(L, idx));
+		if (data == nullptr)
+			file = luax_getfile(L, idx);
+	}
+	else if (luax_istype(L, idx, File::type))
 	{
 		file = luax_getfile(L, idx);
 	}
@@ -427,6 +448,43 @@ bool luax_cangetdata(lua_State *L, int idx)
 
 int w_newFileData(lua_State *L)
 {
+	// Filepath with an options table.
+	if (lua_isstring(L, 1) && lua_istable(L, 2))
+	{
+		const char *filename = lua_tostring(L, 1);
+
+		lua_getfield(L, 2, "mmap");
+		bool setmmap = !lua_isnoneornil(L, -1);
+		bool usemmap = luax_toboolean(L, -1);
+		lua_pop(L, 1);
+
+		FileData *data = nullptr;
+		try
+		{
+			if (!setmmap)
+				data = instance()->read(filename);
+			else
+			{
+				// Files which can't be mapped are read normally instead.
+				if (usemmap)
+					data = instance()->readMapped(filename);
+				if (data == nullptr)
+				{
+					StrongRef<File> file(instance()->openFile(filename, File::MODE_CLOSED), Acquire::NORETAIN);
+					data = file->read();
+				}
+			}
+		}
+		catch (love::Exception &e)
+		{
+			return luax_ioError(L, "%s", e.what());
+		}
+
+		luax_pushtype(L, data);
+		data->release();
+		return 1;
+	}
+
 	// Single argument: treat as filepath or File.
 	if (lua_gettop(L) == 1)
 	{
@@ -695,6 +753,19 @@ static int w_write_or_append(lua_State *L, File::Mode mode)
 	return 1;
 }
 
+int w_readAsync(lua_State *L)
+{
+	const char *filename = luaL_checkstring(L, 1);
+	int priority = (int) luaL_optinteger(L, 2, 0);
+
+	FileRequest *request = nullptr;
+	luax_catchexcept(L, [&]() { request = instance()->readAsync(filename, priority); });
+
+	luax_pushtype(L, request);
+	request->release();
+	return 1;
+}
+
 int w_write(lua_State *L)
 {
 	return w_write_or_append(L, File::MODE_WRITE);
@@ -743,6 +814,20 @@ int w_lines(lua_State *L)
 	return 1;
 }
 
+static int checkLoadStatus(lua_State *L, int status)
+{
+	// Load the chunk, but don't run it.
+	switch (status)
+	{
+	case LUA_ERRMEM:
+		return luaL_error(L, "Memory allocation error: %s\n", lua_tostring(L, -1));
+	case LUA_ERRSYNTAX:
+		return luaL_error(L, "Syntax error: %s\n", lua_tostring(L, -1));
+	default: // success
+		return 1;
+	}
+}
+
 int w_load(lua_State *L)
 {
 	std::string filename = std::string(luaL_checkstring(L, 1));
@@ -788,16 +873,7 @@ int w_load(lua_State *L)
 
 	data->release();
 
-	// Load the chunk, but don't run it.
-	switch (status)
-	{
-	case LUA_ERRMEM:
-		return luaL_error(L, "Memory allocation error: %s\n", lua_tostring(L, -1));
-	case LUA_ERRSYNTAX:
-		return luaL_error(L, "Syntax error: %s\n", lua_tostring(L, -1));
-	default: // success
-		return 1;
-	}
+	return checkLoadStatus(L, status);
 }
 
 int w_setSymlinksEnabled(lua_State *L)
@@ -812,6 +888,21 @@ int w_areSymlinksEnabled(lua_State *L)
 	return 1;
 }
 
+int w_setMemoryMapThreshold(lua_State *L)
+{
+	lua_Number bytes = luaL_checknumber(L, 1);
+	if (bytes < 0)
+		return luaL_argerror(L, 1, "size must not be negative");
+	instance()->setMemoryMapThreshold((int64) bytes);
+	return 0;
+}
+
+int w_getMemoryMapThreshold(lua_State *L)
+{
+	lua_pushnumber(L, (lua_Number) instance()->getMemoryMapThreshold());
+	return 1;
+}
+
 int w_getRequirePath(lua_State *L)
 {
 	std::stringstream path;
@@ -860,9 +951,23 @@ int w_setRequirePath(lua_State *L)
 	while(std::getline(path, element, ';'))
 		requirePath.push_back(element);
 
+	instance()->clearRequirePathCache();
+
 	return 0;
 }
 
+int w_setBytecodeCacheEnabled(lua_State *L)
+{
+	instance()->setBytecodeCacheEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isBytecodeCacheEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isBytecodeCacheEnabled());
+	return 1;
+}
+
 int w_setCRequirePath(lua_State *L)
 {
 	std::string element = luax_checkstring(L, 1);
@@ -894,6 +999,123 @@ static void replaceAll(std::string &str, const std::string &substr, const std::s
 		str.replace(locations[i], sublen, replacement);
 }
 
+static int writeBytecode(lua_State */*L*/, const void *p, size_t size, void *ud)
+{
+	((std::string *) ud)->append((const char *) p, size);
+	return 0;
+}
+
+static std::string getBytecodeCachePath(const char *source, size_t size, const std::string &chunkname)
+{
+	using love::data::HashFunction;
+
+	// Bytecode is only compatible with the exact Lua build which made it.
+#ifdef LUA_JITLIBNAME
+	std::string version = LUAJIT_VERSION;
+#else
+	std::string version = LUA_RELEASE;
+#endif
+	version += " " LOVE_VERSION_STRING " " + std::to_string(sizeof(void *));
+
+	HashFunction::Function function = HashFunction::FUNCTION_XXH3_128;
+	std::unique_ptr<HashFunction::State> state(HashFunction::getHashFunction(function)->newState(function));
+
+	state->update(version.c_str(), version.size() + 1);
+	state->update(chunkname.c_str(), chunkname.size() + 1);
+	state->update(source, size);
+
+	HashFunction::Value hash = {};
+	state->digest(hash);
+
+	static const char hexchars[] = "0123456789abcdef";
+
+	std::string path = std::string(Filesystem::BYTECODE_CACHE_DIRECTORY) + "/";
+	for (size_t i = 0; i < hash.size; i++)
+	{
+		path += hexchars[(hash.data[i] >> 4) & 0xF];
+		path += hexchars[hash.data[i] & 0xF];
+	}
+
+	return path + ".luac";
+}
+
+// Releases the given data.
+static int loadModule(lua_State *L, FileData *data, const std::string &filename)
+{
+	auto *inst = instance();
+
+	const char *source = (const char *) data->getData();
+	size_t size = data->getSize();
+	std::string chunkname = "@" + filename;
+
+	// Precompiled modules start with an escape character.
+	bool usecache = inst->isBytecodeCacheEnabled() && size > 0 && source[0] != '\x1B';
+	std::string cachepath;
+
+	if (usecache)
+	{
+		cachepath = getBytecodeCachePath(source, size, chunkname);
+
+		FileData *bytecode = nullptr;
+		try
+		{
+			StrongRef<File> file(inst->openFile(cachepath.c_str(), File::MODE_READ), Acquire::NORETAIN);
+			bytecode = file->read();
+		}
+		catch (love::Exception &)
+		{
+		}
+
+		if (bytecode != nullptr)
+		{
+			int status = luaL_loadbuffer(L, (const char *) bytecode->getData(), bytecode->getSize(), chunkname.c_str());
+			bytecode->release();
+
+			if (status == 0)
+			{
+				data->release();
+				return 1;
+			}
+
+			// Stale or corrupt bytecode is replaced below.
+			lua_pop(L, 1);
+		}
+	}
+
+	int status = luaL_loadbuffer(L, source, size, chunkname.c_str());
+
+	if (status == 0 && usecache)
+	{
+		std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+		lua_dump(L, writeBytecode, &bytecode, 0);
+#else
+		lua_dump(L, writeBytecode, &bytecode);
+#endif
+
+		try
+		{
+			inst->createDirectory(Filesystem::BYTECODE_CACHE_DIRECTORY);
+			inst->write(cachepath.c_str(), bytecode.data(), (int64) bytecode.size());
+		}
+		catch (love::Exception &)
+		{
+			// The cache is only an optimization.
+		}
+	}
+
+	data->release();
+
+	return checkLoadStatus(L, status);
+}
+
+static FileData *readModule(const std::string &filename)
+{
+	// Modules are small, so skip the memory-mapping size check.
+	StrongRef<File> file(instance()->openFile(filename.c_str(), File::MODE_READ), Acquire::NORETAIN);
+	return file->read();
+}
+
 int loader(lua_State *L)
 {
 	std::string modulename = luax_checkstring(L, 1);
@@ -906,6 +1128,31 @@ int loader(lua_State *L)
 	}
 
 	auto *inst = instance();
+
+	// Modules which were found before are loaded without searching the
+	// require path again. If the file has since disappeared, search anyway.
+	std::string filename;
+	if (inst->getCachedRequirePath(modulename, filename))
+	{
+		FileData *data = nullptr;
+		try
+		{
+			data = readModule(filename);
+		}
+		catch (love::Exception &)
+		{
+			inst->removeCachedRequirePath(modulename);
+		}
+
+		if (data != nullptr)
+		{
+			if (hasSlash)
+				luax_markdeprecated(L, 2, "character in require string (forward slashes), use dots instead.", API_CUSTOM);
+
+			return loadModule(L, data, filename);
+		}
+	}
+
 	for (std::string element : inst->getRequirePath())
 	{
 		replaceAll(element, "?", modulename);
@@ -916,9 +1163,19 @@ int loader(lua_State *L)
 			if (hasSlash)
 				luax_markdeprecated(L, 2, "character in require string (forward slashes), use dots instead.", API_CUSTOM);
 
-			lua_pop(L, 1);
-			lua_pushstring(L, element.c_str());
-			return w_load(L);
+			FileData *data = nullptr;
+			try
+			{
+				data = readModule(element);
+			}
+			catch (love::Exception &e)
+			{
+				return luax_ioError(L, "%s", e.what());
+			}
+
+			inst->setCachedRequirePath(modulename, element);
+
+			return loadModule(L, data, element);
 		}
 	}
 
@@ -1069,6 +1326,7 @@ static const luaL_Reg functions[] =
 	{ "createDirectory", w_createDirectory },
 	{ "remove", w_remove },
 	{ "read", w_read },
+	{ "readAsync", w_readAsync },
 	{ "write", w_write },
 	{ "append", w_append },
 	{ "getDirectoryItems", w_getDirectoryItems },
@@ -1079,8 +1337,12 @@ static const luaL_Reg functions[] =
 	{ "setSymlinksEnabled", w_setSymlinksEnabled },
 	{ "areSymlinksEnabled", w_areSymlinksEnabled },
 	{ "newFileData", w_newFileData },
+	{ "setMemoryMapThreshold", w_setMemoryMapThreshold },
+	{ "getMemoryMapThreshold", w_getMemoryMapThreshold },
 	{ "getRequirePath", w_getRequirePath },
 	{ "setRequirePath", w_setRequirePath },
+	{ "setBytecodeCacheEnabled", w_setBytecodeCacheEnabled },
+	{ "isBytecodeCacheEnabled", w_isBytecodeCacheEnabled },
 	{ "getCRequirePath", w_getCRequirePath },
 	{ "setCRequirePath", w_setCRequirePath },
 
@@ -1095,6 +1357,7 @@ static const lua_CFunction types[] =
 	luaopen_file,
 	luaopen_nativefile,
 	luaopen_filedata,
+	luaopen_filerequest,
 	0
 };
 
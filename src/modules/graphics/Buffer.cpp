@@ -21,6 +21,8 @@
 #include "Buffer.h"
 #include "Graphics.h"
 #include "common/memory.h"
+#include "common/Range.h"
+#include "data/ByteData.h"
 
 namespace love
 {
@@ -288,6 +290,67 @@ void Buffer::clear(size_t offset, size_t size)
 	clearInternal(offset, size);
 }
 
+Buffer::Mapping *Buffer::mapData(size_t offset, size_t size)
+{
+	if (isMapped())
+		throw love::Exception("Buffer is already mapped.");
+	else if (isImmutable())
+		throw love::Exception("Cannot map an immutable Buffer.");
+	else if (size == 0 || !Range(0, getSize()).contains(Range(offset, size)))
+		throw love::Exception("The given offset and size parameters to map() are not within the Buffer's size.");
+
+	MapType maptype = dataUsage == BUFFERDATAUSAGE_READBACK ? MAP_READ_ONLY : MAP_WRITE_INVALIDATE;
+
+	void *data = map(maptype, offset, size);
+	if (data == nullptr)
+		throw love::Exception("Could not map Buffer.");
+
+	Mapping *m = new Mapping(this, data, offset, size);
+	mapping = m;
+	mappingOffset = offset;
+	mappingSize = size;
+	return m;
+}
+
+void Buffer::unmapData()
+{
+	if (mappingSize == 0)
+		return;
+
+	// The Mapping may already be gone, so it's emptied by clearing the
+	// pointer rather than by touching it.
+	mapping = nullptr;
+
+	Range r(mappingOffset, mappingSize);
+	mappingOffset = 0;
+	mappingSize = 0;
+
+	unmap(r.getOffset(), r.getSize());
+}
+
+love::Type Buffer::Mapping::type("GraphicsBufferMapping", &Data::type);
+
+Buffer::Mapping::Mapping(Buffer *buffer, void *data, size_t offset, size_t size)
+	: buffer(buffer)
+	, data(data)
+	, offset(offset)
+	, size(size)
+{
+}
+
+Buffer::Mapping::~Mapping()
+{
+	// The last reference can be dropped on any thread, and unmapping needs the
+	// graphics thread, so this only detaches from the Buffer.
+	Mapping *self = this;
+	buffer->mapping.compare_exchange_strong(self, nullptr);
+}
+
+Data *Buffer::Mapping::clone() const
+{
+	return new love::data::ByteData(data, size);
+}
+
 std::vector<Buffer::DataDeclaration> Buffer::getCommonFormatDeclaration(CommonFormat format)
 {
 	switch (format)
@@ -24,12 +24,14 @@
 #include "common/config.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/Data.h"
 #include "common/Optional.h"
 #include "vertex.h"
 #include "Resource.h"
 
 // C
 #include <stddef.h>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -111,7 +113,7 @@ class Buffer : public love::Object, public Resource
 	size_t getSize() const { return size; }
 	BufferUsageFlags getUsageFlags() const { return usageFlags; }
 	BufferDataUsage getDataUsage() const { return dataUsage; }
-	bool isMapped() const { return mapped; }
+	bool isMapped() const { return mapped || mappingSize > 0; }
 
 	size_t getArrayLength() const { return arrayLength; }
 	size_t getArrayStride() const { return arrayStride; }
@@ -181,6 +183,50 @@ class Buffer : public love::Object, public Resource
 
 	}; // Mapper
 
+	/**
+	 * Data over a mapped range of a Buffer, which lets Lua and FFI code write
+	 * (or for readback Buffers, read) the mapped memory directly. It's empty
+	 * once the Buffer is unmapped. Mappings can be sent to other threads, so
+	 * destroying one doesn't unmap the Buffer: it stays mapped until
+	 * unmapData is called on the main thread.
+	 **/
+	class Mapping : public love::Data
+	{
+	public:
+
+		static love::Type type;
+
+		Mapping(Buffer *buffer, void *data, size_t offset, size_t size);
+		virtual ~Mapping();
+
+		// Implements Data.
+		Data *clone() const override;
+		void *getData() const override { return buffer->mapping == this ? data : nullptr; }
+		size_t getSize() const override { return buffer->mapping == this ? size : 0; }
+
+		Buffer *getBuffer() const { return buffer.get(); }
+		size_t getOffset() const { return offset; }
+
+	private:
+
+		friend class Buffer;
+
+		StrongRef<Buffer> buffer;
+		void *data;
+		size_t offset;
+		size_t size;
+
+	}; // Mapping
+
+	/**
+	 * Maps a range of the Buffer until unmapData is called. Readback Buffers
+	 * are mapped for reading and other Buffers for writing. The contents of a
+	 * write mapping start out undefined, and the whole range is uploaded when
+	 * it's unmapped.
+	 **/
+	Mapping *mapData(size_t offset, size_t size);
+	void unmapData();
+
 protected:
 
 	virtual void clearInternal(size_t offset, size_t size) = 0;
@@ -205,6 +251,14 @@ class Buffer : public love::Object, public Resource
 	bool immutable;
 
 	bool legacyVertexBindings = false;
+
+	// Not owned: the Mapping keeps the Buffer alive instead. Cleared by the
+	// Mapping's destructor, which can run on any thread.
+	std::atomic<Mapping *> mapping { nullptr };
+
+	// The range mapped by mapData, which stays mapped until unmapData.
+	size_t mappingOffset = 0;
+	size_t mappingSize = 0;
 	
 }; // Buffer
 
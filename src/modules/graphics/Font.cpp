@@ -23,6 +23,7 @@
 
 #include "common/math.h"
 #include "common/Matrix.h"
+#include "common/profiler.h"
 #include "Graphics.h"
 
 #include <math.h>
@@ -236,6 +237,8 @@ love::font::GlyphData *Font::getRasterizerGlyphData(love::font::TextShaper::Glyp
 
 const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 {
+	LOVE_PROFILE_ZONE("Font::addGlyph");
+
 	float glyphdpiscale = getDPIScale();
 	StrongRef<love::font::GlyphData> gd(getRasterizerGlyphData(glyphindex, glyphdpiscale), Acquire::NORETAIN);
 
@@ -33,10 +33,12 @@
 #include "TextBatch.h"
 #include "common/deprecation.h"
 #include "common/config.h"
+#include "common/profiler.h"
 
 // C++
 #include <algorithm>
 #include <stdlib.h>
+#include <string.h>
 
 namespace love
 {
@@ -113,6 +115,7 @@ namespace metal { extern love::graphics::Graphics *createInstance(); }
 #ifdef LOVE_GRAPHICS_VULKAN
 namespace vulkan { extern love::graphics::Graphics *createInstance(); }
 #endif
+namespace none { extern love::graphics::Graphics *createInstance(); }
 
 static const Renderer rendererOrder[] = {
 	RENDERER_METAL,
@@ -124,6 +127,8 @@ static const Renderer rendererOrder[] = {
 	RENDERER_VULKAN,
 	RENDERER_OPENGL,
 #endif
+	// Only used when explicitly requested, since it never draws anything.
+	RENDERER_NONE,
 };
 
 static std::vector<Renderer> defaultRenderers =
@@ -184,6 +189,8 @@ Graphics *Graphics::createInstance()
 			if (r == RENDERER_METAL)
 				instance = metal::createInstance();
 #endif
+			if (r == RENDERER_NONE)
+				instance = none::createInstance();
 			if (instance != nullptr)
 				break;
 		}
@@ -1953,9 +1960,11 @@ Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawComman
 	bool shouldflush = false;
 	bool shouldresize = false;
 
+	bool indexed = cmd.indexMode != TRIANGLEINDEX_NONE || cmd.indices != nullptr;
+
 	if (cmd.primitiveMode != state.primitiveMode
 		|| cmd.formats[0] != state.formats[0] || cmd.formats[1] != state.formats[1]
-		|| ((cmd.indexMode != TRIANGLEINDEX_NONE) != (state.indexCount > 0))
+		|| (indexed != (state.indexCount > 0))
 		|| cmd.texture != state.texture
 		|| cmd.standardShaderType != state.standardShaderType)
 	{
@@ -1965,10 +1974,10 @@ Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawComman
 	int totalvertices = state.vertexCount + cmd.vertexCount;
 
 	// We only support uint16 index buffers for now.
-	if (totalvertices > LOVE_UINT16_MAX && cmd.indexMode != TRIANGLEINDEX_NONE)
+	if (totalvertices > LOVE_UINT16_MAX && indexed)
 		shouldflush = true;
 
-	int reqIndexCount = getIndexCount(cmd.indexMode, cmd.vertexCount);
+	int reqIndexCount = cmd.indices != nullptr ? cmd.indexCount : getIndexCount(cmd.indexMode, cmd.vertexCount);
 	size_t reqIndexSize = reqIndexCount * sizeof(uint16);
 
 	size_t newdatasizes[2] = {0, 0};
@@ -1994,7 +2003,7 @@ Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawComman
 		newdatasizes[i] = stride * cmd.vertexCount;
 	}
 
-	if (cmd.indexMode != TRIANGLEINDEX_NONE)
+	if (indexed)
 	{
 		size_t datasize = (state.indexCount + reqIndexCount) * sizeof(uint16);
 
@@ -2046,13 +2055,20 @@ Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawComman
 		}
 	}
 
-	if (cmd.indexMode != TRIANGLEINDEX_NONE)
+	if (indexed)
 	{
 		if (state.indexBufferMap.data == nullptr)
 			state.indexBufferMap = state.indexBuffer->map(reqIndexSize);
 
 		uint16 *indices = (uint16 *) state.indexBufferMap.data;
-		fillIndices(cmd.indexMode, state.vertexCount, cmd.vertexCount, indices);
+
+		if (cmd.indices != nullptr)
+		{
+			for (int i = 0; i < reqIndexCount; i++)
+				indices[i] = (uint16) (state.vertexCount + cmd.indices[i]);
+		}
+		else
+			fillIndices(cmd.indexMode, state.vertexCount, cmd.vertexCount, indices);
 
 		state.indexBufferMap.data += reqIndexSize;
 	}
@@ -2088,6 +2104,8 @@ void Graphics::flushBatchedDraws()
 	if ((sbstate.vertexCount == 0 && sbstate.indexCount == 0) || sbstate.flushing)
 		return;
 
+	LOVE_PROFILE_ZONE("Graphics::flushBatchedDraws");
+
 	VertexAttributes attributes;
 	BufferBindings buffers;
 
@@ -2448,6 +2466,26 @@ void Graphics::polyline(const Vector2 *vertices, size_t count)
 	}
 }
 
+void Graphics::curves(math::BezierCurve * const *curves, size_t count, float tolerance)
+{
+	if (!(tolerance > 0.0f))
+		throw love::Exception("Curve tolerance must be greater than 0.");
+
+	// The pixel scale includes the current transform's scale, so this converts
+	// the tolerance from pixels to the coordinate space of the curves.
+	float pixelscale = std::max((float) pixelScaleStack.back(), 0.000001f);
+	float curvetolerance = tolerance / pixelscale;
+
+	std::vector<Vector2> points;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		points.clear();
+		curves[i]->renderAdaptive(curvetolerance, points);
+		polyline(points.data(), points.size());
+	}
+}
+
 void Graphics::rectangle(DrawMode mode, float x, float y, float w, float h)
 {
 	Vector2 coords[] = {Vector2(x,y), Vector2(x,y+h), Vector2(x+w,y+h), Vector2(x+w,y), Vector2(x,y)};
@@ -2706,6 +2744,247 @@ void Graphics::polygon(DrawMode mode, const Vector2 *coords, size_t count, bool
 	}
 }
 
+// Whether the ring can be drawn as a triangle fan. Every corner turning the
+// same way isn't enough on its own: a star polygon does that too, but winds
+// around more than once, so the total turning has to be a single revolution.
+static bool isSimpleConvex(const Vector2 *coords, size_t count)
+{
+	if (!math::isConvex(coords, count))
+		return false;
+
+	double turning = 0.0;
+	for (size_t i = count - 2, j = count - 1, k = 0; k < count; i = j, j = k, k++)
+	{
+		Vector2 p = coords[j] - coords[i];
+		Vector2 q = coords[k] - coords[j];
+		turning += atan2(Vector2::cross(p, q), Vector2::dot(p, q));
+	}
+
+	return fabs(fabs(turning) - 2.0 * LOVE_M_PI) < 0.01;
+}
+
+void Graphics::fillPolygon(const Vector2 *coords, size_t count, const std::vector<size_t> &holeStarts, FillRule rule)
+{
+	if (count < 3)
+		return;
+
+	// Simple convex outlines don't need to be triangulated at all. Outlines
+	// are often closed by repeating the first vertex, which would add a
+	// zero-length edge that fails the convexity test.
+	if (holeStarts.empty())
+	{
+		size_t ringcount = count;
+		if (ringcount > 3 && coords[ringcount - 1] == coords[0])
+			ringcount--;
+
+		if (isSimpleConvex(coords, ringcount))
+		{
+			polygon(DRAW_FILL, coords, ringcount, false);
+			return;
+		}
+	}
+
+	const PolygonTriangulation &triangulation = getPolygonTriangulation(coords, count, holeStarts, rule);
+	const std::vector<uint32> &indices = triangulation.indices;
+	if (indices.empty() && triangulation.triangles.empty())
+		return;
+
+	const Matrix4 &t = getTransform();
+	bool is2D = t.isAffine2DTransform();
+
+	BatchedDrawCommand cmd;
+	cmd.formats[0] = getSinglePositionFormat(is2D);
+	cmd.formats[1] = CommonFormat::STf_RGBAub;
+
+	// Batched index buffers are 16 bit, so very large polygons are expanded
+	// into unindexed triangles instead.
+	const Vector2 *src = coords;
+	std::vector<Vector2> expanded;
+
+	if (!triangulation.triangles.empty())
+	{
+		src = triangulation.triangles.data();
+		cmd.vertexCount = (int) triangulation.triangles.size();
+	}
+	else if (count <= LOVE_UINT16_MAX)
+	{
+		cmd.vertexCount = (int) count;
+		cmd.indices = indices.data();
+		cmd.indexCount = (int) indices.size();
+	}
+	else
+	{
+		expanded.reserve(indices.size());
+		for (uint32 i : indices)
+			expanded.push_back(coords[i]);
+
+		src = expanded.data();
+		cmd.vertexCount = (int) expanded.size();
+	}
+
+	BatchedVertexData data = requestBatchedDraw(cmd);
+
+	// Texture coordinates span the bounds of the outer ring.
+	size_t outercount = holeStarts.empty() ? count : holeStarts[0];
+
+	constexpr float inf = std::numeric_limits<float>::infinity();
+	Vector2 mincoord(inf, inf);
+	Vector2 maxcoord(-inf, -inf);
+
+	for (size_t i = 0; i < outercount; i++)
+	{
+		Vector2 v = coords[i];
+		mincoord.x = std::min(mincoord.x, v.x);
+		mincoord.y = std::min(mincoord.y, v.y);
+		maxcoord.x = std::max(maxcoord.x, v.x);
+		maxcoord.y = std::max(maxcoord.y, v.y);
+	}
+
+	Vector2 invsize(1.0f / (maxcoord.x - mincoord.x), 1.0f / (maxcoord.y - mincoord.y));
+	Vector2 start(mincoord.x * invsize.x, mincoord.y * invsize.y);
+
+	Color32 c = toColor32(getColor());
+	STf_RGBAub *attributes = (STf_RGBAub *) data.stream[1];
+	for (int i = 0; i < cmd.vertexCount; i++)
+	{
+		attributes[i].s = src[i].x * invsize.x - start.x;
+		attributes[i].t = src[i].y * invsize.y - start.y;
+		attributes[i].color = c;
+	}
+
+	if (is2D)
+		t.transformXY((Vector2 *) data.stream[0], src, cmd.vertexCount);
+	else
+		t.transformXY0((Vector3 *) data.stream[0], src, cmd.vertexCount);
+}
+
+static float getSignedArea(const Vector2 *vertices, size_t start, size_t end)
+{
+	float area = 0.0f;
+	for (size_t i = start, j = end - 1; i < end; j = i++)
+		area += (vertices[j].x - vertices[i].x) * (vertices[i].y + vertices[j].y);
+	return area;
+}
+
+void Graphics::triangulatePolygon(const Vector2 *vertices, size_t count, const std::vector<size_t> &holeStarts, FillRule rule, PolygonTriangulation &result)
+{
+	std::vector<Vector2> rings(vertices, vertices + count);
+
+	result.indices.clear();
+	result.triangles.clear();
+
+	// Ear clipping needs rings which don't cross. Anything else is split into
+	// trapezoids, which handles both fill rules exactly.
+	if (math::isSelfIntersecting(rings, holeStarts))
+	{
+		result.triangles = math::triangulateSelfIntersecting(rings, holeStarts, rule == FILL_RULE_NONZERO);
+		return;
+	}
+
+	std::vector<size_t> ringStarts;
+	std::vector<uint32> remap;
+
+	if (rule == FILL_RULE_NONZERO && !holeStarts.empty())
+	{
+		// With the non-zero rule, a hole wound in the same direction as the
+		// outer ring adds to the winding number instead of cancelling it, so
+		// its area stays filled and it isn't cut out.
+		float outerarea = getSignedArea(vertices, 0, holeStarts[0]);
+
+		rings.clear();
+		remap.reserve(count);
+
+		for (size_t i = 0; i <= holeStarts.size(); i++)
+		{
+			size_t start = i == 0 ? 0 : holeStarts[i - 1];
+			size_t end = i < holeStarts.size() ? holeStarts[i] : count;
+
+			if (i > 0)
+			{
+				if (getSignedArea(vertices, start, end) * outerarea > 0.0f)
+					continue;
+				ringStarts.push_back(rings.size());
+			}
+
+			for (size_t j = start; j < end; j++)
+			{
+				rings.push_back(vertices[j]);
+				remap.push_back((uint32) j);
+			}
+		}
+	}
+	else
+		ringStarts = holeStarts;
+
+	result.indices = math::triangulate(rings, ringStarts);
+
+	if (!remap.empty())
+	{
+		for (uint32 &i : result.indices)
+			i = remap[i];
+	}
+}
+
+const Graphics::PolygonTriangulation &Graphics::getPolygonTriangulation(const Vector2 *vertices, size_t count, const std::vector<size_t> &holeStarts, FillRule rule)
+{
+	if (count > MAX_CACHED_POLYGON_VERTICES)
+	{
+		triangulatePolygon(vertices, count, holeStarts, rule, polygonScratchTriangulation);
+		return polygonScratchTriangulation;
+	}
+
+	data::HashFunction::Value hashvalue;
+	data::hash(data::HashFunction::FUNCTION_XXH3_64, (const char *) vertices, sizeof(Vector2) * count, hashvalue);
+
+	uint64 key = 0;
+	memcpy(&key, hashvalue.data, sizeof(uint64));
+
+	key ^= (uint64) rule + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+	for (size_t start : holeStarts)
+		key ^= (uint64) start + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+
+	auto it = polygonTriangulations.find(key);
+	if (it != polygonTriangulations.end())
+	{
+		PolygonTriangulation &p = it->second;
+
+		if (p.rule == rule && p.holeStarts == holeStarts && p.vertices.size() == count
+			&& memcmp(p.vertices.data(), vertices, sizeof(Vector2) * count) == 0)
+		{
+			// Move to the front of the recently used list.
+			polygonTriangulationOrder.splice(polygonTriangulationOrder.begin(), polygonTriangulationOrder, p.orderPosition);
+			return p;
+		}
+
+		// Hash collision with a different polygon.
+		polygonTriangulationVertexCount -= p.vertices.size();
+		polygonTriangulationOrder.erase(p.orderPosition);
+		polygonTriangulations.erase(it);
+	}
+
+	// Evict the least recently used triangulations until the new one fits.
+	while (!polygonTriangulationOrder.empty()
+		&& (polygonTriangulations.size() >= MAX_CACHED_POLYGONS
+			|| polygonTriangulationVertexCount + count > MAX_CACHED_POLYGON_VERTICES))
+	{
+		auto oldest = polygonTriangulations.find(polygonTriangulationOrder.back());
+		polygonTriangulationVertexCount -= oldest->second.vertices.size();
+		polygonTriangulations.erase(oldest);
+		polygonTriangulationOrder.pop_back();
+	}
+
+	PolygonTriangulation &p = polygonTriangulations[key];
+	p.vertices.assign(vertices, vertices + count);
+	p.holeStarts = holeStarts;
+	p.rule = rule;
+	p.orderPosition = polygonTriangulationOrder.insert(polygonTriangulationOrder.begin(), key);
+	triangulatePolygon(vertices, count, holeStarts, rule, p);
+
+	polygonTriangulationVertexCount += count;
+
+	return p;
+}
+
 const Graphics::Capabilities &Graphics::getCapabilities() const
 {
 	return capabilities;
@@ -2934,6 +3213,13 @@ STRINGMAP_CLASS_BEGIN(Graphics, Graphics::ArcMode, Graphics::ARC_MAX_ENUM, arcMo
 }
 STRINGMAP_CLASS_END(Graphics, Graphics::ArcMode, Graphics::ARC_MAX_ENUM, arcMode)
 
+STRINGMAP_CLASS_BEGIN(Graphics, Graphics::FillRule, Graphics::FILL_RULE_MAX_ENUM, fillRule)
+{
+	{ "evenodd", Graphics::FILL_RULE_EVENODD },
+	{ "nonzero", Graphics::FILL_RULE_NONZERO },
+}
+STRINGMAP_CLASS_END(Graphics, Graphics::FillRule, Graphics::FILL_RULE_MAX_ENUM, fillRule)
+
 STRINGMAP_CLASS_BEGIN(Graphics, Graphics::LineStyle, Graphics::LINE_MAX_ENUM, lineStyle)
 {
 	{ "smooth", Graphics::LINE_SMOOTH },
@@ -2997,6 +3283,7 @@ STRINGMAP_BEGIN(Renderer, RENDERER_MAX_ENUM, renderer)
 	{ "opengl", RENDERER_OPENGL },
 	{ "vulkan", RENDERER_VULKAN },
 	{ "metal",  RENDERER_METAL  },
+	{ "none",   RENDERER_NONE   },
 }
 STRINGMAP_END(Renderer, RENDERER_MAX_ENUM, renderer)
 
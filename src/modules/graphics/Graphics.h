@@ -41,12 +41,14 @@
 #include "Deprecations.h"
 #include "renderstate.h"
 #include "math/Transform.h"
+#include "math/BezierCurve.h"
 #include "font/Rasterizer.h"
 #include "font/Font.h"
 #include "video/VideoStream.h"
 #include "data/HashFunction.h"
 
 // C++
+#include <list>
 #include <string>
 #include <vector>
 
@@ -133,6 +135,13 @@ class Graphics : public Module
 		ARC_MAX_ENUM
 	};
 
+	enum FillRule
+	{
+		FILL_RULE_EVENODD,
+		FILL_RULE_NONZERO,
+		FILL_RULE_MAX_ENUM
+	};
+
 	enum LineStyle
 	{
 		LINE_ROUGH,
@@ -232,6 +241,20 @@ class Graphics : public Module
 		int64 bufferMemory;
 	};
 
+	// Per-frame totals from renderers which record commands rather than
+	// submitting them to a GPU. Indexed draws count one vertex per index.
+	struct RecordingStats
+	{
+		int64 frame = 0;
+		int commands = 0;
+		int drawCalls = 0;
+		int batches = 0;
+		int stateChanges = 0;
+		int64 vertices = 0;
+		int64 indices = 0;
+		int64 uploadBytes = 0;
+	};
+
 	struct DrawCommand
 	{
 		PrimitiveType primitiveType = PRIMITIVE_TRIANGLES;
@@ -292,6 +315,12 @@ class Graphics : public Module
 		CommonFormat formats[2];
 		TriangleIndexMode indexMode = TRIANGLEINDEX_NONE;
 		int vertexCount = 0;
+
+		// Optional explicit triangle indices, relative to the first vertex of
+		// this command. Used instead of indexMode when non-null.
+		const uint32 *indices = nullptr;
+		int indexCount = 0;
+
 		Texture *texture = nullptr;
 		Shader::StandardShader standardShaderType = Shader::STANDARD_DEFAULT;
 
@@ -531,7 +560,7 @@ class Graphics : public Module
 	 * Normally the module will always be active as long as a window exists, it
 	 * may be different on some platforms (especially mobile ones.)
 	 **/
-	bool isActive() const;
+	virtual bool isActive() const;
 
 	/**
 	 * True if a graphics viewport is set.
@@ -818,6 +847,27 @@ class Graphics : public Module
 	 **/
 	void polygon(DrawMode mode, const Vector2 *vertices, size_t count, bool skipLastFilledVertex = true);
 
+	/**
+	 * Fills an arbitrary (possibly concave) polygon with optional holes. The
+	 * triangulation is cached, so redrawing the same shape is cheap.
+	 * @param vertices The outer ring followed by the vertices of each hole.
+	 *        Rings are implicitly closed.
+	 * @param count Total number of vertices.
+	 * @param holeStarts The index into vertices at which each hole begins.
+	 * @param rule How overlapping rings decide what is inside the polygon.
+	 **/
+	void fillPolygon(const Vector2 *vertices, size_t count, const std::vector<size_t> &holeStarts, FillRule rule);
+
+	/**
+	 * Draws Bezier curves as lines. Each curve is flattened only as finely as
+	 * the current transform needs, and all of them go through the batched
+	 * vertex stream, so many curves can share a single draw call.
+	 * @param curves The curves to draw.
+	 * @param count Number of curves.
+	 * @param tolerance Maximum distance in pixels between a curve and its line.
+	 **/
+	void curves(math::BezierCurve * const *curves, size_t count, float tolerance);
+
 	/**
 	 * Gets the graphics capabilities (feature support, limit values, and
 	 * supported texture types) of this system.
@@ -856,6 +906,12 @@ class Graphics : public Module
 	 **/
 	Stats getStats() const;
 
+	/**
+	 * Gets the totals recorded for the most recently presented frame. Returns
+	 * false if the active renderer doesn't record its commands.
+	 **/
+	virtual bool getRecordingStats(RecordingStats &/*stats*/) const { return false; }
+
 	size_t getStackDepth() const;
 	void push(StackType type = STACK_TRANSFORM);
 	void pop();
@@ -918,6 +974,7 @@ class Graphics : public Module
 
 	STRINGMAP_CLASS_DECLARE(DrawMode);
 	STRINGMAP_CLASS_DECLARE(ArcMode);
+	STRINGMAP_CLASS_DECLARE(FillRule);
 	STRINGMAP_CLASS_DECLARE(LineStyle);
 	STRINGMAP_CLASS_DECLARE(LineJoin);
 	STRINGMAP_CLASS_DECLARE(Feature);
@@ -1097,15 +1154,43 @@ class Graphics : public Module
 
 private:
 
+	struct PolygonTriangulation
+	{
+		std::vector<Vector2> vertices;
+		std::vector<size_t> holeStarts;
+		FillRule rule;
+
+		// Indices into vertices, or explicit triangle vertices when the rings
+		// cross each other and new vertices had to be added.
+		std::vector<uint32> indices;
+		std::vector<Vector2> triangles;
+
+		// Position of this triangulation's key in polygonTriangulationOrder.
+		std::list<uint64>::iterator orderPosition;
+	};
+
 	void checkSetDefaultFont();
 	int calculateEllipsePoints(float rx, float ry) const;
 
+	const PolygonTriangulation &getPolygonTriangulation(const Vector2 *vertices, size_t count, const std::vector<size_t> &holeStarts, FillRule rule);
+	static void triangulatePolygon(const Vector2 *vertices, size_t count, const std::vector<size_t> &holeStarts, FillRule rule, PolygonTriangulation &result);
+
 	Texture *defaultTextures[TEXTURE_MAX_ENUM][DATA_BASETYPE_MAX_ENUM][2];
 	Buffer *defaultTexelBuffers[DATA_BASETYPE_MAX_ENUM];
 	Buffer *defaultStorageBuffer;
 
 	std::vector<uint8> scratchBuffer;
 
+	// Triangulations of recently filled polygons, keyed on a hash of their
+	// vertices. The keys are also kept from most to least recently used.
+	std::unordered_map<uint64, PolygonTriangulation> polygonTriangulations;
+	std::list<uint64> polygonTriangulationOrder;
+	PolygonTriangulation polygonScratchTriangulation;
+	size_t polygonTriangulationVertexCount = 0;
+
+	static const size_t MAX_CACHED_POLYGONS = 256;
+	static const size_t MAX_CACHED_POLYGON_VERTICES = 1 << 18;
+
 	std::unordered_map<std::string, ShaderStage *> cachedShaderStages[SHADERSTAGE_MAX_ENUM];
 
 	std::vector<VertexAttributes> vertexAttributesDatabase;
@@ -24,11 +24,20 @@
 #include "common/Exception.h"
 #include "Shader.h"
 #include "Graphics.h"
+#include "thread/ThreadPool.h"
 
 // C++
 #include <algorithm>
 #include <limits>
 
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace love
 {
 namespace graphics
@@ -660,6 +669,259 @@ bool Mesh::getDrawRange(int &start, int &count) const
 	return true;
 }
 
+static const Buffer::DataMember &getSkinningAttribute(const std::vector<Buffer::DataMember> &format, const std::string &name)
+{
+	for (const Buffer::DataMember &member : format)
+	{
+		if (member.decl.name == name)
+			return member;
+	}
+
+	throw love::Exception("Mesh does not have a vertex attribute named '%s' in its own vertex format.", name.c_str());
+}
+
+/**
+ * Reads the first 4 components of a vertex attribute as floats. Missing
+ * components are 0.
+ **/
+static void readSkinningAttribute(const uint8 *vertex, const Buffer::DataMember &member, float out[4])
+{
+	const DataFormatInfo &info = member.info;
+	const uint8 *src = vertex + member.offset;
+
+	for (int i = 0; i < 4; i++)
+	{
+		out[i] = 0.0f;
+		if (i >= info.components)
+			continue;
+
+		const uint8 *c = src + i * info.componentSize;
+
+		if (info.baseType == DATA_BASETYPE_FLOAT)
+		{
+			float v;
+			memcpy(&v, c, sizeof(float));
+			out[i] = v;
+		}
+		else if (info.baseType == DATA_BASETYPE_INT)
+		{
+			if (info.componentSize == 1) { int8 v; memcpy(&v, c, 1); out[i] = v; }
+			else if (info.componentSize == 2) { int16 v; memcpy(&v, c, 2); out[i] = v; }
+			else { int32 v; memcpy(&v, c, 4); out[i] = (float) v; }
+		}
+		else if (info.baseType == DATA_BASETYPE_UINT)
+		{
+			if (info.componentSize == 1) { uint8 v; memcpy(&v, c, 1); out[i] = v; }
+			else if (info.componentSize == 2) { uint16 v; memcpy(&v, c, 2); out[i] = v; }
+			else { uint32 v; memcpy(&v, c, 4); out[i] = (float) v; }
+		}
+		else if (info.baseType == DATA_BASETYPE_UNORM)
+		{
+			if (info.componentSize == 1) { uint8 v; memcpy(&v, c, 1); out[i] = v / 255.0f; }
+			else { uint16 v; memcpy(&v, c, 2); out[i] = v / 65535.0f; }
+		}
+	}
+}
+
+void Mesh::setSkinning(const std::string &bonesattrib, const std::string &weightsattrib, const std::string &posattrib)
+{
+	if (vertexData == nullptr)
+		throw love::Exception("Mesh must own its own vertex buffer.");
+
+	const Buffer::DataMember &bones = getSkinningAttribute(vertexFormat, bonesattrib);
+	const Buffer::DataMember &weights = getSkinningAttribute(vertexFormat, weightsattrib);
+	const Buffer::DataMember &pos = getSkinningAttribute(vertexFormat, posattrib);
+
+	const DataFormatInfo &bonesinfo = bones.info;
+	const DataFormatInfo &weightsinfo = weights.info;
+	const DataFormatInfo &posinfo = pos.info;
+
+	if (bonesinfo.isMatrix || bonesinfo.components > 4
+		|| !(bonesinfo.baseType == DATA_BASETYPE_INT || bonesinfo.baseType == DATA_BASETYPE_UINT
+		|| (bonesinfo.baseType == DATA_BASETYPE_FLOAT && bonesinfo.componentSize == 4)))
+		throw love::Exception("Bone index vertex attribute '%s' must have up to 4 integer or float components.", bonesattrib.c_str());
+
+	if (weightsinfo.isMatrix || weightsinfo.components != bonesinfo.components
+		|| !(weightsinfo.baseType == DATA_BASETYPE_UNORM
+		|| (weightsinfo.baseType == DATA_BASETYPE_FLOAT && weightsinfo.componentSize == 4)))
+		throw love::Exception("Bone weight vertex attribute '%s' must have one unorm or float component per bone index.", weightsattrib.c_str());
+
+	if (posinfo.isMatrix || posinfo.components < 2 || posinfo.baseType != DATA_BASETYPE_FLOAT || posinfo.componentSize != 4)
+		throw love::Exception("Skinned position vertex attribute '%s' must have 2 to 4 float components.", posattrib.c_str());
+
+	std::unique_ptr<Skinning> s(new Skinning());
+
+	s->bonesAttribute = bonesattrib;
+	s->weightsAttribute = weightsattrib;
+	s->positionAttribute = posattrib;
+	s->positionOffset = pos.offset;
+	s->positionComponents = posinfo.components;
+
+	s->restPositions.resize(vertexCount * 3);
+	s->bones.resize(vertexCount * 4);
+	s->weights.resize(vertexCount * 4);
+
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const uint8 *vertex = vertexData + i * vertexStride;
+
+		float p[4];
+		readSkinningAttribute(vertex, pos, p);
+		for (int c = 0; c < 3; c++)
+			s->restPositions[i * 3 + c] = p[c];
+
+		float b[4];
+		float w[4];
+		readSkinningAttribute(vertex, bones, b);
+		readSkinningAttribute(vertex, weights, w);
+
+		for (int j = 0; j < 4; j++)
+		{
+			// Unused influences don't count towards the bone count.
+			if (w[j] == 0.0f)
+				continue;
+
+			if (b[j] < 0.0f || b[j] > (float) std::numeric_limits<uint16>::max())
+				throw love::Exception("Invalid bone index %d for vertex %d.", (int) b[j], (int) i + 1);
+
+			s->bones[i * 4 + j] = (uint16) b[j];
+			s->weights[i * 4 + j] = w[j];
+			s->boneCount = std::max(s->boneCount, (int) b[j] + 1);
+		}
+	}
+
+	skinning = std::move(s);
+}
+
+void Mesh::setSkinning()
+{
+	skinning.reset();
+}
+
+bool Mesh::getSkinning(std::string &bonesattrib, std::string &weightsattrib, std::string &posattrib) const
+{
+	if (skinning == nullptr)
+		return false;
+
+	bonesattrib = skinning->bonesAttribute;
+	weightsattrib = skinning->weightsAttribute;
+	posattrib = skinning->positionAttribute;
+	return true;
+}
+
+int Mesh::getSkinningBoneCount() const
+{
+	return skinning != nullptr ? skinning->boneCount : 0;
+}
+
+/**
+ * Blends the weighted bone matrices, then transforms the rest position by the
+ * blended matrix. Only the first 3 components of the output are meaningful.
+ **/
+static inline void skinVertex(const Matrix4 *bones, const uint16 *indices, const float *weights, const float *rest, float out[4])
+{
+#if defined(LOVE_SIMD_SSE)
+
+	__m128 col1 = _mm_setzero_ps();
+	__m128 col2 = _mm_setzero_ps();
+	__m128 col3 = _mm_setzero_ps();
+	__m128 col4 = _mm_setzero_ps();
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (weights[i] == 0.0f)
+			continue;
+
+		const float *e = bones[indices[i]].getElements();
+		__m128 w = _mm_set1_ps(weights[i]);
+
+		col1 = _mm_add_ps(col1, _mm_mul_ps(w, _mm_loadu_ps(&e[0])));
+		col2 = _mm_add_ps(col2, _mm_mul_ps(w, _mm_loadu_ps(&e[4])));
+		col3 = _mm_add_ps(col3, _mm_mul_ps(w, _mm_loadu_ps(&e[8])));
+		col4 = _mm_add_ps(col4, _mm_mul_ps(w, _mm_loadu_ps(&e[12])));
+	}
+
+	__m128 result = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(col1, _mm_set1_ps(rest[0])), _mm_mul_ps(col2, _mm_set1_ps(rest[1]))),
+		_mm_add_ps(_mm_mul_ps(col3, _mm_set1_ps(rest[2])), col4)
+	);
+
+	_mm_storeu_ps(out, result);
+
+#elif defined(LOVE_SIMD_NEON)
+
+	float32x4_t col1 = vdupq_n_f32(0.0f);
+	float32x4_t col2 = vdupq_n_f32(0.0f);
+	float32x4_t col3 = vdupq_n_f32(0.0f);
+	float32x4_t col4 = vdupq_n_f32(0.0f);
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (weights[i] == 0.0f)
+			continue;
+
+		const float *e = bones[indices[i]].getElements();
+
+		col1 = vmlaq_n_f32(col1, vld1q_f32(&e[0]), weights[i]);
+		col2 = vmlaq_n_f32(col2, vld1q_f32(&e[4]), weights[i]);
+		col3 = vmlaq_n_f32(col3, vld1q_f32(&e[8]), weights[i]);
+		col4 = vmlaq_n_f32(col4, vld1q_f32(&e[12]), weights[i]);
+	}
+
+	float32x4_t result = vmlaq_n_f32(col4, col1, rest[0]);
+	result = vmlaq_n_f32(result, col2, rest[1]);
+	result = vmlaq_n_f32(result, col3, rest[2]);
+
+	vst1q_f32(out, result);
+
+#else
+
+	float m[16] = {};
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (weights[i] == 0.0f)
+			continue;
+
+		const float *e = bones[indices[i]].getElements();
+		for (int j = 0; j < 16; j++)
+			m[j] += weights[i] * e[j];
+	}
+
+	for (int j = 0; j < 4; j++)
+		out[j] = m[j] * rest[0] + m[4 + j] * rest[1] + m[8 + j] * rest[2] + m[12 + j];
+
+#endif
+}
+
+void Mesh::skin(const Matrix4 *bones, size_t bonecount)
+{
+	if (skinning == nullptr)
+		throw love::Exception("Mesh skinning must be set up before skinning the Mesh.");
+
+	if ((size_t) skinning->boneCount > bonecount)
+		throw love::Exception("Mesh skinning uses %d bones, but only %d bone matrices were given.", skinning->boneCount, (int) bonecount);
+
+	const Skinning &s = *skinning;
+	uint8 *positions = vertexData + s.positionOffset;
+	size_t stride = vertexStride;
+
+	// A 4-component position keeps its original w.
+	size_t possize = sizeof(float) * std::min(s.positionComponents, 3);
+
+	love::thread::ThreadPool::getShared()->parallelFor(vertexCount, 1 << 11, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			float p[4];
+			skinVertex(bones, &s.bones[i * 4], &s.weights[i * 4], &s.restPositions[i * 3], p);
+			memcpy(positions + i * stride, p, possize);
+		}
+	});
+
+	setVertexDataModified(0, vertexCount * vertexStride);
+}
+
 void Mesh::updateVertexAttributes(Graphics *gfx)
 {
 	VertexAttributes attributes;
@@ -34,6 +34,7 @@
 // C++
 #include <vector>
 #include <unordered_map>
+#include <memory>
 
 namespace love
 {
@@ -179,6 +180,29 @@ class Mesh : public Drawable
 	void setDrawRange();
 	bool getDrawRange(int &start, int &count) const;
 
+	/**
+	 * Enables skinning on the CPU. The current contents of the position
+	 * attribute become the rest pose, and each vertex's bone indices and
+	 * weights (up to 4 of each) are read from the given attributes. All three
+	 * attributes must be in the Mesh's own vertex format. Changes made to them
+	 * afterwards only take effect once skinning is set up again.
+	 **/
+	void setSkinning(const std::string &bonesattrib, const std::string &weightsattrib, const std::string &posattrib);
+	void setSkinning();
+	bool getSkinning(std::string &bonesattrib, std::string &weightsattrib, std::string &posattrib) const;
+
+	/**
+	 * Gets the number of bone matrices skin() needs: the highest bone index
+	 * with a non-zero weight, plus one.
+	 **/
+	int getSkinningBoneCount() const;
+
+	/**
+	 * Overwrites the position of every vertex with its rest position
+	 * transformed by the weighted sum of its bones' matrices.
+	 **/
+	void skin(const Matrix4 *bones, size_t bonecount);
+
 	// Implements Drawable.
 	void draw(Graphics *gfx, const Matrix4 &m) override;
 
@@ -200,6 +224,22 @@ class Mesh : public Drawable
 
 	void drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buffer *indirectargs, int argsindex);
 
+	struct Skinning
+	{
+		std::string bonesAttribute;
+		std::string weightsAttribute;
+		std::string positionAttribute;
+
+		size_t positionOffset = 0;
+		int positionComponents = 0;
+		int boneCount = 0;
+
+		// 3 floats per vertex, then 4 influences per vertex.
+		std::vector<float> restPositions;
+		std::vector<uint16> bones;
+		std::vector<float> weights;
+	};
+
 	std::vector<Buffer::DataMember> vertexFormat;
 
 	std::vector<BufferAttribute> attachedAttributes;
@@ -230,6 +270,8 @@ class Mesh : public Drawable
 
 	BufferBindings bufferBindings;
 
+	std::unique_ptr<Skinning> skinning;
+
 }; // Mesh
 
 } // graphics
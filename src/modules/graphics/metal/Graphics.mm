@@ -28,6 +28,7 @@
 #include "window/Window.h"
 #include "image/Image.h"
 #include "common/memory.h"
+#include "common/profiler.h"
 
 #import <QuartzCore/CAMetalLayer.h>
 
@@ -1657,6 +1658,8 @@ void Graphics::present(void *screenshotCallbackData)
 	if (isRenderTargetActive())
 		throw love::Exception("present cannot be called while a render target is active.");
 
+	LOVE_PROFILE_ZONE("Graphics::present");
+
 	deprecations.draw(this);
 
 	// endPass calls useRenderEncoder, which makes sure activeDrawable is set
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Buffer.h"
+#include "Graphics.h"
+
+#include "common/Exception.h"
+
+// C
+#include <cstdlib>
+#include <cstring>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+Buffer::Buffer(love::graphics::Graphics *gfx, const Settings &settings, const std::vector<DataDeclaration> &format, const void *data, size_t size, size_t arraylength)
+	: love::graphics::Buffer(gfx, settings, format, size, arraylength)
+	, memory(nullptr)
+{
+	// Zero-initialized regardless of settings.zeroInitialize, since readbacks
+	// and indirect arguments are served straight from this memory.
+	memory = (uint8 *) calloc(getSize(), 1);
+	if (memory == nullptr)
+		throw love::Exception("Could not create buffer with %d bytes (out of memory?)", (int) getSize());
+
+	if (data != nullptr)
+	{
+		memcpy(memory, data, getSize());
+		((Graphics *) gfx)->recordUpload(getSize());
+	}
+}
+
+Buffer::~Buffer()
+{
+	free(memory);
+}
+
+void *Buffer::getData(size_t offset, size_t size) const
+{
+	if (!Range(0, getSize()).contains(Range(offset, size)))
+		return nullptr;
+
+	return memory + offset;
+}
+
+void *Buffer::map(MapType map, size_t offset, size_t size)
+{
+	if (size == 0)
+		return nullptr;
+
+	if (map == MAP_WRITE_INVALIDATE && (isImmutable() || dataUsage == BUFFERDATAUSAGE_READBACK))
+		return nullptr;
+
+	if (map == MAP_READ_ONLY && dataUsage != BUFFERDATAUSAGE_READBACK)
+		return nullptr;
+
+	Range r(offset, size);
+
+	if (!Range(0, getSize()).contains(r))
+		return nullptr;
+
+	mapped = true;
+	mappedType = map;
+	mappedRange = r;
+
+	return memory + offset;
+}
+
+void Buffer::unmap(size_t usedoffset, size_t usedsize)
+{
+	Range r(usedoffset, usedsize);
+
+	if (!mapped || !mappedRange.contains(r))
+		return;
+
+	mapped = false;
+
+	// The data was written in place, only the transfer needs to be accounted
+	// for.
+	if (mappedType != MAP_READ_ONLY && usedsize > 0)
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		if (gfx != nullptr)
+			gfx->recordUpload(usedsize);
+	}
+}
+
+bool Buffer::fill(size_t offset, size_t size, const void *data)
+{
+	if (size == 0 || isImmutable() || dataUsage == BUFFERDATAUSAGE_READBACK)
+		return false;
+
+	if (!Range(0, getSize()).contains(Range(offset, size)))
+		return false;
+
+	memcpy(memory + offset, data, size);
+
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordUpload(size);
+
+	return true;
+}
+
+void Buffer::clearInternal(size_t offset, size_t size)
+{
+	memset(memory + offset, 0, size);
+}
+
+void Buffer::copyTo(love::graphics::Buffer *dest, size_t sourceoffset, size_t destoffset, size_t size)
+{
+	// Higher level code does validation.
+	memmove(((Buffer *) dest)->memory + destoffset, memory + sourceoffset, size);
+
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordCopy(size);
+}
+
+} // none
+} // graphics
+} // love
@@ -0,0 +1,656 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "common/config.h"
+#include "common/profiler.h"
+#include "Graphics.h"
+#include "Buffer.h"
+#include "GraphicsReadback.h"
+#include "Shader.h"
+#include "ShaderStage.h"
+#include "StreamBuffer.h"
+#include "Texture.h"
+
+#include "window/Window.h"
+#include "image/Image.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+love::graphics::Graphics *createInstance()
+{
+	love::graphics::Graphics *instance = nullptr;
+
+	try
+	{
+		instance = new Graphics();
+	}
+	catch (love::Exception &e)
+	{
+		printf("Cannot create headless renderer: %s\n", e.what());
+	}
+
+	return instance;
+}
+
+Graphics::Graphics()
+	: love::graphics::Graphics("love.graphics.none")
+	, headless(false)
+	, requestedBackbufferMSAA(0)
+	, shaderSwitches(0)
+	, frameStats()
+	, lastFrameStats()
+{
+	auto window = getInstance<love::window::Window>(M_WINDOW);
+
+	if (window != nullptr)
+	{
+		window->setGraphics(this);
+
+		// Recreate the window using the current renderer, if needed.
+		if (window->isOpen())
+		{
+			int w, h;
+			love::window::WindowSettings settings;
+			window->getWindow(w, h, settings);
+			window->setWindow(w, h, &settings);
+		}
+	}
+
+	// Nothing here needs a window, so use a default-sized backbuffer until one
+	// is opened. This lets scenes run without any video driver at all.
+	if (!isCreated())
+	{
+		setMode(nullptr, 800, 600, 800, 600, true, true, 0);
+		headless = true;
+	}
+}
+
+Graphics::~Graphics()
+{
+}
+
+love::graphics::StreamBuffer *Graphics::newStreamBuffer(BufferUsage type, size_t size)
+{
+	return new StreamBuffer(type, size);
+}
+
+love::graphics::Texture *Graphics::newTexture(const Texture::Settings &settings, const Texture::Slices *data)
+{
+	return new Texture(this, settings, data);
+}
+
+love::graphics::Texture *Graphics::newTextureView(love::graphics::Texture *base, const Texture::ViewSettings &viewsettings)
+{
+	return new Texture(this, base, viewsettings);
+}
+
+love::graphics::ShaderStage *Graphics::newShaderStageInternal(ShaderStageType stage, const std::string &cachekey, const std::string &source, bool gles)
+{
+	return new ShaderStage(this, stage, source, gles, cachekey);
+}
+
+love::graphics::Shader *Graphics::newShaderInternal(StrongRef<love::graphics::ShaderStage> stages[SHADERSTAGE_MAX_ENUM], const Shader::CompileOptions &options)
+{
+	return new Shader(stages, options);
+}
+
+love::graphics::Buffer *Graphics::newBuffer(const Buffer::Settings &settings, const std::vector<Buffer::DataDeclaration> &format, const void *data, size_t size, size_t arraylength)
+{
+	return new Buffer(this, settings, format, data, size, arraylength);
+}
+
+love::graphics::GraphicsReadback *Graphics::newReadbackInternal(ReadbackMethod method, love::graphics::Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset)
+{
+	return new GraphicsReadback(this, method, buffer, offset, size, dest, destoffset);
+}
+
+love::graphics::GraphicsReadback *Graphics::newReadbackInternal(ReadbackMethod method, love::graphics::Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty)
+{
+	return new GraphicsReadback(this, method, texture, slice, mipmap, rect, dest, destx, desty);
+}
+
+void Graphics::backbufferChanged(int width, int height, int pixelwidth, int pixelheight, bool backbufferstencil, bool backbufferdepth, int msaa)
+{
+	this->width = width;
+	this->height = height;
+	this->pixelWidth = pixelwidth;
+	this->pixelHeight = pixelheight;
+
+	this->backbufferHasStencil = backbufferstencil;
+	this->backbufferHasDepth = backbufferdepth;
+	this->requestedBackbufferMSAA = msaa;
+
+	if (!isRenderTargetActive())
+		resetProjection();
+}
+
+bool Graphics::setMode(void */*context*/, int width, int height, int pixelwidth, int pixelheight, bool backbufferstencil, bool backbufferdepth, int msaa)
+{
+	// A window opened after startup replaces the headless backbuffer.
+	if (isCreated())
+		unSetMode();
+
+	headless = false;
+
+	created = true;
+	initCapabilities();
+
+	backbufferChanged(width, height, pixelwidth, pixelheight, backbufferstencil, backbufferdepth, msaa);
+
+	if (batchedDrawState.vb[0] == nullptr)
+	{
+		// Same initial sizes as the other renderers, so batching behaves the
+		// same way.
+		batchedDrawState.vb[0] = newStreamBuffer(BUFFERUSAGE_VERTEX, 1024 * 1024 * 1);
+		batchedDrawState.vb[1] = newStreamBuffer(BUFFERUSAGE_VERTEX, 256  * 1024 * 1);
+		batchedDrawState.indexBuffer = newStreamBuffer(BUFFERUSAGE_INDEX, sizeof(uint16) * LOVE_UINT16_MAX);
+	}
+
+	createQuadIndexBuffer();
+
+	// Restore the graphics state.
+	restoreState(states.back());
+
+	// We always need a default shader.
+	for (int i = 0; i < Shader::STANDARD_MAX_ENUM; i++)
+	{
+		auto stype = (Shader::StandardShader) i;
+
+		if (!Shader::standardShaders[i])
+		{
+			std::vector<std::string> stages;
+			Shader::CompileOptions opts;
+			stages.push_back(Shader::getDefaultCode(stype, SHADERSTAGE_VERTEX));
+			stages.push_back(Shader::getDefaultCode(stype, SHADERSTAGE_PIXEL));
+			Shader::standardShaders[i] = newShader(stages, opts);
+		}
+	}
+
+	// A shader should always be active, but the default shader shouldn't be
+	// returned by getShader(), so we don't do setShader(defaultShader).
+	if (!Shader::current)
+		Shader::standardShaders[Shader::STANDARD_DEFAULT]->attach();
+
+	return true;
+}
+
+void Graphics::unSetMode()
+{
+	if (!isCreated())
+		return;
+
+	flushBatchedDraws();
+	clearTemporaryResources();
+
+	created = false;
+}
+
+void Graphics::setActive(bool enable)
+{
+	flushBatchedDraws();
+	active = enable;
+}
+
+bool Graphics::isActive() const
+{
+	// There's no context to lose, so a window is optional.
+	return active && isCreated();
+}
+
+void Graphics::record(CommandType type, int64 count, PrimitiveType primtype, int instances)
+{
+	Command cmd;
+	cmd.type = type;
+	cmd.primitiveType = primtype;
+	cmd.count = count;
+	cmd.instances = instances;
+	cmd.batched = batchedDrawState.flushing;
+
+	frameCommands.push_back(cmd);
+	frameStats.commands++;
+}
+
+void Graphics::recordDraw(CommandType type, PrimitiveType primtype, int64 vertexcount, int64 indexcount, int instances)
+{
+	instances = std::max(instances, 1);
+
+	record(type, indexcount > 0 ? indexcount : vertexcount, primtype, instances);
+
+	frameStats.drawCalls++;
+	if (batchedDrawState.flushing)
+		frameStats.batches++;
+
+	frameStats.vertices += vertexcount * instances;
+	frameStats.indices += indexcount * instances;
+
+	++drawCalls;
+}
+
+void Graphics::recordUpload(size_t size)
+{
+	record(COMMAND_UPLOAD, (int64) size);
+	frameStats.uploadBytes += (int64) size;
+}
+
+void Graphics::recordCopy(size_t size)
+{
+	record(COMMAND_COPY, (int64) size);
+}
+
+void Graphics::recordShaderSwitch()
+{
+	record(COMMAND_SET_SHADER);
+	frameStats.stateChanges++;
+	++shaderSwitches;
+}
+
+bool Graphics::dispatch(love::graphics::Shader */*shader*/, int x, int y, int z)
+{
+	record(COMMAND_DISPATCH, (int64) x * y * z);
+	return true;
+}
+
+bool Graphics::dispatch(love::graphics::Shader */*shader*/, love::graphics::Buffer *indirectargs, size_t argsoffset)
+{
+	const uint32 *args = (const uint32 *) ((Buffer *) indirectargs)->getData(argsoffset, sizeof(uint32) * 3);
+	record(COMMAND_DISPATCH, args != nullptr ? (int64) args[0] * args[1] * args[2] : 0);
+	return true;
+}
+
+void Graphics::draw(const DrawCommand &cmd)
+{
+	int64 vertexcount = cmd.vertexCount;
+	int instances = cmd.instanceCount;
+
+	// Indirect arguments are plain memory here, so the real counts are known.
+	// Layout: vertex count, instance count, first vertex, base instance.
+	if (cmd.indirectBuffer != nullptr)
+	{
+		const uint32 *args = (const uint32 *) ((Buffer *) cmd.indirectBuffer)->getData(cmd.indirectBufferOffset, sizeof(uint32) * 4);
+		vertexcount = args != nullptr ? args[0] : 0;
+		instances = args != nullptr ? (int) args[1] : 0;
+	}
+
+	recordDraw(COMMAND_DRAW, cmd.primitiveType, vertexcount, 0, instances);
+}
+
+void Graphics::draw(const DrawIndexedCommand &cmd)
+{
+	int64 indexcount = cmd.indexCount;
+	int instances = cmd.instanceCount;
+
+	// Layout: index count, instance count, first index, base vertex, base
+	// instance.
+	if (cmd.indirectBuffer != nullptr)
+	{
+		const uint32 *args = (const uint32 *) ((Buffer *) cmd.indirectBuffer)->getData(cmd.indirectBufferOffset, sizeof(uint32) * 5);
+		indexcount = args != nullptr ? args[0] : 0;
+		instances = args != nullptr ? (int) args[1] : 0;
+	}
+
+	// Every index fetches a vertex, so indexed draws count one vertex per
+	// index.
+	recordDraw(COMMAND_DRAW_INDEXED, cmd.primitiveType, indexcount, indexcount, instances);
+}
+
+void Graphics::drawQuads(int /*start*/, int count, VertexAttributesID /*attributesID*/, const BufferBindings &/*buffers*/, love::graphics::Texture */*texture*/)
+{
+	const int MAX_VERTICES_PER_DRAW = LOVE_UINT16_MAX;
+	const int MAX_QUADS_PER_DRAW    = MAX_VERTICES_PER_DRAW / 4;
+
+	// Split the same way the GPU renderers do, so draw call counts match.
+	for (int quadindex = 0; quadindex < count; quadindex += MAX_QUADS_PER_DRAW)
+	{
+		int quadcount = std::min(MAX_QUADS_PER_DRAW, count - quadindex);
+		recordDraw(COMMAND_DRAW_QUADS, PRIMITIVE_TRIANGLES, quadcount * 4, quadcount * 6, 1);
+	}
+}
+
+void Graphics::setRenderTargetsInternal(const RenderTargets &rts, int /*pixelw*/, int /*pixelh*/, bool /*hasSRGBtexture*/)
+{
+	record(COMMAND_SET_RENDER_TARGETS, (int64) rts.colors.size());
+}
+
+void Graphics::clear(OptionalColorD c, OptionalInt stencil, OptionalDouble depth)
+{
+	if (!c.hasValue && !stencil.hasValue && !depth.hasValue)
+		return;
+
+	flushBatchedDraws();
+	record(COMMAND_CLEAR, c.hasValue ? 1 : 0);
+}
+
+void Graphics::clear(const std::vector<OptionalColorD> &colors, OptionalInt stencil, OptionalDouble depth)
+{
+	if (colors.size() == 0 && !stencil.hasValue && !depth.hasValue)
+		return;
+
+	flushBatchedDraws();
+	record(COMMAND_CLEAR, (int64) colors.size());
+}
+
+void Graphics::discard(const std::vector<bool> &colorbuffers, bool /*depthstencil*/)
+{
+	flushBatchedDraws();
+	record(COMMAND_DISCARD, (int64) colorbuffers.size());
+}
+
+void Graphics::present(void *screenshotCallbackData)
+{
+	if (!isActive())
+		return;
+
+	if (isRenderTargetActive())
+		throw love::Exception("present cannot be called while a render target is active.");
+
+	LOVE_PROFILE_ZONE("Graphics::present");
+
+	deprecations.draw(this);
+
+	flushBatchedDraws();
+
+	if (!pendingScreenshotCallbacks.empty())
+	{
+		// Nothing is rasterized, so screenshots are transparent black at the
+		// backbuffer's size.
+		auto imagemodule = Module::getInstance<love::image::Image>(M_IMAGE);
+		int w = getPixelWidth();
+		int h = getPixelHeight();
+
+		for (int i = 0; i < (int) pendingScreenshotCallbacks.size(); i++)
+		{
+			const auto &info = pendingScreenshotCallbacks[i];
+			image::ImageData *img = nullptr;
+
+			try
+			{
+				img = imagemodule->newImageData(w, h, PIXELFORMAT_RGBA8_UNORM);
+			}
+			catch (love::Exception &)
+			{
+				info.callback(&info, nullptr, nullptr);
+				for (int j = i + 1; j < (int) pendingScreenshotCallbacks.size(); j++)
+				{
+					const auto &ninfo = pendingScreenshotCallbacks[j];
+					ninfo.callback(&ninfo, nullptr, nullptr);
+				}
+				pendingScreenshotCallbacks.clear();
+				throw;
+			}
+
+			info.callback(&info, img, screenshotCallbackData);
+			img->release();
+		}
+
+		pendingScreenshotCallbacks.clear();
+	}
+
+	for (love::graphics::StreamBuffer *buffer : batchedDrawState.vb)
+		buffer->nextFrame();
+	batchedDrawState.indexBuffer->nextFrame();
+
+	if (!headless)
+	{
+		auto window = getInstance<love::window::Window>(M_WINDOW);
+		if (window != nullptr)
+			window->swapBuffers();
+	}
+
+	frameStats.frame = lastFrameStats.frame + 1;
+	lastFrameStats = frameStats;
+	frameStats = RecordingStats();
+
+	// Keep the allocation around, frames tend to be similar in size.
+	std::swap(lastFrameCommands, frameCommands);
+	frameCommands.clear();
+
+	// Reset the per-frame stat counts.
+	drawCalls = 0;
+	shaderSwitches = 0;
+	renderTargetSwitchCount = 0;
+	drawCallsBatched = 0;
+
+	updatePendingReadbacks();
+	updateTemporaryResources();
+}
+
+bool Graphics::getRecordingStats(RecordingStats &stats) const
+{
+	stats = lastFrameStats;
+	return true;
+}
+
+int Graphics::getRequestedBackbufferMSAA() const
+{
+	return requestedBackbufferMSAA;
+}
+
+int Graphics::getBackbufferMSAA() const
+{
+	return requestedBackbufferMSAA > 1 ? requestedBackbufferMSAA : 0;
+}
+
+void Graphics::setScissor(const Rect &rect)
+{
+	flushBatchedDraws();
+
+	DisplayState &state = states.back();
+	state.scissor = true;
+	state.scissorRect = rect;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setScissor()
+{
+	if (!states.back().scissor)
+		return;
+
+	flushBatchedDraws();
+	states.back().scissor = false;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setStencilState(const StencilState &s)
+{
+	validateStencilState(s);
+
+	flushBatchedDraws();
+	states.back().stencil = s;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setDepthMode(CompareMode compare, bool write)
+{
+	validateDepthState(write);
+
+	DisplayState &state = states.back();
+
+	if (state.depthTest == compare && state.depthWrite == write)
+		return;
+
+	flushBatchedDraws();
+
+	state.depthTest = compare;
+	state.depthWrite = write;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setFrontFaceWinding(Winding winding)
+{
+	DisplayState &state = states.back();
+
+	if (state.winding == winding)
+		return;
+
+	flushBatchedDraws();
+	state.winding = winding;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setColor(Colorf c)
+{
+	c.r = std::min(std::max(c.r, 0.0f), 1.0f);
+	c.g = std::min(std::max(c.g, 0.0f), 1.0f);
+	c.b = std::min(std::max(c.b, 0.0f), 1.0f);
+	c.a = std::min(std::max(c.a, 0.0f), 1.0f);
+
+	states.back().color = c;
+}
+
+void Graphics::setColorMask(ColorChannelMask mask)
+{
+	flushBatchedDraws();
+	states.back().colorMask = mask;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setBlendState(const BlendState &blend)
+{
+	if (blend == states.back().blend)
+		return;
+
+	flushBatchedDraws();
+	states.back().blend = blend;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+void Graphics::setPointSize(float size)
+{
+	if (size != states.back().pointSize)
+		flushBatchedDraws();
+
+	states.back().pointSize = size;
+}
+
+void Graphics::setWireframe(bool enable)
+{
+	if (enable == states.back().wireframe)
+		return;
+
+	flushBatchedDraws();
+	states.back().wireframe = enable;
+
+	record(COMMAND_SET_STATE);
+	frameStats.stateChanges++;
+}
+
+Renderer Graphics::getRenderer() const
+{
+	return RENDERER_NONE;
+}
+
+bool Graphics::usesGLSLES() const
+{
+	return false;
+}
+
+Graphics::RendererInfo Graphics::getRendererInfo() const
+{
+	RendererInfo info;
+	info.name = "None";
+	info.version = "1.0";
+	info.vendor = "LOVE";
+	info.device = "Command recorder";
+	return info;
+}
+
+void Graphics::getAPIStats(int &shaderswitches) const
+{
+	shaderswitches = this->shaderSwitches;
+}
+
+void Graphics::initCapabilities()
+{
+	// Report a capable desktop GPU, so code paths behave as they would on one.
+	capabilities.features[FEATURE_MULTI_RENDER_TARGET_FORMATS] = true;
+	capabilities.features[FEATURE_CLAMP_ZERO] = true;
+	capabilities.features[FEATURE_CLAMP_ONE] = true;
+	capabilities.features[FEATURE_LIGHTEN] = true;
+	capabilities.features[FEATURE_FULL_NPOT] = true;
+	capabilities.features[FEATURE_PIXEL_SHADER_HIGHP] = true;
+	capabilities.features[FEATURE_SHADER_DERIVATIVES] = true;
+	capabilities.features[FEATURE_GLSL3] = true;
+	capabilities.features[FEATURE_GLSL4] = true;
+	capabilities.features[FEATURE_INSTANCING] = true;
+	capabilities.features[FEATURE_TEXEL_BUFFER] = true;
+	capabilities.features[FEATURE_COPY_TEXTURE_TO_BUFFER] = true;
+	capabilities.features[FEATURE_INDIRECT_DRAW] = true;
+	static_assert(FEATURE_MAX_ENUM == 13, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
+
+	capabilities.limits[LIMIT_POINT_SIZE] = 64;
+	capabilities.limits[LIMIT_TEXTURE_SIZE] = 16384;
+	capabilities.limits[LIMIT_TEXTURE_LAYERS] = 2048;
+	capabilities.limits[LIMIT_VOLUME_TEXTURE_SIZE] = 2048;
+	capabilities.limits[LIMIT_CUBE_TEXTURE_SIZE] = 16384;
+	capabilities.limits[LIMIT_TEXEL_BUFFER_SIZE] = 128 * 1024 * 1024;
+	capabilities.limits[LIMIT_SHADER_STORAGE_BUFFER_SIZE] = 128 * 1024 * 1024;
+	capabilities.limits[LIMIT_THREADGROUPS_X] = 65535;
+	capabilities.limits[LIMIT_THREADGROUPS_Y] = 65535;
+	capabilities.limits[LIMIT_THREADGROUPS_Z] = 65535;
+	capabilities.limits[LIMIT_RENDER_TARGETS] = 8;
+	capabilities.limits[LIMIT_TEXTURE_MSAA] = 8;
+	capabilities.limits[LIMIT_ANISOTROPY] = 16;
+	static_assert(LIMIT_MAX_ENUM == 13, "Graphics::initCapabilities must be updated when adding a new system limit!");
+
+	for (int i = 0; i < TEXTURE_MAX_ENUM; i++)
+		capabilities.textureTypes[i] = true;
+}
+
+bool Graphics::isPixelFormatSupported(PixelFormat format, uint32 usage)
+{
+	uint32 supported = PIXELFORMATUSAGEFLAGS_SAMPLE | PIXELFORMATUSAGEFLAGS_LINEAR;
+
+	if (!isPixelFormatCompressed(format))
+	{
+		supported |= PIXELFORMATUSAGEFLAGS_RENDERTARGET | PIXELFORMATUSAGEFLAGS_BLEND | PIXELFORMATUSAGEFLAGS_MSAA;
+
+		if (!isPixelFormatDepthStencil(format))
+			supported |= PIXELFORMATUSAGEFLAGS_COMPUTEWRITE;
+	}
+
+	return (usage & supported) == usage;
+}
+
+} // none
+} // graphics
+} // love
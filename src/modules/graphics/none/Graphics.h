@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "graphics/Graphics.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+/**
+ * A renderer which doesn't talk to any graphics API. Draws, clears, state
+ * changes and data uploads are recorded into memory instead of being submitted
+ * to a GPU, so CPU-side costs can be measured and per-frame totals reported on
+ * machines without a graphics driver (or a window).
+ **/
+class Graphics final : public love::graphics::Graphics
+{
+public:
+
+	enum CommandType
+	{
+		COMMAND_DRAW,
+		COMMAND_DRAW_INDEXED,
+		COMMAND_DRAW_QUADS,
+		COMMAND_CLEAR,
+		COMMAND_DISCARD,
+		COMMAND_DISPATCH,
+		COMMAND_SET_RENDER_TARGETS,
+		COMMAND_SET_STATE,
+		COMMAND_SET_SHADER,
+		COMMAND_UPLOAD,
+		COMMAND_COPY,
+		COMMAND_MAX_ENUM
+	};
+
+	struct Command
+	{
+		CommandType type;
+		PrimitiveType primitiveType;
+		int64 count; // Vertices or indices for draws, bytes for uploads and copies.
+		int instances;
+		bool batched;
+	};
+
+	Graphics();
+	virtual ~Graphics();
+
+	love::graphics::Texture *newTexture(const Texture::Settings &settings, const Texture::Slices *data = nullptr) override;
+	love::graphics::Texture *newTextureView(love::graphics::Texture *base, const Texture::ViewSettings &viewsettings) override;
+	love::graphics::Buffer *newBuffer(const Buffer::Settings &settings, const std::vector<Buffer::DataDeclaration> &format, const void *data, size_t size, size_t arraylength) override;
+
+	void backbufferChanged(int width, int height, int pixelwidth, int pixelheight, bool backbufferstencil, bool backbufferdepth, int msaa) override;
+	bool setMode(void *context, int width, int height, int pixelwidth, int pixelheight, bool backbufferstencil, bool backbufferdepth, int msaa) override;
+	void unSetMode() override;
+
+	void setActive(bool active) override;
+	bool isActive() const override;
+
+	bool dispatch(love::graphics::Shader *shader, int x, int y, int z) override;
+	bool dispatch(love::graphics::Shader *shader, love::graphics::Buffer *indirectargs, size_t argsoffset) override;
+
+	void draw(const DrawCommand &cmd) override;
+	void draw(const DrawIndexedCommand &cmd) override;
+	void drawQuads(int start, int count, VertexAttributesID attributesID, const BufferBindings &buffers, love::graphics::Texture *texture) override;
+
+	void clear(OptionalColorD color, OptionalInt stencil, OptionalDouble depth) override;
+	void clear(const std::vector<OptionalColorD> &colors, OptionalInt stencil, OptionalDouble depth) override;
+
+	void discard(const std::vector<bool> &colorbuffers, bool depthstencil) override;
+
+	void present(void *screenshotCallbackData) override;
+
+	int getRequestedBackbufferMSAA() const override;
+	int getBackbufferMSAA() const override;
+
+	void setColor(Colorf c) override;
+
+	void setScissor(const Rect &rect) override;
+	void setScissor() override;
+
+	void setStencilState(const StencilState &s) override;
+
+	void setDepthMode(CompareMode compare, bool write) override;
+
+	void setFrontFaceWinding(Winding winding) override;
+
+	void setColorMask(ColorChannelMask mask) override;
+
+	void setBlendState(const BlendState &blend) override;
+
+	void setPointSize(float size) override;
+
+	void setWireframe(bool enable) override;
+
+	bool isPixelFormatSupported(PixelFormat format, uint32 usage) override;
+	Renderer getRenderer() const override;
+	bool usesGLSLES() const override;
+	RendererInfo getRendererInfo() const override;
+
+	bool getRecordingStats(RecordingStats &stats) const override;
+
+	/**
+	 * The commands recorded during the most recently presented frame.
+	 **/
+	const std::vector<Command> &getLastFrameCommands() const { return lastFrameCommands; }
+
+	// Internal use.
+	void recordUpload(size_t size);
+	void recordCopy(size_t size);
+	void recordShaderSwitch();
+
+private:
+
+	love::graphics::ShaderStage *newShaderStageInternal(ShaderStageType stage, const std::string &cachekey, const std::string &source, bool gles) override;
+	love::graphics::Shader *newShaderInternal(StrongRef<love::graphics::ShaderStage> stages[SHADERSTAGE_MAX_ENUM], const Shader::CompileOptions &options) override;
+	love::graphics::StreamBuffer *newStreamBuffer(BufferUsage type, size_t size) override;
+
+	love::graphics::GraphicsReadback *newReadbackInternal(ReadbackMethod method, love::graphics::Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset) override;
+	love::graphics::GraphicsReadback *newReadbackInternal(ReadbackMethod method, love::graphics::Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty) override;
+
+	void setRenderTargetsInternal(const RenderTargets &rts, int pixelw, int pixelh, bool hasSRGBtexture) override;
+	void initCapabilities() override;
+	void getAPIStats(int &shaderswitches) const override;
+
+	void record(CommandType type, int64 count = 0, PrimitiveType primtype = PRIMITIVE_TRIANGLES, int instances = 1);
+	void recordDraw(CommandType type, PrimitiveType primtype, int64 vertexcount, int64 indexcount, int instances);
+
+	bool headless;
+	int requestedBackbufferMSAA;
+	int shaderSwitches;
+
+	std::vector<Command> frameCommands;
+	std::vector<Command> lastFrameCommands;
+
+	RecordingStats frameStats;
+	RecordingStats lastFrameStats;
+
+}; // Graphics
+
+} // none
+} // graphics
+} // love
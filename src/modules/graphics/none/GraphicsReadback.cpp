@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "GraphicsReadback.h"
+#include "Buffer.h"
+#include "data/ByteData.h"
+#include "image/ImageData.h"
+
+// C
+#include <cstring>
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+// Everything completes immediately, since there's no GPU work to wait on.
+
+GraphicsReadback::GraphicsReadback(love::graphics::Graphics *gfx, ReadbackMethod method, love::graphics::Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset)
+	: love::graphics::GraphicsReadback(gfx, method, buffer, offset, size, dest, destoffset)
+{
+	const void *src = ((Buffer *) buffer)->getData(offset, size);
+	if (src == nullptr)
+	{
+		status = STATUS_ERROR;
+		return;
+	}
+
+	void *dst = prepareReadbackDest(size);
+	if (dst == nullptr)
+	{
+		status = STATUS_ERROR;
+		return;
+	}
+
+	memcpy(dst, src, std::min(size, bufferData->getSize() - bufferDataOffset));
+	status = STATUS_COMPLETE;
+}
+
+GraphicsReadback::GraphicsReadback(love::graphics::Graphics *gfx, ReadbackMethod method, love::graphics::Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty)
+	: love::graphics::GraphicsReadback(gfx, method, texture, slice, mipmap, rect, dest, destx, desty)
+{
+	size_t size = getPixelFormatSliceSize(textureFormat, rect.w, rect.h);
+
+	uint8 *dst = (uint8 *) prepareReadbackDest(size);
+	if (dst == nullptr)
+	{
+		status = STATUS_ERROR;
+		return;
+	}
+
+	// Texture contents aren't stored, so the readback region is zeroed.
+	love::thread::Lock lock(imageData->getMutex());
+
+	size_t stride = getPixelFormatUncompressedRowSize(textureFormat, imageData->getWidth());
+	size_t rowsize = getPixelFormatUncompressedRowSize(textureFormat, rect.w);
+
+	for (int i = 0; i < rect.h; i++)
+		memset(dst + stride * i, 0, rowsize);
+
+	status = STATUS_COMPLETE;
+}
+
+GraphicsReadback::~GraphicsReadback()
+{
+}
+
+void GraphicsReadback::wait()
+{
+}
+
+void GraphicsReadback::update()
+{
+}
+
+} // none
+} // graphics
+} // love
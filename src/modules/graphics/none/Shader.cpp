@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Shader.h"
+#include "Graphics.h"
+#include "graphics/vertex.h"
+
+// C
+#include <cstdlib>
+#include <cstring>
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+Shader::Shader(StrongRef<love::graphics::ShaderStage> stages[SHADERSTAGE_MAX_ENUM], const CompileOptions &options)
+	: love::graphics::Shader(stages, options)
+	, builtinUniformInfo()
+{
+	// Everything the validator reflected is treated as active, since there's
+	// no linker to strip unused uniforms.
+	for (auto &kvp : reflection.allUniforms)
+	{
+		UniformInfo &u = *kvp.second;
+		u.active = true;
+
+		BuiltinUniform builtin = BUILTIN_MAX_ENUM;
+		if (getConstant(u.name.c_str(), builtin))
+			builtinUniformInfo[(int) builtin] = &u;
+	}
+
+	for (auto &kvp : reflection.localUniforms)
+	{
+		UniformInfo &u = kvp.second;
+
+		if (u.dataSize != 0)
+			continue;
+
+		if (u.baseType == UNIFORM_MATRIX)
+			u.dataSize = sizeof(uint32) * u.matrix.rows * u.matrix.columns * u.count;
+		else
+			u.dataSize = sizeof(uint32) * u.components * u.count;
+
+		u.data = malloc(u.dataSize);
+		memset(u.data, 0, u.dataSize);
+
+		const auto &valuesit = reflection.localUniformInitializerValues.find(u.name);
+		if (valuesit != reflection.localUniformInitializerValues.end())
+		{
+			const auto &values = valuesit->second;
+			if (!values.empty())
+				memcpy(u.data, values.data(), std::min(u.dataSize, sizeof(LocalUniformValue) * values.size()));
+		}
+	}
+}
+
+Shader::~Shader()
+{
+	for (const auto &kvp : reflection.localUniforms)
+	{
+		// Allocated with malloc().
+		if (kvp.second.data != nullptr)
+			free(kvp.second.data);
+	}
+}
+
+void Shader::attach()
+{
+	// Compute shaders are bound by dispatch calls instead.
+	if (hasStage(SHADERSTAGE_COMPUTE) || Shader::current == this)
+		return;
+
+	Graphics::flushBatchedDrawsGlobal();
+	Shader::current = this;
+
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordShaderSwitch();
+}
+
+int Shader::getVertexAttributeIndex(const std::string &name)
+{
+	// Built-in attributes use fixed locations, like the OpenGL backend binds
+	// them.
+	BuiltinVertexAttribute builtin;
+	if (graphics::getConstant(name.c_str(), builtin))
+		return (int) builtin;
+
+	auto it = reflection.vertexInputs.find(name);
+	return it != reflection.vertexInputs.end() ? it->second : -1;
+}
+
+const Shader::UniformInfo *Shader::getUniformInfo(BuiltinUniform builtin) const
+{
+	return builtinUniformInfo[(int) builtin];
+}
+
+void Shader::updateUniform(const UniformInfo *info, int count)
+{
+	if (current == this)
+		Graphics::flushBatchedDrawsGlobal();
+
+	count = std::min(count, info->count);
+
+	// Values are already in info->data, only the transfer is recorded.
+	if (info->count > 0 && info->data != nullptr)
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		if (gfx != nullptr)
+			gfx->recordUpload(info->dataSize / info->count * count);
+	}
+}
+
+void Shader::applyTexture(const UniformInfo */*info*/, int /*i*/, love::graphics::Texture */*texture*/, UniformType /*basetype*/, bool /*isdefault*/)
+{
+	// The base class keeps the bound textures, there's no other state.
+}
+
+void Shader::applyBuffer(const UniformInfo */*info*/, int /*i*/, love::graphics::Buffer */*buffer*/, UniformType /*basetype*/, bool /*isdefault*/)
+{
+}
+
+} // none
+} // graphics
+} // love
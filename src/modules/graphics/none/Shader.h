@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "graphics/Shader.h"
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+class Shader final : public love::graphics::Shader
+{
+public:
+
+	Shader(StrongRef<love::graphics::ShaderStage> stages[SHADERSTAGE_MAX_ENUM], const CompileOptions &options);
+	virtual ~Shader();
+
+	void attach() override;
+	std::string getWarnings() const override { return ""; }
+	int getVertexAttributeIndex(const std::string &name) override;
+	const UniformInfo *getUniformInfo(BuiltinUniform builtin) const override;
+	void updateUniform(const UniformInfo *info, int count) override;
+
+	ptrdiff_t getHandle() const override { return (ptrdiff_t) this; }
+
+private:
+
+	void applyTexture(const UniformInfo *info, int i, love::graphics::Texture *texture, UniformType basetype, bool isdefault) override;
+	void applyBuffer(const UniformInfo *info, int i, love::graphics::Buffer *buffer, UniformType basetype, bool isdefault) override;
+
+	UniformInfo *builtinUniformInfo[BUILTIN_MAX_ENUM];
+
+}; // Shader
+
+} // none
+} // graphics
+} // love
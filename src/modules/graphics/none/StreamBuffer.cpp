@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "StreamBuffer.h"
+#include "Graphics.h"
+
+#include "common/Exception.h"
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+StreamBuffer::StreamBuffer(BufferUsage mode, size_t size)
+	: love::graphics::StreamBuffer(mode, size)
+	, data(nullptr)
+{
+	try
+	{
+		data = new uint8[size];
+	}
+	catch (std::exception &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	delete[] data;
+}
+
+size_t StreamBuffer::getGPUReadOffset() const
+{
+	return frameGPUReadOffset;
+}
+
+love::graphics::StreamBuffer::MapInfo StreamBuffer::map(size_t /*minsize*/)
+{
+	return MapInfo(data + frameGPUReadOffset, bufferSize - frameGPUReadOffset);
+}
+
+size_t StreamBuffer::unmap(size_t usedsize)
+{
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr && usedsize > 0)
+		gfx->recordUpload(usedsize);
+
+	return frameGPUReadOffset;
+}
+
+void StreamBuffer::markUsed(size_t usedsize)
+{
+	frameGPUReadOffset += usedsize;
+}
+
+void StreamBuffer::nextFrame()
+{
+	frameGPUReadOffset = 0;
+}
+
+} // none
+} // graphics
+} // love
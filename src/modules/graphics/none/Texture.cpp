@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Texture.h"
+#include "Buffer.h"
+#include "Graphics.h"
+
+// C
+#include <cstring>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+Texture::Texture(love::graphics::Graphics *gfx, const Settings &settings, const Slices *data)
+	: love::graphics::Texture(gfx, settings, data)
+{
+	// Pixels aren't kept, but the upload is still accounted for. The base
+	// class makes sure data exists for every mip level, when it's given.
+	if (data != nullptr)
+	{
+		for (int mip = 0; mip < data->getMipmapCount(); mip++)
+		{
+			for (int slice = 0; slice < data->getSliceCount(mip); slice++)
+			{
+				love::image::ImageDataBase *id = data->get(slice, mip);
+				if (id != nullptr)
+					uploadImageData(id, mip, slice, 0, 0);
+			}
+		}
+	}
+
+	updateGraphicsMemorySize(true);
+}
+
+Texture::Texture(love::graphics::Graphics *gfx, love::graphics::Texture *base, const Texture::ViewSettings &viewsettings)
+	: love::graphics::Texture(gfx, base, viewsettings)
+{
+	updateGraphicsMemorySize(true);
+}
+
+Texture::~Texture()
+{
+	updateGraphicsMemorySize(false);
+}
+
+void Texture::uploadByteData(const void */*data*/, size_t size, int /*level*/, int /*slice*/, const Rect &/*r*/)
+{
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordUpload(size);
+}
+
+void Texture::generateMipmapsInternal()
+{
+	// Mipmap generation happens entirely on the GPU, there's nothing to record.
+}
+
+void Texture::copyFromBuffer(love::graphics::Buffer */*source*/, size_t /*sourceoffset*/, int /*sourcewidth*/, size_t size, int /*slice*/, int /*mipmap*/, const Rect &/*rect*/)
+{
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordCopy(size);
+}
+
+void Texture::copyToBuffer(love::graphics::Buffer *dest, int /*slice*/, int /*mipmap*/, const Rect &/*rect*/, size_t destoffset, int /*destwidth*/, size_t size)
+{
+	// Higher level code does validation. Texture contents aren't stored, so
+	// the destination reads back as zeroes.
+	Buffer *buffer = (Buffer *) dest;
+	void *memory = buffer->getData(destoffset, size);
+	if (memory != nullptr)
+		memset(memory, 0, size);
+
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+	if (gfx != nullptr)
+		gfx->recordCopy(size);
+}
+
+void Texture::setSamplerState(const SamplerState &s)
+{
+	samplerState = validateSamplerState(s);
+}
+
+} // none
+} // graphics
+} // love
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "graphics/Texture.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+namespace none
+{
+
+class Texture final : public love::graphics::Texture
+{
+public:
+
+	Texture(love::graphics::Graphics *gfx, const Settings &settings, const Slices *data);
+	Texture(love::graphics::Graphics *gfx, love::graphics::Texture *base, const Texture::ViewSettings &viewsettings);
+	virtual ~Texture();
+
+	void copyFromBuffer(love::graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
+	void copyToBuffer(love::graphics::Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth, size_t size) override;
+
+	void setSamplerState(const SamplerState &s) override;
+
+	// There's no API object, the address is just a unique non-zero handle.
+	ptrdiff_t getHandle() const override { return (ptrdiff_t) this; }
+	ptrdiff_t getRenderTargetHandle() const override { return renderTarget ? (ptrdiff_t) this : 0; }
+	ptrdiff_t getSamplerHandle() const override { return 0; }
+
+	int getMSAA() const override { return std::max(requestedMSAA, 1); }
+
+private:
+
+	void uploadByteData(const void *data, size_t size, int level, int slice, const Rect &r) override;
+	void generateMipmapsInternal() override;
+
+}; // Texture
+
+} // none
+} // graphics
+} // love
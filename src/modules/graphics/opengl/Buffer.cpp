@@ -117,6 +117,14 @@ Buffer::Buffer(love::graphics::Graphics *gfx, const Settings &settings, const st
 
 Buffer::~Buffer()
 {
+	// A Buffer:map range that was never unmapped still holds map memory.
+	if (mapped && mappedType != MAP_READ_ONLY && !ownsMemoryMap && memoryMap != nullptr)
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		gfx->releaseBufferMapMemory(memoryMap);
+		memoryMap = nullptr;
+	}
+
 	unloadVolatile();
 	if (memoryMap != nullptr && ownsMemoryMap)
 		free(memoryMap);
@@ -22,6 +22,7 @@
 #include "common/config.h"
 #include "common/math.h"
 #include "common/Vector.h"
+#include "common/profiler.h"
 
 #include "Graphics.h"
 #include "font/Font.h"
@@ -113,6 +114,7 @@ Graphics::Graphics()
 	, requestedBackbufferMSAA(0)
 	, bufferMapMemory(nullptr)
 	, bufferMapMemorySize(2 * 1024 * 1024)
+	, bufferMapMemoryUsed(false)
 	, pixelFormatUsage()
 {
 	gl = OpenGL();
@@ -1187,6 +1189,8 @@ void Graphics::present(void *screenshotCallbackData)
 	if (isRenderTargetActive())
 		throw love::Exception("present cannot be called while a render target is active.");
 
+	LOVE_PROFILE_ZONE("Graphics::present");
+
 	deprecations.draw(this);
 
 	flushBatchedDraws();
@@ -1536,16 +1540,19 @@ void Graphics::setWireframe(bool enable)
 
 void *Graphics::getBufferMapMemory(size_t size)
 {
-	// We don't need anything more complicated because get/release calls are
-	// never interleaved (as of when this comment was written.)
-	if (bufferMapMemory == nullptr || size > bufferMapMemorySize)
+	// Buffer:map can keep a Buffer mapped while others are mapped and unmapped,
+	// so the shared memory is only handed out to one Buffer at a time.
+	if (bufferMapMemory == nullptr || size > bufferMapMemorySize || bufferMapMemoryUsed)
 		return malloc(size);
+	bufferMapMemoryUsed = true;
 	return bufferMapMemory;
 }
 
 void Graphics::releaseBufferMapMemory(void *mem)
 {
-	if (mem != bufferMapMemory)
+	if (mem == bufferMapMemory)
+		bufferMapMemoryUsed = false;
+	else
 		free(mem);
 }
 
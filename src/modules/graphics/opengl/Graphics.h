@@ -170,6 +170,7 @@ class Graphics final : public love::graphics::Graphics
 
 	char *bufferMapMemory;
 	size_t bufferMapMemorySize;
+	bool bufferMapMemoryUsed;
 
 	// [non-readable, readable]
 	uint32 pixelFormatUsage[PIXELFORMAT_MAX_ENUM][2];
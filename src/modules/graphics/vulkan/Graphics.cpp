@@ -22,6 +22,7 @@
 #include "common/pixelformat.h"
 #include "common/version.h"
 #include "common/memory.h"
+#include "common/profiler.h"
 #include "window/Window.h"
 #include "Buffer.h"
 #include "Graphics.h"
@@ -558,6 +559,8 @@ void Graphics::present(void *screenshotCallbackdata)
 	if (isRenderTargetActive())
 		throw love::Exception("present cannot be called while a render target is active.");
 
+	LOVE_PROFILE_ZONE("Graphics::present");
+
 	if (!renderPassState.active && renderPassState.windowClearRequested)
 		startRenderPass();
 
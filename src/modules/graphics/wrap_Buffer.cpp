@@ -21,6 +21,7 @@
 #include "wrap_Buffer.h"
 #include "Buffer.h"
 #include "common/Data.h"
+#include "data/wrap_Data.h"
 
 #include <limits>
 
@@ -215,6 +216,9 @@ static int w_Buffer_setArrayData(lua_State *L)
 {
 	Buffer *t = luax_checkbuffer(L, 1);
 
+	if (t->isMapped())
+		return luaL_error(L, "Cannot set the data of a mapped Buffer.");
+
 	int sourceindex = (int) luaL_optnumber(L, 3, 1) - 1;
 	int destindex = (int) luaL_optnumber(L, 4, 1) - 1;
 
@@ -341,6 +345,82 @@ static int w_Buffer_setArrayData(lua_State *L)
 	return 0;
 }
 
+static int w_Buffer_setData(lua_State *L)
+{
+	Buffer *t = luax_checkbuffer(L, 1);
+	Data *d = luax_checktype<Data>(L, 2);
+
+	if (t->isMapped())
+		return luaL_error(L, "Cannot set the data of a mapped Buffer.");
+
+	lua_Number offsetp = luaL_optnumber(L, 3, 0);
+	lua_Number dataoffsetp = luaL_optnumber(L, 4, 0);
+	if (offsetp < 0 || dataoffsetp < 0)
+		return luaL_error(L, "Offset parameters cannot be negative.");
+
+	size_t offset = (size_t) offsetp;
+	size_t dataoffset = (size_t) dataoffsetp;
+	if (offset >= t->getSize() || dataoffset >= d->getSize())
+		return luaL_error(L, "The given offset parameters are not within the Buffer's or Data's size.");
+
+	size_t size = std::min(t->getSize() - offset, d->getSize() - dataoffset);
+	if (!lua_isnoneornil(L, 5))
+	{
+		lua_Number sizep = luaL_checknumber(L, 5);
+		if (sizep <= 0 || (size_t) sizep > size)
+			return luaL_error(L, "Invalid size %d (at most %d bytes can be copied with these offsets.)", (int) sizep, (int) size);
+		size = (size_t) sizep;
+	}
+
+	// The Data's memory is handed to the backend directly, without staging it
+	// in a Lua-side copy first.
+	const uint8 *source = (const uint8 *) d->getData() + dataoffset;
+
+	bool success = false;
+	luax_catchexcept(L, [&]() { success = t->fill(offset, size, source); });
+	if (!success)
+		return luaL_error(L, "Cannot set the data of an immutable or readback Buffer.");
+
+	return 0;
+}
+
+static int w_Buffer_map(lua_State *L)
+{
+	Buffer *t = luax_checkbuffer(L, 1);
+	size_t offset = 0;
+	size_t size = t->getSize();
+	if (!lua_isnoneornil(L, 2))
+	{
+		lua_Number offsetp = luaL_checknumber(L, 2);
+		lua_Number sizep = luaL_optnumber(L, 3, (lua_Number) t->getSize() - offsetp);
+		if (offsetp < 0 || sizep < 0)
+			return luaL_error(L, "Offset and size parameters cannot be negative.");
+		offset = (size_t) offsetp;
+		size = (size_t) sizep;
+	}
+
+	Buffer::Mapping *mapping = nullptr;
+	luax_catchexcept(L, [&]() { mapping = t->mapData(offset, size); });
+
+	luax_pushtype(L, mapping);
+	mapping->release();
+	return 1;
+}
+
+static int w_Buffer_unmap(lua_State *L)
+{
+	Buffer *t = luax_checkbuffer(L, 1);
+	luax_catchexcept(L, [&]() { t->unmapData(); });
+	return 0;
+}
+
+static int w_Buffer_isMapped(lua_State *L)
+{
+	Buffer *t = luax_checkbuffer(L, 1);
+	luax_pushboolean(L, t->isMapped());
+	return 1;
+}
+
 static int w_Buffer_clear(lua_State *L)
 {
 	Buffer *t = luax_checkbuffer(L, 1);
@@ -444,6 +524,10 @@ static int w_Buffer_getDebugName(lua_State *L)
 static const luaL_Reg w_Buffer_functions[] =
 {
 	{ "setArrayData", w_Buffer_setArrayData },
+	{ "setData", w_Buffer_setData },
+	{ "map", w_Buffer_map },
+	{ "unmap", w_Buffer_unmap },
+	{ "isMapped", w_Buffer_isMapped },
 	{ "clear", w_Buffer_clear },
 	{ "getElementCount", w_Buffer_getElementCount },
 	{ "getElementStride", w_Buffer_getElementStride },
@@ -459,5 +543,12 @@ extern "C" int luaopen_graphicsbuffer(lua_State *L)
 	return luax_register_type(L, &Buffer::type, w_Buffer_functions, nullptr);
 }
 
+extern "C" int luaopen_graphicsbuffermapping(lua_State *L)
+{
+	int ret = luax_register_type(L, &Buffer::Mapping::type, data::w_Data_functions, nullptr);
+	data::luax_rundatawrapper(L, Buffer::Mapping::type);
+	return ret;
+}
+
 } // graphics
 } // love
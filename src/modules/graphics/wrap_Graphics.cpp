@@ -30,6 +30,7 @@
 #include "image/wrap_Image.h"
 #include "common/Reference.h"
 #include "math/wrap_Transform.h"
+#include "math/wrap_BezierCurve.h"
 #include "thread/wrap_Channel.h"
 
 #include "opengl/Graphics.h"
@@ -477,7 +478,12 @@ static void screenshotFileCallback(const Graphics::ScreenshotInfo *info, love::i
 	{
 		try
 		{
-			i->encode(fileinfo->format, fileinfo->filename.c_str(), true);
+			// Screenshots are usually large enough to benefit from
+			// compressing on multiple threads.
+			image::FormatHandler::EncodeOptions options;
+			options.parallel = true;
+
+			i->encode(fileinfo->format, fileinfo->filename.c_str(), true, options);
 		}
 		catch (love::Exception &e)
 		{
@@ -3213,6 +3219,47 @@ int w_getStats(lua_State *L)
 	return 1;
 }
 
+int w_getRecordingStats(lua_State *L)
+{
+	Graphics::RecordingStats stats;
+	if (!instance()->getRecordingStats(stats))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	if (lua_istable(L, 1))
+		lua_pushvalue(L, 1);
+	else
+		lua_createtable(L, 0, 8);
+
+	lua_pushnumber(L, (lua_Number) stats.frame);
+	lua_setfield(L, -2, "frame");
+
+	lua_pushinteger(L, stats.commands);
+	lua_setfield(L, -2, "commands");
+
+	lua_pushinteger(L, stats.drawCalls);
+	lua_setfield(L, -2, "drawcalls");
+
+	lua_pushinteger(L, stats.batches);
+	lua_setfield(L, -2, "batches");
+
+	lua_pushinteger(L, stats.stateChanges);
+	lua_setfield(L, -2, "statechanges");
+
+	lua_pushnumber(L, (lua_Number) stats.vertices);
+	lua_setfield(L, -2, "vertices");
+
+	lua_pushnumber(L, (lua_Number) stats.indices);
+	lua_setfield(L, -2, "indices");
+
+	lua_pushnumber(L, (lua_Number) stats.uploadBytes);
+	lua_setfield(L, -2, "uploadbytes");
+
+	return 1;
+}
+
 int w_draw(lua_State *L)
 {
 	Drawable *drawable = nullptr;
@@ -3710,6 +3757,90 @@ int w_arc(lua_State *L)
 	return 0;
 }
 
+int w_curves(lua_State *L)
+{
+	std::vector<math::BezierCurve *> curves;
+
+	if (lua_istable(L, 1))
+	{
+		int count = (int) luax_objlen(L, 1);
+		curves.reserve(count);
+
+		for (int i = 1; i <= count; i++)
+		{
+			lua_rawgeti(L, 1, i);
+			curves.push_back(math::luax_checkbeziercurve(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+	else
+		curves.push_back(math::luax_checkbeziercurve(L, 1));
+
+	float tolerance = (float) luaL_optnumber(L, 2, 0.25);
+
+	luax_catchexcept(L, [&](){ instance()->curves(curves.data(), curves.size(), tolerance); });
+	return 0;
+}
+
+static void checkPolygonRing(lua_State *L, int idx, std::vector<Vector2> &vertices)
+{
+	int components = (int) luax_objlen(L, idx);
+
+	if (components % 2 != 0)
+		luaL_error(L, "Number of vertex components must be a multiple of two");
+	else if (components < 6)
+		luaL_error(L, "Need at least three vertices to draw a polygon");
+
+	for (int i = 0; i < components / 2; i++)
+	{
+		lua_rawgeti(L, idx, (i * 2) + 1);
+		lua_rawgeti(L, idx, (i * 2) + 2);
+		vertices.emplace_back(luax_checkfloat(L, -2), luax_checkfloat(L, -1));
+		lua_pop(L, 2);
+	}
+}
+
+static int polygonWithHoles(lua_State *L, Graphics::DrawMode mode, Graphics::FillRule rule)
+{
+	std::vector<Vector2> vertices;
+	std::vector<size_t> holeStarts;
+
+	checkPolygonRing(L, 2, vertices);
+
+	int holecount = (int) luax_objlen(L, 3);
+	for (int i = 1; i <= holecount; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		luaL_checktype(L, -1, LUA_TTABLE);
+		holeStarts.push_back(vertices.size());
+		checkPolygonRing(L, lua_gettop(L), vertices);
+		lua_pop(L, 1);
+	}
+
+	luax_catchexcept(L, [&]()
+	{
+		if (mode == Graphics::DRAW_FILL)
+		{
+			instance()->fillPolygon(vertices.data(), vertices.size(), holeStarts, rule);
+			return;
+		}
+
+		// Outline each ring separately, as a closed loop.
+		std::vector<Vector2> loop;
+		for (size_t i = 0; i <= holeStarts.size(); i++)
+		{
+			size_t start = i == 0 ? 0 : holeStarts[i - 1];
+			size_t end = i < holeStarts.size() ? holeStarts[i] : vertices.size();
+
+			loop.assign(vertices.begin() + start, vertices.begin() + end);
+			loop.push_back(vertices[start]);
+			instance()->polygon(mode, loop.data(), loop.size());
+		}
+	});
+
+	return 0;
+}
+
 int w_polygon(lua_State *L)
 {
 	int args = lua_gettop(L) - 1;
@@ -3720,8 +3851,22 @@ int w_polygon(lua_State *L)
 		return luax_enumerror(L, "draw mode", Graphics::getConstants(mode), str);
 
 	bool is_table = false;
-	if (args == 1 && lua_istable(L, 2))
+	Graphics::FillRule rule = Graphics::FILL_RULE_EVENODD;
+	if (lua_istable(L, 2))
 	{
+		if (!lua_isnoneornil(L, 4))
+		{
+			const char *rulestr = luaL_checkstring(L, 4);
+			if (!Graphics::getConstant(rulestr, rule))
+				return luax_enumerror(L, "fill rule", Graphics::getConstants(rule), rulestr);
+		}
+
+		if (!lua_isnoneornil(L, 3))
+		{
+			luaL_checktype(L, 3, LUA_TTABLE);
+			return polygonWithHoles(L, mode, rule);
+		}
+
 		args = (int) luax_objlen(L, 2);
 		is_table = true;
 	}
@@ -3758,7 +3903,13 @@ int w_polygon(lua_State *L)
 	// make a closed loop
 	coords[numvertices] = coords[0];
 
-	luax_catchexcept(L, [&](){ instance()->polygon(mode, coords, numvertices+1); });
+	luax_catchexcept(L, [&]()
+	{
+		if (mode == Graphics::DRAW_FILL)
+			instance()->fillPolygon(coords, numvertices, std::vector<size_t>(), rule);
+		else
+			instance()->polygon(mode, coords, numvertices+1);
+	});
 	return 0;
 }
 
@@ -4014,6 +4165,41 @@ int w_resetProjection(lua_State */*L*/)
 }
 
 
+// C functions in a struct, necessary for the FFI versions of Graphics
+// functions. These return false rather than throwing an exception, in which
+// case wrap_Graphics.lua calls the regular version to raise the error.
+struct FFI_Graphics
+{
+	void (*setColor)(float r, float g, float b, float a);
+	bool (*draw)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+};
+
+static FFI_Graphics ffifuncs =
+{
+	[](float r, float g, float b, float a) // setColor
+	{
+		instance()->setColor(Colorf(r, g, b, a));
+	},
+
+	[](Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky) -> bool // draw
+	{
+		auto drawable = luax_ffi_checktype<Drawable>(p);
+		if (drawable == nullptr)
+			return false;
+
+		try
+		{
+			instance()->draw(drawable, Matrix4(x, y, a, sx, sy, ox, oy, kx, ky));
+		}
+		catch (std::exception &)
+		{
+			return false;
+		}
+
+		return true;
+	},
+};
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -4095,6 +4281,7 @@ static const luaL_Reg functions[] =
 	{ "getSystemLimits", w_getSystemLimits },
 	{ "getTextureTypes", w_getTextureTypes },
 	{ "getStats", w_getStats },
+	{ "getRecordingStats", w_getRecordingStats },
 
 	{ "captureScreenshot", w_captureScreenshot },
 
@@ -4144,6 +4331,7 @@ static const luaL_Reg functions[] =
 	{ "ellipse", w_ellipse },
 	{ "arc", w_arc },
 	{ "polygon", w_polygon },
+	{ "curves", w_curves },
 
 	{ "flushBatch", w_flushBatch },
 
@@ -4188,6 +4376,7 @@ static const lua_CFunction types[] =
 	luaopen_font,
 	luaopen_quad,
 	luaopen_graphicsbuffer,
+	luaopen_graphicsbuffermapping,
 	luaopen_graphicsreadback,
 	luaopen_spritebatch,
 	luaopen_particlesystem,
@@ -4217,8 +4406,13 @@ extern "C" int luaopen_love_graphics(lua_State *L)
 
 	int n = luax_register_module(L, w);
 
+	// Execute wrap_Graphics.lua, sending the graphics table and ffifuncs pointer as args.
 	if (luaL_loadbuffer(L, (const char *)graphics_lua, sizeof(graphics_lua), "=[love \"wrap_Graphics.lua\"]") == 0)
-		lua_call(L, 0, 0);
+	{
+		lua_pushvalue(L, -2);
+		luax_pushpointerasstring(L, &ffifuncs);
+		lua_call(L, 2, 0);
+	}
 	else
 		lua_error(L);
 
@@ -22,10 +22,14 @@ misrepresented as being the original software.
 3. This notice may not be removed or altered from any source distribution.
 --]]
 
+local graphics, ffifuncspointer_str = ...
+
 local table_concat = table.concat
 local ipairs = ipairs
 local pcall = pcall
-local graphics = love.graphics
+local type = type
+local getmetatable = getmetatable
+local setmetatable = setmetatable
 
 function graphics.newVideo(file, settings)
 	settings = settings == nil and {} or settings
@@ -129,5 +133,82 @@ function graphics._transformGLSLErrorMessages(message)
 	return table_concat(lines, "\n")
 end
 
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Graphics
+{
+	void (*setColor)(float r, float g, float b, float a);
+	bool (*draw)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+} FFI_Graphics;
+]])
+
+local ffifuncs = ffi.cast("FFI_Graphics **", ffifuncspointer_str)[0]
+
+local function isoptnumber(v)
+	return v == nil or type(v) == "number"
+end
+
+-- Overwrite some regular love.graphics functions with FFI implementations.
+-- The less common argument variants (tables, Quads, Transforms) and error
+-- reporting still go through the regular versions.
+
+local _setColor = graphics.setColor
+local _draw = graphics.draw
+
+function graphics.setColor(r, g, b, a)
+	if type(r) == "number" and type(g) == "number" and type(b) == "number" and isoptnumber(a) then
+		ffifuncs.setColor(r, g, b, a == nil and 1 or a)
+	else
+		_setColor(r, g, b, a)
+	end
+end
+
+-- Every LOVE type has its own metatable, so whether a userdata is a Drawable
+-- proxy only has to be worked out once per metatable. Other userdata (files,
+-- FFI-created objects, etc.) must never reach the FFI draw function.
+local drawablemetatables = setmetatable({}, {__mode = "k"})
+
+local function isdrawable(v)
+	local mt = getmetatable(v)
+	if mt == nil then
+		return false
+	end
+
+	local known = drawablemetatables[mt]
+	if known == nil then
+		local status, result = pcall(function() return v:typeOf("Drawable") end)
+		known = status and result == true
+		drawablemetatables[mt] = known
+	end
+
+	return known
+end
+
+-- quadky is only used by the draw(texture, quad, x, y, ..., ky) variant.
+function graphics.draw(drawable, x, y, r, sx, sy, ox, oy, kx, ky, quadky)
+	if type(drawable) == "userdata" and isdrawable(drawable) and (type(x) == "number" or (x == nil and y == nil))
+		and isoptnumber(y) and isoptnumber(r) and isoptnumber(sx) and isoptnumber(sy)
+		and isoptnumber(ox) and isoptnumber(oy) and isoptnumber(kx) and isoptnumber(ky) then
+
+		local sx1 = sx == nil and 1 or sx
+		local sy1 = sy == nil and sx1 or sy
+		if ffifuncs.draw(drawable, x or 0, y or 0, r or 0, sx1, sy1, ox or 0, oy or 0, kx or 0, ky or 0) then
+			return
+		end
+	end
+
+	return _draw(drawable, x, y, r, sx, sy, ox, oy, kx, ky, quadky)
+end
+
 -- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
 --)luastring"--"
@@ -23,6 +23,8 @@
 #include "wrap_Buffer.h"
 #include "Texture.h"
 #include "wrap_Texture.h"
+#include "math/wrap_Transform.h"
+#include "common/Data.h"
 
 // C++
 #include <algorithm>
@@ -612,6 +614,81 @@ int w_Mesh_getDrawRange(lua_State *L)
 	return 2;
 }
 
+int w_Mesh_setSkinning(lua_State *L)
+{
+	Mesh *t = luax_checkmesh(L, 1);
+
+	if (lua_isnoneornil(L, 2))
+	{
+		t->setSkinning();
+		return 0;
+	}
+
+	const char *bones = luaL_checkstring(L, 2);
+	const char *weights = luaL_checkstring(L, 3);
+	const char *pos = luaL_optstring(L, 4, getConstant(ATTRIB_POS));
+
+	luax_catchexcept(L, [&](){ t->setSkinning(bones, weights, pos); });
+	return 0;
+}
+
+int w_Mesh_getSkinning(lua_State *L)
+{
+	Mesh *t = luax_checkmesh(L, 1);
+
+	std::string bones, weights, pos;
+	if (!t->getSkinning(bones, weights, pos))
+		return 0;
+
+	luax_pushstring(L, bones);
+	luax_pushstring(L, weights);
+	luax_pushstring(L, pos);
+	return 3;
+}
+
+int w_Mesh_getSkinningBoneCount(lua_State *L)
+{
+	Mesh *t = luax_checkmesh(L, 1);
+	lua_pushinteger(L, t->getSkinningBoneCount());
+	return 1;
+}
+
+int w_Mesh_skin(lua_State *L)
+{
+	static_assert(sizeof(Matrix4) == sizeof(float) * 16, "Matrix4 must be 16 packed floats to alias Data contents.");
+
+	Mesh *t = luax_checkmesh(L, 1);
+
+	// Bone matrices are either Transforms, or packed column-major 4x4 float
+	// matrices such as the ones love.math.composeTransforms writes.
+	if (lua_istable(L, 2))
+	{
+		size_t count = luax_objlen(L, 2);
+		std::vector<Matrix4> bones(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			lua_rawgeti(L, 2, (int) i + 1);
+			if (!luax_istype(L, -1, math::Transform::type))
+				return luaL_error(L, "Bone %d must be a Transform object.", (int) i + 1);
+			bones[i] = luax_totype<math::Transform>(L, -1)->getMatrix();
+			lua_pop(L, 1);
+		}
+
+		luax_catchexcept(L, [&](){ t->skin(bones.data(), count); });
+	}
+	else
+	{
+		Data *data = luax_checktype<Data>(L, 2);
+		const Matrix4 *bones = (const Matrix4 *) data->getData();
+		size_t count = data->getSize() / sizeof(Matrix4);
+
+		luax_catchexcept(L, [&](){ t->skin(bones, count); });
+	}
+
+	return 0;
+}
+
 static const luaL_Reg w_Mesh_functions[] =
 {
 	{ "setVertices", w_Mesh_setVertices },
@@ -638,6 +715,10 @@ static const luaL_Reg w_Mesh_functions[] =
 	{ "getDrawMode", w_Mesh_getDrawMode },
 	{ "setDrawRange", w_Mesh_setDrawRange },
 	{ "getDrawRange", w_Mesh_getDrawRange },
+	{ "setSkinning", w_Mesh_setSkinning },
+	{ "getSkinning", w_Mesh_getSkinning },
+	{ "getSkinningBoneCount", w_Mesh_getSkinningBoneCount },
+	{ "skin", w_Mesh_skin },
 	{ 0, 0 }
 };
 
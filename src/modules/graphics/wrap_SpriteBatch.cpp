@@ -23,6 +23,11 @@
 #include "Texture.h"
 #include "wrap_Texture.h"
 
+// Shove the wrap_SpriteBatch.lua code directly into a raw string literal.
+static const char spritebatch_lua[] =
+#include "wrap_SpriteBatch.lua"
+;
+
 namespace love
 {
 namespace graphics
@@ -260,6 +265,33 @@ int w_SpriteBatch_getDrawRange(lua_State *L)
 	return 2;
 }
 
+// C functions in a struct, necessary for the FFI versions of SpriteBatch
+// methods. add returns 0 rather than throwing an exception, in which case
+// wrap_SpriteBatch.lua calls the regular version to raise the error.
+struct FFI_SpriteBatch
+{
+	int (*add)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+};
+
+static FFI_SpriteBatch ffifuncs =
+{
+	[](Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky) -> int // add
+	{
+		auto t = luax_ffi_checktype<SpriteBatch>(p);
+		if (t == nullptr)
+			return 0;
+
+		try
+		{
+			return t->add(Matrix4(x, y, a, sx, sy, ox, oy, kx, ky)) + 1;
+		}
+		catch (std::exception &)
+		{
+			return 0;
+		}
+	},
+};
+
 static const luaL_Reg w_SpriteBatch_functions[] =
 {
 	{ "add", w_SpriteBatch_add },
@@ -282,7 +314,11 @@ static const luaL_Reg w_SpriteBatch_functions[] =
 
 extern "C" int luaopen_spritebatch(lua_State *L)
 {
-	return luax_register_type(L, &SpriteBatch::type, w_SpriteBatch_functions, nullptr);
+	int ret = luax_register_type(L, &SpriteBatch::type, w_SpriteBatch_functions, nullptr);
+
+	luax_runwrapper(L, spritebatch_lua, sizeof(spritebatch_lua), "SpriteBatch.lua", SpriteBatch::type, &ffifuncs);
+
+	return ret;
 }
 
 } // graphics
@@ -0,0 +1,79 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2024 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local SpriteBatch_mt, ffifuncspointer_str = ...
+local SpriteBatch = SpriteBatch_mt.__index
+
+local type, pcall = type, pcall
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_SpriteBatch
+{
+	int (*add)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+} FFI_SpriteBatch;
+]])
+
+local ffifuncs = ffi.cast("FFI_SpriteBatch **", ffifuncspointer_str)[0]
+
+local function isoptnumber(v)
+	return v == nil or type(v) == "number"
+end
+
+-- Overwrite some regular SpriteBatch methods with FFI implementations. The
+-- Quad and Transform variants and error reporting still go through the
+-- regular versions.
+
+local _add = SpriteBatch.add
+
+-- quadky is only used by the add(quad, x, y, ..., ky) variant.
+function SpriteBatch:add(x, y, r, sx, sy, ox, oy, kx, ky, quadky)
+	if type(self) == "userdata" and (type(x) == "number" or (x == nil and y == nil))
+		and isoptnumber(y) and isoptnumber(r) and isoptnumber(sx) and isoptnumber(sy)
+		and isoptnumber(ox) and isoptnumber(oy) and isoptnumber(kx) and isoptnumber(ky) then
+
+		local sx1 = sx == nil and 1 or sx
+		local sy1 = sy == nil and sx1 or sy
+		local index = ffifuncs.add(self, x or 0, y or 0, r or 0, sx1, sy1, ox or 0, oy or 0, kx or 0, ky or 0)
+		if index > 0 then
+			return index
+		end
+	end
+
+	return _add(self, x, y, r, sx, sy, ox, oy, kx, ky, quadky)
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
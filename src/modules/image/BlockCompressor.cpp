@@ -0,0 +1,972 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "BlockCompressor.h"
+
+// LOVE
+#include "common/Exception.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+// C
+#include <string.h>
+
+namespace love
+{
+namespace image
+{
+
+namespace
+{
+
+// A 4x4 block of RGBA8 pixels, in row-major order.
+typedef uint8 Block[16][4];
+
+inline int clamp255(int v)
+{
+	return std::min(std::max(v, 0), 255);
+}
+
+inline int square(int v)
+{
+	return v * v;
+}
+
+void fetchBlock(const uint8 *rgba, int width, int height, int bx, int by, Block &block)
+{
+	for (int y = 0; y < 4; y++)
+	{
+		int sy = std::min(by * 4 + y, height - 1);
+
+		for (int x = 0; x < 4; x++)
+		{
+			int sx = std::min(bx * 4 + x, width - 1);
+			memcpy(block[y * 4 + x], rgba + ((size_t) sy * width + sx) * 4, 4);
+		}
+	}
+}
+
+// Number of least-squares endpoint refinement passes for BC1 and BC7.
+int getRefinementPasses(CompressQuality quality)
+{
+	switch (quality)
+	{
+	case COMPRESS_QUALITY_FAST: return 0;
+	case COMPRESS_QUALITY_HIGH: return 3;
+	case COMPRESS_QUALITY_NORMAL:
+	default: return 1;
+	}
+}
+
+// Finds the endpoints of the line which best fits the first 'channels'
+// components of the block's pixels, via the principal axis of their
+// covariance.
+void fitEndpoints(const Block &block, int channels, float e0[4], float e1[4])
+{
+	float mean[4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < channels; c++)
+			mean[c] += block[i][c];
+	}
+
+	for (int c = 0; c < channels; c++)
+		mean[c] /= 16.0f;
+
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		float d[4];
+		for (int c = 0; c < channels; c++)
+			d[c] = block[i][c] - mean[c];
+
+		for (int a = 0; a < channels; a++)
+		{
+			for (int b = 0; b < channels; b++)
+				cov[a][b] += d[a] * d[b];
+		}
+	}
+
+	// Power iteration, starting from the row with the largest variance.
+	int start = 0;
+	for (int c = 1; c < channels; c++)
+	{
+		if (cov[c][c] > cov[start][start])
+			start = c;
+	}
+
+	float axis[4] = {};
+	for (int c = 0; c < channels; c++)
+		axis[c] = cov[start][c];
+
+	for (int iter = 0; iter < 8; iter++)
+	{
+		float next[4] = {};
+		float length = 0.0f;
+
+		for (int a = 0; a < channels; a++)
+		{
+			for (int b = 0; b < channels; b++)
+				next[a] += cov[a][b] * axis[b];
+			length += next[a] * next[a];
+		}
+
+		length = sqrtf(length);
+		if (length < 1e-6f)
+			break;
+
+		for (int c = 0; c < channels; c++)
+			axis[c] = next[c] / length;
+	}
+
+	float tmin = 0.0f;
+	float tmax = 0.0f;
+
+	for (int i = 0; i < 16; i++)
+	{
+		float t = 0.0f;
+		for (int c = 0; c < channels; c++)
+			t += (block[i][c] - mean[c]) * axis[c];
+
+		tmin = std::min(tmin, t);
+		tmax = std::max(tmax, t);
+	}
+
+	for (int c = 0; c < channels; c++)
+	{
+		e0[c] = mean[c] + axis[c] * tmax;
+		e1[c] = mean[c] + axis[c] * tmin;
+	}
+}
+
+// Solves for the two endpoints which best reproduce the block given each
+// pixel's interpolation weight towards the first endpoint. Returns false if
+// the system is degenerate (all pixels use the same weight.)
+bool solveEndpoints(const Block &block, int channels, const float weights[16], float e0[4], float e1[4])
+{
+	float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+	float ax[4] = {};
+	float bx[4] = {};
+
+	for (int i = 0; i < 16; i++)
+	{
+		float a = weights[i];
+		float b = 1.0f - a;
+
+		aa += a * a;
+		bb += b * b;
+		ab += a * b;
+
+		for (int c = 0; c < channels; c++)
+		{
+			ax[c] += a * block[i][c];
+			bx[c] += b * block[i][c];
+		}
+	}
+
+	float det = aa * bb - ab * ab;
+	if (fabsf(det) < 1e-6f)
+		return false;
+
+	for (int c = 0; c < channels; c++)
+	{
+		e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+		e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+	}
+
+	return true;
+}
+
+// BC1 (DXT1) color blocks, also used by BC3 (DXT5).
+
+uint16 packRGB565(const float c[3])
+{
+	int r = std::min(std::max((int) lroundf(c[0] * 31.0f / 255.0f), 0), 31);
+	int g = std::min(std::max((int) lroundf(c[1] * 63.0f / 255.0f), 0), 63);
+	int b = std::min(std::max((int) lroundf(c[2] * 31.0f / 255.0f), 0), 31);
+	return (uint16) ((r << 11) | (g << 5) | b);
+}
+
+void unpackRGB565(uint16 c, int out[3])
+{
+	int r = (c >> 11) & 0x1F;
+	int g = (c >> 5) & 0x3F;
+	int b = c & 0x1F;
+
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+int findColorIndices(const Block &block, uint16 c0, uint16 c1, uint8 indices[16])
+{
+	int palette[4][3];
+	unpackRGB565(c0, palette[0]);
+	unpackRGB565(c1, palette[1]);
+
+	for (int c = 0; c < 3; c++)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	int error = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int best = INT_MAX;
+
+		for (int p = 0; p < 4; p++)
+		{
+			int d = square(block[i][0] - palette[p][0])
+			      + square(block[i][1] - palette[p][1])
+			      + square(block[i][2] - palette[p][2]);
+
+			if (d < best)
+			{
+				best = d;
+				indices[i] = (uint8) p;
+			}
+		}
+
+		error += best;
+	}
+
+	return error;
+}
+
+void encodeColorBlock(const Block &block, CompressQuality quality, uint8 *dst)
+{
+	static const float indexweights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+	float e0[4], e1[4];
+	fitEndpoints(block, 3, e0, e1);
+
+	uint16 c0 = packRGB565(e0);
+	uint16 c1 = packRGB565(e1);
+
+	uint8 indices[16];
+	int error = findColorIndices(block, c0, c1, indices);
+
+	for (int pass = 0; pass < getRefinementPasses(quality) && error > 0; pass++)
+	{
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+			weights[i] = indexweights[indices[i]];
+
+		if (!solveEndpoints(block, 3, weights, e0, e1))
+			break;
+
+		uint16 newc0 = packRGB565(e0);
+		uint16 newc1 = packRGB565(e1);
+
+		uint8 newindices[16];
+		int newerror = findColorIndices(block, newc0, newc1, newindices);
+
+		if (newerror >= error)
+			break;
+
+		c0 = newc0;
+		c1 = newc1;
+		error = newerror;
+		memcpy(indices, newindices, sizeof(indices));
+	}
+
+	// The four color mode needs c0 > c1. Swapping the endpoints swaps indices
+	// 0 <-> 1 and 2 <-> 3.
+	if (c0 < c1)
+	{
+		std::swap(c0, c1);
+		for (int i = 0; i < 16; i++)
+			indices[i] ^= 1;
+	}
+	else if (c0 == c1)
+		memset(indices, 0, sizeof(indices));
+
+	uint32 bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint32) indices[i] << (i * 2);
+
+	dst[0] = (uint8) (c0 & 0xFF);
+	dst[1] = (uint8) (c0 >> 8);
+	dst[2] = (uint8) (c1 & 0xFF);
+	dst[3] = (uint8) (c1 >> 8);
+
+	for (int i = 0; i < 4; i++)
+		dst[4 + i] = (uint8) ((bits >> (i * 8)) & 0xFF);
+}
+
+// BC3 (DXT5) alpha blocks.
+
+int findAlphaIndices(const Block &block, int a0, int a1, uint8 indices[16])
+{
+	int palette[8];
+	palette[0] = a0;
+	palette[1] = a1;
+
+	if (a0 > a1)
+	{
+		for (int i = 1; i <= 6; i++)
+			palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+	}
+	else
+	{
+		for (int i = 1; i <= 4; i++)
+			palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	int error = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int best = INT_MAX;
+
+		for (int p = 0; p < 8; p++)
+		{
+			int d = square(block[i][3] - palette[p]);
+			if (d < best)
+			{
+				best = d;
+				indices[i] = (uint8) p;
+			}
+		}
+
+		error += best;
+	}
+
+	return error;
+}
+
+void encodeAlphaBlock(const Block &block, CompressQuality quality, uint8 *dst)
+{
+	int amin = 255, amax = 0;
+	int innermin = 255, innermax = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int a = block[i][3];
+		amin = std::min(amin, a);
+		amax = std::max(amax, a);
+
+		if (a != 0 && a != 255)
+		{
+			innermin = std::min(innermin, a);
+			innermax = std::max(innermax, a);
+		}
+	}
+
+	int a0 = amax;
+	int a1 = amin;
+
+	uint8 indices[16];
+	int error = findAlphaIndices(block, a0, a1, indices);
+
+	// The six value mode has exact 0 and 255 entries, which suits blocks
+	// mixing fully transparent or opaque pixels with partial ones.
+	if (quality != COMPRESS_QUALITY_FAST && error > 0 && innermin <= innermax && (amin == 0 || amax == 255))
+	{
+		uint8 newindices[16];
+		int newerror = findAlphaIndices(block, innermin, innermax, newindices);
+
+		if (newerror < error)
+		{
+			a0 = innermin;
+			a1 = innermax;
+			memcpy(indices, newindices, sizeof(indices));
+		}
+	}
+
+	uint64 bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint64) indices[i] << (i * 3);
+
+	dst[0] = (uint8) a0;
+	dst[1] = (uint8) a1;
+
+	for (int i = 0; i < 6; i++)
+		dst[2 + i] = (uint8) ((bits >> (i * 8)) & 0xFF);
+}
+
+// BC7 blocks, using only mode 6: a single RGBA line with 7 bit endpoints plus
+// a per-endpoint shared low bit, and 4 bit indices.
+
+const int bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct BC7Endpoint
+{
+	int q[4];
+	int pbit;
+};
+
+BC7Endpoint quantizeBC7Endpoint(const float e[4])
+{
+	BC7Endpoint best = {};
+	float besterror = -1.0f;
+
+	for (int p = 0; p < 2; p++)
+	{
+		BC7Endpoint endpoint;
+		endpoint.pbit = p;
+		float error = 0.0f;
+
+		for (int c = 0; c < 4; c++)
+		{
+			endpoint.q[c] = std::min(std::max((int) lroundf((e[c] - p) / 2.0f), 0), 127);
+			float d = (float) ((endpoint.q[c] << 1) | p) - e[c];
+			error += d * d;
+		}
+
+		if (besterror < 0.0f || error < besterror)
+		{
+			best = endpoint;
+			besterror = error;
+		}
+	}
+
+	return best;
+}
+
+int findBC7Indices(const Block &block, const BC7Endpoint &ep0, const BC7Endpoint &ep1, uint8 indices[16])
+{
+	int palette[16][4];
+
+	for (int c = 0; c < 4; c++)
+	{
+		int v0 = (ep0.q[c] << 1) | ep0.pbit;
+		int v1 = (ep1.q[c] << 1) | ep1.pbit;
+
+		for (int i = 0; i < 16; i++)
+			palette[i][c] = ((64 - bc7Weights[i]) * v0 + bc7Weights[i] * v1 + 32) >> 6;
+	}
+
+	int error = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int best = INT_MAX;
+
+		for (int p = 0; p < 16; p++)
+		{
+			int d = square(block[i][0] - palette[p][0])
+			      + square(block[i][1] - palette[p][1])
+			      + square(block[i][2] - palette[p][2])
+			      + square(block[i][3] - palette[p][3]);
+
+			if (d < best)
+			{
+				best = d;
+				indices[i] = (uint8) p;
+			}
+		}
+
+		error += best;
+	}
+
+	return error;
+}
+
+struct BitWriter
+{
+	uint8 *dst;
+	int pos;
+
+	void write(uint32 value, int count)
+	{
+		for (int i = 0; i < count; i++, pos++)
+		{
+			if ((value >> i) & 1)
+				dst[pos >> 3] |= (uint8) (1 << (pos & 7));
+		}
+	}
+};
+
+void encodeBC7Block(const Block &block, CompressQuality quality, uint8 *dst)
+{
+	float e0[4], e1[4];
+	fitEndpoints(block, 4, e0, e1);
+
+	BC7Endpoint ep0 = quantizeBC7Endpoint(e0);
+	BC7Endpoint ep1 = quantizeBC7Endpoint(e1);
+
+	uint8 indices[16];
+	int error = findBC7Indices(block, ep0, ep1, indices);
+
+	for (int pass = 0; pass < getRefinementPasses(quality) && error > 0; pass++)
+	{
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+			weights[i] = 1.0f - bc7Weights[indices[i]] / 64.0f;
+
+		if (!solveEndpoints(block, 4, weights, e0, e1))
+			break;
+
+		BC7Endpoint newep0 = quantizeBC7Endpoint(e0);
+		BC7Endpoint newep1 = quantizeBC7Endpoint(e1);
+
+		uint8 newindices[16];
+		int newerror = findBC7Indices(block, newep0, newep1, newindices);
+
+		if (newerror >= error)
+			break;
+
+		ep0 = newep0;
+		ep1 = newep1;
+		error = newerror;
+		memcpy(indices, newindices, sizeof(indices));
+	}
+
+	// The first pixel's index is stored without its top bit, so it must be
+	// in the lower half of the palette.
+	if (indices[0] >= 8)
+	{
+		std::swap(ep0, ep1);
+		for (int i = 0; i < 16; i++)
+			indices[i] = (uint8) (15 - indices[i]);
+	}
+
+	memset(dst, 0, 16);
+	BitWriter writer = {dst, 0};
+
+	writer.write(1 << 6, 7);
+
+	for (int c = 0; c < 4; c++)
+	{
+		writer.write(ep0.q[c], 7);
+		writer.write(ep1.q[c], 7);
+	}
+
+	writer.write(ep0.pbit, 1);
+	writer.write(ep1.pbit, 1);
+
+	writer.write(indices[0], 3);
+	for (int i = 1; i < 16; i++)
+		writer.write(indices[i], 4);
+}
+
+// ETC2 RGB color blocks, using the individual and differential modes which
+// are shared with ETC1.
+
+const int etcModifiers[8][4] =
+{
+	{  2,   8,  -2,   -8 },
+	{  5,  17,  -5,  -17 },
+	{  9,  29,  -9,  -29 },
+	{ 13,  42, -13,  -42 },
+	{ 18,  60, -18,  -60 },
+	{ 24,  80, -24,  -80 },
+	{ 33, 106, -33, -106 },
+	{ 47, 183, -47, -183 },
+};
+
+// Each ETC block is split into two 2x4 halves, or two 4x2 halves when flipped.
+void getSubblockPixels(int flip, int subblock, int pixels[8])
+{
+	int n = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int x = i % 4;
+		int y = i / 4;
+
+		if ((flip ? y / 2 : x / 2) == subblock)
+			pixels[n++] = i;
+	}
+}
+
+int evaluateSubblock(const Block &block, const int pixels[8], const int base[3], int &table, uint8 indices[16])
+{
+	int besterror = INT_MAX;
+
+	for (int t = 0; t < 8; t++)
+	{
+		uint8 tableindices[8];
+		int error = 0;
+
+		for (int k = 0; k < 8 && error < besterror; k++)
+		{
+			const uint8 *p = block[pixels[k]];
+			int best = INT_MAX;
+
+			for (int m = 0; m < 4; m++)
+			{
+				int mod = etcModifiers[t][m];
+				int d = square(clamp255(base[0] + mod) - p[0])
+				      + square(clamp255(base[1] + mod) - p[1])
+				      + square(clamp255(base[2] + mod) - p[2]);
+
+				if (d < best)
+				{
+					best = d;
+					tableindices[k] = (uint8) m;
+				}
+			}
+
+			error += best;
+		}
+
+		if (error < besterror)
+		{
+			besterror = error;
+			table = t;
+			for (int k = 0; k < 8; k++)
+				indices[pixels[k]] = tableindices[k];
+		}
+	}
+
+	return besterror;
+}
+
+struct ETCSubblock
+{
+	int q[3];
+	int table;
+	int error;
+};
+
+// Finds the quantized base color for a subblock, optionally searching the
+// neighbors of its average color.
+ETCSubblock searchSubblock(const Block &block, const int pixels[8], int bits, bool search, uint8 indices[16])
+{
+	int maxq = (1 << bits) - 1;
+
+	float average[3] = {};
+	for (int k = 0; k < 8; k++)
+	{
+		for (int c = 0; c < 3; c++)
+			average[c] += block[pixels[k]][c];
+	}
+
+	int center[3];
+	for (int c = 0; c < 3; c++)
+		center[c] = (int) lroundf(average[c] / 8.0f * maxq / 255.0f);
+
+	ETCSubblock best = {};
+	best.error = INT_MAX;
+
+	int range = search ? 1 : 0;
+	uint8 candidateindices[16];
+
+	for (int dr = -range; dr <= range; dr++)
+	for (int dg = -range; dg <= range; dg++)
+	for (int db = -range; db <= range; db++)
+	{
+		ETCSubblock candidate;
+		candidate.q[0] = std::min(std::max(center[0] + dr, 0), maxq);
+		candidate.q[1] = std::min(std::max(center[1] + dg, 0), maxq);
+		candidate.q[2] = std::min(std::max(center[2] + db, 0), maxq);
+
+		int base[3];
+		for (int c = 0; c < 3; c++)
+		{
+			if (bits == 4)
+				base[c] = (candidate.q[c] << 4) | candidate.q[c];
+			else
+				base[c] = (candidate.q[c] << 3) | (candidate.q[c] >> 2);
+		}
+
+		candidate.error = evaluateSubblock(block, pixels, base, candidate.table, candidateindices);
+
+		if (candidate.error < best.error)
+		{
+			best = candidate;
+			for (int k = 0; k < 8; k++)
+				indices[pixels[k]] = candidateindices[pixels[k]];
+		}
+	}
+
+	return best;
+}
+
+void encodeETCColorBlock(const Block &block, CompressQuality quality, uint8 *dst)
+{
+	bool search = quality == COMPRESS_QUALITY_HIGH;
+
+	int besterror = INT_MAX;
+	uint32 besthi = 0;
+	uint8 bestindices[16] = {};
+
+	for (int flip = 0; flip < 2; flip++)
+	{
+		int pixels[2][8];
+		getSubblockPixels(flip, 0, pixels[0]);
+		getSubblockPixels(flip, 1, pixels[1]);
+
+		uint8 indices[16];
+
+		// Differential mode: a 5 bit color for the first half, and a signed 3
+		// bit offset from it for the second.
+		ETCSubblock d0 = searchSubblock(block, pixels[0], 5, search, indices);
+		ETCSubblock d1 = searchSubblock(block, pixels[1], 5, search, indices);
+
+		int delta[3];
+		bool diffvalid = true;
+		for (int c = 0; c < 3; c++)
+		{
+			delta[c] = d1.q[c] - d0.q[c];
+			diffvalid = diffvalid && delta[c] >= -4 && delta[c] <= 3;
+		}
+
+		if (diffvalid && d0.error + d1.error < besterror)
+		{
+			besterror = d0.error + d1.error;
+			besthi = ((uint32) d0.q[0] << 27) | ((uint32) (delta[0] & 7) << 24)
+			       | ((uint32) d0.q[1] << 19) | ((uint32) (delta[1] & 7) << 16)
+			       | ((uint32) d0.q[2] << 11) | ((uint32) (delta[2] & 7) << 8)
+			       | (uint32) ((d0.table << 5) | (d1.table << 2) | (1 << 1) | flip);
+			memcpy(bestindices, indices, sizeof(indices));
+		}
+
+		if (diffvalid && quality == COMPRESS_QUALITY_FAST)
+			continue;
+
+		// Individual mode: a 4 bit color for each half.
+		ETCSubblock i0 = searchSubblock(block, pixels[0], 4, search, indices);
+		ETCSubblock i1 = searchSubblock(block, pixels[1], 4, search, indices);
+
+		if (i0.error + i1.error < besterror)
+		{
+			besterror = i0.error + i1.error;
+			besthi = ((uint32) i0.q[0] << 28) | ((uint32) i1.q[0] << 24)
+			       | ((uint32) i0.q[1] << 20) | ((uint32) i1.q[1] << 16)
+			       | ((uint32) i0.q[2] << 12) | ((uint32) i1.q[2] << 8)
+			       | (uint32) ((i0.table << 5) | (i1.table << 2) | flip);
+			memcpy(bestindices, indices, sizeof(indices));
+		}
+	}
+
+	// Pixel indices are stored column by column, split into their high and
+	// low bits.
+	uint32 lo = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int bit = (i % 4) * 4 + (i / 4);
+		lo |= (uint32) ((bestindices[i] >> 1) & 1) << (16 + bit);
+		lo |= (uint32) (bestindices[i] & 1) << bit;
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		dst[i] = (uint8) (besthi >> (24 - i * 8));
+		dst[4 + i] = (uint8) (lo >> (24 - i * 8));
+	}
+}
+
+// ETC2 RGBA alpha blocks (EAC).
+
+const int eacModifiers[16][8] =
+{
+	{ -3, -6,  -9, -15, 2, 5, 8, 14 },
+	{ -3, -7, -10, -13, 2, 6, 9, 12 },
+	{ -2, -5,  -8, -13, 1, 4, 7, 12 },
+	{ -2, -4,  -6, -13, 1, 3, 5, 12 },
+	{ -3, -6,  -8, -12, 2, 5, 7, 11 },
+	{ -3, -7,  -9, -11, 2, 6, 8, 10 },
+	{ -4, -7,  -8, -11, 3, 6, 7, 10 },
+	{ -3, -5,  -8, -11, 2, 4, 7, 10 },
+	{ -2, -6,  -8, -10, 1, 5, 7,  9 },
+	{ -2, -5,  -8, -10, 1, 4, 7,  9 },
+	{ -2, -4,  -8, -10, 1, 3, 7,  9 },
+	{ -2, -5,  -7, -10, 1, 4, 6,  9 },
+	{ -3, -4,  -7, -10, 2, 3, 6,  9 },
+	{ -1, -2,  -3, -10, 0, 1, 2,  9 },
+	{ -4, -6,  -8,  -9, 3, 5, 7,  8 },
+	{ -3, -5,  -7,  -9, 2, 4, 6,  8 },
+};
+
+int findEACIndices(const Block &block, int base, int multiplier, int table, uint8 indices[16], int maxerror)
+{
+	int error = 0;
+
+	for (int i = 0; i < 16 && error < maxerror; i++)
+	{
+		int best = INT_MAX;
+
+		for (int m = 0; m < 8; m++)
+		{
+			int d = square(clamp255(base + eacModifiers[table][m] * multiplier) - block[i][3]);
+			if (d < best)
+			{
+				best = d;
+				indices[i] = (uint8) m;
+			}
+		}
+
+		error += best;
+	}
+
+	return error;
+}
+
+void encodeEACAlphaBlock(const Block &block, CompressQuality quality, uint8 *dst)
+{
+	int amin = 255, amax = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		amin = std::min(amin, (int) block[i][3]);
+		amax = std::max(amax, (int) block[i][3]);
+	}
+
+	// Table 13 has a zero modifier, which reproduces a constant block exactly.
+	int bestbase = amin;
+	int bestmultiplier = 1;
+	int besttable = 13;
+	uint8 bestindices[16];
+	int besterror = findEACIndices(block, bestbase, bestmultiplier, besttable, bestindices, INT_MAX);
+
+	int range = quality == COMPRESS_QUALITY_FAST ? 0 : (quality == COMPRESS_QUALITY_HIGH ? 2 : 1);
+
+	for (int t = 0; t < 16 && besterror > 0; t++)
+	{
+		int modmin = eacModifiers[t][3];
+		int modmax = eacModifiers[t][7];
+
+		int center = (int) lroundf((float) (amax - amin) / (modmax - modmin));
+
+		for (int dm = -range; dm <= range; dm++)
+		{
+			int multiplier = std::min(std::max(center + dm, 1), 15);
+			int basecenter = (int) lroundf((amin + amax) / 2.0f - (modmin + modmax) * multiplier / 2.0f);
+
+			for (int db = -range; db <= range; db++)
+			{
+				int base = clamp255(basecenter + db);
+
+				uint8 indices[16];
+				int error = findEACIndices(block, base, multiplier, t, indices, besterror);
+
+				if (error < besterror)
+				{
+					besterror = error;
+					bestbase = base;
+					bestmultiplier = multiplier;
+					besttable = t;
+					memcpy(bestindices, indices, sizeof(indices));
+				}
+			}
+		}
+	}
+
+	// Indices are 3 bits each, stored column by column, most significant
+	// first.
+	uint64 bits = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int k = (i % 4) * 4 + (i / 4);
+		bits |= (uint64) bestindices[i] << (45 - k * 3);
+	}
+
+	dst[0] = (uint8) bestbase;
+	dst[1] = (uint8) ((bestmultiplier << 4) | besttable);
+
+	for (int i = 0; i < 6; i++)
+		dst[2 + i] = (uint8) ((bits >> (40 - i * 8)) & 0xFF);
+}
+
+void encodeBlock(PixelFormat format, CompressQuality quality, const Block &block, uint8 *dst)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT1_sRGB:
+		encodeColorBlock(block, quality, dst);
+		break;
+	case PIXELFORMAT_DXT5_UNORM:
+	case PIXELFORMAT_DXT5_sRGB:
+		encodeAlphaBlock(block, quality, dst);
+		encodeColorBlock(block, quality, dst + 8);
+		break;
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_BC7_sRGB:
+		encodeBC7Block(block, quality, dst);
+		break;
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+		encodeETCColorBlock(block, quality, dst);
+		break;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		encodeEACAlphaBlock(block, quality, dst);
+		encodeETCColorBlock(block, quality, dst + 8);
+		break;
+	default:
+		break;
+	}
+}
+
+} // anonymous namespace
+
+bool isBlockCompressible(PixelFormat format)
+{
+	switch (getLinearPixelFormat(format))
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT5_UNORM:
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void compressBlocks(PixelFormat format, CompressQuality quality, const uint8 *rgba, int width, int height, uint8 *dst)
+{
+	if (!isBlockCompressible(format))
+		throw love::Exception("Cannot compress to the %s pixel format.", getPixelFormatName(format));
+
+	size_t blocksize = getPixelFormatBlockSize(format);
+	int blockswide = (width + 3) / 4;
+	int blockshigh = (height + 3) / 4;
+
+	auto pool = love::thread::ThreadPool::getShared();
+
+	pool->parallelFor(blockshigh, 1, [&](size_t begin, size_t end)
+	{
+		Block block;
+
+		for (int by = (int) begin; by < (int) end; by++)
+		{
+			uint8 *row = dst + (size_t) by * blockswide * blocksize;
+
+			for (int bx = 0; bx < blockswide; bx++)
+			{
+				fetchBlock(rgba, width, height, bx, by, block);
+				encodeBlock(format, quality, block, row + bx * blocksize);
+			}
+		}
+	});
+}
+
+STRINGMAP_BEGIN(CompressQuality, COMPRESS_QUALITY_MAX_ENUM, compressQuality)
+{
+	{ "fast",   COMPRESS_QUALITY_FAST   },
+	{ "normal", COMPRESS_QUALITY_NORMAL },
+	{ "high",   COMPRESS_QUALITY_HIGH   },
+}
+STRINGMAP_END(CompressQuality, COMPRESS_QUALITY_MAX_ENUM, compressQuality)
+
+} // image
+} // love
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/pixelformat.h"
+#include "common/StringMap.h"
+
+namespace love
+{
+namespace image
+{
+
+enum CompressQuality
+{
+	COMPRESS_QUALITY_FAST,
+	COMPRESS_QUALITY_NORMAL,
+	COMPRESS_QUALITY_HIGH,
+	COMPRESS_QUALITY_MAX_ENUM
+};
+
+/**
+ * Whether compressBlocks can encode to the given pixel format.
+ **/
+bool isBlockCompressible(PixelFormat format);
+
+/**
+ * Encodes RGBA8 pixels into 4x4 blocks of the given compressed format, using
+ * the shared thread pool. Edge blocks of images whose dimensions aren't a
+ * multiple of 4 repeat the last row and column.
+ *
+ * Supported formats are DXT1 (BC1), DXT5 (BC3), BC7, ETC2 RGB and ETC2 RGBA.
+ * BC7 blocks only use mode 6, and ETC2 RGB blocks only use the modes shared
+ * with ETC1.
+ **/
+void compressBlocks(PixelFormat format, CompressQuality quality, const uint8 *rgba, int width, int height, uint8 *dst);
+
+STRINGMAP_DECLARE(CompressQuality);
+
+} // image
+} // love
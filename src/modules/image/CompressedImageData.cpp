@@ -61,6 +61,15 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler *> &forma
 	format = getLinearPixelFormat(format);
 }
 
+CompressedImageData::CompressedImageData(PixelFormat format, ByteData *memory, const std::vector<StrongRef<CompressedSlice>> &slices)
+	: format(getLinearPixelFormat(format))
+	, memory(memory)
+	, dataImages(slices)
+{
+	if (dataImages.size() == 0 || memory->getSize() == 0)
+		throw love::Exception("Compressed image data must contain at least one mipmap level.");
+}
+
 CompressedImageData::CompressedImageData(const CompressedImageData &c)
 	: format(c.format)
 {
@@ -49,6 +49,7 @@ class CompressedImageData : public Data
 	static love::Type type;
 
 	CompressedImageData(const std::list<FormatHandler *> &formats, Data *filedata);
+	CompressedImageData(PixelFormat format, ByteData *memory, const std::vector<StrongRef<CompressedSlice>> &slices);
 	CompressedImageData(const CompressedImageData &c);
 	virtual ~CompressedImageData();
 
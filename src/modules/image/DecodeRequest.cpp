@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "DecodeRequest.h"
+#include "filesystem/Filesystem.h"
+#include "timer/Timer.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace image
+{
+
+love::Type DecodeRequest::type("DecodeRequest", &Object::type);
+
+DecodeRequest::DecodeRequest(Data *data)
+	: source(data)
+	, status(STATUS_PENDING)
+{
+}
+
+DecodeRequest::DecodeRequest(const std::string &filename)
+	: filename(filename)
+	, status(STATUS_PENDING)
+{
+}
+
+DecodeRequest::~DecodeRequest()
+{
+}
+
+DecodeRequest::Status DecodeRequest::getStatus() const
+{
+	thread::Lock lock(mutex);
+	return status;
+}
+
+bool DecodeRequest::isComplete() const
+{
+	Status s = getStatus();
+	return s == STATUS_DONE || s == STATUS_ERROR || s == STATUS_CANCELLED;
+}
+
+bool DecodeRequest::cancel()
+{
+	thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return false;
+
+	// The worker thread skips requests which are no longer pending.
+	status = STATUS_CANCELLED;
+	source.set(nullptr);
+	completed->broadcast();
+	return true;
+}
+
+bool DecodeRequest::wait(double timeout)
+{
+	double start = timer::Timer::getTime();
+
+	thread::Lock lock(mutex);
+
+	while (status == STATUS_PENDING || status == STATUS_DECODING)
+	{
+		if (timeout < 0.0)
+		{
+			completed->wait(mutex);
+			continue;
+		}
+
+		double remaining = timeout - (timer::Timer::getTime() - start);
+		if (remaining <= 0.0)
+			return false;
+
+		completed->wait(mutex, std::max((int) (remaining * 1000.0), 1));
+	}
+
+	return true;
+}
+
+ImageData *DecodeRequest::getImageData() const
+{
+	thread::Lock lock(mutex);
+	return imageData.get();
+}
+
+std::string DecodeRequest::getError() const
+{
+	thread::Lock lock(mutex);
+	return error;
+}
+
+void DecodeRequest::run()
+{
+	StrongRef<Data> data;
+
+	{
+		thread::Lock lock(mutex);
+		if (status != STATUS_PENDING)
+			return;
+
+		status = STATUS_DECODING;
+		data = source;
+	}
+
+	try
+	{
+		if (!data)
+		{
+			auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+			if (fs == nullptr)
+				throw love::Exception("love.filesystem must be loaded to decode images from files.");
+
+			data.set(fs->read(filename.c_str()), Acquire::NORETAIN);
+		}
+
+		StrongRef<ImageData> result(new ImageData(data), Acquire::NORETAIN);
+		complete(STATUS_DONE, result, "");
+	}
+	catch (love::Exception &e)
+	{
+		complete(STATUS_ERROR, nullptr, e.what());
+	}
+}
+
+void DecodeRequest::complete(Status status, ImageData *imageData, const std::string &error)
+{
+	thread::Lock lock(mutex);
+
+	this->status = status;
+	this->imageData.set(imageData);
+	this->error = error;
+
+	// The encoded data isn't needed anymore.
+	source.set(nullptr);
+
+	completed->broadcast();
+}
+
+STRINGMAP_CLASS_BEGIN(DecodeRequest, DecodeRequest::Status, DecodeRequest::STATUS_MAX_ENUM, status)
+{
+	{ "pending",   DecodeRequest::STATUS_PENDING   },
+	{ "decoding",  DecodeRequest::STATUS_DECODING  },
+	{ "done",      DecodeRequest::STATUS_DONE      },
+	{ "error",     DecodeRequest::STATUS_ERROR     },
+	{ "cancelled", DecodeRequest::STATUS_CANCELLED },
+}
+STRINGMAP_CLASS_END(DecodeRequest, DecodeRequest::Status, DecodeRequest::STATUS_MAX_ENUM, status)
+
+} // image
+} // love
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_IMAGE_DECODE_REQUEST_H
+#define LOVE_IMAGE_DECODE_REQUEST_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/Data.h"
+#include "common/StringMap.h"
+#include "thread/threads.h"
+#include "ImageData.h"
+
+// C++
+#include <string>
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * Decodes an encoded image (and optionally reads it from a file first) on a
+ * worker thread. The request can be polled or waited on from any thread.
+ **/
+class DecodeRequest : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Status
+	{
+		STATUS_PENDING,
+		STATUS_DECODING,
+		STATUS_DONE,
+		STATUS_ERROR,
+		STATUS_CANCELLED,
+		STATUS_MAX_ENUM
+	};
+
+	/**
+	 * Decodes the given encoded image data.
+	 **/
+	DecodeRequest(Data *data);
+
+	/**
+	 * Reads the given file with love.filesystem, then decodes it.
+	 **/
+	DecodeRequest(const std::string &filename);
+
+	virtual ~DecodeRequest();
+
+	Status getStatus() const;
+	bool isComplete() const;
+
+	/**
+	 * Stops the request if decoding hasn't started yet.
+	 * @return Whether the request was cancelled.
+	 **/
+	bool cancel();
+
+	/**
+	 * Blocks until the request completes.
+	 * @param timeout The maximum time to wait in seconds, or a negative value
+	 *                to wait indefinitely.
+	 * @return Whether the request has completed.
+	 **/
+	bool wait(double timeout = -1.0);
+
+	/**
+	 * Gets the decoded ImageData, or null if the request hasn't completed
+	 * successfully.
+	 **/
+	ImageData *getImageData() const;
+
+	std::string getError() const;
+
+	/**
+	 * Performs the decode. Called from a worker thread.
+	 **/
+	void run();
+
+	STRINGMAP_CLASS_DECLARE(Status);
+
+private:
+
+	void complete(Status status, ImageData *imageData, const std::string &error);
+
+	StrongRef<Data> source;
+	std::string filename;
+
+	mutable thread::MutexRef mutex;
+	thread::ConditionalRef completed;
+
+	Status status;
+
+	StrongRef<ImageData> imageData;
+	std::string error;
+
+}; // DecodeRequest
+
+} // image
+} // love
+
+#endif // LOVE_IMAGE_DECODE_REQUEST_H
@@ -50,7 +50,7 @@ FormatHandler::DecodedImage FormatHandler::decode(Data* /*data*/)
 	throw love::Exception("Image decoding is not implemented for this format backend.");
 }
 
-FormatHandler::EncodedImage FormatHandler::encode(const DecodedImage& /*img*/, EncodedFormat /*format*/)
+FormatHandler::EncodedImage FormatHandler::encode(const DecodedImage& /*img*/, EncodedFormat /*format*/, const EncodeOptions& /*options*/)
 {
 	throw love::Exception("Image encoding is not implemented for this format backend.");
 }
@@ -65,6 +65,16 @@ StrongRef<ByteData> FormatHandler::parseCompressed(Data* /*filedata*/, std::vect
 	throw love::Exception("Compressed image parsing is not implemented for this format backend.");
 }
 
+bool FormatHandler::canEncodeCompressed(PixelFormat /*format*/)
+{
+	return false;
+}
+
+FormatHandler::EncodedImage FormatHandler::encodeCompressed(PixelFormat /*format*/, const std::vector<StrongRef<CompressedSlice>>& /*images*/)
+{
+	throw love::Exception("Compressed image encoding is not implemented for this format backend.");
+}
+
 void FormatHandler::freeRawPixels(unsigned char *mem)
 {
 	delete[] mem;
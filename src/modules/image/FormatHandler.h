@@ -66,6 +66,28 @@ class FormatHandler : public love::Object
 		unsigned char *data = nullptr;
 	};
 
+	// Scanline filters applied before compression, for formats that use them.
+	enum RowFilter
+	{
+		ROW_FILTER_NONE,
+		ROW_FILTER_SUB,
+		ROW_FILTER_UP,
+		ROW_FILTER_AVERAGE,
+		ROW_FILTER_PAETH,
+		ROW_FILTER_ADAPTIVE, // Picks a filter per row.
+		ROW_FILTER_MAX_ENUM
+	};
+
+	// Optional settings for encoders. Formats ignore settings they don't use.
+	struct EncodeOptions
+	{
+		// Between 0 (no compression) and 9, or -1 for the default.
+		int compressionLevel = -1;
+		RowFilter rowFilter = ROW_FILTER_ADAPTIVE;
+		// Compress independent parts of the image on multiple threads.
+		bool parallel = false;
+	};
+
 	/**
 	 * The default constructor is called when the Image module is initialized.
 	 **/
@@ -90,7 +112,7 @@ class FormatHandler : public love::Object
 	/**
 	 * Encodes an image from raw pixel data into a particular format.
 	 **/
-	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format);
+	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format, const EncodeOptions &options);
 
 	/**
 	 * Whether this format handler can parse the given Data into a
@@ -113,6 +135,17 @@ class FormatHandler : public love::Object
 	        std::vector<StrongRef<CompressedSlice>> &images,
 	        PixelFormat &format);
 
+	/**
+	 * Whether this format handler can write compressed image data with the
+	 * given pixel format to its file format.
+	 **/
+	virtual bool canEncodeCompressed(PixelFormat format);
+
+	/**
+	 * Writes a list of compressed mipmap levels into a single file.
+	 **/
+	virtual EncodedImage encodeCompressed(PixelFormat format, const std::vector<StrongRef<CompressedSlice>> &images);
+
 	/**
 	 * Frees raw pixel memory allocated by the format handler.
 	 **/
@@ -32,6 +32,15 @@
 #include "magpie/PKMHandler.h"
 #include "magpie/ASTCHandler.h"
 
+#include "data/HashFunction.h"
+#include "filesystem/Filesystem.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 namespace love
 {
 namespace image
@@ -39,6 +48,42 @@ namespace image
 
 love::Type Image::type("image", &Module::type);
 
+const char *Image::TEXTURE_CACHE_DIRECTORY = ".texturecache";
+
+// Bump this when the output of compressBlocks changes, so stale cache entries
+// are ignored.
+static const char *TEXTURE_CACHE_VERSION = "1";
+
+// Halves an RGBA8 image with a 2x2 box filter.
+static void downsample(const uint8 *src, int width, int height, std::vector<uint8> &dst)
+{
+	int dstwidth = std::max(width / 2, 1);
+	int dstheight = std::max(height / 2, 1);
+
+	dst.resize((size_t) dstwidth * dstheight * 4);
+
+	for (int y = 0; y < dstheight; y++)
+	{
+		int y0 = std::min(y * 2, height - 1);
+		int y1 = std::min(y * 2 + 1, height - 1);
+
+		for (int x = 0; x < dstwidth; x++)
+		{
+			int x0 = std::min(x * 2, width - 1);
+			int x1 = std::min(x * 2 + 1, width - 1);
+
+			const uint8 *p00 = src + ((size_t) y0 * width + x0) * 4;
+			const uint8 *p01 = src + ((size_t) y0 * width + x1) * 4;
+			const uint8 *p10 = src + ((size_t) y1 * width + x0) * 4;
+			const uint8 *p11 = src + ((size_t) y1 * width + x1) * 4;
+
+			uint8 *out = &dst[((size_t) y * dstwidth + x) * 4];
+			for (int c = 0; c < 4; c++)
+				out[c] = (uint8) ((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+		}
+	}
+}
+
 Image::Image()
 	: Module(M_IMAGE, "love.image.magpie")
 {
@@ -81,11 +126,196 @@ love::image::ImageData *Image::newImageData(int width, int height, PixelFormat f
 	return new ImageData(width, height, format, data, own);
 }
 
+DecodeRequest *Image::newImageDataAsync(Data *data, const std::string &filename)
+{
+	StrongRef<DecodeRequest> request;
+	if (data != nullptr)
+		request.set(new DecodeRequest(data), Acquire::NORETAIN);
+	else
+		request.set(new DecodeRequest(filename), Acquire::NORETAIN);
+
+	thread::ThreadPool::getShared()->submit([request]() { request->run(); });
+
+	request->retain();
+	return request;
+}
+
+void Image::decodeMany(const std::vector<DecodeRequest *> &requests)
+{
+	thread::ThreadPool *pool = thread::ThreadPool::getShared();
+	size_t threads = std::min((size_t) pool->getThreadCount() + 1, requests.size());
+
+	// Images can differ a lot in size, so each thread takes the next image in
+	// the list instead of a fixed range of them.
+	std::atomic<size_t> next(0);
+
+	pool->parallelFor(threads, 1, [&](size_t, size_t)
+	{
+		for (size_t i = next++; i < requests.size(); i = next++)
+			requests[i]->run();
+	});
+}
+
 love::image::CompressedImageData *Image::newCompressedData(Data *data)
 {
 	return new CompressedImageData(formatHandlers, data);
 }
 
+CompressedImageData *Image::compress(ImageData *src, PixelFormat format, CompressQuality quality, bool mipmaps, bool cache)
+{
+	if (src->getFormat() != PIXELFORMAT_RGBA8_UNORM)
+		throw love::Exception("Only ImageData with the rgba8 pixel format can be compressed.");
+
+	if (!isBlockCompressible(format))
+		throw love::Exception("Cannot compress ImageData to the %s pixel format.", getPixelFormatName(format));
+
+	format = getLinearPixelFormat(format);
+
+	int width = src->getWidth();
+	int height = src->getHeight();
+
+	int levels = 1;
+	if (mipmaps)
+	{
+		while ((std::max(width, height) >> levels) > 0)
+			levels++;
+	}
+
+	auto fs = cache ? Module::getInstance<filesystem::Filesystem>(M_FILESYSTEM) : nullptr;
+	std::string cachepath;
+
+	if (fs != nullptr)
+	{
+		cachepath = getTextureCachePath(src, format, quality, mipmaps);
+
+		try
+		{
+			StrongRef<filesystem::FileData> filedata(fs->read(cachepath.c_str()), Acquire::NORETAIN);
+			StrongRef<CompressedImageData> cached(new CompressedImageData(formatHandlers, filedata), Acquire::NORETAIN);
+
+			if (cached->getFormat() == format && cached->getWidth() == width
+				&& cached->getHeight() == height && cached->getMipmapCount() == levels)
+			{
+				cached->retain();
+				return cached.get();
+			}
+		}
+		catch (love::Exception &)
+		{
+			// Missing or unreadable, so compress it again.
+		}
+	}
+
+	size_t totalsize = 0;
+	for (int i = 0; i < levels; i++)
+		totalsize += getPixelFormatSliceSize(format, std::max(width >> i, 1), std::max(height >> i, 1));
+
+	StrongRef<ByteData> memory(new ByteData(totalsize, false), Acquire::NORETAIN);
+	std::vector<StrongRef<CompressedSlice>> slices;
+
+	const uint8 *pixels = (const uint8 *) src->getData();
+	std::vector<uint8> level;
+	std::vector<uint8> nextlevel;
+	size_t offset = 0;
+
+	for (int i = 0; i < levels; i++)
+	{
+		int w = std::max(width >> i, 1);
+		int h = std::max(height >> i, 1);
+		size_t size = getPixelFormatSliceSize(format, w, h);
+
+		compressBlocks(format, quality, pixels, w, h, (uint8 *) memory->getData() + offset);
+
+		auto slice = new CompressedSlice(format, w, h, memory, offset, size);
+		slices.push_back(slice);
+		slice->release();
+
+		offset += size;
+
+		if (i + 1 < levels)
+		{
+			downsample(pixels, w, h, nextlevel);
+			level.swap(nextlevel);
+			pixels = level.data();
+		}
+	}
+
+	StrongRef<CompressedImageData> compressed(new CompressedImageData(format, memory, slices), Acquire::NORETAIN);
+
+	if (fs != nullptr)
+		saveTextureCache(cachepath, compressed);
+
+	compressed->retain();
+	return compressed.get();
+}
+
+std::string Image::getTextureCachePath(ImageData *src, PixelFormat format, CompressQuality quality, bool mipmaps) const
+{
+	using love::data::HashFunction;
+
+	const char *qualityname = nullptr;
+	getConstant(quality, qualityname);
+
+	std::string settings = std::string(TEXTURE_CACHE_VERSION) + " " + getPixelFormatName(format)
+		+ " " + (qualityname ? qualityname : "") + " " + (mipmaps ? "mipmaps" : "nomipmaps")
+		+ " " + std::to_string(src->getWidth()) + "x" + std::to_string(src->getHeight());
+
+	HashFunction::Function function = HashFunction::FUNCTION_XXH3_128;
+	std::unique_ptr<HashFunction::State> state(HashFunction::getHashFunction(function)->newState(function));
+
+	state->update(settings.c_str(), settings.size() + 1);
+	state->update((const char *) src->getData(), src->getSize());
+
+	HashFunction::Value hash = {};
+	state->digest(hash);
+
+	static const char hexchars[] = "0123456789abcdef";
+
+	std::string path = std::string(TEXTURE_CACHE_DIRECTORY) + "/";
+	for (size_t i = 0; i < hash.size; i++)
+	{
+		path += hexchars[(hash.data[i] >> 4) & 0xF];
+		path += hexchars[hash.data[i] & 0xF];
+	}
+
+	return path + ".ktx";
+}
+
+void Image::saveTextureCache(const std::string &path, CompressedImageData *data) const
+{
+	auto fs = Module::getInstance<filesystem::Filesystem>(M_FILESYSTEM);
+	if (fs == nullptr)
+		return;
+
+	PixelFormat format = data->getFormat();
+
+	std::vector<StrongRef<CompressedSlice>> slices;
+	for (int i = 0; i < data->getMipmapCount(); i++)
+		slices.push_back(data->getSlice(0, i));
+
+	for (FormatHandler *handler : formatHandlers)
+	{
+		if (!handler->canEncodeCompressed(format))
+			continue;
+
+		FormatHandler::EncodedImage encoded;
+
+		try
+		{
+			encoded = handler->encodeCompressed(format, slices);
+			fs->createDirectory(TEXTURE_CACHE_DIRECTORY);
+			fs->write(path.c_str(), encoded.data, encoded.size);
+		}
+		catch (love::Exception &)
+		{
+			// The cache is optional (there may not be a save directory yet.)
+		}
+
+		handler->freeEncodedImage(encoded.data);
+		break;
+	}
+}
+
 bool Image::isCompressed(Data *data)
 {
 	for (FormatHandler *handler : formatHandlers)
@@ -27,6 +27,8 @@
 #include "filesystem/File.h"
 #include "ImageData.h"
 #include "CompressedImageData.h"
+#include "DecodeRequest.h"
+#include "BlockCompressor.h"
 
 // C++
 #include <list>
@@ -78,6 +80,20 @@ class Image : public Module
 	 **/
 	ImageData *newImageData(int width, int height, PixelFormat format, void *data, bool own = false);
 
+	/**
+	 * Starts decoding encoded image data on a worker thread.
+	 * @param data The Data containing the encoded image, or null to read the
+	 *        given file with love.filesystem on the worker thread first.
+	 * @return A request which will hold the new ImageData.
+	 **/
+	DecodeRequest *newImageDataAsync(Data *data, const std::string &filename);
+
+	/**
+	 * Runs all of the given (pending) decode requests in parallel on the worker
+	 * threads and the calling thread, and returns when they've completed.
+	 **/
+	void decodeMany(const std::vector<DecodeRequest *> &requests);
+
 	/**
 	 * Creates new CompressedImageData from FileData.
 	 * @param data The FileData containing the compressed image data.
@@ -85,6 +101,17 @@ class Image : public Module
 	 **/
 	CompressedImageData *newCompressedData(Data *data);
 
+	/**
+	 * Encodes RGBA8 ImageData into a GPU-compressed format on the worker
+	 * threads.
+	 * @param mipmaps Whether to also generate and compress a full mipmap chain.
+	 * @param cache Whether to look for the result in TEXTURE_CACHE_DIRECTORY
+	 *        (keyed by a hash of the pixels and settings) before compressing,
+	 *        and to save it there afterwards.
+	 * @return The new CompressedImageData.
+	 **/
+	CompressedImageData *compress(ImageData *src, PixelFormat format, CompressQuality quality, bool mipmaps, bool cache);
+
 	/**
 	 * Determines whether a FileData is Compressed image data or not.
 	 * @param data The FileData to test.
@@ -96,8 +123,14 @@ class Image : public Module
 
 	const std::list<FormatHandler *> &getFormatHandlers() const;
 
+	// Directory in the save folder which holds results of compress().
+	static const char *TEXTURE_CACHE_DIRECTORY;
+
 private:
 
+	std::string getTextureCachePath(ImageData *src, PixelFormat format, CompressQuality quality, bool mipmaps) const;
+	void saveTextureCache(const std::string &path, CompressedImageData *data) const;
+
 	ImageData *newPastedImageData(ImageData *src, int sx, int sy, int w, int h);
 
 	// Image format handlers we can use for decoding and encoding ImageData.
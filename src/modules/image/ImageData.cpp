@@ -20,9 +20,13 @@
 
 #include "ImageData.h"
 #include "Image.h"
+#include "RowKernels.h"
+#include "common/math.h"
 #include "filesystem/Filesystem.h"
+#include "thread/ThreadPool.h"
 
 #include <algorithm> // min/max
+#include <cmath>
 
 using love::thread::Lock;
 
@@ -167,7 +171,7 @@ void ImageData::decode(Data *data)
 	pixelGetFunction = getPixelGetFunction(format);
 }
 
-love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile) const
+love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile, const FormatHandler::EncodeOptions &options) const
 {
 	FormatHandler *encoder = nullptr;
 	FormatHandler::EncodedImage encodedimage;
@@ -194,7 +198,7 @@ love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encod
 	}
 
 	if (encoder != nullptr)
-		encodedimage = encoder->encode(rawimage, encodedFormat);
+		encodedimage = encoder->encode(rawimage, encodedFormat, options);
 
 	if (encoder == nullptr || encodedimage.data == nullptr)
 		throw love::Exception("No suitable image encoder for the %s pixel format.", getPixelFormatName(format));
@@ -638,7 +642,73 @@ static void pasteRGBA32FtoRGBA16F(Row src, Row dst, int w)
 		dst.f16[i] = float32to16(src.f32[i]);
 }
 
-void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh)
+// Reads pixels as normalized float RGBA, 4 floats per pixel.
+static void loadFloatRow(const ImageData *img, int x, int y, int w, float *dst)
+{
+	PixelFormat format = img->getFormat();
+	size_t pixelsize = img->getPixelSize();
+	const uint8 *row = (const uint8 *) img->getData() + (x + (size_t) y * img->getWidth()) * pixelsize;
+
+	if (format == PIXELFORMAT_RGBA8_UNORM)
+		rowRGBA8ToFloat(row, dst, w);
+	else if (format == PIXELFORMAT_RGBA32_FLOAT)
+		memcpy(dst, row, sizeof(float) * 4 * w);
+	else
+	{
+		auto getfunction = ImageData::getPixelGetFunction(format);
+		if (getfunction == nullptr)
+			throw love::Exception("Unsupported pixel format %s.", getPixelFormatName(format));
+
+		Colorf c;
+		for (int i = 0; i < w; i++)
+		{
+			getfunction((const ImageData::Pixel *) (row + i * pixelsize), c);
+			dst[i * 4 + 0] = c.r;
+			dst[i * 4 + 1] = c.g;
+			dst[i * 4 + 2] = c.b;
+			dst[i * 4 + 3] = c.a;
+		}
+	}
+}
+
+static void storeFloatRow(ImageData *img, int x, int y, int w, const float *src)
+{
+	PixelFormat format = img->getFormat();
+	size_t pixelsize = img->getPixelSize();
+	uint8 *row = (uint8 *) img->getData() + (x + (size_t) y * img->getWidth()) * pixelsize;
+
+	if (format == PIXELFORMAT_RGBA8_UNORM)
+		rowFloatToRGBA8(src, row, w);
+	else if (format == PIXELFORMAT_RGBA32_FLOAT)
+		memcpy(row, src, sizeof(float) * 4 * w);
+	else
+	{
+		auto setfunction = ImageData::getPixelSetFunction(format);
+		if (setfunction == nullptr)
+			throw love::Exception("Unsupported pixel format %s.", getPixelFormatName(format));
+
+		for (int i = 0; i < w; i++)
+		{
+			Colorf c(src[i * 4 + 0], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
+			setfunction(c, (ImageData::Pixel *) (row + i * pixelsize));
+		}
+	}
+}
+
+// Splits rows across the shared thread pool, keeping enough pixels per task
+// that small images don't pay for the hand-off.
+template <typename RowRangeFunc>
+static void parallelRows(int rows, int width, bool parallel, const RowRangeFunc &func)
+{
+	int minrows = std::max(1, 16384 / std::max(width, 1));
+
+	if (parallel && rows > minrows)
+		love::thread::ThreadPool::getShared()->parallelFor(rows, minrows, func);
+	else if (rows > 0)
+		func(0, rows);
+}
+
+void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh, BlendMode mode)
 {
 	PixelFormat dstformat = getFormat();
 	PixelFormat srcformat = src->getFormat();
@@ -700,70 +770,314 @@ void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, in
 	auto getfunction = src->pixelGetFunction;
 	auto setfunction = pixelSetFunction;
 
+	// Rows can only be processed out of order if they don't overlap.
+	bool parallel = src != this;
+
+	if (sw <= 0)
+		return;
+
+	if (mode != BLEND_REPLACE)
+	{
+		parallelRows(sh, sw, parallel, [&](size_t begin, size_t end)
+		{
+			std::vector<float> srcrow(sw * 4);
+			std::vector<float> dstrow(sw * 4);
+
+			for (int i = (int) begin; i < (int) end; i++)
+			{
+				loadFloatRow(src, sx, sy + i, sw, srcrow.data());
+				loadFloatRow(this, dx, dy + i, sw, dstrow.data());
+				rowBlend(dstrow.data(), srcrow.data(), sw, mode);
+				storeFloatRow(this, dx, dy + i, sw, dstrow.data());
+			}
+		});
+	}
 	// If the dimensions match up, copy the entire memory stream in one go
-	if (srcformat == dstformat && (sw == dstW && dstW == srcW && sh == dstH && dstH == srcH))
+	else if (srcformat == dstformat && (sw == dstW && dstW == srcW && sh == dstH && dstH == srcH))
 	{
 		memcpy(d, s, srcpixelsize * sw * sh);
 	}
-	else if (sw > 0)
+	else
 	{
 		// Otherwise, copy each row individually.
-		for (int i = 0; i < sh; i++)
+		parallelRows(sh, sw, parallel, [&](size_t begin, size_t end)
 		{
-			Row rowsrc = {s + (sx + (i + sy) * srcW) * srcpixelsize};
-			Row rowdst = {d + (dx + (i + dy) * dstW) * dstpixelsize};
-
-			if (srcformat == dstformat)
-				memcpy(rowdst.u8, rowsrc.u8, srcpixelsize * sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA8toRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA8toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA8toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA16toRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA16toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA16toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA16FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA16FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA16FtoRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA32FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA32FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA32FtoRGBA16F(rowsrc, rowdst, sw);
-
-			else if (getfunction != nullptr && setfunction != nullptr)
+			for (int i = (int) begin; i < (int) end; i++)
 			{
-				// Slow path: convert src -> Colorf -> dst.
-				Colorf c;
-				for (int x = 0; x < sw; x++)
+				Row rowsrc = {s + (sx + (i + sy) * srcW) * srcpixelsize};
+				Row rowdst = {d + (dx + (i + dy) * dstW) * dstpixelsize};
+
+				if (srcformat == dstformat)
+					memcpy(rowdst.u8, rowsrc.u8, srcpixelsize * sw);
+
+				else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_UNORM)
+					pasteRGBA8toRGBA16(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
+					pasteRGBA8toRGBA16F(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
+					pasteRGBA8toRGBA32F(rowsrc, rowdst, sw);
+
+				else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA8_UNORM)
+					pasteRGBA16toRGBA8(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
+					pasteRGBA16toRGBA16F(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
+					pasteRGBA16toRGBA32F(rowsrc, rowdst, sw);
+
+				else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
+					pasteRGBA16FtoRGBA8(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
+					pasteRGBA16FtoRGBA16(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA32_FLOAT)
+					pasteRGBA16FtoRGBA32F(rowsrc, rowdst, sw);
+
+				else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
+					pasteRGBA32FtoRGBA8(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
+					pasteRGBA32FtoRGBA16(rowsrc, rowdst, sw);
+				else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_FLOAT)
+					pasteRGBA32FtoRGBA16F(rowsrc, rowdst, sw);
+
+				else if ((srcformat == PIXELFORMAT_RGBA8_UNORM || dstformat == PIXELFORMAT_RGBA8_UNORM)
+					&& getfunction != nullptr && setfunction != nullptr)
+				{
+					// One side can go through the SIMD row kernels.
+					float rowf[256 * 4];
+					for (int x = 0; x < sw; x += 256)
+					{
+						int n = std::min(sw - x, 256);
+						loadFloatRow(src, sx + x, sy + i, n, rowf);
+						storeFloatRow(this, dx + x, dy + i, n, rowf);
+					}
+				}
+
+				else if (getfunction != nullptr && setfunction != nullptr)
 				{
-					auto srcp = (const Pixel *) (rowsrc.u8 + x * srcpixelsize);
-					auto dstp = (Pixel *) (rowdst.u8 + x * dstpixelsize);
-					getfunction(srcp, c);
-					setfunction(c, dstp);
+					// Slow path: convert src -> Colorf -> dst.
+					Colorf c;
+					for (int x = 0; x < sw; x++)
+					{
+						auto srcp = (const Pixel *) (rowsrc.u8 + x * srcpixelsize);
+						auto dstp = (Pixel *) (rowdst.u8 + x * dstpixelsize);
+						getfunction(srcp, c);
+						setfunction(c, dstp);
+					}
 				}
+				else if (getfunction == nullptr)
+					throw love::Exception("ImageData:paste does not currently support converting from the %s pixel format.", getPixelFormatName(srcformat));
+				else
+					throw love::Exception("ImageData:paste does not currently support converting to the %s pixel format.", getPixelFormatName(dstformat));
 			}
-			else if (getfunction == nullptr)
-				throw love::Exception("ImageData:paste does not currently support converting from the %s pixel format.", getPixelFormatName(srcformat));
-			else
-				throw love::Exception("ImageData:paste does not currently support converting to the %s pixel format.", getPixelFormatName(dstformat));
+		});
+	}
+}
+
+ImageData *ImageData::convert(PixelFormat format) const
+{
+	StrongRef<ImageData> result(new ImageData(width, height, format), Acquire::NORETAIN);
+	result->paste((ImageData *) this, 0, 0, 0, 0, width, height);
+	result->retain();
+	return result.get();
+}
+
+void ImageData::premultiplyAlpha()
+{
+	if (getPixelFormatColorComponents(format) < 4)
+		return;
+
+	parallelRows(height, width, true, [&](size_t begin, size_t end)
+	{
+		std::vector<float> row(width * 4);
+		for (int y = (int) begin; y < (int) end; y++)
+		{
+			loadFloatRow(this, 0, y, width, row.data());
+			rowPremultiply(row.data(), width);
+			storeFloatRow(this, 0, y, width, row.data());
 		}
+	});
+}
+
+void ImageData::unpremultiplyAlpha()
+{
+	if (getPixelFormatColorComponents(format) < 4)
+		return;
+
+	parallelRows(height, width, true, [&](size_t begin, size_t end)
+	{
+		std::vector<float> row(width * 4);
+		for (int y = (int) begin; y < (int) end; y++)
+		{
+			loadFloatRow(this, 0, y, width, row.data());
+			rowUnpremultiply(row.data(), width);
+			storeFloatRow(this, 0, y, width, row.data());
+		}
+	});
+}
+
+static float getFilterSupport(ImageData::ResizeFilter filter)
+{
+	switch (filter)
+	{
+	case ImageData::RESIZE_BOX:
+		return 0.5f;
+	case ImageData::RESIZE_LANCZOS:
+		return 3.0f;
+	case ImageData::RESIZE_BILINEAR:
+	default:
+		return 1.0f;
 	}
 }
 
+static float sinc(float x)
+{
+	if (x == 0.0f)
+		return 1.0f;
+	x *= (float) LOVE_M_PI;
+	return sinf(x) / x;
+}
+
+static float getFilterWeight(ImageData::ResizeFilter filter, float x)
+{
+	x = fabsf(x);
+
+	switch (filter)
+	{
+	case ImageData::RESIZE_BOX:
+		return x < 0.5f ? 1.0f : 0.0f;
+	case ImageData::RESIZE_LANCZOS:
+		return x < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+	case ImageData::RESIZE_BILINEAR:
+	default:
+		return x < 1.0f ? 1.0f - x : 0.0f;
+	}
+}
+
+static ResampleWeights computeResampleWeights(int srcsize, int dstsize, ImageData::ResizeFilter filter)
+{
+	// When shrinking, the filter is widened to cover every source pixel.
+	float scale = (float) dstsize / (float) srcsize;
+	float filterscale = std::max(1.0f / scale, 1.0f);
+	float support = getFilterSupport(filter) * filterscale;
+
+	ResampleWeights w;
+	w.stride = (int) ceilf(support * 2.0f) + 2;
+	w.first.resize(dstsize);
+	w.count.resize(dstsize);
+	w.weights.resize((size_t) dstsize * w.stride);
+
+	for (int i = 0; i < dstsize; i++)
+	{
+		float *taps = &w.weights[(size_t) i * w.stride];
+		float center = (i + 0.5f) / scale;
+
+		int first = std::max((int) floorf(center - support), 0);
+		int last = std::min((int) ceilf(center + support), srcsize - 1);
+
+		int count = 0;
+		float total = 0.0f;
+
+		for (int j = first; j <= last && count < w.stride; j++)
+		{
+			float weight = getFilterWeight(filter, (j + 0.5f - center) / filterscale);
+
+			// Skip leading zero taps so the loop doesn't have to.
+			if (count == 0 && weight == 0.0f)
+			{
+				first++;
+				continue;
+			}
+
+			taps[count++] = weight;
+			total += weight;
+		}
+
+		while (count > 0 && taps[count - 1] == 0.0f)
+			count--;
+
+		if (count == 0 || total == 0.0f)
+		{
+			first = std::min(std::max((int) center, 0), srcsize - 1);
+			taps[0] = 1.0f;
+			count = 1;
+		}
+		else
+		{
+			for (int k = 0; k < count; k++)
+				taps[k] /= total;
+		}
+
+		w.first[i] = first;
+		w.count[i] = count;
+	}
+
+	return w;
+}
+
+ImageData *ImageData::resize(int newwidth, int newheight, ResizeFilter filter) const
+{
+	if (newwidth <= 0 || newheight <= 0)
+		throw love::Exception("Invalid ImageData dimensions.");
+
+	StrongRef<ImageData> result(new ImageData(newwidth, newheight, format), Acquire::NORETAIN);
+
+	ResampleWeights hweights = computeResampleWeights(width, newwidth, filter);
+	ResampleWeights vweights = computeResampleWeights(height, newheight, filter);
+
+	// Horizontal pass into an intermediate float image, then vertical pass
+	// straight into the destination.
+	std::vector<float> temp((size_t) height * newwidth * 4);
+
+	parallelRows(height, width, true, [&](size_t begin, size_t end)
+	{
+		std::vector<float> row(width * 4);
+		for (int y = (int) begin; y < (int) end; y++)
+		{
+			loadFloatRow(this, 0, y, width, row.data());
+			rowResample(row.data(), &temp[(size_t) y * newwidth * 4], hweights);
+		}
+	});
+
+	parallelRows(newheight, newwidth, true, [&](size_t begin, size_t end)
+	{
+		std::vector<float> row(newwidth * 4);
+		for (int y = (int) begin; y < (int) end; y++)
+		{
+			const float *taps = &vweights.weights[(size_t) y * vweights.stride];
+			int first = vweights.first[y];
+
+			std::fill(row.begin(), row.end(), 0.0f);
+			for (int k = 0; k < vweights.count[y]; k++)
+				rowAddScaled(row.data(), &temp[(size_t) (first + k) * newwidth * 4], taps[k], newwidth);
+
+			storeFloatRow(result, 0, y, newwidth, row.data());
+		}
+	});
+
+	result->retain();
+	return result.get();
+}
+
+std::vector<StrongRef<ImageData>> ImageData::generateMipmaps(ResizeFilter filter) const
+{
+	std::vector<StrongRef<ImageData>> mipmaps;
+
+	const ImageData *prev = this;
+	int w = width;
+	int h = height;
+
+	while (w > 1 || h > 1)
+	{
+		w = std::max(w / 2, 1);
+		h = std::max(h / 2, 1);
+
+		StrongRef<ImageData> mip(prev->resize(w, h, filter), Acquire::NORETAIN);
+		mipmaps.push_back(mip);
+		prev = mip.get();
+	}
+
+	return mipmaps;
+}
+
 size_t ImageData::getPixelSize() const
 {
 	return getPixelFormatBlockSize(format);
@@ -839,6 +1153,21 @@ std::vector<std::string> ImageData::getConstants(FormatHandler::EncodedFormat)
 	return encodedFormats.getNames();
 }
 
+bool ImageData::getConstant(const char *in, FormatHandler::RowFilter &out)
+{
+	return rowFilters.find(in, out);
+}
+
+bool ImageData::getConstant(FormatHandler::RowFilter in, const char *&out)
+{
+	return rowFilters.find(in, out);
+}
+
+std::vector<std::string> ImageData::getConstants(FormatHandler::RowFilter)
+{
+	return rowFilters.getNames();
+}
+
 StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry ImageData::encodedFormatEntries[] =
 {
 	{"tga", FormatHandler::ENCODED_TGA},
@@ -848,5 +1177,38 @@ StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry
 
 StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> ImageData::encodedFormats(ImageData::encodedFormatEntries, sizeof(ImageData::encodedFormatEntries));
 
+StringMap<FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM>::Entry ImageData::rowFilterEntries[] =
+{
+	{"none",     FormatHandler::ROW_FILTER_NONE    },
+	{"sub",      FormatHandler::ROW_FILTER_SUB     },
+	{"up",       FormatHandler::ROW_FILTER_UP      },
+	{"average",  FormatHandler::ROW_FILTER_AVERAGE },
+	{"paeth",    FormatHandler::ROW_FILTER_PAETH   },
+	{"adaptive", FormatHandler::ROW_FILTER_ADAPTIVE},
+};
+
+StringMap<FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM> ImageData::rowFilters(ImageData::rowFilterEntries, sizeof(ImageData::rowFilterEntries));
+
+STRINGMAP_CLASS_BEGIN(ImageData, ImageData::ResizeFilter, ImageData::RESIZE_MAX_ENUM, resizeFilter)
+{
+	{ "box",      ImageData::RESIZE_BOX      },
+	{ "bilinear", ImageData::RESIZE_BILINEAR },
+	{ "lanczos",  ImageData::RESIZE_LANCZOS  },
+}
+STRINGMAP_CLASS_END(ImageData, ImageData::ResizeFilter, ImageData::RESIZE_MAX_ENUM, resizeFilter)
+
+STRINGMAP_CLASS_BEGIN(ImageData, ImageData::BlendMode, ImageData::BLEND_MAX_ENUM, blendMode)
+{
+	{ "replace",  ImageData::BLEND_REPLACE  },
+	{ "alpha",    ImageData::BLEND_ALPHA    },
+	{ "add",      ImageData::BLEND_ADD      },
+	{ "subtract", ImageData::BLEND_SUBTRACT },
+	{ "multiply", ImageData::BLEND_MULTIPLY },
+	{ "lighten",  ImageData::BLEND_LIGHTEN  },
+	{ "darken",   ImageData::BLEND_DARKEN   },
+	{ "screen",   ImageData::BLEND_SCREEN   },
+}
+STRINGMAP_CLASS_END(ImageData, ImageData::BlendMode, ImageData::BLEND_MAX_ENUM, blendMode)
+
 } // image
 } // love
@@ -59,6 +59,29 @@ class ImageData : public ImageDataBase
 	typedef void (*PixelSetFunction)(const Colorf &c, Pixel *p);
 	typedef void (*PixelGetFunction)(const Pixel *p, Colorf &c);
 
+	enum ResizeFilter
+	{
+		RESIZE_BOX,
+		RESIZE_BILINEAR,
+		RESIZE_LANCZOS,
+		RESIZE_MAX_ENUM
+	};
+
+	// Blend modes for paste, matching love.graphics' modes with alpha
+	// multiplication. Replace copies the source exactly.
+	enum BlendMode
+	{
+		BLEND_REPLACE,
+		BLEND_ALPHA,
+		BLEND_ADD,
+		BLEND_SUBTRACT,
+		BLEND_MULTIPLY,
+		BLEND_LIGHTEN,
+		BLEND_DARKEN,
+		BLEND_SCREEN,
+		BLEND_MAX_ENUM
+	};
+
 	static love::Type type;
 
 	ImageData(Data *data);
@@ -76,8 +99,31 @@ class ImageData : public ImageDataBase
 	 * @param sy The source y-coordinate.
 	 * @param sw The source width.
 	 * @param sh The source height.
+	 * @param mode How to combine the source with existing pixels.
 	 **/
-	void paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh);
+	void paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh, BlendMode mode = BLEND_REPLACE);
+
+	/**
+	 * Creates a copy of this ImageData with a different pixel format.
+	 **/
+	ImageData *convert(PixelFormat format) const;
+
+	/**
+	 * Multiplies (or divides) the color channels of every pixel by alpha.
+	 **/
+	void premultiplyAlpha();
+	void unpremultiplyAlpha();
+
+	/**
+	 * Creates a resampled copy of this ImageData with the given size.
+	 **/
+	ImageData *resize(int width, int height, ResizeFilter filter) const;
+
+	/**
+	 * Creates each successively halved mipmap level below this one, down to
+	 * 1x1.
+	 **/
+	std::vector<StrongRef<ImageData>> generateMipmaps(ResizeFilter filter) const;
 
 	/**
 	 * Checks whether a position is inside this ImageData. Useful for checking bounds.
@@ -107,8 +153,9 @@ class ImageData : public ImageDataBase
 	 * Encodes raw pixel data into a given format.
 	 * @param f The file to save the encoded image data to.
 	 * @param format The format of the encoded data.
+	 * @param options Compression settings passed to the encoder.
 	 **/
-	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
+	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile, const FormatHandler::EncodeOptions &options = FormatHandler::EncodeOptions()) const;
 
 	// Implements ImageDataBase.
 	ImageData *clone() const override;
@@ -129,6 +176,13 @@ class ImageData : public ImageDataBase
 	static bool getConstant(FormatHandler::EncodedFormat in, const char *&out);
 	static std::vector<std::string> getConstants(FormatHandler::EncodedFormat);
 
+	static bool getConstant(const char *in, FormatHandler::RowFilter &out);
+	static bool getConstant(FormatHandler::RowFilter in, const char *&out);
+	static std::vector<std::string> getConstants(FormatHandler::RowFilter);
+
+	STRINGMAP_CLASS_DECLARE(ResizeFilter);
+	STRINGMAP_CLASS_DECLARE(BlendMode);
+
 private:
 
 	// Create imagedata. Initialize with data if not null.
@@ -150,6 +204,9 @@ class ImageData : public ImageDataBase
 	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry encodedFormatEntries[];
 	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> encodedFormats;
 
+	static StringMap<FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM>::Entry rowFilterEntries[];
+	static StringMap<FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM> rowFilters;
+
 }; // ImageData
 
 } // image
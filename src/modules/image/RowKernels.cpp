@@ -0,0 +1,337 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "RowKernels.h"
+#include "common/config.h"
+
+// C++
+#include <algorithm>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace image
+{
+
+namespace
+{
+
+// Minimal 4-wide float vector, one RGBA pixel per vector.
+
+#if defined(LOVE_SIMD_SSE)
+
+typedef __m128 float4;
+
+inline float4 load4(const float *p) { return _mm_loadu_ps(p); }
+inline void store4(float *p, float4 v) { _mm_storeu_ps(p, v); }
+inline float4 splat4(float x) { return _mm_set1_ps(x); }
+inline float4 set4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline float4 add4(float4 a, float4 b) { return _mm_add_ps(a, b); }
+inline float4 sub4(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+inline float4 mul4(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+inline float4 min4(float4 a, float4 b) { return _mm_min_ps(a, b); }
+inline float4 max4(float4 a, float4 b) { return _mm_max_ps(a, b); }
+
+// Returns (a, a, a, w), where a is the pixel's alpha.
+inline float4 alphaFactor4(float4 v, float w)
+{
+	float4 t = _mm_shuffle_ps(v, _mm_set1_ps(w), _MM_SHUFFLE(0, 0, 3, 3));
+	return _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 0, 0, 0));
+}
+
+inline float4 splatAlpha4(float4 v)
+{
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+#elif defined(LOVE_SIMD_NEON)
+
+typedef float32x4_t float4;
+
+inline float4 load4(const float *p) { return vld1q_f32(p); }
+inline void store4(float *p, float4 v) { vst1q_f32(p, v); }
+inline float4 splat4(float x) { return vdupq_n_f32(x); }
+inline float4 set4(float x, float y, float z, float w) { float v[4] = {x, y, z, w}; return vld1q_f32(v); }
+inline float4 add4(float4 a, float4 b) { return vaddq_f32(a, b); }
+inline float4 sub4(float4 a, float4 b) { return vsubq_f32(a, b); }
+inline float4 mul4(float4 a, float4 b) { return vmulq_f32(a, b); }
+inline float4 min4(float4 a, float4 b) { return vminq_f32(a, b); }
+inline float4 max4(float4 a, float4 b) { return vmaxq_f32(a, b); }
+
+inline float4 alphaFactor4(float4 v, float w)
+{
+	return vsetq_lane_f32(w, vdupq_n_f32(vgetq_lane_f32(v, 3)), 3);
+}
+
+inline float4 splatAlpha4(float4 v)
+{
+	return vdupq_n_f32(vgetq_lane_f32(v, 3));
+}
+
+#else
+
+struct float4
+{
+	float v[4];
+};
+
+inline float4 load4(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store4(float *p, float4 a) { for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+inline float4 splat4(float x) { return {{x, x, x, x}}; }
+inline float4 set4(float x, float y, float z, float w) { return {{x, y, z, w}}; }
+inline float4 add4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+inline float4 sub4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+inline float4 mul4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+inline float4 min4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+inline float4 max4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+
+inline float4 alphaFactor4(float4 v, float w)
+{
+	return {{v.v[3], v.v[3], v.v[3], w}};
+}
+
+inline float4 splatAlpha4(float4 v)
+{
+	return splat4(v.v[3]);
+}
+
+#endif
+
+template <typename BlendFunc>
+void blendLoop(float *dst, const float *src, int width, BlendFunc blend)
+{
+	for (int i = 0; i < width * 4; i += 4)
+		store4(dst + i, blend(load4(src + i), load4(dst + i)));
+}
+
+} // anonymous namespace
+
+void rowRGBA8ToFloat(const uint8 *src, float *dst, int width)
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+	for (; i + 4 <= width; i += 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i * 4));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+
+		_mm_storeu_ps(dst + i * 4 + 0,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + i * 4 + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + i * 4 + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(dst + i * 4 + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+
+	for (; i + 4 <= width; i += 4)
+	{
+		uint8x16_t v = vld1q_u8(src + i * 4);
+		uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+
+		vst1q_f32(dst + i * 4 + 0,  vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+		vst1q_f32(dst + i * 4 + 4,  vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+		vst1q_f32(dst + i * 4 + 8,  vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+		vst1q_f32(dst + i * 4 + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+	}
+#endif
+
+	for (; i < width; i++)
+	{
+		for (int c = 0; c < 4; c++)
+			dst[i * 4 + c] = src[i * 4 + c] * (1.0f / 255.0f);
+	}
+}
+
+void rowFloatToRGBA8(const float *src, uint8 *dst, int width)
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	for (; i + 4 <= width; i += 4)
+	{
+		__m128i p[4];
+		for (int k = 0; k < 4; k++)
+		{
+			__m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i * 4 + k * 4), zero), one);
+			p[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+		}
+
+		__m128i lo = _mm_packs_epi32(p[0], p[1]);
+		__m128i hi = _mm_packs_epi32(p[2], p[3]);
+		_mm_storeu_si128((__m128i *) (dst + i * 4), _mm_packus_epi16(lo, hi));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t scale = vdupq_n_f32(255.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+
+	for (; i + 4 <= width; i += 4)
+	{
+		uint16x4_t p[4];
+		for (int k = 0; k < 4; k++)
+		{
+			float32x4_t v = vminq_f32(vmaxq_f32(vld1q_f32(src + i * 4 + k * 4), zero), one);
+			p[k] = vmovn_u32(vcvtq_u32_f32(vmlaq_f32(half, v, scale)));
+		}
+
+		uint8x8_t lo = vmovn_u16(vcombine_u16(p[0], p[1]));
+		uint8x8_t hi = vmovn_u16(vcombine_u16(p[2], p[3]));
+		vst1q_u8(dst + i * 4, vcombine_u8(lo, hi));
+	}
+#endif
+
+	for (; i < width; i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			float v = std::min(std::max(src[i * 4 + c], 0.0f), 1.0f);
+			dst[i * 4 + c] = (uint8) (v * 255.0f + 0.5f);
+		}
+	}
+}
+
+void rowPremultiply(float *rgba, int width)
+{
+	for (int i = 0; i < width * 4; i += 4)
+	{
+		float4 v = load4(rgba + i);
+		store4(rgba + i, mul4(v, alphaFactor4(v, 1.0f)));
+	}
+}
+
+void rowUnpremultiply(float *rgba, int width)
+{
+	for (int i = 0; i < width * 4; i += 4)
+	{
+		float a = rgba[i + 3];
+		float inv = a > 0.0f ? 1.0f / a : 1.0f;
+		store4(rgba + i, mul4(load4(rgba + i), set4(inv, inv, inv, 1.0f)));
+	}
+}
+
+void rowAddScaled(float *dst, const float *src, float scale, int width)
+{
+	float4 s = splat4(scale);
+
+	for (int i = 0; i < width * 4; i += 4)
+		store4(dst + i, add4(load4(dst + i), mul4(load4(src + i), s)));
+}
+
+void rowResample(const float *src, float *dst, const ResampleWeights &weights)
+{
+	int width = (int) weights.first.size();
+
+	for (int i = 0; i < width; i++)
+	{
+		const float *taps = &weights.weights[(size_t) i * weights.stride];
+		const float *s = src + weights.first[i] * 4;
+		int count = weights.count[i];
+
+		float4 sum = splat4(0.0f);
+		for (int k = 0; k < count; k++)
+			sum = add4(sum, mul4(load4(s + k * 4), splat4(taps[k])));
+
+		store4(dst + i * 4, sum);
+	}
+}
+
+void rowBlend(float *dst, const float *src, int width, ImageData::BlendMode mode)
+{
+	const float4 one = splat4(1.0f);
+
+	// Source colors are straight (non-premultiplied) alpha. Modes which use
+	// the source alpha composite the destination alpha with "over".
+	switch (mode)
+	{
+	case ImageData::BLEND_REPLACE:
+	case ImageData::BLEND_MAX_ENUM:
+		std::copy(src, src + width * 4, dst);
+		break;
+	case ImageData::BLEND_ALPHA:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return add4(mul4(s, alphaFactor4(s, 1.0f)), mul4(d, sub4(one, splatAlpha4(s))));
+		});
+		break;
+	case ImageData::BLEND_ADD:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return add4(d, mul4(s, alphaFactor4(s, 0.0f)));
+		});
+		break;
+	case ImageData::BLEND_SUBTRACT:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return sub4(d, mul4(s, alphaFactor4(s, 0.0f)));
+		});
+		break;
+	case ImageData::BLEND_MULTIPLY:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return mul4(s, d);
+		});
+		break;
+	case ImageData::BLEND_LIGHTEN:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return max4(s, d);
+		});
+		break;
+	case ImageData::BLEND_DARKEN:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			return min4(s, d);
+		});
+		break;
+	case ImageData::BLEND_SCREEN:
+		blendLoop(dst, src, width, [&](float4 s, float4 d)
+		{
+			float4 ps = mul4(s, alphaFactor4(s, 1.0f));
+			return add4(ps, mul4(d, sub4(one, ps)));
+		});
+		break;
+	}
+}
+
+} // image
+} // love
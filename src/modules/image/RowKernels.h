@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "ImageData.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * Row kernels for bulk ImageData operations. Rows are normalized float RGBA,
+ * 4 floats per pixel. Each kernel has SSE, NEON and plain C++ versions.
+ **/
+
+// Precomputed filter taps for resampling one axis.
+struct ResampleWeights
+{
+	// Per output pixel: index of the first source pixel and number of taps.
+	std::vector<int> first;
+	std::vector<int> count;
+
+	// Taps for output pixel i start at i * stride.
+	std::vector<float> weights;
+	int stride = 0;
+};
+
+void rowRGBA8ToFloat(const uint8 *src, float *dst, int width);
+void rowFloatToRGBA8(const float *src, uint8 *dst, int width);
+
+void rowPremultiply(float *rgba, int width);
+void rowUnpremultiply(float *rgba, int width);
+
+// dst[i] += src[i] * scale, for 'width' pixels.
+void rowAddScaled(float *dst, const float *src, float scale, int width);
+
+// Horizontally resamples a row to weights.first.size() pixels.
+void rowResample(const float *src, float *dst, const ResampleWeights &weights);
+
+// Blends src into dst with the given mode.
+void rowBlend(float *dst, const float *src, int width, ImageData::BlendMode mode);
+
+} // image
+} // love
@@ -137,6 +137,46 @@ enum KTXGLInternalFormat
 	KTX_GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR = 0x93DD
 };
 
+// Only covers the formats love.image.compress produces, plus their close
+// relatives.
+uint32 convertToGLFormat(PixelFormat format, uint32 &baseformat)
+{
+	baseformat = 0x1908; // GL_RGBA
+
+	switch (format)
+	{
+	case PIXELFORMAT_ETC1_UNORM:
+		baseformat = 0x1907; // GL_RGB
+		return KTX_GL_ETC1_RGB8_OES;
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+		baseformat = 0x1907;
+		return KTX_GL_COMPRESSED_RGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+		baseformat = 0x1907;
+		return KTX_GL_COMPRESSED_SRGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		return KTX_GL_COMPRESSED_RGBA8_ETC2_EAC;
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+	case PIXELFORMAT_DXT1_UNORM:
+		baseformat = 0x1907;
+		return KTX_GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT1_sRGB:
+		baseformat = 0x1907;
+		return KTX_GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT5_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_DXT5_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_BC7_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_BPTC_UNORM;
+	case PIXELFORMAT_BC7_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+	default:
+		return 0;
+	}
+}
+
 PixelFormat convertFormat(uint32 glformat)
 {
 	// hnnngg ASTC...
@@ -383,6 +423,71 @@ StrongRef<ByteData> KTXHandler::parseCompressed(Data *filedata, std::vector<Stro
 	return memory;
 }
 
+bool KTXHandler::canEncodeCompressed(PixelFormat format)
+{
+	uint32 baseformat = 0;
+	return convertToGLFormat(format, baseformat) != 0;
+}
+
+FormatHandler::EncodedImage KTXHandler::encodeCompressed(PixelFormat format, const std::vector<StrongRef<CompressedSlice>> &images)
+{
+	uint32 baseformat = 0;
+	uint32 glformat = convertToGLFormat(format, baseformat);
+
+	if (glformat == 0)
+		throw love::Exception("Cannot encode the %s pixel format to a KTX file.", getPixelFormatName(format));
+
+	if (images.empty())
+		throw love::Exception("Cannot encode a KTX file without any image data.");
+
+	size_t totalsize = sizeof(KTXHeader);
+	for (const auto &image : images)
+		totalsize += sizeof(uint32) + ((image->getSize() + 3) & ~size_t(3));
+
+	EncodedImage encimg;
+
+	try
+	{
+		encimg.data = new uint8[totalsize];
+		encimg.size = totalsize;
+	}
+	catch (std::exception &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	memset(encimg.data, 0, totalsize);
+
+	KTXHeader header = {};
+	uint8 ktxidentifier[12] = KTX_IDENTIFIER_REF;
+	memcpy(header.identifier, ktxidentifier, 12);
+
+	header.endianness = KTX_ENDIAN_REF;
+	header.glTypeSize = 1;
+	header.glInternalFormat = glformat;
+	header.glBaseInternalFormat = baseformat;
+	header.pixelWidth = (uint32) images[0]->getWidth();
+	header.pixelHeight = (uint32) images[0]->getHeight();
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32) images.size();
+
+	memcpy(encimg.data, &header, sizeof(KTXHeader));
+
+	size_t offset = sizeof(KTXHeader);
+
+	for (const auto &image : images)
+	{
+		uint32 mipsize = (uint32) image->getSize();
+		memcpy(encimg.data + offset, &mipsize, sizeof(uint32));
+		offset += sizeof(uint32);
+
+		memcpy(encimg.data + offset, image->getData(), mipsize);
+		offset += (mipsize + 3) & ~uint32(3);
+	}
+
+	return encimg;
+}
+
 } // magpie
 } // image
 } // love
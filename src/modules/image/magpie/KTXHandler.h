@@ -46,6 +46,9 @@ class KTXHandler : public FormatHandler
 	        std::vector<StrongRef<CompressedSlice>> &images,
 	        PixelFormat &format) override;
 
+	bool canEncodeCompressed(PixelFormat format) override;
+	EncodedImage encodeCompressed(PixelFormat format, const std::vector<StrongRef<CompressedSlice>> &images) override;
+
 }; // KTXHandler
 
 } // magpie
@@ -23,6 +23,7 @@
 // LOVE
 #include "common/Exception.h"
 #include "common/math.h"
+#include "thread/ThreadPool.h"
 
 // LodePNG
 #include "lodepng/lodepng.h"
@@ -32,9 +33,11 @@
 
 // C++
 #include <algorithm>
+#include <vector>
 
 // C
 #include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -97,10 +100,158 @@ static unsigned zlibDecompress(unsigned char **out, size_t *outsize, const unsig
 	return 0; // Success.
 }
 
+// Size of the independently compressed pieces used by parallel encoding.
+static const size_t PARALLEL_CHUNK_SIZE = 256 * 1024;
+
+// Maximum distance of a deflate back-reference.
+static const size_t DEFLATE_WINDOW_SIZE = 32768;
+
+struct DeflateChunk
+{
+	std::vector<unsigned char> data;
+	uLong adler = 1;
+	bool failed = false;
+};
+
+// Compresses one chunk as raw deflate blocks. The last 32KB of the previous
+// chunk is used as a dictionary so matches can reach back across the chunk
+// boundary, the same as they would in a single stream. Every chunk except the
+// last ends with a sync flush so the pieces can be concatenated directly.
+static void deflateChunk(DeflateChunk &chunk, const unsigned char *in, size_t begin, size_t size, bool last, int level)
+{
+	z_stream stream = {};
+
+	if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		chunk.failed = true;
+		return;
+	}
+
+	if (begin > 0)
+	{
+		size_t dictsize = std::min(begin, DEFLATE_WINDOW_SIZE);
+		deflateSetDictionary(&stream, in + begin - dictsize, (uInt) dictsize);
+	}
+
+	try
+	{
+		// A sync flush appends an empty stored block after the data.
+		chunk.data.resize(deflateBound(&stream, (uLong) size) + 16);
+	}
+	catch (std::exception &)
+	{
+		deflateEnd(&stream);
+		chunk.failed = true;
+		return;
+	}
+
+	stream.next_in = (Bytef *) (in + begin);
+	stream.avail_in = (uInt) size;
+	stream.next_out = chunk.data.data();
+	stream.avail_out = (uInt) chunk.data.size();
+
+	int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+	int status = deflate(&stream, flush);
+
+	bool complete = last ? status == Z_STREAM_END : (status == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+
+	chunk.data.resize(stream.total_out);
+	chunk.failed = !complete;
+	chunk.adler = adler32(1, in + begin, (uInt) size);
+
+	deflateEnd(&stream);
+}
+
+// Compresses the data in fixed-size chunks on the shared thread pool, and
+// stitches them together into a single zlib stream (like pigz does).
+static unsigned zlibCompressParallel(unsigned char **out, size_t *outsize, const unsigned char *in,
+                                     size_t insize, int level)
+{
+	size_t chunkcount = (insize + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+	std::vector<DeflateChunk> chunks(chunkcount);
+
+	love::thread::ThreadPool::getShared()->parallelFor(chunkcount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t offset = i * PARALLEL_CHUNK_SIZE;
+			size_t size = std::min(PARALLEL_CHUNK_SIZE, insize - offset);
+			deflateChunk(chunks[i], in, offset, size, i == chunkcount - 1, level);
+		}
+	});
+
+	size_t outdatasize = 2 + 4;
+	for (const DeflateChunk &chunk : chunks)
+	{
+		if (chunk.failed)
+			return 10000; // "Unknown error code" for LodePNG.
+		outdatasize += chunk.data.size();
+	}
+
+	// LodePNG uses malloc, realloc, and free.
+	unsigned char *outdata = (unsigned char *) malloc(outdatasize);
+
+	if (!outdata)
+		return 83; // "Memory allocation failed" error code for LodePNG.
+
+	// zlib header: 32K window deflate, with the level hint zlib itself uses.
+	int levelhint = 2;
+	if (level >= 0 && level <= 1)
+		levelhint = 0;
+	else if (level >= 2 && level <= 5)
+		levelhint = 1;
+	else if (level >= 7)
+		levelhint = 3;
+
+	unsigned header = (0x78 << 8) | (levelhint << 6);
+	header += 31 - (header % 31);
+
+	outdata[0] = (unsigned char) (header >> 8);
+	outdata[1] = (unsigned char) (header & 0xFF);
+
+	size_t pos = 2;
+	uLong adler = chunks[0].adler;
+
+	for (size_t i = 0; i < chunkcount; i++)
+	{
+		memcpy(outdata + pos, chunks[i].data.data(), chunks[i].data.size());
+		pos += chunks[i].data.size();
+
+		if (i > 0)
+		{
+			size_t size = std::min(PARALLEL_CHUNK_SIZE, insize - i * PARALLEL_CHUNK_SIZE);
+			adler = adler32_combine(adler, chunks[i].adler, (z_off_t) size);
+		}
+	}
+
+	outdata[pos + 0] = (unsigned char) ((adler >> 24) & 0xFF);
+	outdata[pos + 1] = (unsigned char) ((adler >> 16) & 0xFF);
+	outdata[pos + 2] = (unsigned char) ((adler >> 8) & 0xFF);
+	outdata[pos + 3] = (unsigned char) (adler & 0xFF);
+
+	if (out != nullptr)
+		*out = outdata;
+
+	if (outsize != nullptr)
+		*outsize = outdatasize;
+
+	return 0; // Success.
+}
+
 // Custom PNG compression function for LodePNG, using zlib.
 static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigned char *in,
-                             size_t insize, const LodePNGCompressSettings* /*settings*/)
+                             size_t insize, const LodePNGCompressSettings *settings)
 {
+	auto options = (const FormatHandler::EncodeOptions *) settings->custom_context;
+
+	int level = Z_DEFAULT_COMPRESSION;
+	if (options != nullptr)
+		level = options->compressionLevel;
+
+	// Storing without compression is already as fast as a memcpy.
+	if (options != nullptr && options->parallel && level != 0 && insize > PARALLEL_CHUNK_SIZE)
+		return zlibCompressParallel(out, outsize, in, insize, level);
+
 	// Get the maximum compressed size of the data.
 	uLongf outdatasize = compressBound(insize);
 
@@ -111,7 +262,7 @@ static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigne
 		return 83; // "Memory allocation failed" error code for LodePNG.
 
 	// Use zlib to compress the PNG data.
-	int status = compress(outdata, &outdatasize, in, insize);
+	int status = compress2(outdata, &outdatasize, in, insize, level);
 
 	if (status != Z_OK)
 	{
@@ -128,6 +279,20 @@ static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigne
 	return 0; // Success.
 }
 
+static LodePNGFilterStrategy getFilterStrategy(FormatHandler::RowFilter filter)
+{
+	switch (filter)
+	{
+	case FormatHandler::ROW_FILTER_NONE: return LFS_ZERO;
+	case FormatHandler::ROW_FILTER_SUB: return LFS_ONE;
+	case FormatHandler::ROW_FILTER_UP: return LFS_TWO;
+	case FormatHandler::ROW_FILTER_AVERAGE: return LFS_THREE;
+	case FormatHandler::ROW_FILTER_PAETH: return LFS_FOUR;
+	case FormatHandler::ROW_FILTER_ADAPTIVE:
+	default: return LFS_MINSUM;
+	}
+}
+
 bool PNGHandler::canDecode(Data *data)
 {
 	unsigned int width = 0, height = 0;
@@ -199,7 +364,7 @@ PNGHandler::DecodedImage PNGHandler::decode(Data *fdata)
 	return img;
 }
 
-FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat, const EncodeOptions &options)
 {
 	if (!canEncode(img.format, encodedFormat))
 		throw love::Exception("PNG encoder cannot encode to non-PNG format.");
@@ -215,6 +380,12 @@ FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedF
 	state.info_png.color.bitdepth = state.info_raw.bitdepth;
 
 	state.encoder.zlibsettings.custom_zlib = zlibCompress;
+	state.encoder.zlibsettings.custom_context = &options;
+	state.encoder.filter_palette_zero = 0;
+
+	// Filtering only helps the compressor, so it's wasted work when the
+	// rows are stored as-is.
+	state.encoder.filter_strategy = getFilterStrategy(options.compressionLevel == 0 ? ROW_FILTER_NONE : options.rowFilter);
 
 	const uint8 *data = img.data;
 	uint16 *swappeddata = nullptr;
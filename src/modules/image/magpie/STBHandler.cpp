@@ -108,7 +108,7 @@ FormatHandler::DecodedImage STBHandler::decode(Data *data)
 	return img;
 }
 
-FormatHandler::EncodedImage STBHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+FormatHandler::EncodedImage STBHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat, const EncodeOptions &/*options*/)
 {
 	if (!canEncode(img.format, encodedFormat))
 		throw love::Exception("Invalid format.");
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_DecodeRequest.h"
+
+namespace love
+{
+namespace image
+{
+
+DecodeRequest *luax_checkdecoderequest(lua_State *L, int idx)
+{
+	return luax_checktype<DecodeRequest>(L, idx);
+}
+
+int w_DecodeRequest_getStatus(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+	const char *str = nullptr;
+	if (!DecodeRequest::getConstant(t->getStatus(), str))
+		return luaL_error(L, "Unknown decode request status.");
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_DecodeRequest_isComplete(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_DecodeRequest_cancel(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+	luax_pushboolean(L, t->cancel());
+	return 1;
+}
+
+int w_DecodeRequest_wait(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+	double timeout = luaL_optnumber(L, 2, -1.0);
+	luax_pushboolean(L, t->wait(timeout));
+	return 1;
+}
+
+int w_DecodeRequest_getImageData(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+
+	ImageData *imageData = t->getImageData();
+	if (imageData != nullptr)
+	{
+		luax_pushtype(L, imageData);
+		return 1;
+	}
+
+	lua_pushnil(L);
+	if (t->getStatus() == DecodeRequest::STATUS_ERROR)
+	{
+		luax_pushstring(L, t->getError());
+		return 2;
+	}
+
+	return 1;
+}
+
+int w_DecodeRequest_getError(lua_State *L)
+{
+	DecodeRequest *t = luax_checkdecoderequest(L, 1);
+	if (t->getStatus() == DecodeRequest::STATUS_ERROR)
+		luax_pushstring(L, t->getError());
+	else
+		lua_pushnil(L);
+	return 1;
+}
+
+static const luaL_Reg w_DecodeRequest_functions[] =
+{
+	{ "getStatus", w_DecodeRequest_getStatus },
+	{ "isComplete", w_DecodeRequest_isComplete },
+	{ "cancel", w_DecodeRequest_cancel },
+	{ "wait", w_DecodeRequest_wait },
+	{ "getImageData", w_DecodeRequest_getImageData },
+	{ "getError", w_DecodeRequest_getError },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_decoderequest(lua_State *L)
+{
+	return luax_register_type(L, &DecodeRequest::type, w_DecodeRequest_functions, nullptr);
+}
+
+} // image
+} // love
@@ -26,6 +26,7 @@
 #include "Image.h"
 
 #include "filesystem/wrap_Filesystem.h"
+#include "wrap_DecodeRequest.h"
 
 namespace love
 {
@@ -103,6 +104,110 @@ int w_newImageData(lua_State *L)
 	}
 }
 
+static DecodeRequest *newDecodeRequest(lua_State *L, int idx)
+{
+	DecodeRequest *request = nullptr;
+
+	// Filenames are read on the worker thread, along with decoding.
+	if (lua_type(L, idx) == LUA_TSTRING)
+	{
+		std::string filename = luax_checkstring(L, idx);
+		luax_catchexcept(L, [&]() { request = instance()->newImageDataAsync(nullptr, filename); });
+	}
+	else if (filesystem::luax_cangetdata(L, idx))
+	{
+		Data *data = love::filesystem::luax_getdata(L, idx);
+		luax_catchexcept(L,
+			[&]() { request = instance()->newImageDataAsync(data, ""); },
+			[&](bool) { data->release(); }
+		);
+	}
+	else
+		luax_typerror(L, idx, "filename, File, or Data");
+
+	return request;
+}
+
+int w_newImageDataAsync(lua_State *L)
+{
+	DecodeRequest *request = newDecodeRequest(L, 1);
+	luax_pushtype(L, request);
+	request->release();
+	return 1;
+}
+
+int w_decodeMany(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	int count = (int) luax_objlen(L, 1);
+	lua_settop(L, 1);
+
+	// The requests are kept alive by a Lua table rather than a C++ container,
+	// so Lua errors raised while they're gathered can't skip any destructors.
+	lua_createtable(L, count, 0);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 1, i);
+
+		DecodeRequest *request = nullptr;
+		if (lua_type(L, -1) == LUA_TSTRING)
+		{
+			const char *filename = lua_tostring(L, -1);
+			luax_catchexcept(L, [&]() { request = new DecodeRequest(filename); });
+		}
+		else if (filesystem::luax_cangetdata(L, -1))
+		{
+			Data *data = love::filesystem::luax_getdata(L, -1);
+			luax_catchexcept(L,
+				[&]() { request = new DecodeRequest(data); },
+				[&](bool) { data->release(); }
+			);
+		}
+		else
+			return luaL_error(L, "Expected a filename, File, or Data at index %d.", i);
+
+		lua_pop(L, 1);
+
+		luax_pushtype(L, request);
+		request->release();
+		lua_rawseti(L, 2, i);
+	}
+
+	luax_catchexcept(L, [&]()
+	{
+		std::vector<DecodeRequest *> pending;
+		pending.reserve(count);
+		for (int i = 1; i <= count; i++)
+		{
+			lua_rawgeti(L, 2, i);
+			pending.push_back(luax_totype<DecodeRequest>(L, -1));
+			lua_pop(L, 1);
+		}
+		instance()->decodeMany(pending);
+	});
+
+	lua_createtable(L, count, 0);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 2, i);
+		DecodeRequest *request = luax_totype<DecodeRequest>(L, -1);
+		lua_pop(L, 1);
+
+		if (request->getImageData() == nullptr)
+		{
+			luax_pushstring(L, request->getError());
+			return luaL_error(L, "Could not decode image %d: %s", i, lua_tostring(L, -1));
+		}
+
+		luax_pushtype(L, request->getImageData());
+		lua_rawseti(L, -2, i);
+	}
+
+	return 1;
+}
+
 int w_newCompressedData(lua_State *L)
 {
 	Data *data = love::filesystem::luax_getdata(L, 1);
@@ -118,6 +223,41 @@ int w_newCompressedData(lua_State *L)
 	return 1;
 }
 
+int w_compress(lua_State *L)
+{
+	ImageData *id = luax_checkimagedata(L, 1);
+
+	const char *fstr = luaL_checkstring(L, 2);
+	PixelFormat format = PIXELFORMAT_UNKNOWN;
+	if (!getConstant(fstr, format))
+		return luax_enumerror(L, "pixel format", fstr);
+
+	CompressQuality quality = COMPRESS_QUALITY_NORMAL;
+	if (!lua_isnoneornil(L, 3))
+	{
+		const char *qstr = luaL_checkstring(L, 3);
+		if (!getConstant(qstr, quality))
+			return luax_enumerror(L, "compression quality", getConstants(quality), qstr);
+	}
+
+	bool mipmaps = true;
+	bool cache = false;
+
+	if (!lua_isnoneornil(L, 4))
+	{
+		luaL_checktype(L, 4, LUA_TTABLE);
+		mipmaps = luax_boolflag(L, 4, "mipmaps", mipmaps);
+		cache = luax_boolflag(L, 4, "cache", cache);
+	}
+
+	CompressedImageData *t = nullptr;
+	luax_catchexcept(L, [&]() { t = instance()->compress(id, format, quality, mipmaps, cache); });
+
+	luax_pushtype(L, CompressedImageData::type, t);
+	t->release();
+	return 1;
+}
+
 int w_isCompressed(lua_State *L)
 {
 	Data *data = love::filesystem::luax_getdata(L, 1);
@@ -142,7 +282,10 @@ int w_newCubeFaces(lua_State *L)
 static const luaL_Reg functions[] =
 {
 	{ "newImageData",  w_newImageData },
+	{ "newImageDataAsync", w_newImageDataAsync },
+	{ "decodeMany", w_decodeMany },
 	{ "newCompressedData", w_newCompressedData },
+	{ "compress", w_compress },
 	{ "isCompressed", w_isCompressed },
 	{ "newCubeFaces", w_newCubeFaces },
 	{ 0, 0 }
@@ -152,6 +295,7 @@ static const lua_CFunction types[] =
 {
 	luaopen_imagedata,
 	luaopen_compressedimagedata,
+	luaopen_decoderequest,
 	0
 };
 
@@ -230,10 +230,93 @@ int w_ImageData_paste(lua_State *L)
 	int sy = (int) luaL_optinteger(L, 6, 0);
 	int sw = (int) luaL_optinteger(L, 7, src->getWidth());
 	int sh = (int) luaL_optinteger(L, 8, src->getHeight());
-	t->paste((love::image::ImageData *)src, dx, dy, sx, sy, sw, sh);
+
+	ImageData::BlendMode mode = ImageData::BLEND_REPLACE;
+	if (!lua_isnoneornil(L, 9))
+	{
+		const char *modestr = luaL_checkstring(L, 9);
+		if (!ImageData::getConstant(modestr, mode))
+			return luax_enumerror(L, "blend mode", ImageData::getConstants(mode), modestr);
+	}
+
+	luax_catchexcept(L, [&](){ t->paste((love::image::ImageData *)src, dx, dy, sx, sy, sw, sh, mode); });
+	return 0;
+}
+
+int w_ImageData_convert(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	const char *fstr = luaL_checkstring(L, 2);
+	PixelFormat format = PIXELFORMAT_UNKNOWN;
+	if (!getConstant(fstr, format))
+		return luax_enumerror(L, "pixel format", fstr);
+
+	ImageData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->convert(format); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_ImageData_premultiplyAlpha(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	luax_catchexcept(L, [&](){ t->premultiplyAlpha(); });
+	return 0;
+}
+
+int w_ImageData_unpremultiplyAlpha(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	luax_catchexcept(L, [&](){ t->unpremultiplyAlpha(); });
 	return 0;
 }
 
+static ImageData::ResizeFilter luax_checkresizefilter(lua_State *L, int idx, ImageData::ResizeFilter def)
+{
+	ImageData::ResizeFilter filter = def;
+	if (!lua_isnoneornil(L, idx))
+	{
+		const char *filterstr = luaL_checkstring(L, idx);
+		if (!ImageData::getConstant(filterstr, filter))
+			luax_enumerror(L, "resize filter", ImageData::getConstants(filter), filterstr);
+	}
+	return filter;
+}
+
+int w_ImageData_resize(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	int w = (int) luaL_checkinteger(L, 2);
+	int h = (int) luaL_checkinteger(L, 3);
+	ImageData::ResizeFilter filter = luax_checkresizefilter(L, 4, ImageData::RESIZE_BILINEAR);
+
+	ImageData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->resize(w, h, filter); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_ImageData_generateMipmaps(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	ImageData::ResizeFilter filter = luax_checkresizefilter(L, 2, ImageData::RESIZE_BOX);
+
+	std::vector<StrongRef<ImageData>> mipmaps;
+	luax_catchexcept(L, [&](){ mipmaps = t->generateMipmaps(filter); });
+
+	lua_createtable(L, (int) mipmaps.size(), 0);
+	for (int i = 0; i < (int) mipmaps.size(); i++)
+	{
+		luax_pushtype(L, mipmaps[i].get());
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
 int w_ImageData_encode(lua_State *L)
 {
 	ImageData *t = luax_checkimagedata(L, 1);
@@ -244,16 +327,41 @@ int w_ImageData_encode(lua_State *L)
 		return luax_enumerror(L, "encoded image format", ImageData::getConstants(format), fmt);
 
 	bool hasfilename = false;
+	int optionsidx = 4;
 
 	std::string filename = "Image." + std::string(fmt);
-	if (!lua_isnoneornil(L, 3))
+	if (lua_istable(L, 3))
+		optionsidx = 3;
+	else if (!lua_isnoneornil(L, 3))
 	{
 		hasfilename = true;
 		filename = luax_checkstring(L, 3);
 	}
 
+	FormatHandler::EncodeOptions options;
+
+	if (!lua_isnoneornil(L, optionsidx))
+	{
+		luaL_checktype(L, optionsidx, LUA_TTABLE);
+
+		options.compressionLevel = luax_intflag(L, optionsidx, "level", options.compressionLevel);
+		if (options.compressionLevel < -1 || options.compressionLevel > 9)
+			return luaL_error(L, "Invalid compression level: %d (must be between -1 and 9)", options.compressionLevel);
+
+		lua_getfield(L, optionsidx, "filter");
+		if (!lua_isnoneornil(L, -1))
+		{
+			const char *filterstr = luaL_checkstring(L, -1);
+			if (!ImageData::getConstant(filterstr, options.rowFilter))
+				return luax_enumerror(L, "row filter", ImageData::getConstants(options.rowFilter), filterstr);
+		}
+		lua_pop(L, 1);
+
+		options.parallel = luax_boolflag(L, optionsidx, "parallel", options.parallel);
+	}
+
 	love::filesystem::FileData *filedata = nullptr;
-	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename); });
+	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename, options); });
 
 	luax_pushtype(L, filedata);
 	filedata->release();
@@ -296,6 +404,11 @@ static const luaL_Reg w_ImageData_functions[] =
 	{ "getPixel", w_ImageData_getPixel },
 	{ "setPixel", w_ImageData_setPixel },
 	{ "paste", w_ImageData_paste },
+	{ "convert", w_ImageData_convert },
+	{ "premultiplyAlpha", w_ImageData_premultiplyAlpha },
+	{ "unpremultiplyAlpha", w_ImageData_unpremultiplyAlpha },
+	{ "resize", w_ImageData_resize },
+	{ "generateMipmaps", w_ImageData_generateMipmaps },
 	{ "mapPixel", w_ImageData_mapPixel },
 	{ "encode", w_ImageData_encode },
 	{ 0, 0 }
@@ -171,6 +171,17 @@ class Joystick : public Object
 		};
 	};
 
+	/**
+	 * A single joystick axis motion event, as recorded at the device's native
+	 * rate. The layout is exposed to Lua as packed binary data.
+	 **/
+	struct AxisSample
+	{
+		double time; // Seconds, in the same timebase as love.timer.getTime.
+		float axis; // 1-based axis index.
+		float value;
+	};
+
 	virtual ~Joystick() {}
 
 	virtual bool open(int64 deviceid) = 0;
@@ -224,6 +235,19 @@ class Joystick : public Object
 	virtual void setSensorEnabled(Sensor::SensorType type, bool enabled) = 0;
 	virtual std::vector<float> getSensorData(Sensor::SensorType type) const = 0;
 
+	/**
+	 * Records an axis sample. Called by the event module for every axis
+	 * motion event, before events are coalesced or handed to Lua.
+	 **/
+	virtual void addAxisSample(const AxisSample &sample) = 0;
+
+	/**
+	 * Removes up to maxcount of the oldest recorded axis samples and copies
+	 * them into dst. Returns the number of samples copied.
+	 **/
+	virtual size_t getAxisSamples(AxisSample *dst, size_t maxcount) = 0;
+	virtual size_t getAxisSampleCount() const = 0;
+
 	STRINGMAP_CLASS_DECLARE(Hat);
 	STRINGMAP_CLASS_DECLARE(JoystickType);
 	STRINGMAP_CLASS_DECLARE(GamepadType);
@@ -44,6 +44,7 @@ Joystick::Joystick(int id)
 	, joystickType(JOYSTICK_TYPE_UNKNOWN)
 	, instanceid(-1)
 	, id(id)
+	, axisSamples(MAX_AXIS_SAMPLES)
 {
 }
 
@@ -130,6 +131,8 @@ void Joystick::close()
 	joyhandle = nullptr;
 	controller = nullptr;
 	instanceid = -1;
+
+	axisSamples.clear();
 }
 
 bool Joystick::isConnected() const
@@ -527,6 +530,21 @@ void Joystick::setSensorEnabled(Sensor::SensorType type, bool enabled)
 #endif
 }
 
+void Joystick::addAxisSample(const AxisSample &sample)
+{
+	axisSamples.push(sample);
+}
+
+size_t Joystick::getAxisSamples(AxisSample *dst, size_t maxcount)
+{
+	return axisSamples.pop(dst, maxcount);
+}
+
+size_t Joystick::getAxisSampleCount() const
+{
+	return axisSamples.size();
+}
+
 std::vector<float> Joystick::getSensorData(Sensor::SensorType type) const
 {
 #if defined(LOVE_ENABLE_SENSOR)
@@ -24,6 +24,7 @@
 // LOVE
 #include "joystick/Joystick.h"
 #include "common/EnumMap.h"
+#include "common/RingBuffer.h"
 #include "common/int.h"
 
 // SDL
@@ -95,6 +96,10 @@ class Joystick : public love::joystick::Joystick
 	void setSensorEnabled(Sensor::SensorType type, bool enabled) override;
 	std::vector<float> getSensorData(Sensor::SensorType type) const override;
 
+	void addAxisSample(const AxisSample &sample) override;
+	size_t getAxisSamples(AxisSample *dst, size_t maxcount) override;
+	size_t getAxisSampleCount() const override;
+
 	static bool getConstant(Hat in, Uint8 &out);
 	static bool getConstant(Uint8 in, Hat &out);
 
@@ -106,7 +111,10 @@ class Joystick : public love::joystick::Joystick
 
 private:
 
-	Joystick() {}
+	// About a second of samples from a 1000 Hz device with a single axis.
+	static const size_t MAX_AXIS_SAMPLES = 1024;
+
+	Joystick() : axisSamples(MAX_AXIS_SAMPLES) {}
 
 	SDL_Joystick *joyhandle;
 	SDL_Gamepad *controller;
@@ -119,6 +127,8 @@ class Joystick : public love::joystick::Joystick
 
 	std::string name;
 
+	RingBuffer<AxisSample> axisSamples;
+
 	static EnumMap<Hat, Uint8, Joystick::HAT_MAX_ENUM>::Entry hatEntries[];
 	static EnumMap<Hat, Uint8, Joystick::HAT_MAX_ENUM> hats;
 
@@ -22,7 +22,9 @@
 #include "wrap_Joystick.h"
 #include "wrap_JoystickModule.h"
 #include "sensor/Sensor.h"
+#include "data/ByteData.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace love
@@ -449,6 +451,57 @@ int w_Joystick_getSensorData(lua_State *L)
 
 #endif // LOVE_ENABLE_SENSOR
 
+int w_Joystick_getAxisSamples(lua_State *L)
+{
+	Joystick *j = luax_checkjoystick(L, 1);
+
+	// Fill the given Data if there is one, otherwise return a new ByteData
+	// which holds exactly the pending samples, or nil if there are none.
+	const size_t stride = sizeof(Joystick::AxisSample);
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		Data *dest = luax_checktype<Data>(L, 2);
+
+		// Samples are written in place, so the Data has to hold whole samples
+		// at a suitably aligned address.
+		if (dest->getSize() % stride != 0)
+			return luaL_error(L, "Data size must be a multiple of the sample size (%d bytes).", (int) stride);
+		if ((uintptr_t) dest->getData() % alignof(Joystick::AxisSample) != 0)
+			return luaL_error(L, "Data must be aligned to %d bytes.", (int) alignof(Joystick::AxisSample));
+
+		size_t count = j->getAxisSamples((Joystick::AxisSample *) dest->getData(), dest->getSize() / stride);
+		lua_pushvalue(L, 2);
+		lua_pushinteger(L, (lua_Integer) count);
+		return 2;
+	}
+
+	size_t count = j->getAxisSampleCount();
+	if (count == 0)
+	{
+		lua_pushnil(L);
+		lua_pushinteger(L, 0);
+		return 2;
+	}
+
+	love::data::ByteData *dest = nullptr;
+	luax_catchexcept(L, [&]() { dest = new love::data::ByteData(count * stride); });
+
+	count = j->getAxisSamples((Joystick::AxisSample *) dest->getData(), count);
+
+	luax_pushtype(L, dest);
+	dest->release();
+	lua_pushinteger(L, (lua_Integer) count);
+	return 2;
+}
+
+int w_Joystick_getAxisSampleCount(lua_State *L)
+{
+	Joystick *j = luax_checkjoystick(L, 1);
+	lua_pushinteger(L, (lua_Integer) j->getAxisSampleCount());
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg w_Joystick_functions[] =
 {
@@ -463,6 +516,8 @@ static const luaL_Reg w_Joystick_functions[] =
 	{ "getHatCount", w_Joystick_getHatCount },
 	{ "getAxis", w_Joystick_getAxis },
 	{ "getAxes", w_Joystick_getAxes },
+	{ "getAxisSamples", w_Joystick_getAxisSamples },
+	{ "getAxisSampleCount", w_Joystick_getAxisSampleCount },
 	{ "getHat", w_Joystick_getHat },
 	{ "isDown", w_Joystick_isDown },
 	{ "setPlayerIndex", w_Joystick_setPlayerIndex },
@@ -200,6 +200,7 @@ function love.init()
 			audio = true,
 			math = true,
 			physics = true,
+			profiler = true,
 			sensor = true,
 			sound = true,
 			system = true,
@@ -351,6 +352,7 @@ function love.init()
 		"graphics",
 		"math",
 		"physics",
+		"profiler",
 	} do
 		if c.modules[v] then
 			require("love." .. v)
@@ -186,14 +186,25 @@ function love.run()
 		-- Update dt, as we'll be passing it to update
 		local dt = love.timer and love.timer.step() or 0
 
+		-- Only add zones for the callbacks while a profiler capture is running.
+		local profiler = love.profiler and love.profiler.isCapturing() and love.profiler
+
 		-- Call update and draw
-		if love.update then love.update(dt) end -- will pass 0 if love.timer is disabled
+		if love.update then
+			if profiler then profiler.beginZone("love.update") end
+			love.update(dt) -- will pass 0 if love.timer is disabled
+			if profiler then profiler.endZone() end
+		end
 
 		if love.graphics and love.graphics.isActive() then
 			love.graphics.origin()
 			love.graphics.clear(love.graphics.getBackgroundColor())
 
-			if love.draw then love.draw() end
+			if love.draw then
+				if profiler then profiler.beginZone("love.draw") end
+				love.draw()
+				if profiler then profiler.endZone() end
+			end
 
 			love.graphics.present()
 		end
@@ -144,6 +144,9 @@ extern "C"
 #if defined(LOVE_ENABLE_PHYSICS)
 	extern int luaopen_love_physics(lua_State*);
 #endif
+#if defined(LOVE_ENABLE_PROFILER)
+	extern int luaopen_love_profiler(lua_State*);
+#endif
 #if defined(LOVE_ENABLE_SENSOR)
 	extern int luaopen_love_sensor(lua_State*);
 #endif
@@ -216,6 +219,9 @@ static const luaL_Reg modules[] = {
 #if defined(LOVE_ENABLE_PHYSICS)
 	{ "love.physics", luaopen_love_physics },
 #endif
+#if defined(LOVE_ENABLE_PROFILER)
+	{ "love.profiler", luaopen_love_profiler },
+#endif
 #if defined(LOVE_ENABLE_SENSOR)
 	{ "love.sensor", luaopen_love_sensor },
 #endif
@@ -79,6 +79,57 @@ void subdivide(vector<love::Vector2> &points, int k)
 		points[i-1 + left.size() - 1] = right[right.size() - i - 1];
 }
 
+// Deep enough for 65536 segments per curve.
+const int MAX_ADAPTIVE_DEPTH = 16;
+
+/**
+ * Adaptive subdivision. Appends the points of the chain after points[0].
+ **/
+void subdivideAdaptive(const love::Vector2 *points, size_t count, float tolerance, int depth, vector<love::Vector2> &out)
+{
+	// Wang's bound on the distance between the curve and the line connecting
+	// its end points, from the second differences of the control polygon.
+	float maxdd = 0.0f;
+	for (size_t i = 0; i + 2 < count; i++)
+	{
+		love::Vector2 dd = points[i] - points[i+1] * 2.0f + points[i+2];
+		maxdd = std::max(maxdd, dd.getLengthSquare());
+	}
+
+	float degree = (float) (count - 1);
+	if (degree * (degree - 1.0f) * 0.125f * sqrtf(maxdd) <= tolerance || depth >= MAX_ADAPTIVE_DEPTH)
+	{
+		out.push_back(points[count - 1]);
+		return;
+	}
+
+	// Same de casteljau split as subdivide(), at t = 0.5. The right half is
+	// computed in place, so it doesn't need to be reversed.
+	love::Vector2 localbuffer[16];
+	vector<love::Vector2> heapbuffer;
+
+	love::Vector2 *left = localbuffer;
+	if (count > 8)
+	{
+		heapbuffer.resize(count * 2);
+		left = heapbuffer.data();
+	}
+
+	love::Vector2 *right = left + count;
+	std::copy(points, points + count, right);
+
+	for (size_t step = 1; step < count; ++step)
+	{
+		left[step - 1] = right[0];
+		for (size_t i = 0; i < count - step; ++i)
+			right[i] = (right[i] + right[i+1]) * .5;
+	}
+	left[count - 1] = right[0];
+
+	subdivideAdaptive(left, count, tolerance, depth + 1, out);
+	subdivideAdaptive(right, count, tolerance, depth + 1, out);
+}
+
 }
 
 namespace love
@@ -250,6 +301,17 @@ vector<Vector2> BezierCurve::render(int accuracy) const
 	return vertices;
 }
 
+void BezierCurve::renderAdaptive(float tolerance, vector<Vector2> &points) const
+{
+	if (controlPoints.size() < 2)
+		throw Exception("Invalid Bezier curve: Not enough control points.");
+	if (!(tolerance > 0.0f))
+		throw Exception("Invalid tolerance: must be greater than 0.");
+
+	points.push_back(controlPoints[0]);
+	subdivideAdaptive(controlPoints.data(), controlPoints.size(), tolerance, 0, points);
+}
+
 vector<Vector2> BezierCurve::renderSegment(double start, double end, int accuracy) const
 {
 	if (controlPoints.size() < 2)
@@ -140,6 +140,14 @@ class BezierCurve : public Object
 	 **/
 	std::vector<Vector2> renderSegment(double start, double end, int accuracy = 4) const;
 
+	/**
+	 * Renders the curve by adaptive subdivision, only splitting the parts of
+	 * the curve which are not yet within the tolerance of a straight line.
+	 * @param tolerance The maximum distance between the curve and the chain.
+	 * @param[out] points The polygon chain is appended to this.
+	 **/
+	void renderAdaptive(float tolerance, std::vector<Vector2> &points) const;
+
 private:
 	std::vector<Vector2> controlPoints;
 };
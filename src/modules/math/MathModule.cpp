@@ -23,149 +23,44 @@
 #include "common/Vector.h"
 #include "common/int.h"
 #include "common/StringMap.h"
+#include "common/floattypes.h"
+#include "common/Exception.h"
 #include "BezierCurve.h"
 #include "Transform.h"
 
 // STL
 #include <cmath>
-#include <list>
 #include <iostream>
 
 // C
 #include <time.h>
 
-using std::list;
 using love::Vector2;
 
-namespace
-{
-
-// check if an angle is oriented counter clockwise
-inline bool is_oriented_ccw(const Vector2 &a, const Vector2 &b, const Vector2 &c)
-{
-	// return det(b-a, c-a) >= 0
-	return ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) >= 0;
-}
-
-// check if a and b are on the same side of the line c->d
-bool on_same_side(const Vector2 &a, const Vector2 &b, const Vector2 &c, const Vector2 &d)
-{
-	float px = d.x - c.x, py = d.y - c.y;
-	// return det(p, a-c) * det(p, b-c) >= 0
-	float l = px * (a.y - c.y) - py * (a.x - c.x);
-	float m = px * (b.y - c.y) - py * (b.x - c.x);
-	return l * m >= 0;
-}
-
-// checks is p is contained in the triangle abc
-inline bool point_in_triangle(const Vector2 &p, const Vector2 &a, const Vector2 &b, const Vector2 &c)
-{
-	return on_same_side(p,a, b,c) && on_same_side(p,b, a,c) && on_same_side(p,c, a,b);
-}
-
-// checks if any vertex in `vertices' is in the triangle abc.
-bool any_point_in_triangle(const std::list<const Vector2 *> &vertices, const Vector2 &a, const Vector2 &b, const Vector2 &c)
-{
-	for (const Vector2 *p : vertices)
-	{
-		if ((p != &a) && (p != &b) && (p != &c) && point_in_triangle(*p, a,b,c)) // oh god...
-			return true;
-	}
-
-	return false;
-}
-
-inline bool is_ear(const Vector2 &a, const Vector2 &b, const Vector2 &c, const std::list<const Vector2 *> &vertices)
-{
-	return is_oriented_ccw(a,b,c) && !any_point_in_triangle(vertices, a,b,c);
-}
-
-} // anonymous namespace
-
 namespace love
 {
 namespace math
 {
 
-std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon)
+bool isConvex(const std::vector<love::Vector2> &polygon)
 {
-	if (polygon.size() < 3)
-		throw love::Exception("Not a polygon");
-	else if (polygon.size() == 3)
-		return std::vector<Triangle>(1, Triangle(polygon[0], polygon[1], polygon[2]));
-
-	// collect list of connections and record leftmost item to check if the polygon
-	// has the expected winding
-	std::vector<size_t> next_idx(polygon.size()), prev_idx(polygon.size());
-	size_t idx_lm = 0;
-	for (size_t i = 0; i < polygon.size(); ++i)
-	{
-		const love::Vector2 &lm = polygon[idx_lm], &p = polygon[i];
-		if (p.x < lm.x || (p.x == lm.x && p.y < lm.y))
-			idx_lm = i;
-		next_idx[i] = i+1;
-		prev_idx[i] = i-1;
-	}
-	next_idx[next_idx.size()-1] = 0;
-	prev_idx[0] = prev_idx.size()-1;
-
-	// check if the polygon has the expected winding and reverse polygon if needed
-	if (!is_oriented_ccw(polygon[prev_idx[idx_lm]], polygon[idx_lm], polygon[next_idx[idx_lm]]))
-		next_idx.swap(prev_idx);
-
-	// collect list of concave polygons
-	std::list<const love::Vector2 *> concave_vertices;
-	for (size_t i = 0; i < polygon.size(); ++i)
-	{
-		if (!is_oriented_ccw(polygon[prev_idx[i]], polygon[i], polygon[next_idx[i]]))
-			concave_vertices.push_back(&polygon[i]);
-	}
-
-	// triangulation according to kong
-	std::vector<Triangle> triangles;
-	size_t n_vertices = polygon.size();
-	size_t current = 1, skipped = 0, next, prev;
-	while (n_vertices > 3)
-	{
-		next = next_idx[current];
-		prev = prev_idx[current];
-		const Vector2 &a = polygon[prev], &b = polygon[current], &c = polygon[next];
-		if (is_ear(a,b,c, concave_vertices))
-		{
-			triangles.push_back(Triangle(a,b,c));
-			next_idx[prev] = next;
-			prev_idx[next] = prev;
-			concave_vertices.remove(&b);
-			--n_vertices;
-			skipped = 0;
-		}
-		else if (++skipped > n_vertices)
-		{
-			throw love::Exception("Cannot triangulate polygon.");
-		}
-		current = next;
-	}
-	next = next_idx[current];
-	prev = prev_idx[current];
-	triangles.push_back(Triangle(polygon[prev], polygon[current], polygon[next]));
-
-	return triangles;
+	return isConvex(polygon.data(), polygon.size());
 }
 
-bool isConvex(const std::vector<love::Vector2> &polygon)
+bool isConvex(const love::Vector2 *polygon, size_t count)
 {
-	if (polygon.size() < 3)
+	if (count < 3)
 		return false;
 
 	// a polygon is convex if all corners turn in the same direction
 	// turning direction can be determined using the cross-product of
 	// the forward difference vectors
-	size_t i = polygon.size() - 2, j = polygon.size() - 1, k = 0;
+	size_t i = count - 2, j = count - 1, k = 0;
 	Vector2 p(polygon[j] - polygon[i]);
 	Vector2 q(polygon[k] - polygon[j]);
 	float winding = Vector2::cross(p, q);
 
-	while (k+1 < polygon.size())
+	while (k+1 < count)
 	{
 		i = j; j = k; k++;
 		p = polygon[j] - polygon[i];
@@ -177,6 +72,26 @@ bool isConvex(const std::vector<love::Vector2> &polygon)
 	return true;
 }
 
+void composeTransforms(const Matrix4 *locals, const int32 *parents, size_t count, Matrix4 *worlds)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (parents[i] >= 0 && (size_t) parents[i] >= i)
+			throw love::Exception("Transform %d's parent (%d) must come before it.", (int) i + 1, (int) parents[i] + 1);
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		// Copied first since the output may overwrite the input.
+		Matrix4 local = locals[i];
+
+		if (parents[i] < 0)
+			worlds[i] = local;
+		else
+			Matrix4::multiply(worlds[parents[i]], local, worlds[i]);
+	}
+}
+
 /**
  * http://en.wikipedia.org/wiki/SRGB#The_reverse_transformation
  **/
@@ -207,6 +122,8 @@ Math::Math()
 
 	rng.set(new RandomGenerator(), Acquire::NORETAIN);
 	rng->setSeed(seed);
+
+	float16Init(); // Makes sure fillNoise can write half-float formats.
 }
 
 Math::~Math()
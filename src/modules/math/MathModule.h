@@ -26,6 +26,7 @@
 // LOVE
 #include "common/Module.h"
 #include "common/math.h"
+#include "common/Matrix.h"
 #include "common/Vector.h"
 #include "common/int.h"
 
@@ -55,11 +56,37 @@ struct Triangle
 /**
  * Triangulate a simple polygon.
  *
- * @param polygon Polygon to triangulate. Must not intersect itself.
+ * @param polygon Polygon to triangulate.
  * @return List of triangles the polygon is composed of.
  **/
 std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon);
 
+/**
+ * Triangulate a polygon with holes. Degenerate and self-intersecting input
+ * produces a best-effort result instead of an error.
+ *
+ * @param vertices The vertices of the outer ring followed by each hole.
+ * @param holeStarts The index in vertices of the first vertex of each hole.
+ * @return Three vertex indices per triangle.
+ **/
+std::vector<uint32> triangulate(const std::vector<love::Vector2> &vertices, const std::vector<size_t> &holeStarts);
+
+/**
+ * Checks whether any two edges of a polygon's rings cross each other.
+ **/
+bool isSelfIntersecting(const std::vector<love::Vector2> &vertices, const std::vector<size_t> &holeStarts);
+
+/**
+ * Triangulate a polygon whose rings may cross each other or themselves, using
+ * the even-odd or non-zero winding rule to decide which areas are inside.
+ *
+ * @param vertices The vertices of the outer ring followed by each hole.
+ * @param holeStarts The index in vertices of the first vertex of each hole.
+ * @param nonZero Whether to use the non-zero rule rather than even-odd.
+ * @return Three vertices per triangle.
+ **/
+std::vector<love::Vector2> triangulateSelfIntersecting(const std::vector<love::Vector2> &vertices, const std::vector<size_t> &holeStarts, bool nonZero);
+
 /**
  * Checks whether a polygon is convex.
  *
@@ -67,6 +94,21 @@ std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon);
  * @return True if the polygon is convex, false otherwise.
  **/
 bool isConvex(const std::vector<love::Vector2> &polygon);
+bool isConvex(const love::Vector2 *polygon, size_t count);
+
+/**
+ * Computes the world matrix of every node in a transform hierarchy in a
+ * single pass. A node's world matrix is its parent's world matrix multiplied
+ * by its local matrix.
+ *
+ * @param locals Each node's matrix relative to its parent.
+ * @param parents Index of each node's parent, or a negative value for root
+ *        nodes. Parents must come before their children.
+ * @param count Number of nodes.
+ * @param[out] worlds Receives the world matrices. May be the same array as
+ *             locals.
+ **/
+void composeTransforms(const Matrix4 *locals, const int32 *parents, size_t count, Matrix4 *worlds);
 
 /**
  * Converts a value from the sRGB (gamma) colorspace to linear RGB.
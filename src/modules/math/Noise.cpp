@@ -0,0 +1,561 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Noise.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "common/floattypes.h"
+#include "common/StringMap.h"
+#include "thread/ThreadPool.h"
+
+// Noise
+#include "libraries/noise1234/noise1234.h"
+#include "libraries/noise1234/simplexnoise1234.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace math
+{
+
+namespace
+{
+
+// Minimal 4-wide float vector, one noise sample per lane.
+
+#if defined(LOVE_SIMD_SSE2)
+
+typedef __m128 float4;
+
+inline float4 load4(const float *p) { return _mm_loadu_ps(p); }
+inline void store4(float *p, float4 v) { _mm_storeu_ps(p, v); }
+inline float4 splat4(float x) { return _mm_set1_ps(x); }
+inline float4 add4(float4 a, float4 b) { return _mm_add_ps(a, b); }
+inline float4 sub4(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+inline float4 mul4(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+inline float4 max4(float4 a, float4 b) { return _mm_max_ps(a, b); }
+
+// 1 where a > b, 0 elsewhere.
+inline float4 greater4(float4 a, float4 b)
+{
+	return _mm_and_ps(_mm_cmpgt_ps(a, b), _mm_set1_ps(1.0f));
+}
+
+// Same rounding as FASTFLOOR in noise1234: (x > 0) ? (int)x : (int)x - 1.
+inline float4 fastfloor4(float4 v)
+{
+	float4 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(t, _mm_and_ps(_mm_cmple_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)));
+}
+
+#elif defined(LOVE_SIMD_NEON)
+
+typedef float32x4_t float4;
+
+inline float4 load4(const float *p) { return vld1q_f32(p); }
+inline void store4(float *p, float4 v) { vst1q_f32(p, v); }
+inline float4 splat4(float x) { return vdupq_n_f32(x); }
+inline float4 add4(float4 a, float4 b) { return vaddq_f32(a, b); }
+inline float4 sub4(float4 a, float4 b) { return vsubq_f32(a, b); }
+inline float4 mul4(float4 a, float4 b) { return vmulq_f32(a, b); }
+inline float4 max4(float4 a, float4 b) { return vmaxq_f32(a, b); }
+
+inline float4 greater4(float4 a, float4 b)
+{
+	return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(a, b), vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+}
+
+inline float4 fastfloor4(float4 v)
+{
+	float4 t = vcvtq_f32_s32(vcvtq_s32_f32(v));
+	uint32x4_t le = vcleq_f32(v, vdupq_n_f32(0.0f));
+	return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(le, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+}
+
+#else
+
+struct float4
+{
+	float v[4];
+};
+
+inline float4 load4(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store4(float *p, float4 a) { for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+inline float4 splat4(float x) { return {{x, x, x, x}}; }
+inline float4 add4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+inline float4 sub4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+inline float4 mul4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+inline float4 max4(float4 a, float4 b) { for (int i = 0; i < 4; i++) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+
+inline float4 greater4(float4 a, float4 b)
+{
+	for (int i = 0; i < 4; i++) a.v[i] = a.v[i] > b.v[i] ? 1.0f : 0.0f;
+	return a;
+}
+
+inline float4 fastfloor4(float4 a)
+{
+	for (int i = 0; i < 4; i++) a.v[i] = (float) (a.v[i] > 0 ? (int) a.v[i] : (int) a.v[i] - 1);
+	return a;
+}
+
+#endif
+
+// The 8 gradient directions selected by the low 3 bits of a hash in the 2D
+// grad() functions of both noise libraries, as (x, y) weights.
+const float gradX[8] = { 1.0f, -1.0f,  1.0f, -1.0f, 2.0f,  2.0f, -2.0f, -2.0f };
+const float gradY[8] = { 2.0f,  2.0f, -2.0f, -2.0f, 1.0f, -1.0f,  1.0f, -1.0f };
+
+// Gradients for 4 lanes, gathered from scalar lattice hashes.
+struct Gradient4
+{
+	float x[4];
+	float y[4];
+
+	void set(int lane, int hash)
+	{
+		x[lane] = gradX[hash & 7];
+		y[lane] = gradY[hash & 7];
+	}
+};
+
+inline float4 grad4(const Gradient4 &g, float4 x, float4 y)
+{
+	return add4(mul4(load4(g.x), x), mul4(load4(g.y), y));
+}
+
+inline float4 simplexCorner4(const Gradient4 &g, float4 x, float4 y)
+{
+	float4 t = max4(sub4(sub4(splat4(0.5f), mul4(x, x)), mul4(y, y)), splat4(0.0f));
+	t = mul4(t, t);
+	return mul4(mul4(t, t), grad4(g, x, y));
+}
+
+// SimplexNoise1234::noise(x, y) for 4 points.
+float4 simplex4(float4 x, float4 y)
+{
+	const float F2 = 0.366025403f;
+	const float G2 = 0.211324865f;
+	const unsigned char *perm = SimplexNoise1234::getPermutation();
+
+	float4 s = mul4(add4(x, y), splat4(F2));
+	float4 i = fastfloor4(add4(x, s));
+	float4 j = fastfloor4(add4(y, s));
+
+	float4 t = mul4(add4(i, j), splat4(G2));
+	float4 x0 = sub4(x, sub4(i, t));
+	float4 y0 = sub4(y, sub4(j, t));
+
+	float4 i1 = greater4(x0, y0);
+	float4 j1 = sub4(splat4(1.0f), i1);
+
+	float4 x1 = add4(sub4(x0, i1), splat4(G2));
+	float4 y1 = add4(sub4(y0, j1), splat4(G2));
+	float4 x2 = add4(x0, splat4(-1.0f + 2.0f * G2));
+	float4 y2 = add4(y0, splat4(-1.0f + 2.0f * G2));
+
+	float fi[4], fj[4], fi1[4];
+	store4(fi, i);
+	store4(fj, j);
+	store4(fi1, i1);
+
+	Gradient4 g0, g1, g2;
+	for (int k = 0; k < 4; k++)
+	{
+		int ii = (int) fi[k] & 0xff;
+		int jj = (int) fj[k] & 0xff;
+		int di = (int) fi1[k];
+		int dj = 1 - di;
+
+		g0.set(k, perm[ii + perm[jj]]);
+		g1.set(k, perm[ii + di + perm[jj + dj]]);
+		g2.set(k, perm[ii + 1 + perm[jj + 1]]);
+	}
+
+	float4 n = add4(add4(simplexCorner4(g0, x0, y0), simplexCorner4(g1, x1, y1)), simplexCorner4(g2, x2, y2));
+	return mul4(n, splat4(45.23f));
+}
+
+inline float4 fade4(float4 t)
+{
+	float4 p = add4(mul4(t, sub4(mul4(t, splat4(6.0f)), splat4(15.0f))), splat4(10.0f));
+	return mul4(mul4(mul4(t, t), t), p);
+}
+
+inline float4 lerp4(float4 t, float4 a, float4 b)
+{
+	return add4(a, mul4(t, sub4(b, a)));
+}
+
+// Noise1234::noise(x, y) for 4 points.
+float4 perlin4(float4 x, float4 y)
+{
+	const unsigned char *perm = Noise1234::getPermutation();
+
+	float4 ix = fastfloor4(x);
+	float4 iy = fastfloor4(y);
+
+	float4 fx0 = sub4(x, ix);
+	float4 fy0 = sub4(y, iy);
+	float4 fx1 = sub4(fx0, splat4(1.0f));
+	float4 fy1 = sub4(fy0, splat4(1.0f));
+
+	float fix[4], fiy[4];
+	store4(fix, ix);
+	store4(fiy, iy);
+
+	Gradient4 g00, g01, g10, g11;
+	for (int k = 0; k < 4; k++)
+	{
+		int ix0 = (int) fix[k];
+		int iy0 = (int) fiy[k];
+		int ix1 = (ix0 + 1) & 0xff;
+		int iy1 = (iy0 + 1) & 0xff;
+		ix0 &= 0xff;
+		iy0 &= 0xff;
+
+		g00.set(k, perm[ix0 + perm[iy0]]);
+		g01.set(k, perm[ix0 + perm[iy1]]);
+		g10.set(k, perm[ix1 + perm[iy0]]);
+		g11.set(k, perm[ix1 + perm[iy1]]);
+	}
+
+	float4 s = fade4(fx0);
+	float4 t = fade4(fy0);
+
+	float4 n0 = lerp4(t, grad4(g00, fx0, fy0), grad4(g01, fx0, fy1));
+	float4 n1 = lerp4(t, grad4(g10, fx1, fy0), grad4(g11, fx1, fy1));
+
+	return mul4(lerp4(s, n0, n1), splat4(0.507f));
+}
+
+template <typename NoiseFunc>
+void rowNoiseLoop(const float *x, const float *y, float amplitude, float *dst, int count, NoiseFunc noise)
+{
+	const float4 amp = splat4(amplitude);
+	int i = 0;
+
+	for (; i + 4 <= count; i += 4)
+		store4(dst + i, add4(load4(dst + i), mul4(amp, noise(load4(x + i), load4(y + i)))));
+
+	if (i < count)
+	{
+		float tx[4] = {}, ty[4] = {}, tn[4];
+		for (int k = 0; i + k < count; k++)
+		{
+			tx[k] = x[i + k];
+			ty[k] = y[i + k];
+		}
+
+		store4(tn, noise(load4(tx), load4(ty)));
+
+		for (int k = 0; i + k < count; k++)
+			dst[i + k] += amplitude * tn[k];
+	}
+}
+
+inline double noise3(NoiseType type, double x, double y, double z)
+{
+	if (type == NOISE_PERLIN)
+		return Noise1234::noise(x, y, z);
+	else
+		return SimplexNoise1234::noise(x, y, z);
+}
+
+struct Octave
+{
+	double frequency;
+	float amplitude;
+};
+
+// Per-octave frequencies, and amplitudes normalized to sum to 1.
+std::vector<Octave> getOctaves(const NoiseParams &params)
+{
+	if (params.octaves < 1)
+		throw love::Exception("Noise octave count must be at least 1.");
+
+	std::vector<Octave> octaves(params.octaves);
+
+	double frequency = params.frequency;
+	double amplitude = 1.0;
+	double total = 0.0;
+
+	for (Octave &o : octaves)
+	{
+		o.frequency = frequency;
+		o.amplitude = (float) amplitude;
+		total += amplitude;
+		frequency *= params.lacunarity;
+		amplitude *= params.gain;
+	}
+
+	if (total == 0.0)
+		throw love::Exception("Noise gain must not be 0 with more than one octave.");
+
+	for (Octave &o : octaves)
+		o.amplitude = (float) (o.amplitude / total);
+
+	return octaves;
+}
+
+inline uint8 toUnorm8(float v)
+{
+	return (uint8) (std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+inline uint16 toUnorm16(float v)
+{
+	return (uint16) (std::min(std::max(v, 0.0f), 1.0f) * 65535.0f + 0.5f);
+}
+
+inline float toFloat32(float v)
+{
+	return v;
+}
+
+// Color channels get the value, a 4th (alpha) channel gets 'one'.
+template <typename T, typename Convert>
+void writeChannels(const float *values, int count, int components, T one, Convert convert, void *dst)
+{
+	T *p = (T *) dst;
+
+	for (int i = 0; i < count; i++, p += components)
+	{
+		T v = convert(values[i]);
+		for (int c = 0; c < std::min(components, 3); c++)
+			p[c] = v;
+		if (components == 4)
+			p[3] = one;
+	}
+}
+
+// Maps summed noise from [-1, 1] to [0, 1] and writes it as 'format'.
+void writeRow(PixelFormat format, float *values, int count, void *dst)
+{
+	for (int i = 0; i < count; i++)
+		values[i] = values[i] * 0.5f + 0.5f;
+
+	int components = getPixelFormatInfo(format).components;
+
+	switch (format)
+	{
+	case PIXELFORMAT_R8_UNORM:
+	case PIXELFORMAT_RG8_UNORM:
+	case PIXELFORMAT_RGBA8_UNORM:
+		writeChannels<uint8>(values, count, components, 255, toUnorm8, dst);
+		break;
+	case PIXELFORMAT_R16_UNORM:
+	case PIXELFORMAT_RG16_UNORM:
+	case PIXELFORMAT_RGBA16_UNORM:
+		writeChannels<uint16>(values, count, components, 65535, toUnorm16, dst);
+		break;
+	case PIXELFORMAT_R16_FLOAT:
+	case PIXELFORMAT_RG16_FLOAT:
+	case PIXELFORMAT_RGBA16_FLOAT:
+		writeChannels<float16>(values, count, components, float32to16(1.0f), float32to16, dst);
+		break;
+	case PIXELFORMAT_R32_FLOAT:
+	case PIXELFORMAT_RG32_FLOAT:
+	case PIXELFORMAT_RGBA32_FLOAT:
+		writeChannels<float>(values, count, components, 1.0f, toFloat32, dst);
+		break;
+	default:
+		break;
+	}
+}
+
+void checkFormat(PixelFormat format)
+{
+	if (!isNoiseFormatSupported(format))
+	{
+		const char *name = "unknown";
+		love::getConstant(format, name);
+		throw love::Exception("Noise cannot be written in the %s pixel format.", name);
+	}
+}
+
+} // anonymous namespace
+
+void rowNoise2(NoiseType type, const float *x, const float *y, float amplitude, float *dst, int count)
+{
+	if (type == NOISE_PERLIN)
+		rowNoiseLoop(x, y, amplitude, dst, count, perlin4);
+	else
+		rowNoiseLoop(x, y, amplitude, dst, count, simplex4);
+}
+
+bool isNoiseFormatSupported(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_R8_UNORM:
+	case PIXELFORMAT_RG8_UNORM:
+	case PIXELFORMAT_RGBA8_UNORM:
+	case PIXELFORMAT_R16_UNORM:
+	case PIXELFORMAT_RG16_UNORM:
+	case PIXELFORMAT_RGBA16_UNORM:
+	case PIXELFORMAT_R16_FLOAT:
+	case PIXELFORMAT_RG16_FLOAT:
+	case PIXELFORMAT_RGBA16_FLOAT:
+	case PIXELFORMAT_R32_FLOAT:
+	case PIXELFORMAT_RG32_FLOAT:
+	case PIXELFORMAT_RGBA32_FLOAT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void fillNoise(const NoiseParams &params, PixelFormat format, int width, int height, void *dst)
+{
+	checkFormat(format);
+
+	std::vector<Octave> octaves = getOctaves(params);
+
+	if (width <= 0 || height <= 0)
+		return;
+
+	size_t rowsize = getPixelFormatInfo(format).blockSize * width;
+	size_t minrows = std::max(1, 4096 / width);
+
+	thread::ThreadPool::getShared()->parallelFor(height, minrows, [&](size_t begin, size_t end)
+	{
+		std::vector<float> buffer(width * 3);
+		float *xs = buffer.data();
+		float *ys = xs + width;
+		float *values = ys + width;
+
+		for (size_t row = begin; row < end; row++)
+		{
+			std::fill(values, values + width, 0.0f);
+
+			for (const Octave &o : octaves)
+			{
+				double y = (params.y + row) * o.frequency;
+
+				if (params.useZ)
+				{
+					double z = params.z * o.frequency;
+					for (int i = 0; i < width; i++)
+						values[i] += o.amplitude * (float) noise3(params.type, (params.x + i) * o.frequency, y, z);
+				}
+				else
+				{
+					for (int i = 0; i < width; i++)
+						xs[i] = (float) ((params.x + i) * o.frequency);
+					std::fill(ys, ys + width, (float) y);
+
+					rowNoise2(params.type, xs, ys, o.amplitude, values, width);
+				}
+			}
+
+			writeRow(format, values, width, (uint8 *) dst + row * rowsize);
+		}
+	});
+}
+
+void fillNoise(const NoiseParams &params, PixelFormat format, const float *points, size_t count, void *dst)
+{
+	checkFormat(format);
+
+	std::vector<Octave> octaves = getOctaves(params);
+
+	size_t pixelsize = getPixelFormatInfo(format).blockSize;
+	const int chunksize = 256;
+
+	thread::ThreadPool::getShared()->parallelFor(count, 4096, [&](size_t begin, size_t end)
+	{
+		float buffer[chunksize * 3];
+		float *xs = buffer;
+		float *ys = xs + chunksize;
+		float *values = ys + chunksize;
+
+		for (size_t first = begin; first < end; first += chunksize)
+		{
+			int n = (int) std::min<size_t>(chunksize, end - first);
+			const float *p = points + first * 2;
+
+			std::fill(values, values + n, 0.0f);
+
+			for (const Octave &o : octaves)
+			{
+				if (params.useZ)
+				{
+					double z = params.z * o.frequency;
+					for (int i = 0; i < n; i++)
+					{
+						double x = (params.x + p[i * 2 + 0]) * o.frequency;
+						double y = (params.y + p[i * 2 + 1]) * o.frequency;
+						values[i] += o.amplitude * (float) noise3(params.type, x, y, z);
+					}
+				}
+				else
+				{
+					for (int i = 0; i < n; i++)
+					{
+						xs[i] = (float) ((params.x + p[i * 2 + 0]) * o.frequency);
+						ys[i] = (float) ((params.y + p[i * 2 + 1]) * o.frequency);
+					}
+
+					rowNoise2(params.type, xs, ys, o.amplitude, values, n);
+				}
+			}
+
+			writeRow(format, values, n, (uint8 *) dst + first * pixelsize);
+		}
+	});
+}
+
+static StringMap<NoiseType, NOISE_MAX_ENUM>::Entry noiseTypeEntries[] =
+{
+	{ "simplex", NOISE_SIMPLEX },
+	{ "perlin",  NOISE_PERLIN  },
+};
+
+static StringMap<NoiseType, NOISE_MAX_ENUM> noiseTypes(noiseTypeEntries, sizeof(noiseTypeEntries));
+
+bool getConstant(const char *in, NoiseType &out)
+{
+	return noiseTypes.find(in, out);
+}
+
+bool getConstant(NoiseType in, const char *&out)
+{
+	return noiseTypes.find(in, out);
+}
+
+std::vector<std::string> getConstants(NoiseType)
+{
+	return noiseTypes.getNames();
+}
+
+} // math
+} // love
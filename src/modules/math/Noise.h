@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/pixelformat.h"
+#include "common/int.h"
+
+// C++
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * Bulk fractal noise generation. Samples are written directly into memory in
+ * a pixel format, with rows split across the shared thread pool. 2D noise uses
+ * 4-wide SIMD kernels, 3D noise uses the scalar noise functions.
+ **/
+
+enum NoiseType
+{
+	NOISE_SIMPLEX,
+	NOISE_PERLIN,
+	NOISE_MAX_ENUM
+};
+
+struct NoiseParams
+{
+	NoiseType type = NOISE_SIMPLEX;
+
+	// Offset added to every sample coordinate before scaling by frequency.
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+	bool useZ = false;
+
+	double frequency = 1.0;
+	int octaves = 1;
+	double lacunarity = 2.0;
+	double gain = 0.5;
+};
+
+/**
+ * Writes a width x height grid of fractal noise in [0, 1] to dst. Pixel (i, j)
+ * samples the noise at (x + i, y + j) scaled by the frequency. For RGB(A)
+ * formats the value is written to each color channel and alpha is 1.
+ **/
+void fillNoise(const NoiseParams &params, PixelFormat format, int width, int height, void *dst);
+
+/**
+ * Writes one noise sample per point to dst, for 'count' (x, y) pairs.
+ **/
+void fillNoise(const NoiseParams &params, PixelFormat format, const float *points, size_t count, void *dst);
+
+bool isNoiseFormatSupported(PixelFormat format);
+
+/**
+ * Adds amplitude * noise(x[i], y[i]) to dst[i], with noise in [-1, 1].
+ **/
+void rowNoise2(NoiseType type, const float *x, const float *y, float amplitude, float *dst, int count);
+
+bool getConstant(const char *in, NoiseType &out);
+bool getConstant(NoiseType in, const char *&out);
+std::vector<std::string> getConstants(NoiseType);
+
+} // math
+} // love
@@ -19,14 +19,18 @@
  **/
 
 #include "RandomGenerator.h"
+#include "thread/ThreadPool.h"
 
 // C++
 #include <sstream>
 #include <iomanip>
+#include <type_traits>
+#include <vector>
 
 // C
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -52,6 +56,147 @@ love::Type RandomGenerator::type("RandomGenerator", &Object::type);
 // 64 bit Xorshift implementation taken from the end of Sec. 3 (page 4) in
 // George Marsaglia, "Xorshift RNGs", Journal of Statistical Software, Vol.8 (Issue 14), 2003
 // Use an 'Xorshift*' variant, as shown here: http://xorshift.di.unimi.it
+static inline uint64 xorshiftStar(uint64 &state)
+{
+	state ^= (state >> 12);
+	state ^= (state << 25);
+	state ^= (state >> 27);
+	return state * 2685821657736338717ULL;
+}
+
+// Same as RandomGenerator::random().
+static inline double toUnitDouble(uint64 r)
+{
+	union { uint64 i; double d; } u;
+	u.i = ((0x3FFULL) << 52) | (r >> 12);
+	return u.d - 1.0;
+}
+
+// The xorshift state update is linear over GF(2), so advancing it by n steps
+// is a multiplication with the n'th power of a 64x64 bit matrix. Matrices are
+// stored as the images of each of the 64 unit vectors.
+struct JumpMatrix
+{
+	uint64 columns[64];
+};
+
+static uint64 multiply(const JumpMatrix &m, uint64 v)
+{
+	uint64 r = 0;
+	for (int i = 0; v != 0; i++, v >>= 1)
+	{
+		if (v & 1)
+			r ^= m.columns[i];
+	}
+	return r;
+}
+
+// The state update raised to the powers 2^0 ... 2^63.
+static const JumpMatrix *getJumpMatrices()
+{
+	static const std::vector<JumpMatrix> matrices = []()
+	{
+		std::vector<JumpMatrix> m(64);
+
+		for (int i = 0; i < 64; i++)
+		{
+			uint64 v = 1ULL << i;
+			xorshiftStar(v);
+			m[0].columns[i] = v;
+		}
+
+		for (int p = 1; p < 64; p++)
+		{
+			for (int i = 0; i < 64; i++)
+				m[p].columns[i] = multiply(m[p - 1], m[p - 1].columns[i]);
+		}
+
+		return m;
+	}();
+
+	return matrices.data();
+}
+
+static uint64 jumpState(uint64 state, uint64 steps)
+{
+	const JumpMatrix *matrices = getJumpMatrices();
+	for (int p = 0; steps != 0; p++, steps >>= 1)
+	{
+		if (steps & 1)
+			state = multiply(matrices[p], state);
+	}
+	return state;
+}
+
+template <typename T>
+static inline T convertValue(double v)
+{
+	return (T) v;
+}
+
+template <>
+inline int32 convertValue<int32>(double v)
+{
+	return (int32) (int64) floor(v);
+}
+
+template <>
+inline uint32 convertValue<uint32>(double v)
+{
+	return (uint32) (int64) floor(v);
+}
+
+template <typename T, typename F>
+static void writeValues(uint8 *dst, size_t count, F next)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		T v = convertValue<T>(next());
+		memcpy(dst + i * sizeof(T), &v, sizeof(T));
+	}
+}
+
+template <typename T>
+static void fillValues(const RandomGenerator::FillParams &p, uint64 state, uint8 *dst, size_t count)
+{
+	switch (p.distribution)
+	{
+	case RandomGenerator::DISTRIBUTION_UNIFORM:
+	default:
+	{
+		// Rounding, in the calculation or when narrowing to T, can give exactly
+		// max. Floating point values are kept below it, like random() is kept
+		// below 1.
+		const T max = convertValue<T>(p.max);
+		const T below = (T) std::nextafter(max, convertValue<T>(p.min));
+		const bool clamp = std::is_floating_point<T>::value && p.max > p.min;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			T v = convertValue<T>(toUnitDouble(xorshiftStar(state)) * (p.max - p.min) + p.min);
+			if (clamp && v >= max)
+				v = below;
+			memcpy(dst + i * sizeof(T), &v, sizeof(T));
+		}
+		break;
+	}
+	case RandomGenerator::DISTRIBUTION_INTEGER:
+		writeValues<T>(dst, count, [&]()
+		{
+			return floor(toUnitDouble(xorshiftStar(state)) * (p.max - p.min + 1.0)) + p.min;
+		});
+		break;
+	case RandomGenerator::DISTRIBUTION_NORMAL:
+		// Box-Muller, as in randomNormal but without caching the second value.
+		writeValues<T>(dst, count, [&]()
+		{
+			double r = sqrt(-2.0 * log(1. - toUnitDouble(xorshiftStar(state))));
+			double phi = 2.0 * LOVE_M_PI * (1. - toUnitDouble(xorshiftStar(state)));
+			return r * sin(phi) * p.stddev + p.mean;
+		});
+		break;
+	}
+}
 
 RandomGenerator::RandomGenerator()
 	: last_randomnormal(std::numeric_limits<double>::infinity())
@@ -64,12 +209,14 @@ RandomGenerator::RandomGenerator()
 	setSeed(newseed);
 }
 
+RandomGenerator *RandomGenerator::clone() const
+{
+	return new RandomGenerator(*this);
+}
+
 uint64 RandomGenerator::rand()
 {
-	rng_state.b64 ^= (rng_state.b64 >> 12);
-	rng_state.b64 ^= (rng_state.b64 << 25);
-	rng_state.b64 ^= (rng_state.b64 >> 27);
-	return rng_state.b64 * 2685821657736338717ULL;
+	return xorshiftStar(rng_state.b64);
 }
 
 // Box–Muller transform
@@ -90,6 +237,61 @@ double RandomGenerator::randomNormal(double stddev)
 	return r * sin(phi) * stddev;
 }
 
+void RandomGenerator::fill(const FillParams &params, void *dst, size_t count)
+{
+	uint64 steps = params.distribution == DISTRIBUTION_NORMAL ? 2 : 1;
+	uint64 start = rng_state.b64;
+	size_t size = getValueTypeSize(params.type);
+	uint8 *bytes = (uint8 *) dst;
+
+	// Every range jumps to its own part of the sequence, so the result doesn't
+	// depend on how the work is split.
+	thread::ThreadPool::getShared()->parallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+	{
+		uint64 state = jumpState(start, begin * steps);
+		uint8 *rangedst = bytes + begin * size;
+		size_t rangecount = end - begin;
+
+		switch (params.type)
+		{
+		case VALUE_FLOAT:
+		default:
+			fillValues<float>(params, state, rangedst, rangecount);
+			break;
+		case VALUE_DOUBLE:
+			fillValues<double>(params, state, rangedst, rangecount);
+			break;
+		case VALUE_INT32:
+			fillValues<int32>(params, state, rangedst, rangecount);
+			break;
+		case VALUE_UINT32:
+			fillValues<uint32>(params, state, rangedst, rangecount);
+			break;
+		}
+	});
+
+	rng_state.b64 = jumpState(start, count * steps);
+}
+
+void RandomGenerator::jump(uint64 steps)
+{
+	rng_state.b64 = jumpState(rng_state.b64, steps);
+}
+
+size_t RandomGenerator::getValueTypeSize(ValueType type)
+{
+	switch (type)
+	{
+	case VALUE_FLOAT:
+	case VALUE_INT32:
+	case VALUE_UINT32:
+	default:
+		return 4;
+	case VALUE_DOUBLE:
+		return 8;
+	}
+}
+
 void RandomGenerator::setSeed(RandomGenerator::Seed newseed)
 {
 	seed = newseed;
@@ -145,5 +347,54 @@ std::string RandomGenerator::getState() const
 	return ss.str();
 }
 
+bool RandomGenerator::getConstant(const char *in, Distribution &out)
+{
+	return distributions.find(in, out);
+}
+
+bool RandomGenerator::getConstant(Distribution in, const char *&out)
+{
+	return distributions.find(in, out);
+}
+
+std::vector<std::string> RandomGenerator::getConstants(Distribution)
+{
+	return distributions.getNames();
+}
+
+bool RandomGenerator::getConstant(const char *in, ValueType &out)
+{
+	return valueTypes.find(in, out);
+}
+
+bool RandomGenerator::getConstant(ValueType in, const char *&out)
+{
+	return valueTypes.find(in, out);
+}
+
+std::vector<std::string> RandomGenerator::getConstants(ValueType)
+{
+	return valueTypes.getNames();
+}
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM>::Entry RandomGenerator::distributionEntries[] =
+{
+	{ "uniform", DISTRIBUTION_UNIFORM },
+	{ "integer", DISTRIBUTION_INTEGER },
+	{ "normal",  DISTRIBUTION_NORMAL  },
+};
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM> RandomGenerator::distributions(RandomGenerator::distributionEntries, sizeof(RandomGenerator::distributionEntries));
+
+StringMap<RandomGenerator::ValueType, RandomGenerator::VALUE_MAX_ENUM>::Entry RandomGenerator::valueTypeEntries[] =
+{
+	{ "float",  VALUE_FLOAT  },
+	{ "double", VALUE_DOUBLE },
+	{ "int32",  VALUE_INT32  },
+	{ "uint32", VALUE_UINT32 },
+};
+
+StringMap<RandomGenerator::ValueType, RandomGenerator::VALUE_MAX_ENUM> RandomGenerator::valueTypes(RandomGenerator::valueTypeEntries, sizeof(RandomGenerator::valueTypeEntries));
+
 } // math
 } // love
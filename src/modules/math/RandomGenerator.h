@@ -27,10 +27,12 @@
 #include "common/math.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/StringMap.h"
 
 // C++
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace love
 {
@@ -41,6 +43,36 @@ class RandomGenerator : public Object
 {
 public:
 
+	enum Distribution
+	{
+		DISTRIBUTION_UNIFORM,
+		DISTRIBUTION_INTEGER,
+		DISTRIBUTION_NORMAL,
+		DISTRIBUTION_MAX_ENUM
+	};
+
+	enum ValueType
+	{
+		VALUE_FLOAT,
+		VALUE_DOUBLE,
+		VALUE_INT32,
+		VALUE_UINT32,
+		VALUE_MAX_ENUM
+	};
+
+	struct FillParams
+	{
+		Distribution distribution = DISTRIBUTION_UNIFORM;
+		ValueType type = VALUE_FLOAT;
+
+		// Uniform values are in [min, max), integers in [min, max].
+		double min = 0.0;
+		double max = 1.0;
+
+		double mean = 0.0;
+		double stddev = 1.0;
+	};
+
 	static love::Type type;
 
 	union Seed
@@ -61,6 +93,8 @@ class RandomGenerator : public Object
 	RandomGenerator();
 	virtual ~RandomGenerator() {}
 
+	RandomGenerator *clone() const;
+
 	/**
 	 * Return uniformly distributed pseudo random integer.
 	 *
@@ -112,6 +146,31 @@ class RandomGenerator : public Object
 	 **/
 	double randomNormal(double stddev);
 
+	/**
+	 * Writes count pseudo random values to dst. The sequence is the same as
+	 * generating the values one at a time: uniform and integer values use one
+	 * step of the generator each, and normal values use two. Large fills are
+	 * split across threads.
+	 **/
+	void fill(const FillParams &params, void *dst, size_t count);
+
+	/**
+	 * Advances the generator as if rand() had been called the given number of
+	 * times, in constant time. Generators with the same state can jump to
+	 * disjoint parts of the sequence and fill them independently.
+	 **/
+	void jump(uint64 steps);
+
+	static size_t getValueTypeSize(ValueType type);
+
+	static bool getConstant(const char *in, Distribution &out);
+	static bool getConstant(Distribution in, const char *&out);
+	static std::vector<std::string> getConstants(Distribution);
+
+	static bool getConstant(const char *in, ValueType &out);
+	static bool getConstant(ValueType in, const char *&out);
+	static std::vector<std::string> getConstants(ValueType);
+
 	/**
 	 * Set pseudo-random seed.
 	 * It's up to the implementation how to use this.
@@ -140,6 +199,12 @@ class RandomGenerator : public Object
 	Seed rng_state;
 	double last_randomnormal;
 
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM>::Entry distributionEntries[];
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM> distributions;
+
+	static StringMap<ValueType, VALUE_MAX_ENUM>::Entry valueTypeEntries[];
+	static StringMap<ValueType, VALUE_MAX_ENUM> valueTypes;
+
 }; // RandomGenerator
 
 } // math
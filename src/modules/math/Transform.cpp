@@ -19,6 +19,7 @@
  **/
 
 #include "Transform.h"
+#include "thread/ThreadPool.h"
 
 namespace love
 {
@@ -118,6 +119,26 @@ love::Vector2 Transform::inverseTransformPoint(love::Vector2 p)
 	return result;
 }
 
+static void transformPointArray(const Matrix4 &m, love::Vector2 *points, size_t count)
+{
+	// Each point is only a handful of multiply-adds, so small batches aren't
+	// worth waking up worker threads for.
+	love::thread::ThreadPool::getShared()->parallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+	{
+		m.transformXY(points + begin, points + begin, (int) (end - begin));
+	});
+}
+
+void Transform::transformPoints(love::Vector2 *points, size_t count) const
+{
+	transformPointArray(matrix, points, count);
+}
+
+void Transform::inverseTransformPoints(love::Vector2 *points, size_t count)
+{
+	transformPointArray(getInverseMatrix(), points, count);
+}
+
 const Matrix4 &Transform::getMatrix() const
 {
 	return matrix;
@@ -66,6 +66,13 @@ class Transform : public Object
 	love::Vector2 transformPoint(love::Vector2 p) const;
 	love::Vector2 inverseTransformPoint(love::Vector2 p);
 
+	/**
+	 * Transforms an array of points in place. Large arrays are split across
+	 * the shared thread pool.
+	 **/
+	void transformPoints(love::Vector2 *points, size_t count) const;
+	void inverseTransformPoints(love::Vector2 *points, size_t count);
+
 	const Matrix4 &getMatrix() const;
 	void setMatrix(const Matrix4 &m);
 
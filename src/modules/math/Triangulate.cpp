@@ -0,0 +1,1022 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "MathModule.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+/**
+ * Ear clipping with z-order hashing and hole bridging, ported from earcut
+ * (https://github.com/mapbox/earcut):
+ *
+ * ISC License
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose
+ * with or without fee is hereby granted, provided that the above copyright notice
+ * and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF
+ * THIS SOFTWARE.
+ *
+ * Rings are doubly linked lists of nodes. Ears are checked only against nodes
+ * whose z-order (Morton) code falls within the ear's bounding box, which keeps
+ * large polygons close to O(n log n). Holes are joined to the outer ring with
+ * bridge edges, and polygons which are degenerate or self-intersecting are
+ * handled by filtering, curing local intersections and finally splitting,
+ * rather than by failing.
+ *
+ * Rings which cross each other are instead split into horizontal trapezoids at
+ * every vertex and crossing, and each trapezoid is kept or discarded using the
+ * even-odd or non-zero winding rule.
+ **/
+
+namespace love
+{
+namespace math
+{
+
+namespace
+{
+
+struct Node
+{
+	Node(uint32 i, double x, double y)
+		: i(i), x(x), y(y)
+	{}
+
+	// Index of the vertex in the input list.
+	uint32 i;
+	double x, y;
+
+	Node *prev = nullptr;
+	Node *next = nullptr;
+
+	// z-order curve value and neighbours in z-order.
+	int32 z = 0;
+	Node *prevZ = nullptr;
+	Node *nextZ = nullptr;
+
+	// Single-vertex holes are kept even if they're collinear.
+	bool steiner = false;
+};
+
+// Signed area of the triangle pqr, negative when counter-clockwise in a
+// y-down coordinate system.
+inline double area(const Node *p, const Node *q, const Node *r)
+{
+	return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+inline bool equals(const Node *a, const Node *b)
+{
+	return a->x == b->x && a->y == b->y;
+}
+
+inline int sign(double v)
+{
+	return (v > 0.0) - (v < 0.0);
+}
+
+inline bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+	return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+		&& (ax - px) * (by - py) >= (bx - px) * (ay - py)
+		&& (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+// Whether q lies on segment pr, given that the three points are collinear.
+inline bool onSegment(const Node *p, const Node *q, const Node *r)
+{
+	return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x)
+		&& q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+}
+
+bool intersects(const Node *p1, const Node *q1, const Node *p2, const Node *q2)
+{
+	int o1 = sign(area(p1, q1, p2));
+	int o2 = sign(area(p1, q1, q2));
+	int o3 = sign(area(p2, q2, p1));
+	int o4 = sign(area(p2, q2, q1));
+
+	if (o1 != o2 && o3 != o4)
+		return true;
+
+	if (o1 == 0 && onSegment(p1, p2, q1)) return true;
+	if (o2 == 0 && onSegment(p1, q2, q1)) return true;
+	if (o3 == 0 && onSegment(p2, p1, q2)) return true;
+	if (o4 == 0 && onSegment(p2, q1, q2)) return true;
+
+	return false;
+}
+
+// Whether the diagonal ab intersects any edge of the polygon.
+bool intersectsPolygon(const Node *a, const Node *b)
+{
+	const Node *p = a;
+	do
+	{
+		if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects(p, p->next, a, b))
+			return true;
+		p = p->next;
+	} while (p != a);
+
+	return false;
+}
+
+// Whether the diagonal ab starts inside the polygon at a.
+bool locallyInside(const Node *a, const Node *b)
+{
+	if (area(a->prev, a, a->next) < 0)
+		return area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0;
+	else
+		return area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+}
+
+// Whether the middle point of the diagonal ab is inside the polygon.
+bool middleInside(const Node *a, const Node *b)
+{
+	const Node *p = a;
+	bool inside = false;
+	double px = (a->x + b->x) / 2.0;
+	double py = (a->y + b->y) / 2.0;
+
+	do
+	{
+		if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y
+			&& (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+			inside = !inside;
+		p = p->next;
+	} while (p != a);
+
+	return inside;
+}
+
+bool isValidDiagonal(const Node *a, const Node *b)
+{
+	// Doesn't intersect other edges, and is locally visible from both ends.
+	return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b)
+		&& ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b)
+			&& (area(a->prev, a, b->prev) != 0.0 || area(a, b->prev, b) != 0.0))
+		|| (equals(a, b) && area(a->prev, a, a->next) > 0 && area(b->prev, b, b->next) > 0));
+}
+
+bool sectorContainsSector(const Node *m, const Node *p)
+{
+	return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+}
+
+void removeNode(Node *p)
+{
+	p->next->prev = p->prev;
+	p->prev->next = p->next;
+
+	if (p->prevZ)
+		p->prevZ->nextZ = p->nextZ;
+	if (p->nextZ)
+		p->nextZ->prevZ = p->prevZ;
+}
+
+// Removes duplicate and collinear points between start and end.
+Node *filterPoints(Node *start, Node *end = nullptr)
+{
+	if (start == nullptr)
+		return start;
+	if (end == nullptr)
+		end = start;
+
+	Node *p = start;
+	bool again = false;
+	do
+	{
+		again = false;
+		if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0.0))
+		{
+			removeNode(p);
+			p = end = p->prev;
+			if (p == p->next)
+				break;
+			again = true;
+		}
+		else
+			p = p->next;
+	} while (again || p != end);
+
+	return end;
+}
+
+Node *getLeftmost(Node *start)
+{
+	Node *p = start;
+	Node *leftmost = start;
+	do
+	{
+		if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+			leftmost = p;
+		p = p->next;
+	} while (p != start);
+
+	return leftmost;
+}
+
+// Interleaves the bits of the cell coordinates of a point, with coordinates
+// mapped to 15-bit integers within the polygon's bounding box.
+int32 zOrder(double px, double py, double minX, double minY, double invSize)
+{
+	uint32 x = (uint32) ((px - minX) * invSize);
+	uint32 y = (uint32) ((py - minY) * invSize);
+
+	x = (x | (x << 8)) & 0x00FF00FF;
+	x = (x | (x << 4)) & 0x0F0F0F0F;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+
+	y = (y | (y << 8)) & 0x00FF00FF;
+	y = (y | (y << 4)) & 0x0F0F0F0F;
+	y = (y | (y << 2)) & 0x33333333;
+	y = (y | (y << 1)) & 0x55555555;
+
+	return (int32) (x | (y << 1));
+}
+
+// Merge sort of the z-order list (Simon Tatham's linked list merge sort).
+Node *sortLinked(Node *list)
+{
+	int insize = 1;
+	int merges = 0;
+
+	do
+	{
+		Node *p = list;
+		Node *tail = nullptr;
+		list = nullptr;
+		merges = 0;
+
+		while (p != nullptr)
+		{
+			merges++;
+
+			Node *q = p;
+			int psize = 0;
+			for (int i = 0; i < insize; i++)
+			{
+				psize++;
+				q = q->nextZ;
+				if (q == nullptr)
+					break;
+			}
+
+			int qsize = insize;
+
+			while (psize > 0 || (qsize > 0 && q != nullptr))
+			{
+				Node *e = nullptr;
+				if (psize != 0 && (qsize == 0 || q == nullptr || p->z <= q->z))
+				{
+					e = p;
+					p = p->nextZ;
+					psize--;
+				}
+				else
+				{
+					e = q;
+					q = q->nextZ;
+					qsize--;
+				}
+
+				if (tail != nullptr)
+					tail->nextZ = e;
+				else
+					list = e;
+
+				e->prevZ = tail;
+				tail = e;
+			}
+
+			p = q;
+		}
+
+		tail->nextZ = nullptr;
+		insize *= 2;
+	} while (merges > 1);
+
+	return list;
+}
+
+class Triangulator
+{
+public:
+
+	Triangulator(const std::vector<Vector2> &vertices, std::vector<uint32> &indices)
+		: vertices(vertices)
+		, indices(indices)
+	{}
+
+	void run(const std::vector<size_t> &holeStarts)
+	{
+		size_t outerend = holeStarts.empty() ? vertices.size() : holeStarts[0];
+
+		Node *outer = linkedList(0, outerend, true);
+		if (outer == nullptr || outer->next == outer->prev)
+			return;
+
+		if (!holeStarts.empty())
+			outer = eliminateHoles(holeStarts, outer);
+
+		// z-order hashing only pays off for larger polygons.
+		if (vertices.size() > 80)
+		{
+			minX = maxX = vertices[0].x;
+			minY = maxY = vertices[0].y;
+
+			for (size_t i = 1; i < outerend; i++)
+			{
+				minX = std::min(minX, (double) vertices[i].x);
+				minY = std::min(minY, (double) vertices[i].y);
+				maxX = std::max(maxX, (double) vertices[i].x);
+				maxY = std::max(maxY, (double) vertices[i].y);
+			}
+
+			invSize = std::max(maxX - minX, maxY - minY);
+			invSize = invSize != 0.0 ? 32767.0 / invSize : 0.0;
+		}
+
+		earcutLinked(outer, 0);
+	}
+
+private:
+
+	Node *createNode(uint32 i, double x, double y)
+	{
+		nodes.emplace_back(i, x, y);
+		return &nodes.back();
+	}
+
+	Node *insertNode(uint32 i, Node *last)
+	{
+		Node *p = createNode(i, vertices[i].x, vertices[i].y);
+
+		if (last == nullptr)
+		{
+			p->prev = p;
+			p->next = p;
+		}
+		else
+		{
+			p->next = last->next;
+			p->prev = last;
+			last->next->prev = p;
+			last->next = p;
+		}
+
+		return p;
+	}
+
+	// Creates a circular list from a ring, in the specified winding order.
+	Node *linkedList(size_t start, size_t end, bool clockwise)
+	{
+		double sum = 0.0;
+		for (size_t i = start, j = end - 1; i < end; j = i++)
+			sum += ((double) vertices[j].x - vertices[i].x) * ((double) vertices[i].y + vertices[j].y);
+
+		Node *last = nullptr;
+
+		if (clockwise == (sum > 0.0))
+		{
+			for (size_t i = start; i < end; i++)
+				last = insertNode((uint32) i, last);
+		}
+		else
+		{
+			for (size_t i = end; i-- > start;)
+				last = insertNode((uint32) i, last);
+		}
+
+		if (last != nullptr && equals(last, last->next))
+		{
+			removeNode(last);
+			last = last->next;
+		}
+
+		return last;
+	}
+
+	// Links two nodes with a bridge. If they're in the same ring this splits
+	// it in two, otherwise it merges the rings into one.
+	Node *splitPolygon(Node *a, Node *b)
+	{
+		Node *a2 = createNode(a->i, a->x, a->y);
+		Node *b2 = createNode(b->i, b->x, b->y);
+		Node *an = a->next;
+		Node *bp = b->prev;
+
+		a->next = b;
+		b->prev = a;
+
+		a2->next = an;
+		an->prev = a2;
+
+		b2->next = a2;
+		a2->prev = b2;
+
+		bp->next = b2;
+		b2->prev = bp;
+
+		return b2;
+	}
+
+	Node *eliminateHoles(const std::vector<size_t> &holeStarts, Node *outer)
+	{
+		std::vector<Node *> queue;
+
+		for (size_t h = 0; h < holeStarts.size(); h++)
+		{
+			size_t start = holeStarts[h];
+			size_t end = h + 1 < holeStarts.size() ? holeStarts[h + 1] : vertices.size();
+
+			if (start >= end)
+				continue;
+
+			Node *list = linkedList(start, end, false);
+			if (list == nullptr)
+				continue;
+
+			if (list == list->next)
+				list->steiner = true;
+
+			queue.push_back(getLeftmost(list));
+		}
+
+		std::sort(queue.begin(), queue.end(), [](const Node *a, const Node *b) { return a->x < b->x; });
+
+		// Bridge holes to the outer ring from left to right.
+		for (Node *hole : queue)
+			outer = eliminateHole(hole, outer);
+
+		return outer;
+	}
+
+	Node *eliminateHole(Node *hole, Node *outer)
+	{
+		Node *bridge = findHoleBridge(hole, outer);
+		if (bridge == nullptr)
+			return outer;
+
+		Node *bridgeReverse = splitPolygon(bridge, hole);
+
+		filterPoints(bridgeReverse, bridgeReverse->next);
+		return filterPoints(bridge, bridge->next);
+	}
+
+	// David Eberly's algorithm for finding a bridge between a hole and the
+	// outer polygon.
+	Node *findHoleBridge(Node *hole, Node *outer)
+	{
+		Node *p = outer;
+		double hx = hole->x;
+		double hy = hole->y;
+		double qx = -std::numeric_limits<double>::infinity();
+		Node *m = nullptr;
+
+		// Find a segment intersected by a ray from the hole's leftmost point
+		// to the left. The segment's endpoint with the lesser x is the
+		// potential connection point.
+		do
+		{
+			if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+			{
+				double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+				if (x <= hx && x > qx)
+				{
+					qx = x;
+					m = p->x < p->next->x ? p : p->next;
+					if (x == hx)
+						return m; // The hole touches the outer segment.
+				}
+			}
+			p = p->next;
+		} while (p != outer);
+
+		if (m == nullptr)
+			return nullptr;
+
+		// Look for points inside the triangle of the hole point, the
+		// segment intersection and the endpoint. If there are none, the
+		// endpoint is the connection point, otherwise use the point with the
+		// minimum angle to the ray as the connection point.
+		const Node *stop = m;
+		double mx = m->x;
+		double my = m->y;
+		double tanMin = std::numeric_limits<double>::infinity();
+
+		p = m;
+		do
+		{
+			if (hx >= p->x && p->x >= mx && hx != p->x
+				&& pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+			{
+				double tan = std::abs(hy - p->y) / (hx - p->x);
+
+				if (locallyInside(p, hole)
+					&& (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sectorContainsSector(m, p))))))
+				{
+					m = p;
+					tanMin = tan;
+				}
+			}
+			p = p->next;
+		} while (p != stop);
+
+		return m;
+	}
+
+	void indexCurve(Node *start)
+	{
+		Node *p = start;
+		do
+		{
+			if (p->z == 0)
+				p->z = zOrder(p->x, p->y, minX, minY, invSize);
+			p->prevZ = p->prev;
+			p->nextZ = p->next;
+			p = p->next;
+		} while (p != start);
+
+		p->prevZ->nextZ = nullptr;
+		p->prevZ = nullptr;
+
+		sortLinked(p);
+	}
+
+	bool isEar(const Node *ear) const
+	{
+		const Node *a = ear->prev;
+		const Node *b = ear;
+		const Node *c = ear->next;
+
+		if (area(a, b, c) >= 0)
+			return false; // Reflex, can't be an ear.
+
+		double x0 = std::min(a->x, std::min(b->x, c->x));
+		double y0 = std::min(a->y, std::min(b->y, c->y));
+		double x1 = std::max(a->x, std::max(b->x, c->x));
+		double y1 = std::max(a->y, std::max(b->y, c->y));
+
+		// Make sure no other point is inside the potential ear.
+		for (const Node *p = c->next; p != a; p = p->next)
+		{
+			if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1
+				&& pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+				&& area(p->prev, p, p->next) >= 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool isEarHashed(const Node *ear) const
+	{
+		const Node *a = ear->prev;
+		const Node *b = ear;
+		const Node *c = ear->next;
+
+		if (area(a, b, c) >= 0)
+			return false;
+
+		double x0 = std::min(a->x, std::min(b->x, c->x));
+		double y0 = std::min(a->y, std::min(b->y, c->y));
+		double x1 = std::max(a->x, std::max(b->x, c->x));
+		double y1 = std::max(a->y, std::max(b->y, c->y));
+
+		// Only nodes within the ear's bounding box in z-order need checking.
+		int32 minZ = zOrder(x0, y0, minX, minY, invSize);
+		int32 maxZ = zOrder(x1, y1, minX, minY, invSize);
+
+		auto inside = [&](const Node *p)
+		{
+			return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c
+				&& pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+				&& area(p->prev, p, p->next) >= 0;
+		};
+
+		// Look for points in both directions of the z-order list at once.
+		const Node *p = ear->prevZ;
+		const Node *n = ear->nextZ;
+
+		while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ)
+		{
+			if (inside(p))
+				return false;
+			p = p->prevZ;
+
+			if (inside(n))
+				return false;
+			n = n->nextZ;
+		}
+
+		for (; p != nullptr && p->z >= minZ; p = p->prevZ)
+		{
+			if (inside(p))
+				return false;
+		}
+
+		for (; n != nullptr && n->z <= maxZ; n = n->nextZ)
+		{
+			if (inside(n))
+				return false;
+		}
+
+		return true;
+	}
+
+	void addTriangle(const Node *a, const Node *b, const Node *c)
+	{
+		indices.push_back(a->i);
+		indices.push_back(b->i);
+		indices.push_back(c->i);
+	}
+
+	// Main ear slicing loop. Later passes fall back to progressively more
+	// forgiving strategies for polygons that don't have any simple ears left.
+	void earcutLinked(Node *ear, int pass)
+	{
+		if (ear == nullptr)
+			return;
+
+		if (pass == 0 && invSize != 0.0)
+			indexCurve(ear);
+
+		Node *stop = ear;
+
+		while (ear->prev != ear->next)
+		{
+			Node *prev = ear->prev;
+			Node *next = ear->next;
+
+			if (invSize != 0.0 ? isEarHashed(ear) : isEar(ear))
+			{
+				addTriangle(prev, ear, next);
+				removeNode(ear);
+
+				// Skipping the next vertex leads to less sliver triangles.
+				ear = next->next;
+				stop = next->next;
+				continue;
+			}
+
+			ear = next;
+
+			// If we looped through the whole remaining polygon and can't find
+			// any more ears...
+			if (ear == stop)
+			{
+				if (pass == 0)
+					earcutLinked(filterPoints(ear), 1);
+				else if (pass == 1)
+					earcutLinked(cureLocalIntersections(filterPoints(ear)), 2);
+				else if (pass == 2)
+					splitEarcut(ear);
+
+				break;
+			}
+		}
+	}
+
+	// Cuts off triangles at small self-intersections (a-b-c-d where a-b and
+	// c-d cross).
+	Node *cureLocalIntersections(Node *start)
+	{
+		Node *p = start;
+		do
+		{
+			Node *a = p->prev;
+			Node *b = p->next->next;
+
+			if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a))
+			{
+				addTriangle(a, p, b);
+
+				removeNode(p);
+				removeNode(p->next);
+
+				p = start = b;
+			}
+			p = p->next;
+		} while (p != start);
+
+		return filterPoints(p);
+	}
+
+	// Splits the polygon in two along a valid diagonal and triangulates both.
+	void splitEarcut(Node *start)
+	{
+		Node *a = start;
+		do
+		{
+			Node *b = a->next->next;
+			while (b != a->prev)
+			{
+				if (a->i != b->i && isValidDiagonal(a, b))
+				{
+					Node *c = splitPolygon(a, b);
+
+					a = filterPoints(a, a->next);
+					c = filterPoints(c, c->next);
+
+					earcutLinked(a, 0);
+					earcutLinked(c, 0);
+					return;
+				}
+				b = b->next;
+			}
+			a = a->next;
+		} while (a != start);
+	}
+
+	const std::vector<Vector2> &vertices;
+	std::vector<uint32> &indices;
+
+	// Nodes never move once created, so they can link to each other.
+	std::deque<Node> nodes;
+
+	double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+	double invSize = 0.0;
+};
+
+} // anonymous namespace
+
+std::vector<uint32> triangulate(const std::vector<Vector2> &vertices, const std::vector<size_t> &holeStarts)
+{
+	for (size_t i = 0; i < holeStarts.size(); i++)
+	{
+		if (holeStarts[i] > vertices.size() || (i > 0 && holeStarts[i] < holeStarts[i - 1]))
+			throw love::Exception("Invalid polygon hole start index.");
+	}
+
+	std::vector<uint32> indices;
+	indices.reserve(vertices.size() * 3);
+
+	Triangulator triangulator(vertices, indices);
+	triangulator.run(holeStarts);
+
+	return indices;
+}
+
+std::vector<Triangle> triangulate(const std::vector<Vector2> &polygon)
+{
+	if (polygon.size() < 3)
+		throw love::Exception("Not a polygon");
+
+	std::vector<uint32> indices = triangulate(polygon, std::vector<size_t>());
+
+	std::vector<Triangle> triangles;
+	triangles.reserve(indices.size() / 3);
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		triangles.push_back(Triangle(polygon[indices[i + 0]], polygon[indices[i + 1]], polygon[indices[i + 2]]));
+
+	return triangles;
+}
+
+namespace
+{
+
+// A polygon edge, stored top to bottom.
+struct Edge
+{
+	double x0, y0, x1, y1;
+	int winding;
+
+	double xAt(double y) const
+	{
+		if (y <= y0)
+			return x0;
+		if (y >= y1)
+			return x1;
+		return x0 + (x1 - x0) * (y - y0) / (y1 - y0);
+	}
+};
+
+void getEdges(const std::vector<Vector2> &vertices, const std::vector<size_t> &holeStarts, bool horizontal, std::vector<Edge> &edges)
+{
+	edges.reserve(vertices.size());
+
+	for (size_t ring = 0; ring <= holeStarts.size(); ring++)
+	{
+		size_t start = ring == 0 ? 0 : holeStarts[ring - 1];
+		size_t end = ring < holeStarts.size() ? holeStarts[ring] : vertices.size();
+
+		for (size_t i = start; i < end; i++)
+		{
+			const Vector2 &a = vertices[i];
+			const Vector2 &b = vertices[i + 1 < end ? i + 1 : start];
+
+			if (a.y < b.y)
+				edges.push_back({a.x, a.y, b.x, b.y, 1});
+			else if (a.y > b.y || (horizontal && a.x != b.x))
+				edges.push_back({b.x, b.y, a.x, a.y, -1});
+		}
+	}
+
+	std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.y0 < b.y0; });
+}
+
+// Calls func for every pair of edges whose vertical extents overlap, stopping
+// early if it returns true. Edges must be sorted by y0.
+template <typename F>
+bool forEachOverlappingEdgePair(const std::vector<Edge> &edges, F func)
+{
+	std::vector<const Edge *> active;
+
+	for (const Edge &e : edges)
+	{
+		active.erase(std::remove_if(active.begin(), active.end(), [&](const Edge *a) { return a->y1 < e.y0; }), active.end());
+
+		for (const Edge *a : active)
+		{
+			if (std::max(a->x0, a->x1) < std::min(e.x0, e.x1) || std::min(a->x0, a->x1) > std::max(e.x0, e.x1))
+				continue;
+
+			if (func(*a, e))
+				return true;
+		}
+
+		active.push_back(&e);
+	}
+
+	return false;
+}
+
+inline double orient(double ax, double ay, double bx, double by, double px, double py)
+{
+	return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+// Whether the interiors of two edges cross at a single point.
+bool crosses(const Edge &a, const Edge &b, double &y)
+{
+	double o1 = orient(a.x0, a.y0, a.x1, a.y1, b.x0, b.y0);
+	double o2 = orient(a.x0, a.y0, a.x1, a.y1, b.x1, b.y1);
+	double o3 = orient(b.x0, b.y0, b.x1, b.y1, a.x0, a.y0);
+	double o4 = orient(b.x0, b.y0, b.x1, b.y1, a.x1, a.y1);
+
+	if (!(((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) && ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0))))
+		return false;
+
+	y = a.y0 + (a.y1 - a.y0) * (o3 / (o3 - o4));
+	return true;
+}
+
+} // anonymous namespace
+
+bool isSelfIntersecting(const std::vector<Vector2> &vertices, const std::vector<size_t> &holeStarts)
+{
+	std::vector<Edge> edges;
+	getEdges(vertices, holeStarts, true, edges);
+
+	return forEachOverlappingEdgePair(edges, [](const Edge &a, const Edge &b)
+	{
+		double y;
+		return crosses(a, b, y);
+	});
+}
+
+std::vector<Vector2> triangulateSelfIntersecting(const std::vector<Vector2> &vertices, const std::vector<size_t> &holeStarts, bool nonZero)
+{
+	for (size_t i = 0; i < holeStarts.size(); i++)
+	{
+		if (holeStarts[i] > vertices.size() || (i > 0 && holeStarts[i] < holeStarts[i - 1]))
+			throw love::Exception("Invalid polygon hole start index.");
+	}
+
+	// Horizontal edges never change the winding number within a slab.
+	std::vector<Edge> edges;
+	getEdges(vertices, holeStarts, false, edges);
+
+	// Split the polygon into horizontal slabs at every vertex and crossing, so
+	// that no two edges cross inside a slab.
+	std::vector<double> ys;
+	ys.reserve(edges.size() * 2);
+
+	for (const Edge &e : edges)
+	{
+		ys.push_back(e.y0);
+		ys.push_back(e.y1);
+	}
+
+	forEachOverlappingEdgePair(edges, [&](const Edge &a, const Edge &b)
+	{
+		double y;
+		if (crosses(a, b, y))
+			ys.push_back(y);
+		return false;
+	});
+
+	std::sort(ys.begin(), ys.end());
+	ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+	struct Span
+	{
+		double top, bottom, middle;
+		int winding;
+	};
+
+	std::vector<const Edge *> active;
+	std::vector<Span> spans;
+	std::vector<Vector2> triangles;
+	size_t next = 0;
+
+	for (size_t s = 0; s + 1 < ys.size(); s++)
+	{
+		double top = ys[s];
+		double bottom = ys[s + 1];
+
+		active.erase(std::remove_if(active.begin(), active.end(), [&](const Edge *e) { return e->y1 <= top; }), active.end());
+		while (next < edges.size() && edges[next].y0 <= top)
+		{
+			if (edges[next].y1 > top)
+				active.push_back(&edges[next]);
+			next++;
+		}
+
+		spans.clear();
+		for (const Edge *e : active)
+		{
+			double xtop = e->xAt(top);
+			double xbottom = e->xAt(bottom);
+			spans.push_back({xtop, xbottom, xtop + xbottom, e->winding});
+		}
+
+		std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) { return a.middle < b.middle; });
+
+		// Emit a trapezoid for every run of spans that is inside the polygon
+		// according to the fill rule.
+		int winding = 0;
+		const Span *left = nullptr;
+
+		for (const Span &span : spans)
+		{
+			winding += span.winding;
+			bool inside = nonZero ? winding != 0 : (winding & 1) != 0;
+
+			if (inside && left == nullptr)
+				left = &span;
+			else if (!inside && left != nullptr)
+			{
+				Vector2 tl((float) left->top, (float) top);
+				Vector2 tr((float) span.top, (float) top);
+				Vector2 br((float) span.bottom, (float) bottom);
+				Vector2 bl((float) left->bottom, (float) bottom);
+
+				if (tl.x != tr.x)
+				{
+					triangles.push_back(tl);
+					triangles.push_back(tr);
+					triangles.push_back(br);
+				}
+
+				if (bl.x != br.x)
+				{
+					triangles.push_back(tl);
+					triangles.push_back(br);
+					triangles.push_back(bl);
+				}
+
+				left = nullptr;
+			}
+		}
+	}
+
+	return triangles;
+}
+
+} // math
+} // love
@@ -23,8 +23,10 @@
 #include "wrap_BezierCurve.h"
 #include "wrap_Transform.h"
 #include "MathModule.h"
+#include "Noise.h"
 #include "BezierCurve.h"
 #include "Transform.h"
+#include "common/Data.h"
 
 #include <cmath>
 #include <iostream>
@@ -145,25 +147,55 @@ int w_newTransform(lua_State *L)
 	return 1;
 }
 
-int w_triangulate(lua_State *L)
+static void getFlatVertices(lua_State *L, int idx, std::vector<love::Vector2> &vertices)
 {
-	std::vector<love::Vector2> vertices;
-	if (lua_istable(L, 1))
+	int top = (int) luax_objlen(L, idx);
+	vertices.reserve(vertices.size() + top / 2);
+	for (int i = 1; i <= top; i += 2)
 	{
-		int top = (int) luax_objlen(L, 1);
-		vertices.reserve(top / 2);
-		for (int i = 1; i <= top; i += 2)
-		{
-			lua_rawgeti(L, 1, i);
-			lua_rawgeti(L, 1, i+1);
+		lua_rawgeti(L, idx, i);
+		lua_rawgeti(L, idx, i+1);
 
-			Vector2 v;
-			v.x = (float) luaL_checknumber(L, -2);
-			v.y = (float) luaL_checknumber(L, -1);
-			vertices.push_back(v);
+		Vector2 v;
+		v.x = (float) luaL_checknumber(L, -2);
+		v.y = (float) luaL_checknumber(L, -1);
+		vertices.push_back(v);
 
-			lua_pop(L, 2);
-		}
+		lua_pop(L, 2);
+	}
+}
+
+// Appends each hole in a list of flat vertex tables, recording where each one
+// starts.
+static void getPolygonHoles(lua_State *L, int idx, std::vector<love::Vector2> &vertices, std::vector<size_t> &holeStarts)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+	int holecount = (int) luax_objlen(L, idx);
+
+	for (int i = 1; i <= holecount; i++)
+	{
+		lua_rawgeti(L, idx, i);
+		if (!lua_istable(L, -1))
+			luaL_error(L, "Expected a table of vertices for hole %d.", i);
+
+		holeStarts.push_back(vertices.size());
+		getFlatVertices(L, lua_gettop(L), vertices);
+
+		lua_pop(L, 1);
+	}
+}
+
+// Shared by triangulate and triangulateIndices. Accepts a flat table with an
+// optional list of holes, or the outer ring's coordinates as arguments.
+static std::vector<uint32> triangulatePolygon(lua_State *L, std::vector<love::Vector2> &vertices)
+{
+	std::vector<size_t> holeStarts;
+
+	if (lua_istable(L, 1))
+	{
+		getFlatVertices(L, 1, vertices);
+		if (!lua_isnoneornil(L, 2))
+			getPolygonHoles(L, 2, vertices, holeStarts);
 	}
 	else
 	{
@@ -178,36 +210,41 @@ int w_triangulate(lua_State *L)
 		}
 	}
 
-	if (vertices.size() < 3)
-		return luaL_error(L, "Need at least 3 vertices to triangulate (got %d).", (int)vertices.size());
+	size_t outercount = holeStarts.empty() ? vertices.size() : holeStarts[0];
+	if (outercount < 3)
+		luaL_error(L, "Need at least 3 vertices to triangulate (got %d).", (int)outercount);
 
-	std::vector<Triangle> triangles;
+	std::vector<uint32> indices;
 
 	luax_catchexcept(L, [&]() {
 		if (vertices.size() == 3)
-			triangles.push_back(Triangle(vertices[0], vertices[1], vertices[2]));
+			indices = {0, 1, 2};
 		else
-			triangles = triangulate(vertices);
+			indices = triangulate(vertices, holeStarts);
 	});
 
-	lua_createtable(L, (int) triangles.size(), 0);
-	for (int i = 0; i < (int) triangles.size(); ++i)
-	{
-		const Triangle &tri = triangles[i];
+	return indices;
+}
 
+int w_triangulate(lua_State *L)
+{
+	std::vector<love::Vector2> vertices;
+	std::vector<uint32> indices = triangulatePolygon(L, vertices);
+
+	int count = (int) indices.size() / 3;
+
+	lua_createtable(L, count, 0);
+	for (int i = 0; i < count; ++i)
+	{
 		lua_createtable(L, 6, 0);
-		lua_pushnumber(L, tri.a.x);
-		lua_rawseti(L, -2, 1);
-		lua_pushnumber(L, tri.a.y);
-		lua_rawseti(L, -2, 2);
-		lua_pushnumber(L, tri.b.x);
-		lua_rawseti(L, -2, 3);
-		lua_pushnumber(L, tri.b.y);
-		lua_rawseti(L, -2, 4);
-		lua_pushnumber(L, tri.c.x);
-		lua_rawseti(L, -2, 5);
-		lua_pushnumber(L, tri.c.y);
-		lua_rawseti(L, -2, 6);
+		for (int j = 0; j < 3; j++)
+		{
+			const Vector2 &v = vertices[indices[i * 3 + j]];
+			lua_pushnumber(L, v.x);
+			lua_rawseti(L, -2, j * 2 + 1);
+			lua_pushnumber(L, v.y);
+			lua_rawseti(L, -2, j * 2 + 2);
+		}
 
 		lua_rawseti(L, -2, i+1);
 	}
@@ -215,6 +252,22 @@ int w_triangulate(lua_State *L)
 	return 1;
 }
 
+int w_triangulateIndices(lua_State *L)
+{
+	std::vector<love::Vector2> vertices;
+	std::vector<uint32> indices = triangulatePolygon(L, vertices);
+
+	// 1-based, to match Mesh:setVertexMap.
+	lua_createtable(L, (int) indices.size(), 0);
+	for (int i = 0; i < (int) indices.size(); i++)
+	{
+		lua_pushinteger(L, indices[i] + 1);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
 int w_isConvex(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
@@ -408,6 +461,276 @@ int w_simplexNoise(lua_State* L)
 	return 1;
 }
 
+// Checks the points or grid dimensions in the noise parameters table at idx
+// against the destination's capacity. Point lists get their count (and their
+// Data, if they're in one), grids get their width and height. Grid dimensions
+// given as arguments at dimidx and dimidx + 1 override the table's.
+static void luax_checknoiseshape(lua_State *L, int idx, size_t capacity, int dimidx, Data *&pointdata, size_t &count, int &width, int &height)
+{
+	pointdata = nullptr;
+	count = 0;
+	width = 0;
+	height = 0;
+
+	lua_getfield(L, idx, "points");
+	if (!lua_isnil(L, -1))
+	{
+		if (luax_istype(L, -1, Data::type))
+		{
+			pointdata = luax_checktype<Data>(L, -1);
+			count = pointdata->getSize() / (sizeof(float) * 2);
+		}
+		else if (lua_istable(L, -1))
+		{
+			int n = (int) luax_objlen(L, -1);
+			if (n % 2 != 0)
+				luaL_error(L, "Noise points must be a flat list of x, y coordinate pairs.");
+
+			for (int i = 1; i <= n; i++)
+			{
+				lua_rawgeti(L, -1, i);
+				if (lua_type(L, -1) != LUA_TNUMBER)
+					luaL_error(L, "Noise point coordinates must be numbers.");
+				lua_pop(L, 1);
+			}
+
+			count = n / 2;
+		}
+		else
+			luaL_error(L, "Noise points must be a table or a Data object.");
+
+		lua_pop(L, 1);
+
+		if (count > capacity)
+			luaL_error(L, "The destination is too small for %d noise points (capacity: %d).", (int) count, (int) capacity);
+		return;
+	}
+	lua_pop(L, 1);
+
+	if (dimidx <= 0 || lua_isnoneornil(L, dimidx))
+	{
+		width = luax_intflag(L, idx, "width", (int) capacity);
+		height = luax_intflag(L, idx, "height", width > 0 ? (int) (capacity / width) : 0);
+	}
+	else
+	{
+		width = (int) luaL_checkinteger(L, dimidx);
+		height = (int) luaL_checkinteger(L, dimidx + 1);
+	}
+
+	if (width <= 0 || height <= 0)
+		luaL_error(L, "Invalid noise grid dimensions: %dx%d.", width, height);
+
+	if ((size_t) width * (size_t) height > capacity)
+		luaL_error(L, "The destination is too small for a %dx%d noise grid.", width, height);
+}
+
+// love.math.fillNoise in wrap_Math.lua passes the format and dimensions of
+// ImageData destinations, and handles Buffers.
+int w__fillNoise(lua_State *L)
+{
+	Data *data = luax_checktype<Data>(L, 1);
+
+	lua_settop(L, 5);
+	if (lua_isnil(L, 2))
+	{
+		lua_newtable(L);
+		lua_replace(L, 2);
+	}
+	else
+		luaL_checktype(L, 2, LUA_TTABLE);
+
+	PixelFormat format = PIXELFORMAT_R32_FLOAT;
+	if (!lua_isnil(L, 3))
+	{
+		const char *str = luaL_checkstring(L, 3);
+		if (!love::getConstant(str, format))
+			return luax_enumerror(L, "pixel format", str);
+	}
+
+	if (!isNoiseFormatSupported(format))
+		return luaL_error(L, "Noise cannot be written in the %s pixel format.", lua_tostring(L, 3));
+
+	NoiseParams params;
+
+	lua_getfield(L, 2, "type");
+	if (!lua_isnil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!getConstant(str, params.type))
+			return luax_enumerror(L, "noise type", getConstants(params.type), str);
+	}
+	lua_pop(L, 1);
+
+	params.x = luax_numberflag(L, 2, "x", 0.0);
+	params.y = luax_numberflag(L, 2, "y", 0.0);
+
+	lua_getfield(L, 2, "z");
+	if (!lua_isnil(L, -1))
+	{
+		params.useZ = true;
+		params.z = luaL_checknumber(L, -1);
+	}
+	lua_pop(L, 1);
+
+	params.frequency = luax_numberflag(L, 2, "frequency", params.frequency);
+	params.octaves = luax_intflag(L, 2, "octaves", params.octaves);
+	params.lacunarity = luax_numberflag(L, 2, "lacunarity", params.lacunarity);
+	params.gain = luax_numberflag(L, 2, "gain", params.gain);
+
+	size_t capacity = data->getSize() / getPixelFormatInfo(format).blockSize;
+
+	Data *pointdata = nullptr;
+	size_t count = 0;
+	int width = 0;
+	int height = 0;
+	luax_checknoiseshape(L, 2, capacity, 4, pointdata, count, width, height);
+
+	if (width > 0)
+	{
+		luax_catchexcept(L, [&]() { fillNoise(params, format, width, height, data->getData()); });
+		lua_pushinteger(L, (lua_Integer) width * height);
+		return 1;
+	}
+
+	// Table points are copied inside luax_catchexcept, so no Lua error can be
+	// raised while the copy is alive. They were validated above.
+	luax_catchexcept(L, [&]()
+	{
+		std::vector<float> tablepoints;
+		const float *points = nullptr;
+
+		if (pointdata != nullptr)
+			points = (const float *) pointdata->getData();
+		else
+		{
+			lua_getfield(L, 2, "points");
+			tablepoints.resize(count * 2);
+			for (size_t i = 0; i < count * 2; i++)
+			{
+				lua_rawgeti(L, -1, (int) i + 1);
+				tablepoints[i] = (float) lua_tonumber(L, -1);
+				lua_pop(L, 1);
+			}
+			lua_pop(L, 1);
+			points = tablepoints.data();
+		}
+
+		fillNoise(params, format, points, count, data->getData());
+	});
+
+	lua_pushinteger(L, (lua_Integer) count);
+	return 1;
+}
+
+// Gets the number of values love.math.fillNoise would write for the given
+// parameters into a destination which can hold capacity values, so Buffers
+// can map exactly that range.
+int w__getNoiseCount(lua_State *L)
+{
+	lua_settop(L, 2);
+	if (lua_isnil(L, 1))
+	{
+		lua_newtable(L);
+		lua_replace(L, 1);
+	}
+	else
+		luaL_checktype(L, 1, LUA_TTABLE);
+
+	size_t capacity = (size_t) luaL_checkinteger(L, 2);
+
+	Data *pointdata = nullptr;
+	size_t count = 0;
+	int width = 0;
+	int height = 0;
+	luax_checknoiseshape(L, 1, capacity, 0, pointdata, count, width, height);
+
+	if (width > 0)
+		count = (size_t) width * (size_t) height;
+
+	lua_pushinteger(L, (lua_Integer) count);
+	return 1;
+}
+
+// love.math.composeTransforms in wrap_Math.lua creates the destination when
+// none is given, and handles Buffers.
+int w__composeTransforms(lua_State *L)
+{
+	static_assert(sizeof(Matrix4) == sizeof(float) * 16, "Matrix4 must be 16 packed floats to alias Data contents.");
+
+	std::vector<Matrix4> tablelocals;
+	const Matrix4 *locals = nullptr;
+	size_t count = 0;
+
+	if (lua_istable(L, 1))
+	{
+		count = luax_objlen(L, 1);
+		tablelocals.resize(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			lua_rawgeti(L, 1, (int) i + 1);
+			if (!luax_istype(L, -1, Transform::type))
+				return luaL_error(L, "Local transform %d must be a Transform object.", (int) i + 1);
+			tablelocals[i] = luax_totype<Transform>(L, -1)->getMatrix();
+			lua_pop(L, 1);
+		}
+
+		locals = tablelocals.data();
+	}
+	else if (luax_istype(L, 1, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, 1);
+		locals = (const Matrix4 *) data->getData();
+		count = data->getSize() / sizeof(Matrix4);
+	}
+	else
+		return luax_typerror(L, 1, "table or Data");
+
+	// Parent indices are 1-based with 0 for root nodes, like the locals table.
+	std::vector<int32> parents(count);
+
+	if (lua_istable(L, 2))
+	{
+		if (luax_objlen(L, 2) < count)
+			return luaL_error(L, "Expected %d parent indices, got %d.", (int) count, (int) luax_objlen(L, 2));
+
+		for (size_t i = 0; i < count; i++)
+		{
+			lua_rawgeti(L, 2, (int) i + 1);
+			parents[i] = (int32) luaL_checkinteger(L, -1) - 1;
+			lua_pop(L, 1);
+		}
+	}
+	else if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, 2);
+		if (data->getSize() / sizeof(int32) < count)
+			return luaL_error(L, "Expected %d parent indices, got %d.", (int) count, (int) (data->getSize() / sizeof(int32)));
+
+		const int32 *indices = (const int32 *) data->getData();
+		for (size_t i = 0; i < count; i++)
+			parents[i] = indices[i] - 1;
+	}
+	else
+		return luax_typerror(L, 2, "table or Data");
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (parents[i] < -1)
+			return luaL_error(L, "Invalid parent index %d for transform %d.", (int) parents[i] + 1, (int) i + 1);
+	}
+
+	Data *dest = luax_checktype<Data>(L, 3);
+	if (dest->getSize() < count * sizeof(Matrix4))
+		return luaL_error(L, "The destination is too small for %d matrices.", (int) count);
+
+	luax_catchexcept(L, [&]() { composeTransforms(locals, parents.data(), count, (Matrix4 *) dest->getData()); });
+
+	lua_pushvalue(L, 3);
+	return 1;
+}
+
 // C functions in a struct, necessary for the FFI versions of math functions.
 struct FFI_Math
 {
@@ -450,12 +773,16 @@ static const luaL_Reg functions[] =
 	{ "newBezierCurve", w_newBezierCurve },
 	{ "newTransform", w_newTransform },
 	{ "triangulate", w_triangulate },
+	{ "triangulateIndices", w_triangulateIndices },
 	{ "isConvex", w_isConvex },
 	{ "gammaToLinear", w_gammaToLinear },
 	{ "linearToGamma", w_linearToGamma },
 	{ "noise", w_noise },
 	{ "perlinNoise", w_perlinNoise },
 	{ "simplexNoise", w_simplexNoise },
+	{ "_fillNoise", w__fillNoise },
+	{ "_getNoiseCount", w__getNoiseCount },
+	{ "_composeTransforms", w__composeTransforms },
 
 	{ 0, 0 }
 };
@@ -24,7 +24,7 @@ misrepresented as being the original software.
 
 local love_math, ffifuncspointer_str = ...
 
-local type, tonumber, error = type, tonumber, error
+local type, tonumber, error, pcall = type, tonumber, error, pcall
 local floor = math.floor
 local min, max = math.min, math.max
 
@@ -80,6 +80,66 @@ function love_math.colorFromBytes(r, g, b, a)
 	return r, g, b, a
 end
 
+function love_math.fillNoise(dest, params)
+	if type(dest) == "userdata" and dest:typeOf("ImageData") then
+		local width, height = dest:getDimensions()
+		love_math._fillNoise(dest, params, dest:getFormat(), width, height)
+		return
+	elseif type(dest) == "userdata" and dest:typeOf("Buffer") then
+		-- Buffers aren't Data, so only the range holding the noise values is
+		-- mapped and they're written straight into it. The rest of the Buffer
+		-- keeps its contents. Values are always consecutive 32-bit floats,
+		-- whatever the Buffer's format is.
+		local count = love_math._getNoiseCount(params, floor(dest:getSize() / 4))
+		if count <= 0 then
+			return
+		end
+
+		local mapping = dest:map(0, count * 4)
+		local success, err = pcall(love_math._fillNoise, mapping, params)
+		dest:unmap()
+		mapping:release()
+		if not success then
+			error(err, 2)
+		end
+		return
+	end
+	love_math._fillNoise(dest, params)
+end
+
+function love_math.composeTransforms(locals, parents, dest)
+	if dest ~= nil and not (type(dest) == "userdata" and dest:typeOf("Buffer")) then
+		return love_math._composeTransforms(locals, parents, dest)
+	end
+
+	-- World matrices are 16 column-major floats each, which matches a Buffer
+	-- with a single floatmat4x4 member.
+	local count = type(locals) == "table" and #locals or floor(locals:getSize() / 64)
+
+	if dest == nil then
+		local data = require("love.data").newByteData(max(count, 1) * 64)
+		return love_math._composeTransforms(locals, parents, data)
+	end
+
+	if count <= 0 then
+		return dest
+	end
+	if dest:getSize() < count * 64 then
+		error(("The destination is too small for %d matrices."):format(count), 2)
+	end
+
+	-- Only the range holding the world matrices is mapped, and they're
+	-- composed straight into it.
+	local mapping = dest:map(0, count * 64)
+	local success, err = pcall(love_math._composeTransforms, locals, parents, mapping)
+	dest:unmap()
+	mapping:release()
+	if not success then
+		error(err, 2)
+	end
+	return dest
+end
+
 if type(jit) ~= "table" or not jit.status() then
 	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
 	-- compiler is disabled.
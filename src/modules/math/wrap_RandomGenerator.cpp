@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_RandomGenerator.h"
+#include "common/Data.h"
 
 #include <cmath>
 #include <algorithm>
@@ -85,6 +86,92 @@ int w_RandomGenerator_randomNormal(lua_State *L)
 	return 1;
 }
 
+int w_RandomGenerator__fill(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	Data *data = luax_checktype<Data>(L, 2);
+
+	RandomGenerator::FillParams params;
+
+	if (!lua_isnoneornil(L, 3))
+	{
+		const char *str = luaL_checkstring(L, 3);
+		if (!RandomGenerator::getConstant(str, params.distribution))
+			return luax_enumerror(L, "random distribution", RandomGenerator::getConstants(params.distribution), str);
+	}
+
+	lua_settop(L, 4);
+	if (lua_isnil(L, 4))
+	{
+		lua_newtable(L);
+		lua_replace(L, 4);
+	}
+	else
+		luaL_checktype(L, 4, LUA_TTABLE);
+
+	bool integer = params.distribution == RandomGenerator::DISTRIBUTION_INTEGER;
+	if (integer)
+		params.type = RandomGenerator::VALUE_INT32;
+
+	lua_getfield(L, 4, "type");
+	if (!lua_isnil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!RandomGenerator::getConstant(str, params.type))
+			return luax_enumerror(L, "random value type", RandomGenerator::getConstants(params.type), str);
+	}
+	lua_pop(L, 1);
+
+	if (integer)
+	{
+		lua_getfield(L, 4, "max");
+		if (lua_isnil(L, -1))
+			return luaL_error(L, "The integer distribution requires a max value.");
+		lua_pop(L, 1);
+	}
+
+	params.min = luax_numberflag(L, 4, "min", integer ? 1.0 : params.min);
+	params.max = luax_numberflag(L, 4, "max", params.max);
+	params.mean = luax_numberflag(L, 4, "mean", params.mean);
+	params.stddev = luax_numberflag(L, 4, "stddev", params.stddev);
+
+	size_t valuesize = RandomGenerator::getValueTypeSize(params.type);
+
+	double offset = luax_numberflag(L, 4, "offset", 0.0);
+	if (offset < 0 || offset > (double) data->getSize())
+		return luaL_error(L, "Invalid byte offset: %f", offset);
+
+	size_t maxcount = (data->getSize() - (size_t) offset) / valuesize;
+
+	double count = luax_numberflag(L, 4, "count", (double) maxcount);
+	if (count < 0 || count > (double) maxcount)
+		return luaL_error(L, "Invalid value count %f (the Data has room for %d values at this offset.)", count, (int) maxcount);
+
+	uint8 *dst = (uint8 *) data->getData() + (size_t) offset;
+	luax_catchexcept(L, [&](){ rng->fill(params, dst, (size_t) count); });
+	return 0;
+}
+
+int w_RandomGenerator_jump(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	double steps = luaL_checknumber(L, 2);
+	if (steps < 0 || steps != steps)
+		return luaL_argerror(L, 2, "steps must not be negative");
+	rng->jump((uint64) steps);
+	return 0;
+}
+
+int w_RandomGenerator_clone(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	RandomGenerator *clone = nullptr;
+	luax_catchexcept(L, [&](){ clone = rng->clone(); });
+	luax_pushtype(L, clone);
+	clone->release();
+	return 1;
+}
+
 int w_RandomGenerator_setSeed(lua_State *L)
 {
 	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
@@ -141,6 +228,9 @@ static const luaL_Reg w_RandomGenerator_functions[] =
 {
 	{ "_random", w_RandomGenerator__random }, // random() is defined in wrap_RandomGenerator.lua.
 	{ "randomNormal", w_RandomGenerator_randomNormal },
+	{ "_fill", w_RandomGenerator__fill }, // fill() is defined in wrap_RandomGenerator.lua.
+	{ "jump", w_RandomGenerator_jump },
+	{ "clone", w_RandomGenerator_clone },
 	{ "setSeed", w_RandomGenerator_setSeed },
 	{ "getSeed", w_RandomGenerator_getSeed },
 	{ "setState", w_RandomGenerator_setState },
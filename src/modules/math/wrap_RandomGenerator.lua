@@ -25,10 +25,11 @@ misrepresented as being the original software.
 local RandomGenerator_mt, ffifuncspointer_str = ...
 local RandomGenerator = RandomGenerator_mt.__index
 
-local type, tonumber, error = type, tonumber, error
+local type, tonumber, error, pairs, pcall = type, tonumber, error, pairs, pcall
 local floor = math.floor
 
 local _random = RandomGenerator._random
+local _fill = RandomGenerator._fill
 
 local function getrandom(r, l, u)
 	if u ~= nil then
@@ -48,6 +49,46 @@ function RandomGenerator:random(l, u)
 	return getrandom(r, l, u)
 end
 
+local fillvaluesizes = {
+	float = 4,
+	double = 8,
+	int32 = 4,
+	uint32 = 4,
+}
+
+function RandomGenerator:fill(dest, distribution, params)
+	if type(dest) == "userdata" and dest:typeOf("Buffer") then
+		-- Buffers aren't Data, so only the requested range is mapped and the
+		-- values are written straight into it. The rest of the Buffer is left
+		-- untouched.
+		params = params or {}
+		local valuetype = params.type or (distribution == "integer" and "int32" or "float")
+		local valuesize = fillvaluesizes[valuetype] or 4
+		local offset = params.offset or 0
+		local count = params.count or floor((dest:getSize() - offset) / valuesize)
+		if count <= 0 then
+			return
+		end
+
+		local rangeparams = {}
+		for k, v in pairs(params) do
+			rangeparams[k] = v
+		end
+		rangeparams.offset = 0
+		rangeparams.count = count
+
+		local mapping = dest:map(offset, count * valuesize)
+		local success, err = pcall(_fill, self, mapping, distribution, rangeparams)
+		dest:unmap()
+		mapping:release()
+		if not success then
+			error(err, 2)
+		end
+		return
+	end
+	return _fill(self, dest, distribution, params)
+end
+
 if type(jit) ~= "table" or not jit.status() then
 	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
 	-- compiler is disabled.
@@ -19,6 +19,12 @@
  **/
 
 #include "wrap_Transform.h"
+#include "common/Data.h"
+
+// Shove the wrap_Transform.lua code directly into a raw string literal.
+static const char transform_lua[] =
+#include "wrap_Transform.lua"
+;
 
 namespace love
 {
@@ -284,6 +290,43 @@ int w_Transform_inverseTransformPoint(lua_State *L)
 	return 2;
 }
 
+// Points are consecutive x, y float pairs, modified in place.
+static love::Vector2 *luax_checkpointdata(lua_State *L, int idx, size_t &count)
+{
+	Data *data = luax_checktype<Data>(L, idx);
+
+	lua_Integer offset = luaL_optinteger(L, idx + 1, 0);
+	if (offset < 0 || (size_t) offset > data->getSize())
+		luaL_error(L, "Invalid byte offset: %d", (int) offset);
+
+	size_t maxcount = (data->getSize() - (size_t) offset) / sizeof(love::Vector2);
+
+	lua_Integer n = luaL_optinteger(L, idx + 2, (lua_Integer) maxcount);
+	if (n < 0 || (size_t) n > maxcount)
+		luaL_error(L, "Invalid point count %d (the Data has room for %d points at this offset.)", (int) n, (int) maxcount);
+
+	count = (size_t) n;
+	return (love::Vector2 *) ((uint8 *) data->getData() + offset);
+}
+
+int w_Transform_transformPoints(lua_State *L)
+{
+	Transform *t = luax_checktransform(L, 1);
+	size_t count = 0;
+	love::Vector2 *points = luax_checkpointdata(L, 2, count);
+	t->transformPoints(points, count);
+	return 0;
+}
+
+int w_Transform_inverseTransformPoints(lua_State *L)
+{
+	Transform *t = luax_checktransform(L, 1);
+	size_t count = 0;
+	love::Vector2 *points = luax_checkpointdata(L, 2, count);
+	t->inverseTransformPoints(points, count);
+	return 0;
+}
+
 int w_Transform__mul(lua_State *L)
 {
 	Transform *t1 = luax_checktransform(L, 1);
@@ -294,6 +337,88 @@ int w_Transform__mul(lua_State *L)
 	return 1;
 }
 
+// C functions in a struct, necessary for the FFI versions of Transform methods.
+struct FFI_Transform
+{
+	bool (*translate)(Proxy *p, float x, float y);
+	bool (*rotate)(Proxy *p, float angle);
+	bool (*scale)(Proxy *p, float sx, float sy);
+	bool (*shear)(Proxy *p, float kx, float ky);
+	bool (*setTransformation)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+	bool (*transformPoint)(Proxy *p, float x, float y, float *out);
+	bool (*inverseTransformPoint)(Proxy *p, float x, float y, float *out);
+};
+
+static FFI_Transform ffifuncs =
+{
+	[](Proxy *p, float x, float y) -> bool // translate
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->translate(x, y);
+		return true;
+	},
+
+	[](Proxy *p, float angle) -> bool // rotate
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->rotate(angle);
+		return true;
+	},
+
+	[](Proxy *p, float sx, float sy) -> bool // scale
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->scale(sx, sy);
+		return true;
+	},
+
+	[](Proxy *p, float kx, float ky) -> bool // shear
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->shear(kx, ky);
+		return true;
+	},
+
+	[](Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky) -> bool // setTransformation
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		t->setTransformation(x, y, a, sx, sy, ox, oy, kx, ky);
+		return true;
+	},
+
+	[](Proxy *p, float x, float y, float *out) -> bool // transformPoint
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		love::Vector2 v = t->transformPoint(love::Vector2(x, y));
+		out[0] = v.x;
+		out[1] = v.y;
+		return true;
+	},
+
+	[](Proxy *p, float x, float y, float *out) -> bool // inverseTransformPoint
+	{
+		auto t = luax_ffi_checktype<Transform>(p);
+		if (t == nullptr)
+			return false;
+		love::Vector2 v = t->inverseTransformPoint(love::Vector2(x, y));
+		out[0] = v.x;
+		out[1] = v.y;
+		return true;
+	},
+};
+
 static const luaL_Reg functions[] =
 {
 	{ "clone", w_Transform_clone },
@@ -310,13 +435,19 @@ static const luaL_Reg functions[] =
 	{ "getMatrix", w_Transform_getMatrix },
 	{ "transformPoint", w_Transform_transformPoint },
 	{ "inverseTransformPoint", w_Transform_inverseTransformPoint },
+	{ "transformPoints", w_Transform_transformPoints },
+	{ "inverseTransformPoints", w_Transform_inverseTransformPoints },
 	{ "__mul", w_Transform__mul },
 	{ 0, 0 }
 };
 
 extern "C" int luaopen_transform(lua_State *L)
 {
-	return luax_register_type(L, &Transform::type, functions, nullptr);
+	int ret = luax_register_type(L, &Transform::type, functions, nullptr);
+
+	luax_runwrapper(L, transform_lua, sizeof(transform_lua), "Transform.lua", Transform::type, &ffifuncs);
+
+	return ret;
 }
 
 } // math
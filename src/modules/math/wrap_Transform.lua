@@ -0,0 +1,131 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2024 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local Transform_mt, ffifuncspointer_str = ...
+local Transform = Transform_mt.__index
+
+local type, pcall = type, pcall
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Transform
+{
+	bool (*translate)(Proxy *p, float x, float y);
+	bool (*rotate)(Proxy *p, float angle);
+	bool (*scale)(Proxy *p, float sx, float sy);
+	bool (*shear)(Proxy *p, float kx, float ky);
+	bool (*setTransformation)(Proxy *p, float x, float y, float a, float sx, float sy, float ox, float oy, float kx, float ky);
+	bool (*transformPoint)(Proxy *p, float x, float y, float *out);
+	bool (*inverseTransformPoint)(Proxy *p, float x, float y, float *out);
+} FFI_Transform;
+]])
+
+local ffifuncs = ffi.cast("FFI_Transform **", ffifuncspointer_str)[0]
+
+local point = ffi.new("float[2]")
+
+local function isoptnumber(v)
+	return v == nil or type(v) == "number"
+end
+
+-- Overwrite some regular Transform methods with FFI implementations. Error
+-- reporting still goes through the regular versions.
+
+local _translate = Transform.translate
+local _rotate = Transform.rotate
+local _scale = Transform.scale
+local _shear = Transform.shear
+local _setTransformation = Transform.setTransformation
+local _transformPoint = Transform.transformPoint
+local _inverseTransformPoint = Transform.inverseTransformPoint
+
+function Transform:translate(x, y)
+	if type(self) == "userdata" and type(x) == "number" and type(y) == "number" and ffifuncs.translate(self, x, y) then
+		return self
+	end
+	return _translate(self, x, y)
+end
+
+function Transform:rotate(angle)
+	if type(self) == "userdata" and type(angle) == "number" and ffifuncs.rotate(self, angle) then
+		return self
+	end
+	return _rotate(self, angle)
+end
+
+function Transform:scale(sx, sy)
+	if type(self) == "userdata" and type(sx) == "number" and isoptnumber(sy) and ffifuncs.scale(self, sx, sy == nil and sx or sy) then
+		return self
+	end
+	return _scale(self, sx, sy)
+end
+
+function Transform:shear(kx, ky)
+	if type(self) == "userdata" and type(kx) == "number" and type(ky) == "number" and ffifuncs.shear(self, kx, ky) then
+		return self
+	end
+	return _shear(self, kx, ky)
+end
+
+function Transform:setTransformation(x, y, r, sx, sy, ox, oy, kx, ky)
+	if type(self) == "userdata" and isoptnumber(x) and isoptnumber(y) and isoptnumber(r)
+		and isoptnumber(sx) and isoptnumber(sy) and isoptnumber(ox) and isoptnumber(oy)
+		and isoptnumber(kx) and isoptnumber(ky) then
+
+		local sx1 = sx == nil and 1 or sx
+		local sy1 = sy == nil and sx1 or sy
+		if ffifuncs.setTransformation(self, x or 0, y or 0, r or 0, sx1, sy1, ox or 0, oy or 0, kx or 0, ky or 0) then
+			return self
+		end
+	end
+	return _setTransformation(self, x, y, r, sx, sy, ox, oy, kx, ky)
+end
+
+function Transform:transformPoint(x, y)
+	if type(self) == "userdata" and type(x) == "number" and type(y) == "number" and ffifuncs.transformPoint(self, x, y, point) then
+		return point[0], point[1]
+	end
+	return _transformPoint(self, x, y)
+end
+
+function Transform:inverseTransformPoint(x, y)
+	if type(self) == "userdata" and type(x) == "number" and type(y) == "number" and ffifuncs.inverseTransformPoint(self, x, y, point) then
+		return point[0], point[1]
+	end
+	return _inverseTransformPoint(self, x, y)
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
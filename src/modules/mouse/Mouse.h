@@ -38,6 +38,17 @@ class Mouse : public Module
 {
 public:
 
+	/**
+	 * A single mouse motion event, as recorded at the device's native rate.
+	 * The layout is exposed to Lua as packed binary data.
+	 **/
+	struct Sample
+	{
+		double time; // Seconds, in the same timebase as love.timer.getTime.
+		float x, y;
+		float dx, dy;
+	};
+
 	virtual ~Mouse() {}
 
 	// Implements Module.
@@ -64,6 +75,19 @@ class Mouse : public Module
 	virtual bool setRelativeMode(bool relative) = 0;
 	virtual bool getRelativeMode() const = 0;
 
+	/**
+	 * Records a motion sample. Called by the event module for every motion
+	 * event, before events are coalesced or handed to Lua.
+	 **/
+	virtual void addSample(const Sample &sample) = 0;
+
+	/**
+	 * Removes up to maxcount of the oldest recorded samples and copies them
+	 * into dst. Returns the number of samples copied.
+	 **/
+	virtual size_t getSamples(Sample *dst, size_t maxcount) = 0;
+	virtual size_t getSampleCount() const = 0;
+
 protected:
 
 	Mouse(const char *name)
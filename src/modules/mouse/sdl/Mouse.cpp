@@ -67,6 +67,7 @@ static void clampToWindow(double *x, double *y)
 Mouse::Mouse()
 	: love::mouse::Mouse("love.mouse.sdl")
 	, curCursor(nullptr)
+	, samples(MAX_SAMPLES)
 {
 	// SDL may need the video subsystem in order to clean up the cursor when
 	// quitting. Subsystems are reference-counted.
@@ -269,6 +270,21 @@ bool Mouse::getRelativeMode() const
 	return SDL_GetWindowRelativeMouseMode(sdlwindow);
 }
 
+void Mouse::addSample(const Sample &sample)
+{
+	samples.push(sample);
+}
+
+size_t Mouse::getSamples(Sample *dst, size_t maxcount)
+{
+	return samples.pop(dst, maxcount);
+}
+
+size_t Mouse::getSampleCount() const
+{
+	return samples.size();
+}
+
 } // sdl
 } // mouse
 } // love
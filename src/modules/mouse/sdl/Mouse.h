@@ -24,6 +24,7 @@
 // LOVE
 #include "mouse/Mouse.h"
 #include "Cursor.h"
+#include "common/RingBuffer.h"
 
 // C++
 #include <map>
@@ -63,12 +64,21 @@ class Mouse : public love::mouse::Mouse
 	bool setRelativeMode(bool relative) override;
 	bool getRelativeMode() const override;
 
+	void addSample(const Sample &sample) override;
+	size_t getSamples(Sample *dst, size_t maxcount) override;
+	size_t getSampleCount() const override;
+
 private:
 
+	// About a second of samples from a 1000 Hz mouse.
+	static const size_t MAX_SAMPLES = 1024;
+
 	StrongRef<love::mouse::Cursor> curCursor;
 
 	std::map<Cursor::SystemCursor, Cursor *> systemCursors;
 
+	RingBuffer<Sample> samples;
+
 }; // Mouse
 
 } // sdl
@@ -25,6 +25,10 @@
 
 #include "sdl/Mouse.h"
 #include "filesystem/File.h"
+#include "data/ByteData.h"
+
+// C++
+#include <cstdint>
 
 namespace love
 {
@@ -266,6 +270,54 @@ int w_getRelativeMode(lua_State *L)
 	return 1;
 }
 
+int w_getSamples(lua_State *L)
+{
+	// Fill the given Data if there is one, otherwise return a new ByteData
+	// which holds exactly the pending samples, or nil if there are none.
+	const size_t stride = sizeof(Mouse::Sample);
+
+	if (!lua_isnoneornil(L, 1))
+	{
+		Data *dest = luax_checktype<Data>(L, 1);
+
+		// Samples are written in place, so the Data has to hold whole samples
+		// at a suitably aligned address.
+		if (dest->getSize() % stride != 0)
+			return luaL_error(L, "Data size must be a multiple of the sample size (%d bytes).", (int) stride);
+		if ((uintptr_t) dest->getData() % alignof(Mouse::Sample) != 0)
+			return luaL_error(L, "Data must be aligned to %d bytes.", (int) alignof(Mouse::Sample));
+
+		size_t count = instance()->getSamples((Mouse::Sample *) dest->getData(), dest->getSize() / stride);
+		lua_pushvalue(L, 1);
+		lua_pushinteger(L, (lua_Integer) count);
+		return 2;
+	}
+
+	size_t count = instance()->getSampleCount();
+	if (count == 0)
+	{
+		lua_pushnil(L);
+		lua_pushinteger(L, 0);
+		return 2;
+	}
+
+	love::data::ByteData *dest = nullptr;
+	luax_catchexcept(L, [&]() { dest = new love::data::ByteData(count * stride); });
+
+	count = instance()->getSamples((Mouse::Sample *) dest->getData(), count);
+
+	luax_pushtype(L, dest);
+	dest->release();
+	lua_pushinteger(L, (lua_Integer) count);
+	return 2;
+}
+
+int w_getSampleCount(lua_State *L)
+{
+	lua_pushinteger(L, (lua_Integer) instance()->getSampleCount());
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -288,6 +340,8 @@ static const luaL_Reg functions[] =
 	{ "isGrabbed", w_isGrabbed },
 	{ "setRelativeMode", w_setRelativeMode },
 	{ "getRelativeMode", w_getRelativeMode },
+	{ "getSamples", w_getSamples },
+	{ "getSampleCount", w_getSampleCount },
 	{ 0, 0 }
 };
 
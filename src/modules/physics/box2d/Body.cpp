@@ -48,6 +48,7 @@ Body::Body(World *world, b2Vec2 p, Body::Type type)
 	// Box2D body holds a reference to the love Body.
 	this->retain();
 	this->setType(type);
+	savePreviousTransform();
 }
 
 Body::~Body()
@@ -203,11 +204,13 @@ void Body::applyForce(float fx, float fy, bool wake)
 void Body::setX(float x)
 {
 	body->SetTransform(Physics::scaleDown(b2Vec2(x, getY())), getAngle());
+	savePreviousTransform();
 }
 
 void Body::setY(float y)
 {
 	body->SetTransform(Physics::scaleDown(b2Vec2(getX(), y)), getAngle());
+	savePreviousTransform();
 }
 
 void Body::setLinearVelocity(float x, float y)
@@ -218,6 +221,7 @@ void Body::setLinearVelocity(float x, float y)
 void Body::setAngle(float d)
 {
 	body->SetTransform(body->GetPosition(), d);
+	savePreviousTransform();
 }
 
 void Body::setAngularVelocity(float r)
@@ -230,11 +234,13 @@ void Body::setKinematicState(b2Vec2 pos, float a, b2Vec2 vel, float da)
 	body->SetTransform(Physics::scaleDown(pos), a);
 	body->SetLinearVelocity(Physics::scaleDown(vel));
 	body->SetAngularVelocity(da);
+	savePreviousTransform();
 }
 
 void Body::setPosition(float x, float y)
 {
 	body->SetTransform(Physics::scaleDown(b2Vec2(x, y)), body->GetAngle());
+	savePreviousTransform();
 }
 
 void Body::setAngularDamping(float d)
@@ -591,6 +597,27 @@ int Body::getUserData(lua_State *L)
 	return 1;
 }
 
+void Body::savePreviousTransform()
+{
+	previousPosition = body->GetPosition();
+	previousAngle = body->GetAngle();
+}
+
+void Body::shiftPreviousTransform(const b2Vec2 &origin)
+{
+	previousPosition -= origin;
+}
+
+void Body::getInterpolatedTransform(float alpha, float &x_o, float &y_o, float &a_o) const
+{
+	// Box2D doesn't wrap angles, so they can be interpolated linearly.
+	b2Vec2 p = previousPosition + alpha * (body->GetPosition() - previousPosition);
+	p = Physics::scaleUp(p);
+	x_o = p.x;
+	y_o = p.y;
+	a_o = previousAngle + alpha * (body->GetAngle() - previousAngle);
+}
+
 } // box2d
 } // physics
 } // love
@@ -429,6 +429,26 @@ class Body : public love::physics::Body
 	 **/
 	int getUserData(lua_State *L);
 
+	/**
+	 * Stores the current transform as the previous one, used by the World
+	 * to interpolate between fixed time steps.
+	 **/
+	void savePreviousTransform();
+
+	/**
+	 * Moves the previous transform along with a shift of the World's origin,
+	 * so interpolation doesn't blend across the old and new origins.
+	 * @param origin The new origin, in Box2D units.
+	 **/
+	void shiftPreviousTransform(const b2Vec2 &origin);
+
+	/**
+	 * Gets the transform interpolated between the previous fixed step and
+	 * the current one.
+	 * @param alpha The interpolation factor, in [0, 1].
+	 **/
+	void getInterpolatedTransform(float alpha, float &x_o, float &y_o, float &a_o) const;
+
 private:
 
 	// FIXME: This should be a weak reference, rather than being completely
@@ -437,6 +457,10 @@ class Body : public love::physics::Body
 
 	bool hasCustomMass;
 
+	// Transform before the most recent fixed time step.
+	b2Vec2 previousPosition;
+	float previousAngle;
+
 	// Reference to arbitrary data.
 	Reference* ref = nullptr;
 
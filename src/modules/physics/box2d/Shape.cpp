@@ -265,6 +265,25 @@ void Shape::getFilterData(int *v)
 	v[2] = (int) f.groupIndex;
 }
 
+void Shape::setFilterGroup(int group)
+{
+	if (group < 0 || group > World::MAX_FILTER_GROUPS)
+		throw love::Exception("Filter group must be in range 0-%d.", World::MAX_FILTER_GROUPS);
+
+	filterGroup = group;
+
+	if (fixture != nullptr)
+		fixture->Refilter();
+}
+
+void Shape::setOwnerID(int64 id)
+{
+	ownerID = id;
+
+	if (fixture != nullptr)
+		fixture->Refilter();
+}
+
 int Shape::setCategory(lua_State *L)
 {
 	throwIfFixtureNotValid();
@@ -159,6 +159,20 @@ class Shape : public love::physics::Shape
 	void setGroupIndex(int index);
 	int getGroupIndex() const;
 
+	/**
+	 * Sets the group (1-32, or 0 for none) used by the World's native
+	 * collision matrix.
+	 **/
+	void setFilterGroup(int group);
+	int getFilterGroup() const { return filterGroup; }
+
+	/**
+	 * Sets an owner ID (0 for none). Shapes with the same owner ID can be
+	 * prevented from colliding via World::setSameOwnerCollisionAllowed.
+	 **/
+	void setOwnerID(int64 id);
+	int64 getOwnerID() const { return ownerID; }
+
 	int setCategory(lua_State *L);
 	int setMask(lua_State *L);
 	int getCategory(lua_State *L);
@@ -194,6 +208,10 @@ class Shape : public love::physics::Shape
 	// Reference to arbitrary data.
 	Reference* ref = nullptr;
 
+	// Data for the World's native contact filtering.
+	int filterGroup = 0;
+	int64 ownerID = 0;
+
 }; // Shape
 
 } // box2d
@@ -24,11 +24,16 @@
 #include "Contact.h"
 #include "Physics.h"
 #include "common/Reference.h"
+#include "common/profiler.h"
 
 // Needed for World::getJoints. It should be moved to wrapper code...
 #include "wrap_Joint.h"
 #include "wrap_Shape.h"
 
+// STD
+#include <algorithm>
+#include <cmath>
+
 namespace love
 {
 namespace physics
@@ -268,7 +273,14 @@ World::World()
 	, end(this)
 	, presolve(this)
 	, postsolve(this)
+	, sameOwnerCollisionAllowed(true)
+	, fixedStep(0.0f)
+	, maxSubsteps(8)
+	, accumulator(0.0f)
 {
+	for (int i = 0; i < MAX_FILTER_GROUPS; i++)
+		groupCollisionMasks[i] = 0xFFFFFFFF;
+
 	world = new b2World(b2Vec2(0,0));
 	world->SetAllowSleeping(true);
 	world->SetContactListener(this);
@@ -286,7 +298,14 @@ World::World(b2Vec2 gravity, bool sleep)
 	, end(this)
 	, presolve(this)
 	, postsolve(this)
+	, sameOwnerCollisionAllowed(true)
+	, fixedStep(0.0f)
+	, maxSubsteps(8)
+	, accumulator(0.0f)
 {
+	for (int i = 0; i < MAX_FILTER_GROUPS; i++)
+		groupCollisionMasks[i] = 0xFFFFFFFF;
+
 	world = new b2World(Physics::scaleDown(gravity));
 	world->SetAllowSleeping(sleep);
 	world->SetContactListener(this);
@@ -308,6 +327,36 @@ void World::update(float dt)
 }
 
 void World::update(float dt, int velocityIterations, int positionIterations)
+{
+	LOVE_PROFILE_ZONE("World::update");
+
+	if (fixedStep <= 0.0f)
+	{
+		step(dt, velocityIterations, positionIterations);
+		return;
+	}
+
+	accumulator += dt;
+
+	int substeps = 0;
+	while (accumulator >= fixedStep && substeps < maxSubsteps)
+	{
+		savePreviousTransforms();
+		step(fixedStep, velocityIterations, positionIterations);
+		accumulator -= fixedStep;
+		substeps++;
+
+		// The world may have been destroyed in a callback.
+		if (world == nullptr)
+			return;
+	}
+
+	// Drop time we couldn't catch up on, instead of building up a backlog.
+	if (accumulator >= fixedStep)
+		accumulator = fmodf(accumulator, fixedStep);
+}
+
+void World::step(float dt, int velocityIterations, int positionIterations)
 {
 	world->Step(dt, velocityIterations, positionIterations);
 
@@ -338,6 +387,76 @@ void World::update(float dt, int velocityIterations, int positionIterations)
 		destroy();
 }
 
+void World::setFixedStep(float stepSize, int maxSubsteps)
+{
+	if (stepSize < 0.0f)
+		throw love::Exception("Fixed step size cannot be negative.");
+	if (maxSubsteps < 1)
+		throw love::Exception("Maximum sub-step count must be at least 1.");
+
+	fixedStep = stepSize;
+	this->maxSubsteps = maxSubsteps;
+	accumulator = 0.0f;
+
+	savePreviousTransforms();
+}
+
+float World::getFixedStep() const
+{
+	return fixedStep;
+}
+
+int World::getMaxSubsteps() const
+{
+	return maxSubsteps;
+}
+
+float World::getInterpolationAlpha() const
+{
+	if (fixedStep <= 0.0f)
+		return 1.0f;
+	return std::min(accumulator / fixedStep, 1.0f);
+}
+
+int World::getInterpolatedBodyStates(float alpha, float *dest, int maxBodies) const
+{
+	int count = 0;
+	for (b2Body *b = world->GetBodyList(); b != nullptr && count < maxBodies; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+
+		Body *body = (Body *)(b->GetUserData().pointer);
+		if (!body)
+			throw love::Exception("A body has escaped Memoizer!");
+
+		float *state = dest + count * 3;
+		body->getInterpolatedTransform(alpha, state[0], state[1], state[2]);
+		count++;
+	}
+
+	return count;
+}
+
+void World::savePreviousTransforms()
+{
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		Body *body = (Body *)(b->GetUserData().pointer);
+		if (body != nullptr)
+			body->savePreviousTransform();
+	}
+}
+
+void World::refilterContacts()
+{
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		for (b2Fixture *f = b->GetFixtureList(); f != nullptr; f = f->GetNext())
+			f->Refilter();
+	}
+}
+
 void World::BeginContact(b2Contact *contact)
 {
 	begin.process(contact);
@@ -384,6 +503,19 @@ bool World::ShouldCollide(b2Fixture *fixtureA, b2Fixture *fixtureB)
 	if (!a || !b)
 		throw love::Exception("A Shape has escaped Memoizer!");
 
+	// Native rules are cheap, so they're checked before the Lua filter.
+	int groupA = a->getFilterGroup();
+	int groupB = b->getFilterGroup();
+	if (groupA != 0 && groupB != 0 && (groupCollisionMasks[groupA - 1] & (1u << (groupB - 1))) == 0)
+		return false;
+
+	if (!sameOwnerCollisionAllowed)
+	{
+		int64 ownerA = a->getOwnerID();
+		if (ownerA != 0 && ownerA == b->getOwnerID())
+			return false;
+	}
+
 	return filter.process(a, b);
 }
 
@@ -477,6 +609,47 @@ int World::getContactFilter(lua_State *L)
 	return 1;
 }
 
+void World::setGroupCollision(int groupA, int groupB, bool collide)
+{
+	if (groupA < 1 || groupA > MAX_FILTER_GROUPS || groupB < 1 || groupB > MAX_FILTER_GROUPS)
+		throw love::Exception("Filter groups must be in range 1-%d.", MAX_FILTER_GROUPS);
+
+	uint32 bitA = 1u << (groupA - 1);
+	uint32 bitB = 1u << (groupB - 1);
+
+	if (collide)
+	{
+		groupCollisionMasks[groupA - 1] |= bitB;
+		groupCollisionMasks[groupB - 1] |= bitA;
+	}
+	else
+	{
+		groupCollisionMasks[groupA - 1] &= ~bitB;
+		groupCollisionMasks[groupB - 1] &= ~bitA;
+	}
+
+	refilterContacts();
+}
+
+bool World::getGroupCollision(int groupA, int groupB) const
+{
+	if (groupA < 1 || groupA > MAX_FILTER_GROUPS || groupB < 1 || groupB > MAX_FILTER_GROUPS)
+		throw love::Exception("Filter groups must be in range 1-%d.", MAX_FILTER_GROUPS);
+
+	return (groupCollisionMasks[groupA - 1] & (1u << (groupB - 1))) != 0;
+}
+
+void World::setSameOwnerCollisionAllowed(bool allow)
+{
+	sameOwnerCollisionAllowed = allow;
+	refilterContacts();
+}
+
+bool World::isSameOwnerCollisionAllowed() const
+{
+	return sameOwnerCollisionAllowed;
+}
+
 void World::setGravity(float x, float y)
 {
 	world->SetGravity(Physics::scaleDown(b2Vec2(x, y)));
@@ -492,7 +665,15 @@ int World::getGravity(lua_State *L)
 
 void World::translateOrigin(float x, float y)
 {
-	world->ShiftOrigin(Physics::scaleDown(b2Vec2(x, y)));
+	b2Vec2 origin = Physics::scaleDown(b2Vec2(x, y));
+	world->ShiftOrigin(origin);
+
+	for (b2Body *b = world->GetBodyList(); b != nullptr; b = b->GetNext())
+	{
+		Body *body = (Body *)(b->GetUserData().pointer);
+		if (body != nullptr)
+			body->shiftPreviousTransform(origin);
+	}
 }
 
 void World::setSleepingAllowed(bool allow)
@@ -69,6 +69,10 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 
 	static love::Type type;
 
+	// Number of groups in the native collision matrix. Group 0 means a Shape
+	// doesn't participate in group filtering.
+	static const int MAX_FILTER_GROUPS = 32;
+
 	class ContactCallback
 	{
 	public:
@@ -168,6 +172,33 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	void update(float dt);
 	void update(float dt, int velocityIterations, int positionIterations);
 
+	/**
+	 * Makes update() advance the simulation in fixed-size sub-steps, carrying
+	 * leftover time over to the next update. A step of 0 disables this.
+	 * @param stepSize The size of each sub-step.
+	 * @param maxSubsteps The maximum number of sub-steps per update. Time
+	 * beyond that is discarded.
+	 **/
+	void setFixedStep(float stepSize, int maxSubsteps);
+	float getFixedStep() const;
+	int getMaxSubsteps() const;
+
+	/**
+	 * Gets how far (in [0, 1]) the leftover time is between the last fixed
+	 * step and the next one.
+	 **/
+	float getInterpolationAlpha() const;
+
+	/**
+	 * Writes the x, y and angle of every Body (in the same order as
+	 * getBodies), interpolated between the previous and current fixed step.
+	 * @param alpha The interpolation factor.
+	 * @param dest Destination array with room for 3 floats per Body.
+	 * @param maxBodies The maximum number of Bodies to write.
+	 * @return The number of Bodies written.
+	 **/
+	int getInterpolatedBodyStates(float alpha, float *dest, int maxBodies) const;
+
 	// From b2ContactListener
 	void BeginContact(b2Contact *contact);
 	void EndContact(b2Contact *contact);
@@ -216,6 +247,23 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	 **/
 	int getContactFilter(lua_State *L);
 
+	/**
+	 * Sets whether Shapes in the two given filter groups (1-32) can collide.
+	 * These rules are evaluated natively before the Lua contact filter.
+	 **/
+	void setGroupCollision(int groupA, int groupB, bool collide);
+
+	/**
+	 * Gets whether Shapes in the two given filter groups can collide.
+	 **/
+	bool getGroupCollision(int groupA, int groupB) const;
+
+	/**
+	 * Sets whether Shapes which share the same non-zero owner ID can collide.
+	 **/
+	void setSameOwnerCollisionAllowed(bool allow);
+	bool isSameOwnerCollisionAllowed() const;
+
 	/**
 	 * Sets the current gravity of the World.
 	 * @param x Gravity in the x-direction.
@@ -327,6 +375,12 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 
 private:
 
+	void step(float dt, int velocityIterations, int positionIterations);
+	void savePreviousTransforms();
+
+	// Flags every existing contact to be filtered again in the next step.
+	void refilterContacts();
+
 	// Pointer to the Box2D world.
 	b2World *world;
 
@@ -343,6 +397,16 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	ContactCallback begin, end, presolve, postsolve;
 	ContactFilter filter;
 
+	// Native collision rules. Each group has a bitmask of the groups it
+	// collides with.
+	uint32 groupCollisionMasks[MAX_FILTER_GROUPS];
+	bool sameOwnerCollisionAllowed;
+
+	// Fixed time step state.
+	float fixedStep;
+	int maxSubsteps;
+	float accumulator;
+
 	std::unordered_map<void *, love::Object *> box2dObjectMap;
 
 }; // World
@@ -22,6 +22,11 @@
 #include "wrap_Physics.h"
 #include "wrap_Shape.h"
 
+// Shove the wrap_Body.lua code directly into a raw string literal.
+static const char body_lua[] =
+#include "wrap_Body.lua"
+;
+
 namespace love
 {
 namespace physics
@@ -679,6 +684,34 @@ int w_Body_getUserData(lua_State *L)
 	return t->getUserData(L);
 }
 
+// C functions in a struct, necessary for the FFI versions of Body methods.
+struct FFI_Body
+{
+	bool (*getPosition)(Proxy *p, float *out);
+	bool (*getAngle)(Proxy *p, float *out);
+};
+
+static FFI_Body ffifuncs =
+{
+	[](Proxy *p, float *out) -> bool // getPosition
+	{
+		auto b = luax_ffi_checktype<Body>(p);
+		if (b == nullptr || b->body == nullptr)
+			return false;
+		b->getPosition(out[0], out[1]);
+		return true;
+	},
+
+	[](Proxy *p, float *out) -> bool // getAngle
+	{
+		auto b = luax_ffi_checktype<Body>(p);
+		if (b == nullptr || b->body == nullptr)
+			return false;
+		out[0] = b->getAngle();
+		return true;
+	},
+};
+
 static const luaL_Reg w_Body_functions[] =
 {
 	{ "getX", w_Body_getX },
@@ -756,7 +789,11 @@ static const luaL_Reg w_Body_functions[] =
 
 extern "C" int luaopen_body(lua_State *L)
 {
-	return luax_register_type(L, &Body::type, w_Body_functions, nullptr);
+	int ret = luax_register_type(L, &Body::type, w_Body_functions, nullptr);
+
+	luax_runwrapper(L, body_lua, sizeof(body_lua), "Body.lua", Body::type, &ffifuncs);
+
+	return ret;
 }
 
 } // box2d
@@ -0,0 +1,76 @@
+R"luastring"--(
+-- DO NOT REMOVE THE ABOVE LINE. It is used to load this file as a C++ string.
+-- There is a matching delimiter at the bottom of the file.
+
+--[[
+Copyright (c) 2006-2024 LOVE Development Team
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+claim that you wrote the original software. If you use this software
+in a product, an acknowledgment in the product documentation would be
+appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+--]]
+
+
+local Body_mt, ffifuncspointer_str = ...
+local Body = Body_mt.__index
+
+local type, pcall = type, pcall
+
+if type(jit) ~= "table" or not jit.status() then
+	-- LuaJIT's FFI is *much* slower than LOVE's regular methods when the JIT
+	-- compiler is disabled.
+	return
+end
+
+local status, ffi = pcall(require, "ffi")
+if not status then return end
+
+pcall(ffi.cdef, [[
+typedef struct Proxy Proxy;
+
+typedef struct FFI_Body
+{
+	bool (*getPosition)(Proxy *p, float *out);
+	bool (*getAngle)(Proxy *p, float *out);
+} FFI_Body;
+]])
+
+local ffifuncs = ffi.cast("FFI_Body **", ffifuncspointer_str)[0]
+
+local out = ffi.new("float[2]")
+
+-- Overwrite some regular Body methods with FFI implementations. Error
+-- reporting (for example for destroyed bodies) still goes through the regular
+-- versions.
+
+local _getPosition = Body.getPosition
+local _getAngle = Body.getAngle
+
+function Body:getPosition()
+	if type(self) == "userdata" and ffifuncs.getPosition(self, out) then
+		return out[0], out[1]
+	end
+	return _getPosition(self)
+end
+
+function Body:getAngle()
+	if type(self) == "userdata" and ffifuncs.getAngle(self, out) then
+		return out[0]
+	end
+	return _getAngle(self)
+end
+
+-- DO NOT REMOVE THE NEXT LINE. It is used to load this file as a C++ string.
+--)luastring"--"
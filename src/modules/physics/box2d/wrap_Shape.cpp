@@ -334,6 +334,36 @@ int w_Shape_setGroupIndex(lua_State *L)
 	return 0;
 }
 
+int w_Shape_setFilterGroup(lua_State *L)
+{
+	Shape *t = luax_checkshape(L, 1);
+	int group = (int) luaL_checkinteger(L, 2);
+	luax_catchexcept(L, [&]() { t->setFilterGroup(group); });
+	return 0;
+}
+
+int w_Shape_getFilterGroup(lua_State *L)
+{
+	Shape *t = luax_checkshape(L, 1);
+	lua_pushinteger(L, t->getFilterGroup());
+	return 1;
+}
+
+int w_Shape_setOwnerID(lua_State *L)
+{
+	Shape *t = luax_checkshape(L, 1);
+	int64 id = (int64) luaL_checkinteger(L, 2);
+	t->setOwnerID(id);
+	return 0;
+}
+
+int w_Shape_getOwnerID(lua_State *L)
+{
+	Shape *t = luax_checkshape(L, 1);
+	lua_pushinteger(L, (lua_Integer) t->getOwnerID());
+	return 1;
+}
+
 int w_Shape_destroy(lua_State *L)
 {
 	Shape *t = luax_checkshape(L, 1);
@@ -379,6 +409,10 @@ const luaL_Reg w_Shape_functions[] =
 	{ "getMassData", w_Shape_getMassData },
 	{ "getGroupIndex", w_Shape_getGroupIndex },
 	{ "setGroupIndex", w_Shape_setGroupIndex },
+	{ "setFilterGroup", w_Shape_setFilterGroup },
+	{ "getFilterGroup", w_Shape_getFilterGroup },
+	{ "setOwnerID", w_Shape_setOwnerID },
+	{ "getOwnerID", w_Shape_getOwnerID },
 	{ "destroy", w_Shape_destroy },
 	{ "isDestroyed", w_Shape_isDestroyed },
 	{ 0, 0 }
@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_World.h"
+#include "common/Data.h"
 
 namespace love
 {
@@ -55,6 +56,47 @@ int w_World_update(lua_State *L)
 	return 0;
 }
 
+int w_World_setFixedStep(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	float step = (float) luaL_optnumber(L, 2, 0.0);
+	int maxsubsteps = (int) luaL_optinteger(L, 3, 8);
+	luax_catchexcept(L, [&](){ t->setFixedStep(step, maxsubsteps); });
+	return 0;
+}
+
+int w_World_getFixedStep(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushnumber(L, t->getFixedStep());
+	lua_pushinteger(L, t->getMaxSubsteps());
+	return 2;
+}
+
+int w_World_getInterpolationAlpha(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushnumber(L, t->getInterpolationAlpha());
+	return 1;
+}
+
+int w_World_getInterpolatedBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	float alpha = lua_isnoneornil(L, 2) ? t->getInterpolationAlpha() : (float) luaL_checknumber(L, 2);
+	Data *dest = luax_checktype<Data>(L, 3);
+
+	int bodycount = t->getBodyCount();
+	size_t needed = sizeof(float) * 3 * bodycount;
+	if (dest->getSize() < needed)
+		return luaL_error(L, "Data is too small to hold %d body states (%d bytes needed.)", bodycount, (int) needed);
+
+	int count = 0;
+	luax_catchexcept(L, [&](){ count = t->getInterpolatedBodyStates(alpha, (float *) dest->getData(), bodycount); });
+	lua_pushinteger(L, count);
+	return 1;
+}
+
 int w_World_setCallbacks(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -83,6 +125,42 @@ int w_World_getContactFilter(lua_State *L)
 	return t->getContactFilter(L);
 }
 
+int w_World_setGroupCollision(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int groupA = (int) luaL_checkinteger(L, 2);
+	int groupB = (int) luaL_checkinteger(L, 3);
+	bool collide = luax_checkboolean(L, 4);
+	luax_catchexcept(L, [&](){ t->setGroupCollision(groupA, groupB, collide); });
+	return 0;
+}
+
+int w_World_getGroupCollision(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int groupA = (int) luaL_checkinteger(L, 2);
+	int groupB = (int) luaL_checkinteger(L, 3);
+	bool collide = false;
+	luax_catchexcept(L, [&](){ collide = t->getGroupCollision(groupA, groupB); });
+	luax_pushboolean(L, collide);
+	return 1;
+}
+
+int w_World_setSameOwnerCollisionAllowed(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	bool b = luax_checkboolean(L, 2);
+	t->setSameOwnerCollisionAllowed(b);
+	return 0;
+}
+
+int w_World_isSameOwnerCollisionAllowed(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	luax_pushboolean(L, t->isSameOwnerCollisionAllowed());
+	return 1;
+}
+
 int w_World_setGravity(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -244,10 +322,18 @@ int w_World_isDestroyed(lua_State *L)
 static const luaL_Reg w_World_functions[] =
 {
 	{ "update", w_World_update },
+	{ "setFixedStep", w_World_setFixedStep },
+	{ "getFixedStep", w_World_getFixedStep },
+	{ "getInterpolationAlpha", w_World_getInterpolationAlpha },
+	{ "getInterpolatedBodyStates", w_World_getInterpolatedBodyStates },
 	{ "setCallbacks", w_World_setCallbacks },
 	{ "getCallbacks", w_World_getCallbacks },
 	{ "setContactFilter", w_World_setContactFilter },
 	{ "getContactFilter", w_World_getContactFilter },
+	{ "setGroupCollision", w_World_setGroupCollision },
+	{ "getGroupCollision", w_World_getGroupCollision },
+	{ "setSameOwnerCollisionAllowed", w_World_setSameOwnerCollisionAllowed },
+	{ "isSameOwnerCollisionAllowed", w_World_isSameOwnerCollisionAllowed },
 	{ "setGravity", w_World_setGravity },
 	{ "getGravity", w_World_getGravity },
 	{ "translateOrigin", w_World_translateOrigin },
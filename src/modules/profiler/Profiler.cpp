@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Profiler.h"
+#include "common/profiler.h"
+
+namespace love
+{
+namespace profiler
+{
+
+Profiler::Profiler()
+	: Module(M_PROFILER, "love.profiler")
+{
+	// Modules are always opened on the main thread.
+	setThreadName("Main");
+}
+
+Profiler::~Profiler()
+{
+	stopCapture();
+}
+
+void Profiler::startCapture(int frames)
+{
+	profiler::startCapture(frames);
+}
+
+void Profiler::stopCapture()
+{
+	profiler::stopCapture();
+}
+
+bool Profiler::isCapturing() const
+{
+	return profiler::isCapturing();
+}
+
+int Profiler::getCapturedFrames() const
+{
+	return profiler::getCapturedFrames();
+}
+
+void Profiler::beginZone(const std::string &name)
+{
+	profiler::beginZone(internName(name));
+}
+
+void Profiler::endZone()
+{
+	profiler::endZone();
+}
+
+std::string Profiler::exportTrace() const
+{
+	return profiler::exportTrace();
+}
+
+} // profiler
+} // love
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Module.h"
+
+namespace love
+{
+namespace profiler
+{
+
+/**
+ * Exposes the engine's CPU zone instrumentation (common/profiler.h) to Lua.
+ * Zones recorded by the engine itself don't depend on this module being
+ * loaded, but captures can only be started and exported through it.
+ **/
+class Profiler : public Module
+{
+public:
+
+	Profiler();
+	virtual ~Profiler();
+
+	void startCapture(int frames);
+	void stopCapture();
+	bool isCapturing() const;
+	int getCapturedFrames() const;
+
+	void beginZone(const std::string &name);
+	void endZone();
+
+	std::string exportTrace() const;
+
+}; // Profiler
+
+} // profiler
+} // love
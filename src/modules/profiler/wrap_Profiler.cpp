@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_Profiler.h"
+#include "filesystem/Filesystem.h"
+
+namespace love
+{
+namespace profiler
+{
+
+#define instance() (Module::getInstance<Profiler>(Module::M_PROFILER))
+
+int w_startCapture(lua_State *L)
+{
+	int frames = (int) luaL_optinteger(L, 1, 0);
+	instance()->startCapture(frames);
+	return 0;
+}
+
+int w_stopCapture(lua_State *)
+{
+	instance()->stopCapture();
+	return 0;
+}
+
+int w_isCapturing(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isCapturing());
+	return 1;
+}
+
+int w_getCapturedFrames(lua_State *L)
+{
+	lua_pushinteger(L, instance()->getCapturedFrames());
+	return 1;
+}
+
+int w_beginZone(lua_State *L)
+{
+	std::string name = luax_checkstring(L, 1);
+	luax_catchexcept(L, [&]() { instance()->beginZone(name); });
+	return 0;
+}
+
+int w_endZone(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->endZone(); });
+	return 0;
+}
+
+int w_exportTrace(lua_State *L)
+{
+	std::string trace;
+	luax_catchexcept(L, [&]() { trace = instance()->exportTrace(); });
+
+	if (lua_isnoneornil(L, 1))
+	{
+		luax_pushstring(L, trace);
+		return 1;
+	}
+
+	// Optionally write the trace straight to a file in the save directory.
+	const char *filename = luaL_checkstring(L, 1);
+	auto fs = Module::getInstance<love::filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		return luaL_error(L, "love.filesystem must be loaded to write a trace to a file.");
+
+	luax_catchexcept(L, [&]() { fs->write(filename, trace.data(), (int64) trace.size()); });
+	luax_pushboolean(L, true);
+	return 1;
+}
+
+// List of functions to wrap.
+static const luaL_Reg functions[] =
+{
+	{ "startCapture", w_startCapture },
+	{ "stopCapture", w_stopCapture },
+	{ "isCapturing", w_isCapturing },
+	{ "getCapturedFrames", w_getCapturedFrames },
+	{ "beginZone", w_beginZone },
+	{ "endZone", w_endZone },
+	{ "exportTrace", w_exportTrace },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_love_profiler(lua_State *L)
+{
+	Profiler *instance = instance();
+	if (instance == nullptr)
+	{
+		luax_catchexcept(L, [&](){ instance = new love::profiler::Profiler(); });
+	}
+	else
+		instance->retain();
+
+	WrappedModule w;
+	w.module = instance;
+	w.name = "profiler";
+	w.type = &Module::type;
+	w.functions = functions;
+	w.types = 0;
+
+	return luax_register_module(L, w);
+}
+
+} // profiler
+} // love
@@ -130,12 +130,10 @@ void LuaThread::onError()
 	if (!eventmodule)
 		return;
 
-	std::vector<Variant> vargs = {
-		Variant(&LuaThread::type, this),
-		Variant(error.c_str(), error.length())
-	};
+	event::Message msg("threaderror");
+	msg.addArg(&LuaThread::type, this);
+	msg.addArg(error.c_str(), error.length());
 
-	StrongRef<event::Message> msg(new event::Message("threaderror", vargs), Acquire::NORETAIN);
 	eventmodule->push(msg);
 }
 
@@ -0,0 +1,256 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <thread>
+
+namespace love
+{
+namespace thread
+{
+
+ThreadPool::Worker::Worker(ThreadPool *pool, const char *name)
+	: pool(pool)
+{
+	threadName = name;
+}
+
+void ThreadPool::Worker::threadFunction()
+{
+	pool->workerLoop();
+}
+
+ThreadPool::ThreadPool(int threadCount, const char *name)
+	: quit(false)
+	, maxParallelism(0)
+{
+	threadCount = std::max(threadCount, 1);
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		Worker *worker = new Worker(this, name);
+		if (!worker->start())
+		{
+			worker->release();
+			break;
+		}
+		workers.push_back(worker);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Workers keep running queued tasks until the queue is empty, so nothing
+	// submitted before this point is dropped.
+	{
+		Lock lock(mutex);
+		quit = true;
+		taskAvailable->broadcast();
+	}
+
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+void ThreadPool::submit(const Task &task, int priority)
+{
+	// Without any workers, tasks would never run.
+	if (workers.empty())
+	{
+		task();
+		return;
+	}
+
+	Lock lock(mutex);
+
+	// Most tasks share a priority, so search from the back of the queue.
+	auto it = tasks.end();
+	while (it != tasks.begin() && std::prev(it)->priority < priority)
+		--it;
+
+	tasks.insert(it, {task, priority});
+	taskAvailable->signal();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minRangeSize, const RangeTask &task)
+{
+	if (count == 0)
+		return;
+
+	minRangeSize = std::max(minRangeSize, (size_t) 1);
+
+	size_t maxranges = (size_t) getMaxParallelism();
+	size_t rangecount = std::min(maxranges, (count + minRangeSize - 1) / minRangeSize);
+	size_t rangesize = (count + rangecount - 1) / rangecount;
+
+	if (rangecount <= 1)
+	{
+		task(0, count);
+		return;
+	}
+
+	// Completion state shared by all ranges, which live on this stack frame
+	// until every range has finished.
+	MutexRef donemutex;
+	ConditionalRef donecond;
+	size_t remaining = rangecount - 1;
+	std::exception_ptr error;
+
+	for (size_t i = 1; i < rangecount; i++)
+	{
+		size_t begin = std::min(i * rangesize, count);
+		size_t end = std::min(begin + rangesize, count);
+
+		submit([&, begin, end]()
+		{
+			// Any exception has to be caught here: letting it escape would
+			// terminate a worker thread, or skip the decrement below and leave
+			// the caller waiting forever.
+			std::exception_ptr e;
+			try
+			{
+				task(begin, end);
+			}
+			catch (...)
+			{
+				e = std::current_exception();
+			}
+
+			Lock lock(donemutex);
+			if (e && !error)
+				error = e;
+			remaining--;
+			donecond->broadcast();
+		});
+	}
+
+	// The queued ranges reference this stack frame, so the caller's own
+	// range can't propagate an exception until they have all finished.
+	std::exception_ptr localerror;
+	try
+	{
+		task(0, std::min(rangesize, count));
+	}
+	catch (...)
+	{
+		localerror = std::current_exception();
+	}
+
+	// Help with queued work while waiting, so nested calls from a worker
+	// thread can't deadlock the pool.
+	while (true)
+	{
+		{
+			Lock lock(donemutex);
+			if (remaining == 0)
+				break;
+		}
+
+		if (!runPendingTask())
+		{
+			Lock lock(donemutex);
+			if (remaining > 0)
+				donecond->wait(donemutex, 1);
+		}
+	}
+
+	if (localerror)
+		std::rethrow_exception(localerror);
+	if (error)
+		std::rethrow_exception(error);
+}
+
+int ThreadPool::getThreadCount() const
+{
+	return (int) workers.size();
+}
+
+void ThreadPool::setMaxParallelism(int count)
+{
+	maxParallelism = std::max(count, 0);
+}
+
+int ThreadPool::getMaxParallelism() const
+{
+	int count = (int) workers.size() + 1;
+	int limit = maxParallelism;
+	return limit > 0 ? std::min(limit, count) : count;
+}
+
+ThreadPool *ThreadPool::getShared()
+{
+	static ThreadPool pool(getProcessorCount() - 1, "love-worker");
+	return &pool;
+}
+
+int ThreadPool::getProcessorCount()
+{
+	return std::max((int) std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		Task task;
+
+		{
+			Lock lock(mutex);
+			while (!quit && tasks.empty())
+				taskAvailable->wait(mutex);
+
+			if (tasks.empty())
+				return;
+
+			task = std::move(tasks.front().task);
+			tasks.pop_front();
+		}
+
+		task();
+	}
+}
+
+bool ThreadPool::runPendingTask()
+{
+	Task task;
+
+	{
+		Lock lock(mutex);
+		if (tasks.empty())
+			return false;
+
+		task = std::move(tasks.front().task);
+		tasks.pop_front();
+	}
+
+	task();
+	return true;
+}
+
+} // thread
+} // love
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_THREAD_THREADPOOL_H
+#define LOVE_THREAD_THREADPOOL_H
+
+// LOVE
+#include "threads.h"
+
+// C++
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * A fixed set of worker threads which run queued tasks. Used by other modules
+ * to spread CPU-heavy work (compression, decoding, etc.) across cores.
+ **/
+class ThreadPool
+{
+public:
+
+	typedef std::function<void()> Task;
+	typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+	ThreadPool(int threadCount, const char *name);
+	~ThreadPool();
+
+	/**
+	 * Queues a task to be run on one of the worker threads. Tasks with a
+	 * higher priority run first, and tasks with equal priorities run in the
+	 * order they were submitted.
+	 **/
+	void submit(const Task &task, int priority = 0);
+
+	/**
+	 * Splits [0, count) into ranges of at least minRangeSize items, and runs
+	 * them on the worker threads as well as the calling thread. Returns once
+	 * every range has completed. If any range throws, the exception is
+	 * rethrown on the calling thread once all ranges have finished.
+	 **/
+	void parallelFor(size_t count, size_t minRangeSize, const RangeTask &task);
+
+	int getThreadCount() const;
+
+	/**
+	 * Limits how many threads parallelFor spreads its ranges across, counting
+	 * the calling thread. A limit of 1 runs every range on the calling thread,
+	 * and 0 removes the limit. Tasks queued with submit are not affected.
+	 **/
+	void setMaxParallelism(int count);
+
+	/**
+	 * Gets the number of threads parallelFor currently spreads its ranges
+	 * across, counting the calling thread.
+	 **/
+	int getMaxParallelism() const;
+
+	/**
+	 * Gets a lazily created pool with one thread per logical core (minus the
+	 * calling thread), shared by all modules.
+	 **/
+	static ThreadPool *getShared();
+
+	static int getProcessorCount();
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+		Worker(ThreadPool *pool, const char *name);
+		void threadFunction() override;
+	private:
+		ThreadPool *pool;
+	};
+
+	void workerLoop();
+
+	// Runs a queued task on the calling thread if there is one.
+	bool runPendingTask();
+
+	struct QueuedTask
+	{
+		Task task;
+		int priority;
+	};
+
+	std::vector<Worker *> workers;
+	std::deque<QueuedTask> tasks;
+
+	MutexRef mutex;
+	ConditionalRef taskAvailable;
+	bool quit;
+
+	std::atomic<int> maxParallelism;
+
+}; // ThreadPool
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_THREADPOOL_H
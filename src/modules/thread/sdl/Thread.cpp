@@ -19,6 +19,7 @@
  **/
 
 #include "Thread.h"
+#include "common/profiler.h"
 
 namespace love
 {
@@ -92,6 +93,10 @@ int Thread::thread_runner(void *data)
 {
 	Thread *self = (Thread *) data; // some compilers don't like 'this'
 
+	const char *name = self->t->getThreadName();
+	if (name != nullptr)
+		love::profiler::setThreadName(name);
+
 	self->t->threadFunction();
 
 	{
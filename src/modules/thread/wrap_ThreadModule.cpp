@@ -23,6 +23,7 @@
 #include "wrap_LuaThread.h"
 #include "wrap_Channel.h"
 #include "ThreadModule.h"
+#include "ThreadPool.h"
 
 #include "filesystem/File.h"
 #include "filesystem/FileData.h"
@@ -97,12 +98,29 @@ int w_getChannel(lua_State *L)
 	return 1;
 }
 
+int w_setParallelism(lua_State *L)
+{
+	int count = lua_isnoneornil(L, 1) ? 0 : (int) luaL_checkinteger(L, 1);
+	if (count < 0)
+		return luaL_error(L, "Parallelism limit must not be negative.");
+	ThreadPool::getShared()->setMaxParallelism(count);
+	return 0;
+}
+
+int w_getParallelism(lua_State *L)
+{
+	lua_pushinteger(L, ThreadPool::getShared()->getMaxParallelism());
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg module_functions[] =
 {
 	{ "newThread", w_newThread },
 	{ "newChannel", w_newChannel },
 	{ "getChannel", w_getChannel },
+	{ "setParallelism", w_setParallelism },
+	{ "getParallelism", w_getParallelism },
 	{ 0, 0 }
 };
 
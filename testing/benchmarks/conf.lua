@@ -0,0 +1,9 @@
+function love.conf(t)
+  t.console = true
+  t.window = nil
+  t.modules.audio = false
+  t.modules.sound = false
+  -- records draws instead of rendering them, so graphics benchmarks measure
+  -- only the CPU side of a frame and run without a GPU
+  t.graphics.renderers = { 'none' }
+end
@@ -0,0 +1,100 @@
+-- love.data benchmarks
+
+-- semi-compressible input, so neither format hits a degenerate fast path
+local function makeInput(size)
+  local rng = love.math.newRandomGenerator(1234)
+  local words = { 'love', 'data', 'hello', 'world', 'chunk', 'stream', 'bench' }
+  local parts, total = {}, 0
+  while total < size do
+    local word = words[rng:random(1, #words)] .. rng:random(0, 9999) .. ' '
+    parts[#parts+1] = word
+    total = total + #word
+  end
+  return love.data.newByteData(table.concat(parts):sub(1, size))
+end
+
+return {
+
+  -- compares single-threaded lz4 with the chunk-parallel lz4chunked format
+  { 'compress', function(bench)
+    local input = makeInput(64 * 1024 * 1024)
+    local size = input:getSize()
+    for _, format in ipairs({ 'lz4', 'lz4chunked', 'zlib' }) do
+      bench:run(format .. ' compress', size, function()
+        love.data.compress('data', format, input)
+      end)
+      local compressed = love.data.compress('data', format, input)
+      bench:run(format .. ' decompress', size, function()
+        love.data.decompress('data', compressed)
+      end)
+    end
+  end },
+
+  -- lz4chunked at 1, 2, 4 and all threads, to show how it scales with cores
+  { 'scaling', function(bench)
+    local input = makeInput(64 * 1024 * 1024)
+    local size = input:getSize()
+    local compressed = love.data.compress('data', 'lz4chunked', input)
+    local maxthreads = love.thread.getParallelism()
+    local counts = {}
+    for _, count in ipairs({ 1, 2, 4, maxthreads }) do
+      if count <= maxthreads and count ~= counts[#counts] then
+        counts[#counts+1] = count
+      end
+    end
+    for _, count in ipairs(counts) do
+      love.thread.setParallelism(count)
+      bench:run('lz4chunked compress, ' .. count .. ' threads', size, function()
+        love.data.compress('data', 'lz4chunked', input)
+      end)
+      bench:run('lz4chunked decompress, ' .. count .. ' threads', size, function()
+        love.data.decompress('data', compressed)
+      end)
+    end
+    love.thread.setParallelism()
+  end },
+
+  -- one-shot throughput of each hash function
+  { 'hash', function(bench)
+    local input = makeInput(64 * 1024 * 1024)
+    local size = input:getSize()
+    for _, fn in ipairs({ 'md5', 'sha1', 'sha256', 'sha512', 'xxh3_64', 'xxh3_128', 'crc32' }) do
+      bench:run(fn .. ' hash', size, function()
+        love.data.hash('string', fn, input)
+      end)
+    end
+  end },
+
+  -- incremental hashing in 64 KB pieces
+  { 'hasher', function(bench)
+    local input = makeInput(16 * 1024 * 1024)
+    local size = input:getSize()
+    local piece = 64 * 1024
+    for _, fn in ipairs({ 'sha256', 'xxh3_64' }) do
+      bench:run(fn .. ' hasher', size, function()
+        local hasher = love.data.newHasher(fn)
+        for offset=0,size-1,piece do
+          hasher:update(love.data.newDataView(input, offset, math.min(piece, size - offset)))
+        end
+        hasher:digest()
+      end)
+    end
+  end },
+
+  -- streaming in 256 KB pieces, as a file reader or socket would
+  { 'stream', function(bench)
+    local input = makeInput(16 * 1024 * 1024)
+    local size = input:getSize()
+    local piece = 256 * 1024
+    for _, format in ipairs({ 'lz4chunked', 'zlib' }) do
+      bench:run(format .. ' stream compress', size, function()
+        local stream = love.data.newCompressor(format)
+        for offset=0,size-1,piece do
+          stream:push(love.data.newDataView(input, offset, math.min(piece, size - offset)))
+        end
+        stream:flush()
+      end)
+    end
+  end },
+
+}
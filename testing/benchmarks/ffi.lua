@@ -0,0 +1,116 @@
+-- per-call overhead of the functions with LuaJIT FFI fast paths, compared
+-- with the regular Lua C API versions they fall back to
+
+local CALLS = 10000
+
+-- the regular version a FFI fast path falls back to is kept as an upvalue
+-- named after the function (e.g. _draw), nil when FFI isn't in use
+local function capi(func, name)
+  if debug == nil or debug.getupvalue == nil then return nil end
+  for i=1,255 do
+    local upname, value = debug.getupvalue(func, i)
+    if upname == nil then break end
+    if upname == '_' .. name then return value end
+  end
+  return nil
+end
+
+-- runs make(func) with the current function and then with its fallback, where
+-- make returns the function to measure
+local function compare(bench, label, func, name, make)
+  local fallback = capi(func, name)
+  bench:rate(label .. (fallback ~= nil and ' (ffi)' or ''), CALLS, make(func))
+  if fallback ~= nil then
+    bench:rate(label .. ' (lua c api)', CALLS, make(fallback))
+  end
+end
+
+return {
+
+  { 'graphics', function(bench)
+    local image = love.graphics.newImage(love.image.newImageData(32, 32))
+    local batch = love.graphics.newSpriteBatch(image, CALLS, 'stream')
+
+    compare(bench, 'love.graphics.setColor', love.graphics.setColor, 'setColor', function(setColor)
+      return function()
+        for i=1,CALLS do
+          setColor(1, 1, 1, (i % 2) * 0.5)
+        end
+      end
+    end)
+
+    love.graphics.setColor(1, 1, 1, 1)
+
+    compare(bench, 'love.graphics.draw(image, x, y)', love.graphics.draw, 'draw', function(draw)
+      return function()
+        love.graphics.origin()
+        for i=1,CALLS do
+          draw(image, i % 800, i % 600)
+        end
+        love.graphics.present()
+      end
+    end)
+
+    compare(bench, 'SpriteBatch:add(x, y, r)', batch.add, 'add', function(add)
+      return function()
+        batch:clear()
+        for i=1,CALLS do
+          add(batch, i % 800, i % 600, i)
+        end
+      end
+    end)
+  end },
+
+  { 'transform', function(bench)
+    local transform = love.math.newTransform()
+
+    compare(bench, 'Transform:translate', transform.translate, 'translate', function(translate)
+      return function()
+        transform:reset()
+        for i=1,CALLS do
+          translate(transform, 1, 2)
+        end
+      end
+    end)
+
+    compare(bench, 'Transform:transformPoint', transform.transformPoint, 'transformPoint', function(transformPoint)
+      return function()
+        local sum = 0
+        for i=1,CALLS do
+          local x, y = transformPoint(transform, i, i)
+          sum = sum + x + y
+        end
+        return sum
+      end
+    end)
+  end },
+
+  { 'physics', function(bench)
+    local world = love.physics.newWorld(0, 9.81 * 64)
+    local body = love.physics.newBody(world, 100, 100, 'dynamic')
+
+    compare(bench, 'Body:getPosition', body.getPosition, 'getPosition', function(getPosition)
+      return function()
+        local sum = 0
+        for i=1,CALLS do
+          local x, y = getPosition(body)
+          sum = sum + x + y
+        end
+        return sum
+      end
+    end)
+
+    compare(bench, 'Body:getAngle', body.getAngle, 'getAngle', function(getAngle)
+      return function()
+        local sum = 0
+        for i=1,CALLS do
+          sum = sum + getAngle(body)
+        end
+        return sum
+      end
+    end)
+
+    world:destroy()
+  end },
+
+}
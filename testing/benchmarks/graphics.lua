@@ -0,0 +1,219 @@
+-- love.graphics benchmarks
+
+-- one full frame, drawn the way love.run does it
+local function frame(draw)
+  love.graphics.origin()
+  love.graphics.clear(0, 0, 0)
+  draw()
+  love.graphics.present()
+end
+
+-- per-frame totals from the last presented frame, when the renderer records
+-- them (see conf.lua)
+local function report(label)
+  local stats = love.graphics.getRecordingStats()
+  if stats == nil then return end
+  print(string.format('    %s: %d draws (%d batched), %d state changes, %d vertices, %.1f KB uploaded',
+    label, stats.drawcalls, stats.batches, stats.statechanges, stats.vertices, stats.uploadbytes / 1024))
+end
+
+local function makeRects(count)
+  local rng = love.math.newRandomGenerator(1234)
+  local rects = {}
+  for i=1,count do
+    rects[i] = { rng:random(0, 800), rng:random(0, 600), rng:random(4, 32), rng:random(4, 32) }
+  end
+  return rects
+end
+
+return {
+
+  -- immediate-mode shapes which all end up in the same autobatch, compared
+  -- with a colour/blend change every 100 shapes which splits the batch
+  { 'shapes', function(bench)
+    local rects = makeRects(10000)
+    local function draw()
+      for i=1,#rects do
+        local r = rects[i]
+        love.graphics.rectangle('fill', r[1], r[2], r[3], r[4])
+      end
+    end
+    local function drawsplit()
+      for i=1,#rects do
+        if i % 100 == 0 then
+          love.graphics.setBlendMode(i % 200 == 0 and 'add' or 'alpha')
+        end
+        local r = rects[i]
+        love.graphics.rectangle('fill', r[1], r[2], r[3], r[4])
+      end
+      love.graphics.setBlendMode('alpha')
+    end
+    bench:run('10000 rectangles', nil, function() frame(draw) end)
+    report('10000 rectangles')
+    bench:run('10000 rectangles, 100 blend changes', nil, function() frame(drawsplit) end)
+    report('10000 rectangles, 100 blend changes')
+  end },
+
+  -- sprites drawn one at a time vs. rebuilt into a stream SpriteBatch
+  { 'sprites', function(bench)
+    local rects = makeRects(10000)
+    local image = love.graphics.newImage(love.image.newImageData(32, 32))
+    local batch = love.graphics.newSpriteBatch(image, #rects, 'stream')
+    local function draw()
+      for i=1,#rects do
+        love.graphics.draw(image, rects[i][1], rects[i][2])
+      end
+    end
+    local function drawbatch()
+      batch:clear()
+      for i=1,#rects do
+        batch:add(rects[i][1], rects[i][2])
+      end
+      love.graphics.draw(batch)
+    end
+    bench:run('10000 draw(image)', nil, function() frame(draw) end)
+    report('10000 draw(image)')
+    bench:run('10000 SpriteBatch:add', nil, function() frame(drawbatch) end)
+    report('10000 SpriteBatch:add')
+  end },
+
+  -- many small curves, rendered to tables and drawn as lines vs. flattened
+  -- adaptively in C++ and drawn together
+  { 'curves', function(bench)
+    local rng = love.math.newRandomGenerator(4321)
+    local curves = {}
+    for i=1,2000 do
+      local x, y = rng:random(0, 760), rng:random(0, 560)
+      curves[i] = love.math.newBezierCurve(x, y, x + rng:random(0, 40), y + rng:random(0, 40),
+        x + rng:random(0, 40), y + rng:random(0, 40), x + 40, y + 40)
+    end
+    local function draw()
+      for i=1,#curves do
+        love.graphics.line(curves[i]:render())
+      end
+    end
+    local function drawbatch()
+      love.graphics.curves(curves)
+    end
+    bench:run('2000 line(curve:render())', nil, function() frame(draw) end)
+    report('2000 line(curve:render())')
+    bench:run('2000 curves', nil, function() frame(drawbatch) end)
+    report('2000 curves')
+  end },
+
+  -- static concave polygons with a hole, whose triangulations are cached
+  -- after the first frame
+  { 'polygons', function(bench)
+    local shapes = {}
+    for i=1,200 do
+      local cx, cy = (i % 20) * 40 + 20, math.floor(i / 20) * 40 + 20
+      local outer, hole = {}, {}
+      for j=1,64 do
+        local angle = (j - 1) / 64 * math.pi * 2
+        local r = 18 * (1 + 0.3 * math.sin(angle * 5))
+        outer[j*2-1], outer[j*2] = cx + math.cos(angle) * r, cy + math.sin(angle) * r
+      end
+      for j=1,8 do
+        local angle = -(j - 1) / 8 * math.pi * 2
+        hole[j*2-1], hole[j*2] = cx + math.cos(angle) * 5, cy + math.sin(angle) * 5
+      end
+      shapes[i] = { outer, { hole } }
+    end
+    local function draw()
+      for i=1,#shapes do
+        love.graphics.polygon('fill', shapes[i][1], shapes[i][2])
+      end
+    end
+    bench:run('200 concave polygons with holes', nil, function() frame(draw) end)
+    report('200 concave polygons with holes')
+  end },
+
+  -- 40 characters of 5000 vertices and 32 bones each, posed by rewriting
+  -- every vertex from Lua vs. Mesh:skin
+  { 'skinning', function(bench)
+    local vertexcount, bonecount, meshcount = 5000, 32, 40
+    local rng = love.math.newRandomGenerator(4321)
+    local vertices, rest = {}, {}
+    for i=1,vertexcount do
+      local b1, b2 = rng:random(0, bonecount - 1), rng:random(0, bonecount - 1)
+      local x, y = rng:random(-50, 50), rng:random(-50, 50)
+      vertices[i] = { x, y, b1, b2, 0, 0, 0.75, 0.25, 0, 0 }
+      rest[i] = { x, y, b1 + 1, b2 + 1 }
+    end
+    local format = {
+      { name = 'VertexPosition', format = 'floatvec2' },
+      { name = 'VertexBones', format = 'uint8vec4' },
+      { name = 'VertexWeights', format = 'floatvec4' },
+    }
+    local meshes = {}
+    for i=1,meshcount do
+      meshes[i] = love.graphics.newMesh(format, vertices, 'points', 'stream')
+      meshes[i]:setSkinning('VertexBones', 'VertexWeights')
+    end
+    local bones = {}
+    for i=1,bonecount do
+      bones[i] = love.math.newTransform(i, 0, i * 0.01)
+    end
+    local posed = {}
+    for i=1,vertexcount do
+      posed[i] = { unpack(vertices[i]) }
+    end
+    local function drawlua()
+      for m=1,meshcount do
+        for i=1,vertexcount do
+          local r = rest[i]
+          local x1, y1 = bones[r[3]]:transformPoint(r[1], r[2])
+          local x2, y2 = bones[r[4]]:transformPoint(r[1], r[2])
+          posed[i][1], posed[i][2] = x1 * 0.75 + x2 * 0.25, y1 * 0.75 + y2 * 0.25
+        end
+        meshes[m]:setVertices(posed)
+        love.graphics.draw(meshes[m], (m % 8) * 100 + 50, math.floor(m / 8) * 100 + 50)
+      end
+    end
+    local function drawskin()
+      for m=1,meshcount do
+        meshes[m]:skin(bones)
+        love.graphics.draw(meshes[m], (m % 8) * 100 + 50, math.floor(m / 8) * 100 + 50)
+      end
+    end
+    bench:run('40 meshes, skinned from Lua', nil, function() frame(drawlua) end)
+    report('40 meshes, skinned from Lua')
+    bench:run('40 meshes, Mesh:skin', nil, function() frame(drawskin) end)
+    report('40 meshes, Mesh:skin')
+  end },
+
+  -- uploading 100k procedurally generated vertices into a Buffer from a Lua
+  -- table, from a Data, and by writing into a mapping through the FFI
+  { 'buffers', function(bench)
+    local count = 100000
+    local format = {{ name = 'VertexPosition', format = 'floatvec2' }}
+    local buffer = love.graphics.newBuffer(format, count, { vertex = true, usage = 'stream' })
+    local bytes = count * 8
+    local flat = {}
+    for i=1,count*2 do
+      flat[i] = i % 800
+    end
+    local data = love.data.newByteData(bytes)
+    bench:run('setArrayData from a table', bytes, function()
+      buffer:setArrayData(flat)
+    end)
+    bench:run('setData from a ByteData', bytes, function()
+      buffer:setData(data)
+    end)
+    local hasffi, ffi = pcall(require, 'ffi')
+    if hasffi then
+      bench:run('map, FFI writes, unmap', bytes, function()
+        local mapping = buffer:map()
+        local floats = ffi.cast('float *', mapping:getFFIPointer())
+        for i=0,count*2-1 do
+          floats[i] = i % 800
+        end
+        buffer:unmap()
+        mapping:release()
+      end)
+    end
+    data:release()
+    buffer:release()
+  end },
+
+}
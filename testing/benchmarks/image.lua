@@ -0,0 +1,84 @@
+-- love.image benchmarks
+
+-- noisy gradient, so the png doesn't compress down to almost nothing
+local function makeImage(width, height)
+  local rng = love.math.newRandomGenerator(1234)
+  local idata = love.image.newImageData(width, height)
+  idata:mapPixel(function(x, y)
+    return x / width, y / height, rng:random(), 1
+  end)
+  return idata
+end
+
+return {
+
+  -- decoding a batch of pngs one by one vs across the worker pool
+  { 'decode', function(bench)
+    local count = 64
+    local png = makeImage(512, 512):encode('png')
+    local sources = {}
+    for i=1,count do sources[i] = png end
+    local bytes = png:getSize() * count
+    bench:run('newImageData x' .. count, bytes, function()
+      for i=1,count do love.image.newImageData(sources[i]) end
+    end)
+    bench:run('decodeMany x' .. count, bytes, function()
+      love.image.decodeMany(sources)
+    end)
+    bench:run('newImageDataAsync x' .. count, bytes, function()
+      local requests = {}
+      for i=1,count do requests[i] = love.image.newImageDataAsync(sources[i]) end
+      for i=1,count do requests[i]:wait() end
+    end)
+  end },
+
+  -- png encoding at screenshot sizes with the different encode options
+  { 'encode', function(bench)
+    local sizes = { { '1080p', 1920, 1080 }, { '4k', 3840, 2160 } }
+    local options = {
+      { 'default', nil },
+      { 'store', { level = 0 } },
+      { 'fast', { level = 1, filter = 'up' } },
+      { 'parallel', { parallel = true } },
+      { 'fast parallel', { level = 1, filter = 'up', parallel = true } },
+    }
+    for _, size in ipairs(sizes) do
+      local idata = makeImage(size[2], size[3])
+      for _, option in ipairs(options) do
+        bench:run(size[1] .. ' ' .. option[1], idata:getSize(), function()
+          idata:encode('png', option[2])
+        end)
+      end
+      idata:release()
+    end
+  end },
+
+  -- bulk pixel operations vs the equivalent mapPixel / paste loops
+  { 'bulk', function(bench)
+    local idata = makeImage(1920, 1080)
+    local bytes = idata:getSize()
+    bench:run('mapPixel premultiply', bytes, function()
+      idata:mapPixel(function(x, y, r, g, b, a) return r * a, g * a, b * a, a end)
+    end)
+    bench:run('premultiplyAlpha', bytes, function()
+      idata:premultiplyAlpha()
+    end)
+    bench:run('convert to rgba16f', bytes, function()
+      idata:convert('rgba16f')
+    end)
+    local overlay = makeImage(1920, 1080)
+    bench:run('paste alpha', bytes, function()
+      idata:paste(overlay, 0, 0, 0, 0, 1920, 1080, 'alpha')
+    end)
+    for _, filter in ipairs({ 'box', 'bilinear', 'lanczos' }) do
+      bench:run('resize 960x540 ' .. filter, bytes, function()
+        idata:resize(960, 540, filter)
+      end)
+    end
+    bench:run('generateMipmaps', bytes, function()
+      idata:generateMipmaps()
+    end)
+    idata:release()
+  end },
+
+}
@@ -0,0 +1,63 @@
+-- love.benchmark
+-- simple throughput/timing harness for engine hot paths, i.e:
+-- `love testing/benchmarks` runs every benchmark file
+-- `love testing/benchmarks data physics` runs only the given files
+
+local files = { 'data', 'image', 'graphics', 'math', 'physics', 'ffi' }
+
+-- each benchmark file returns a list of { name, fn } pairs, fn is called with
+-- a bench obj and should call bench:run(label, bytes, func) per measurement
+local Bench = {}
+Bench.__index = Bench
+
+-- runs func repeatedly for at least the min time and prints the average
+-- time per call, plus throughput if a byte count is given
+function Bench:run(label, bytes, func)
+  func() -- warm up so first-use allocations aren't counted
+  local count, start = 0, love.timer.getTime()
+  local elapsed = 0
+  repeat
+    func()
+    count = count + 1
+    elapsed = love.timer.getTime() - start
+  until elapsed >= self.mintime
+  local per = elapsed / count
+  local line = string.format('  %-48s %10.3f ms', label, per * 1000)
+  if bytes ~= nil and bytes > 0 then
+    line = line .. string.format('  %10.1f MB/s', bytes / per / (1024 * 1024))
+  end
+  print(line)
+end
+
+-- like run, but func makes the given number of calls and the result is
+-- printed as calls per second
+function Bench:rate(label, calls, func)
+  func()
+  local count, start = 0, love.timer.getTime()
+  local elapsed = 0
+  repeat
+    func()
+    count = count + 1
+    elapsed = love.timer.getTime() - start
+  until elapsed >= self.mintime
+  print(string.format('  %-48s %10.2f M calls/s', label, calls * count / elapsed / 1000000))
+end
+
+love.load = function(args)
+  local selected = files
+  if args ~= nil and #args > 0 then
+    selected = args
+  end
+
+  local bench = setmetatable({ mintime = 0.5 }, Bench)
+  print(string.format('love.benchmark - %s, %d cores', love.system.getOS(), love.system.getProcessorCount()))
+  for f=1,#selected do
+    local benchmarks = require(selected[f])
+    for b=1,#benchmarks do
+      print(selected[f] .. '.' .. benchmarks[b][1])
+      benchmarks[b][2](bench)
+    end
+  end
+
+  love.event.quit(0)
+end
@@ -0,0 +1,28 @@
+-- love.physics benchmarks
+
+return {
+
+  -- returning objects to Lua, which reuses each object's existing Proxy
+  -- userdata while Lua still references it and creates new ones after
+  -- they've been collected
+  { 'getBodies', function(bench)
+    local world = love.physics.newWorld(0, 0)
+    local bodies = {}
+    for i=1,10000 do
+      bodies[i] = love.physics.newBody(world, (i % 100) * 10, math.floor(i / 100) * 10, 'dynamic')
+    end
+
+    bench:run('World:getBodies, 10000 bodies', nil, function()
+      world:getBodies()
+    end)
+
+    bodies = nil
+    bench:run('World:getBodies, 10000 bodies, collected', nil, function()
+      world:getBodies()
+      collectgarbage()
+    end)
+
+    world:destroy()
+  end },
+
+}
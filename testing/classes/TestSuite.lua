@@ -41,6 +41,7 @@ TestSuite = {
       math = {},
       mouse = {},
       physics = {},
+      profiler = {},
       sensor = {},
       sound = {},
       system = {},
@@ -21,6 +21,7 @@ if love.keyboard ~= nil then require('tests.keyboard') end
 if love.math ~= nil then require('tests.math') end
 if love.mouse ~= nil then require('tests.mouse') end
 if love.physics ~= nil then require('tests.physics') end
+if love.profiler ~= nil then require('tests.profiler') end
 if love.sensor ~= nil then require('tests.sensor') end
 if love.sound ~= nil then require('tests.sound') end
 if love.system ~= nil then require('tests.system') end
@@ -80,8 +81,8 @@ love.load = function(args)
   local cmderr = 'Invalid flag used'
   local modules = {
     'audio', 'data', 'event', 'filesystem', 'font', 'graphics', 'image',
-    'joystick', 'keyboard', 'love', 'math', 'mouse', 'physics', 'sensor',
-    'sound', 'system', 'thread', 'timer', 'touch', 'video', 'window'
+    'joystick', 'keyboard', 'love', 'math', 'mouse', 'physics', 'profiler',
+    'sensor', 'sound', 'system', 'thread', 'timer', 'touch', 'video', 'window'
   }
   GITHUB_RUNNER = false
   for a=1,#arglist do
@@ -62,6 +62,80 @@ love.test.data.CompressedData = function(test)
 end
 
 
+-- CompressionStream (love.data.newCompressor)
+love.test.data.CompressionStream = function(test)
+
+  -- create new compressor + decompressor pair
+  local compressor = love.data.newCompressor('zlib')
+  local decompressor = love.data.newDecompressor('zlib')
+  test:assertObject(compressor)
+  test:assertObject(decompressor)
+  test:assertEquals('zlib', compressor:getFormat(), 'check format used')
+  test:assertEquals('compress', compressor:getMode(), 'check compress mode')
+  test:assertEquals('decompress', decompressor:getMode(), 'check decompress mode')
+
+  -- check pushing data in pieces gives back the same bytes
+  local compressed = compressor:push('hello') .. compressor:push(love.data.newByteData('world'))
+  compressed = compressed .. compressor:flush()
+  test:assertTrue(compressor:isFinished(), 'check finished after flush')
+  test:assertEquals('helloworld', love.data.decompress('string', 'zlib', compressed), 'check stream matches compress')
+  local decompressed = decompressor:push(compressed) .. decompressor:flush()
+  test:assertEquals('helloworld', decompressed, 'check stream decompress')
+
+  -- check pushing after finishing errors
+  local ok = pcall(compressor.push, compressor, 'more')
+  test:assertFalse(ok, 'check push after finish errors')
+
+  -- lz4 can't be streamed, but lz4chunked can
+  test:assertFalse(pcall(love.data.newCompressor, 'lz4'), 'check lz4 stream errors')
+  local lz4 = love.data.newCompressor('lz4chunked', 9)
+  local lz4compressed = lz4:push(string.rep('helloworld', 1000)) .. lz4:flush()
+  local lz4decompressor = love.data.newDecompressor('lz4chunked')
+  local half = math.floor(#lz4compressed / 2)
+  local lz4decompressed = lz4decompressor:push(lz4compressed:sub(1, half))
+  lz4decompressed = lz4decompressed .. lz4decompressor:push(lz4compressed:sub(half + 1))
+  lz4decompressed = lz4decompressed .. lz4decompressor:flush()
+  test:assertEquals(string.rep('helloworld', 1000), lz4decompressed, 'check lz4chunked stream')
+
+end
+
+
+-- Hasher (love.data.newHasher)
+love.test.data.Hasher = function(test)
+
+  -- create new obj
+  local hasher = love.data.newHasher('sha256')
+  test:assertObject(hasher)
+  test:assertEquals('sha256', hasher:getFunction(), 'check function used')
+
+  -- check hashing in pieces matches hashing all at once
+  hasher:update('hello')
+  hasher:update(love.data.newByteData('world'))
+  local expected = love.data.hash('string', 'sha256', 'helloworld')
+  test:assertEquals(expected, hasher:digest(), 'check digest matches hash')
+  test:assertEquals(expected, hasher:digest('data'):getString(), 'check data digest')
+
+  -- check more input can be added after a digest
+  hasher:update('!')
+  test:assertEquals(love.data.hash('string', 'sha256', 'helloworld!'), hasher:digest(), 'check digest after more input')
+
+  -- check reset discards input
+  hasher:reset()
+  test:assertEquals(love.data.hash('string', 'sha256', ''), hasher:digest(), 'check reset')
+
+  -- check every function works incrementally, across block boundaries
+  local input = string.rep('love', 100)
+  for _, fn in ipairs({ 'md5', 'sha1', 'sha224', 'sha384', 'sha512', 'xxh3_64', 'xxh3_128', 'crc32' }) do
+    local h = love.data.newHasher(fn)
+    for i=1,#input,7 do
+      h:update(input:sub(i, i + 6))
+    end
+    test:assertEquals(love.data.hash('string', fn, input), h:digest(), 'check ' .. fn .. ' hasher')
+  end
+
+end
+
+
 --------------------------------------------------------------------------------
 --------------------------------------------------------------------------------
 ------------------------------------METHODS-------------------------------------
@@ -87,6 +161,8 @@ love.test.data.compress = function(test)
     { love.data.compress('string', 'deflate', 'heloworld', -1), 'string'},
     { love.data.compress('string', 'deflate', 'heloworld', 0), 'string'},
     { love.data.compress('string', 'deflate', 'heloworld', 9), 'string'},
+    { love.data.compress('string', 'lz4chunked', 'helloworld', -1), 'string'},
+    { love.data.compress('string', 'lz4chunked', 'helloworld', 9), 'string'},
     { love.data.compress('data', 'lz4', 'helloworld', -1), 'userdata'},
     { love.data.compress('data', 'lz4', 'helloworld', 0), 'userdata'},
     { love.data.compress('data', 'lz4', 'helloworld', 9), 'userdata'},
@@ -147,6 +223,8 @@ love.test.data.decompress = function(test)
   local str16 = love.data.compress('data', 'gzip', 'helloworld', -1)
   local str17 = love.data.compress('data', 'gzip', 'helloworld', 0)
   local str18 = love.data.compress('data', 'gzip', 'helloworld', 9)
+  local str19 = love.data.compress('string', 'lz4chunked', 'helloworld', -1)
+  local str20 = love.data.compress('data', 'lz4chunked', 'helloworld', 9)
   -- check decompressed value matches whats expected
   test:assertEquals('helloworld', love.data.decompress('string', 'lz4', str1), 'check string lz4 decompress')
   test:assertEquals('helloworld', love.data.decompress('string', 'lz4', str2), 'check string lz4 decompress')
@@ -166,6 +244,8 @@ love.test.data.decompress = function(test)
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str16):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str17):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str18):getString(), 'check data glib decompress')
+  test:assertEquals('helloworld', love.data.decompress('string', 'lz4chunked', str19), 'check string lz4chunked decompress')
+  test:assertEquals('helloworld', love.data.decompress('data', 'lz4chunked', str20):getString(), 'check data lz4chunked decompress')
 end
 
 
@@ -213,12 +293,16 @@ love.test.data.hash = function(test)
   local str4 = love.data.hash('string', 'sha256', 'helloworld')
   local str5 = love.data.hash('string', 'sha384', 'helloworld')
   local str6 = love.data.hash('string', 'sha512', 'helloworld')
+  local str7 = love.data.hash('string', 'xxh3_64', 'helloworld')
+  local str8 = love.data.hash('string', 'xxh3_128', 'helloworld')
+  local str9 = love.data.hash('string', 'crc32', 'helloworld')
   local data1 = love.data.hash('data', 'md5', 'helloworld')
   local data2 = love.data.hash('data', 'sha1', 'helloworld')
   local data3 = love.data.hash('data', 'sha224', 'helloworld')
   local data4 = love.data.hash('data', 'sha256', 'helloworld')
   local data5 = love.data.hash('data', 'sha384', 'helloworld')
   local data6 = love.data.hash('data', 'sha512', 'helloworld')
+  local data7 = love.data.hash('data', 'crc32', 'helloworld')
   -- check encoded hash value matches what's expected for that algo
     -- test container string
   test:assertEquals('fc5e038d38a57032085441e7fe7010b0', love.data.encode("string", "hex", str1), 'check string md5 encode')
@@ -227,6 +311,9 @@ love.test.data.hash = function(test)
   test:assertEquals('936a185caaa266bb9cbe981e9e05cb78cd732b0b3280eb944412bb6f8f8f07af', love.data.encode("string", "hex", str4), 'check string sha256 encode')
   test:assertEquals('97982a5b1414b9078103a1c008c4e3526c27b41cdbcf80790560a40f2a9bf2ed4427ab1428789915ed4b3dc07c454bd9', love.data.encode("string", "hex", str5), 'check string sha384 encode')
   test:assertEquals('1594244d52f2d8c12b142bb61f47bc2eaf503d6d9ca8480cae9fcf112f66e4967dc5e8fa98285e36db8af1b8ffa8b84cb15e0fbcf836c3deb803c13f37659a60', love.data.encode("string", "hex", str6), 'check string sha512 encode')
+  test:assertEquals('ffdcce9d0e1f7d46', love.data.encode("string", "hex", str7), 'check string xxh3_64 encode')
+  test:assertEquals('ddf7ff67be2b60f50f178df33653476f', love.data.encode("string", "hex", str8), 'check string xxh3_128 encode')
+  test:assertEquals('f9eb20ad', love.data.encode("string", "hex", str9), 'check string crc32 encode')
     -- test container data
   test:assertEquals('fc5e038d38a57032085441e7fe7010b0', love.data.encode("string", "hex", data1), 'check data md5 encode')
   test:assertEquals('6adfb183a4a2c94a2f92dab5ade762a47889a5a1', love.data.encode("string", "hex", data2), 'check data sha1 encode')
@@ -234,6 +321,7 @@ love.test.data.hash = function(test)
   test:assertEquals('936a185caaa266bb9cbe981e9e05cb78cd732b0b3280eb944412bb6f8f8f07af', love.data.encode("string", "hex", data4), 'check data sha256 encode')
   test:assertEquals('97982a5b1414b9078103a1c008c4e3526c27b41cdbcf80790560a40f2a9bf2ed4427ab1428789915ed4b3dc07c454bd9', love.data.encode("string", "hex", data5), 'check data sha384 encode')
   test:assertEquals('1594244d52f2d8c12b142bb61f47bc2eaf503d6d9ca8480cae9fcf112f66e4967dc5e8fa98285e36db8af1b8ffa8b84cb15e0fbcf836c3deb803c13f37659a60', love.data.encode("string", "hex", data6), 'check data sha512 encode')
+  test:assertEquals('f9eb20ad', love.data.encode("string", "hex", data7), 'check data crc32 encode')
 end
 
 
@@ -244,6 +332,13 @@ love.test.data.newByteData = function(test)
 end
 
 
+-- love.data.newHasher
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.data.newHasher = function(test)
+  test:assertObject(love.data.newHasher('xxh3_64'))
+end
+
+
 -- love.data.newDataView
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.data.newDataView = function(test)
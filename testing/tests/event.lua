@@ -24,6 +24,16 @@ love.test.event.clear = function(test)
 end
 
 
+-- love.event.isCoalescing
+love.test.event.isCoalescing = function(test)
+  test:assertFalse(love.event.isCoalescing(), 'check disabled by default')
+  love.event.setCoalescing(true)
+  test:assertTrue(love.event.isCoalescing(), 'check enabled')
+  love.event.setCoalescing(false)
+  test:assertFalse(love.event.isCoalescing(), 'check disabled')
+end
+
+
 -- love.event.poll
 love.test.event.poll = function(test)
   -- push some events first
@@ -60,6 +70,39 @@ love.test.event.push = function(test)
     end
   end
   test:assertEquals(12, count, 'check total events')
+  -- check messages with more arguments than are stored inline
+  local long = string.rep('x', 100)
+  love.event.push('many', 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, long, true)
+  local name, a, b, c, d, e, f, g, h, i, j, k, l = love.event.poll()()
+  test:assertEquals('many', name, 'check name')
+  test:assertEquals(1, a, 'check first arg')
+  test:assertEquals(8, h, 'check last inline arg')
+  test:assertEquals(10, j, 'check extra arg')
+  test:assertEquals(long, k, 'check long string arg')
+  test:assertTrue(l, 'check last arg')
+  -- more events than the initial queue size keep their order
+  for n=1,200 do
+    love.event.push('order', n)
+  end
+  local expected = 1
+  for n, a in love.event.poll() do
+    if n == 'order' then
+      test:assertEquals(expected, a, 'check event order ' .. expected)
+      expected = expected + 1
+    end
+  end
+  test:assertEquals(201, expected, 'check all events polled')
+  -- check many distinct names keep their own name
+  for n=1,300 do
+    love.event.push('name' .. n, n)
+  end
+  local names = 0
+  for n, a in love.event.poll() do
+    if n == 'name' .. a then
+      names = names + 1
+    end
+  end
+  test:assertEquals(300, names, 'check distinct names')
 end
 
 
@@ -73,6 +116,51 @@ love.test.event.quit = function(test)
 end
 
 
+-- love.event.setCoalescing
+love.test.event.setCoalescing = function(test)
+  love.event.setCoalescing(true)
+  love.event.clear()
+  -- check relative motion is accumulated and positions replaced
+  love.event.push('mousemoved', 1, 1, 1, 1, false)
+  love.event.push('mousemoved', 2, 3, 1, 2, false)
+  love.event.push('mousemoved', 4, 4, 2, 1, false)
+  local events = {}
+  for n, a, b, c, d in love.event.poll() do
+    table.insert(events, { n, a, b, c, d })
+  end
+  test:assertEquals(1, #events, 'check motion merged')
+  test:assertEquals(4, events[1][2], 'check merged x')
+  test:assertEquals(4, events[1][3], 'check merged y')
+  test:assertEquals(4, events[1][4], 'check merged dx')
+  test:assertEquals(4, events[1][5], 'check merged dy')
+  -- check events aren't merged across an event which can't be merged
+  love.event.push('mousemoved', 1, 1, 1, 1, false)
+  love.event.push('mousepressed', 1, 1, 1, false, 1)
+  love.event.push('mousemoved', 2, 2, 1, 1, false)
+  love.event.push('gamepadaxis', 'joy', 'leftx', 0.25)
+  love.event.push('gamepadaxis', 'joy', 'lefty', 0.5)
+  love.event.push('gamepadaxis', 'joy', 'leftx', 0.75)
+  local count, leftx = 0, nil
+  for n, a, b, c in love.event.poll() do
+    count = count + 1
+    if n == 'gamepadaxis' and b == 'leftx' then
+      leftx = c
+    end
+  end
+  test:assertEquals(5, count, 'check merge stops at other events')
+  test:assertEquals(0.75, leftx, 'check axis value replaced')
+  -- check nothing is merged once disabled
+  love.event.setCoalescing(false)
+  love.event.push('mousemoved', 1, 1, 1, 1, false)
+  love.event.push('mousemoved', 2, 2, 1, 1, false)
+  count = 0
+  for n in love.event.poll() do
+    count = count + 1
+  end
+  test:assertEquals(2, count, 'check not merged when disabled')
+end
+
+
 -- love.event.wait
 -- @NOTE not sure best way to test this one
 love.test.event.wait = function(test)
@@ -78,6 +78,38 @@ love.test.filesystem.File = function(test)
 end
 
 
+-- FileRequest (love.filesystem.readAsync)
+love.test.filesystem.FileRequest = function(test)
+
+  -- create new obj
+  local request = love.filesystem.readAsync('resources/test.txt', 5)
+  test:assertObject(request)
+  test:assertEquals('resources/test.txt', request:getFilename(), 'check filename')
+  test:assertEquals(5, request:getPriority(), 'check priority')
+
+  -- check request completes
+  test:assertTrue(request:wait(5), 'check wait')
+  test:assertTrue(request:isComplete(), 'check complete')
+  test:assertEquals('done', request:getStatus(), 'check status')
+  test:assertEquals('helloworld', request:getData():getString(), 'check data')
+  test:assertEquals(nil, request:getError(), 'check no error')
+  test:assertFalse(request:cancel(), 'check cancel after completion')
+
+  -- check latency is reported
+  local queued, reading = request:getLatency()
+  test:assertGreaterEqual(0, queued, 'check queued time')
+  test:assertGreaterEqual(0, reading, 'check reading time')
+
+  -- check cancelling, which may race with the read finishing
+  local cancelled = love.filesystem.readAsync('resources/love.png')
+  cancelled:cancel()
+  test:assertTrue(cancelled:wait(), 'check cancelled wait')
+  local status = cancelled:getStatus()
+  test:assertTrue(status == 'cancelled' or status == 'done', 'check cancelled status')
+
+end
+
+
 -- FileData (love.filesystem.newFileData)
 love.test.filesystem.FileData = function(test)
 
@@ -96,6 +128,23 @@ love.test.filesystem.FileData = function(test)
   test:assertObject(clonedfdata)
   test:assertEquals('helloworld', clonedfdata:getString(), 'check cloned data')
   test:assertEquals(10, clonedfdata:getSize(), 'check cloned size')
+  test:assertFalse(fdata:isMemoryMapped(), 'check not mapped')
+
+  -- check memory-mapped file data matches a normal read
+  local contents = love.filesystem.read('resources/love.png')
+  local mapped = love.filesystem.newFileData('resources/love.png', { mmap = true })
+  local copied = love.filesystem.newFileData('resources/love.png', { mmap = false })
+  test:assertObject(mapped)
+  test:assertEquals('resources/love.png', mapped:getFilename(), 'check mapped filename')
+  test:assertTrue(mapped:isMemoryMapped(), 'check mapped')
+  test:assertEquals(contents, mapped:getString(), 'check mapped data')
+  test:assertEquals(contents, copied:getString(), 'check copied data')
+  test:assertFalse(copied:isMemoryMapped(), 'check copied not mapped')
+
+  -- check mapped data can be cloned into normal memory
+  local clonedmapped = mapped:clone()
+  test:assertFalse(clonedmapped:isMemoryMapped(), 'check clone not mapped')
+  test:assertEquals(contents, clonedmapped:getString(), 'check cloned mapped data')
 
 end
 
@@ -468,6 +517,28 @@ end
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.filesystem.newFileData = function(test)
   test:assertNotNil(love.filesystem.newFileData('helloworld', 'file1'))
+  test:assertNotNil(love.filesystem.newFileData('resources/test.txt', { mmap = true }))
+end
+
+
+-- love.filesystem.setMemoryMapThreshold
+love.test.filesystem.setMemoryMapThreshold = function(test)
+  local threshold = love.filesystem.getMemoryMapThreshold()
+  test:assertEquals(64*1024*1024, threshold, 'check default threshold')
+  -- check files above the threshold still read the same when mapped
+  local contents = love.filesystem.read('resources/love.png')
+  love.filesystem.setMemoryMapThreshold(1)
+  test:assertEquals(1, love.filesystem.getMemoryMapThreshold(), 'check set threshold')
+  test:assertEquals(contents, love.filesystem.read('resources/love.png'), 'check read')
+  local abovethreshold = love.filesystem.newFileData('resources/love.png')
+  test:assertTrue(abovethreshold:isMemoryMapped(), 'check mapped above threshold')
+  test:assertEquals(contents, abovethreshold:getString(), 'check file data')
+  -- files in the save directory are never mapped
+  love.filesystem.write('filesystem.mmap.txt', 'helloworld')
+  test:assertFalse(love.filesystem.newFileData('filesystem.mmap.txt'):isMemoryMapped(), 'check save dir not mapped')
+  love.filesystem.remove('filesystem.mmap.txt')
+  love.filesystem.setMemoryMapThreshold(threshold)
+  test:assertEquals(threshold, love.filesystem.getMemoryMapThreshold(), 'check threshold reset')
 end
 
 
@@ -486,6 +557,31 @@ love.test.filesystem.read = function(test)
 end
 
 
+-- love.filesystem.readAsync
+love.test.filesystem.readAsync = function(test)
+  -- check several requests in flight at once complete with the right data
+  local files = { 'resources/test.txt', 'resources/love.png', 'resources/font.ttf' }
+  local requests = {}
+  for i, file in ipairs(files) do
+    requests[i] = love.filesystem.readAsync(file, i)
+  end
+  for i, request in ipairs(requests) do
+    test:assertTrue(request:wait(), 'check wait')
+    test:assertEquals('done', request:getStatus(), 'check status')
+    local data = request:getData()
+    test:assertObject(data)
+    test:assertEquals(files[i], data:getFilename(), 'check filename')
+    test:assertEquals(love.filesystem.read(files[i]), data:getString(), 'check contents')
+  end
+  -- check missing files report an error instead of throwing
+  local missing = love.filesystem.readAsync('resources/missing.txt')
+  test:assertTrue(missing:wait(), 'check wait missing')
+  test:assertEquals('error', missing:getStatus(), 'check error status')
+  test:assertEquals(nil, missing:getData(), 'check no data')
+  test:assertNotEquals(nil, missing:getError(), 'check error message')
+end
+
+
 -- love.filesystem.remove
 love.test.filesystem.remove = function(test)
   -- create a dir + subdir with a file
@@ -501,6 +597,34 @@ love.test.filesystem.remove = function(test)
 end
 
 
+-- love.filesystem.setBytecodeCacheEnabled
+love.test.filesystem.setBytecodeCacheEnabled = function(test)
+  test:assertFalse(love.filesystem.isBytecodeCacheEnabled(), 'check default')
+  love.filesystem.setBytecodeCacheEnabled(true)
+  test:assertTrue(love.filesystem.isBytecodeCacheEnabled(), 'check enabled')
+  -- check required modules are cached and still run correctly
+  love.filesystem.write('bytecodetest.lua', 'return 1 + 1')
+  package.loaded['bytecodetest'] = nil
+  test:assertEquals(2, require('bytecodetest'), 'check compiled')
+  local cached = love.filesystem.getDirectoryItems('.bytecodecache')
+  test:assertGreaterEqual(1, #cached, 'check bytecode cached')
+  package.loaded['bytecodetest'] = nil
+  test:assertEquals(2, require('bytecodetest'), 'check cached bytecode')
+  -- check changed sources are recompiled
+  love.filesystem.write('bytecodetest.lua', 'return 3')
+  package.loaded['bytecodetest'] = nil
+  test:assertEquals(3, require('bytecodetest'), 'check recompiled')
+  -- cleanup
+  package.loaded['bytecodetest'] = nil
+  love.filesystem.setBytecodeCacheEnabled(false)
+  love.filesystem.remove('bytecodetest.lua')
+  for _, item in ipairs(love.filesystem.getDirectoryItems('.bytecodecache')) do
+    love.filesystem.remove('.bytecodecache/' .. item)
+  end
+  love.filesystem.remove('.bytecodecache')
+end
+
+
 -- love.filesystem.setCRequirePath
 love.test.filesystem.setCRequirePath = function(test)
   -- check setting path val is returned
@@ -526,6 +650,22 @@ love.test.filesystem.setRequirePath = function(test)
   -- check setting path val is returned
   love.filesystem.setRequirePath('?.lua;?/start.lua')
   test:assertEquals('?.lua;?/start.lua', love.filesystem.getRequirePath(), 'check require path')
+  -- check modules resolve using the new path, even if required before
+  love.filesystem.createDirectory('requirepathtest')
+  love.filesystem.write('requirepathtest.lua', 'return "file"')
+  love.filesystem.write('requirepathtest/start.lua', 'return "start"')
+  package.loaded['requirepathtest'] = nil
+  test:assertEquals('file', require('requirepathtest'), 'check first path')
+  love.filesystem.setRequirePath('?/start.lua')
+  package.loaded['requirepathtest'] = nil
+  test:assertEquals('start', require('requirepathtest'), 'check changed path')
+  -- check removed files are no longer found
+  love.filesystem.remove('requirepathtest/start.lua')
+  love.filesystem.remove('requirepathtest')
+  package.loaded['requirepathtest'] = nil
+  test:assertFalse(pcall(require, 'requirepathtest'), 'check removed module')
+  love.filesystem.remove('requirepathtest.lua')
+  package.loaded['requirepathtest'] = nil
   -- reset to default
   love.filesystem.setRequirePath('?.lua;?/init.lua')
 end
@@ -68,6 +68,75 @@ love.test.graphics.Buffer = function(test)
   local indexbuffer = love.graphics.newBuffer('uint16', 128, {index=true})
   test:assertTrue(indexbuffer:isBufferType('index'), 'check is index buffer')
 
+  -- check uploading bytes straight from a Data (the second vertex's position)
+  local bytes = love.data.newByteData(love.data.pack('string', 'ffff', 5, 6, 7, 8))
+  vertexbuffer2:setData(bytes, 20, 0, 8)
+  local readback = love.graphics.readbackBuffer(vertexbuffer2, 20, 8)
+  test:assertEquals(5, readback:getFloat(0), 'check set data x')
+  test:assertEquals(6, readback:getFloat(4), 'check set data y')
+  local ok = pcall(vertexbuffer2.setData, vertexbuffer2, bytes, 80)
+  test:assertFalse(ok, 'check set data out of range')
+
+  -- check mapping a range of the buffer as a Data
+  test:assertFalse(vertexbuffer2:isMapped(), 'check buffer not mapped')
+  local mapping = vertexbuffer2:map(40, 20)
+  test:assertTrue(mapping:typeOf('Data'), 'check mapping is Data')
+  test:assertEquals(20, mapping:getSize(), 'check mapping size')
+  test:assertTrue(vertexbuffer2:isMapped(), 'check buffer mapped')
+  ok = pcall(vertexbuffer2.map, vertexbuffer2)
+  test:assertFalse(ok, 'check map while mapped')
+  ok = pcall(vertexbuffer2.setData, vertexbuffer2, bytes)
+  test:assertFalse(ok, 'check set data while mapped')
+  local hasffi, ffi = pcall(require, 'ffi')
+  if hasffi then
+    local floats = ffi.cast('float *', mapping:getFFIPointer())
+    floats[0], floats[1], floats[2], floats[3], floats[4] = 11, 12, 0.5, 0.5, 0
+  end
+  vertexbuffer2:unmap()
+  test:assertFalse(vertexbuffer2:isMapped(), 'check buffer unmapped')
+  test:assertEquals(0, mapping:getSize(), 'check mapping empty after unmap')
+  if hasffi then
+    readback = love.graphics.readbackBuffer(vertexbuffer2, 40, 8)
+    test:assertEquals(11, readback:getFloat(0), 'check mapped write x')
+    test:assertEquals(12, readback:getFloat(4), 'check mapped write y')
+  end
+
+  -- check a mapping can be sent to a thread and back, and that the thread
+  -- dropping the last reference leaves the buffer mapped until it's unmapped
+  local tothread = love.thread.newChannel()
+  local fromthread = love.thread.newChannel()
+  local thread = love.thread.newThread([[
+    local tothread, fromthread = ...
+    local mapping = tothread:demand()
+    fromthread:push(mapping)
+    tothread:demand()
+    mapping = nil
+    collectgarbage()
+    collectgarbage()
+  ]])
+  thread:start(tothread, fromthread)
+  mapping = vertexbuffer2:map(40, 8)
+  tothread:push(mapping)
+  mapping:release()
+  mapping = fromthread:demand()
+  test:assertEquals(8, mapping:getSize(), 'check mapping sent back from thread')
+  if hasffi then
+    local floats = ffi.cast('float *', mapping:getFFIPointer())
+    floats[0], floats[1] = 21, 22
+  end
+  mapping:release()
+  tothread:push('drop')
+  thread:wait()
+  test:assertEquals(nil, thread:getError(), 'check thread had no error')
+  test:assertTrue(vertexbuffer2:isMapped(), 'check buffer still mapped after thread')
+  vertexbuffer2:unmap()
+  test:assertFalse(vertexbuffer2:isMapped(), 'check buffer unmapped on main thread')
+  if hasffi then
+    readback = love.graphics.readbackBuffer(vertexbuffer2, 40, 8)
+    test:assertEquals(21, readback:getFloat(0), 'check write through returned mapping x')
+    test:assertEquals(22, readback:getFloat(4), 'check write through returned mapping y')
+  end
+
 end
 
 
@@ -555,6 +624,46 @@ love.test.graphics.Mesh = function(test)
   mesh1:detachAttribute('VertexPosition')
   test:assertTrue(mesh1:isAttributeEnabled('VertexPosition'), 'check cant detach def attribute')
 
+  -- check skinning from bone index and weight attributes
+  local mesh3 = love.graphics.newMesh({
+    { name = 'VertexPosition', format = 'floatvec2' },
+    { name = 'VertexBones', format = 'uint8vec4' },
+    { name = 'VertexWeights', format = 'floatvec4' },
+  }, {
+    { 10, 20, 0, 0, 0, 0, 1, 0, 0, 0 },
+    { 30, 40, 0, 1, 0, 0, 0.5, 0.5, 0, 0 },
+    { 50, 60, 2, 0, 0, 0, 0.25, 0, 0, 0 },
+  }, 'triangles')
+  test:assertEquals(nil, mesh3:getSkinning(), 'check no skinning by def')
+  mesh3:setSkinning('VertexBones', 'VertexWeights')
+  local sbones, sweights, spos = mesh3:getSkinning()
+  test:assertEquals('VertexBones', sbones, 'check skinning bones attribute')
+  test:assertEquals('VertexWeights', sweights, 'check skinning weights attribute')
+  test:assertEquals('VertexPosition', spos, 'check skinning position attribute')
+  test:assertEquals(3, mesh3:getSkinningBoneCount(), 'check skinning bone count')
+  local bones = {
+    love.math.newTransform(100, 0),
+    love.math.newTransform(0, 100),
+    love.math.newTransform(0, 0, 0, 2, 2),
+  }
+  mesh3:skin(bones)
+  local sx1, sy1 = mesh3:getVertexAttribute(1, 1)
+  local sx2, sy2 = mesh3:getVertexAttribute(2, 1)
+  local sx3, sy3 = mesh3:getVertexAttribute(3, 1)
+  test:assertCoords({110, 20}, {sx1, sy1}, 'check skinned single bone')
+  test:assertCoords({80, 90}, {sx2, sy2}, 'check skinned blended bones')
+  test:assertCoords({25, 30}, {sx3, sy3}, 'check skinned partial weight')
+  -- skinning again starts from the rest pose, and accepts packed matrices
+  mesh3:skin(love.math.composeTransforms(bones, { 0, 0, 0 }))
+  sx1, sy1 = mesh3:getVertexAttribute(1, 1)
+  test:assertCoords({110, 20}, {sx1, sy1}, 'check skinned from rest pose')
+  local ok = pcall(mesh3.skin, mesh3, { bones[1] })
+  test:assertFalse(ok, 'check too few bones')
+  mesh3:setSkinning()
+  test:assertEquals(nil, mesh3:getSkinning(), 'check skinning removed')
+  ok = pcall(mesh3.skin, mesh3, bones)
+  test:assertFalse(ok, 'check skin without skinning')
+
 end
 
 
@@ -1329,6 +1438,34 @@ love.test.graphics.clear = function(test)
 end
 
 
+-- love.graphics.curves
+love.test.graphics.curves = function(test)
+  local curves = {
+    love.math.newBezierCurve(0, 8, 5, 8, 11, 8, 16, 8),
+    love.math.newBezierCurve(0, 0, 16, 0, 16, 16),
+    love.math.newBezierCurve(0, 16, 8, 0, 16, 16)
+  }
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.flushBatch()
+  local initial = love.graphics.getStats()['drawcalls']
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.setLineWidth(2)
+    love.graphics.curves(curves)
+    love.graphics.flushBatch()
+    love.graphics.setLineWidth(1)
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  local after = love.graphics.getStats()['drawcalls']
+  test:assertEquals(initial+1, after, 'check all curves in one draw')
+  local imgdata = love.graphics.readbackTexture(canvas)
+  local r, g, b = imgdata:getPixel(2, 8)
+  test:assertEquals(1, r, 'check straight curve drawn')
+  test:assertEquals(0, g, 'check straight curve color')
+end
+
+
 -- love.graphics.discard
 love.test.graphics.discard = function(test)
   -- from the docs: "on some desktops this may do nothing"
@@ -1358,6 +1495,10 @@ love.test.graphics.draw = function(test)
   love.graphics.setCanvas()
   local imgdata = love.graphics.readbackTexture(canvas2)
   test:compareImg(imgdata)
+  -- userdata which isn't a drawable love object must error, not be drawn
+  test:assertFalse(pcall(love.graphics.draw, io.stdout), 'check file handle errors')
+  test:assertFalse(pcall(love.graphics.draw, io.stdout, 0, 0), 'check file handle with position errors')
+  test:assertFalse(pcall(love.graphics.draw, transform, 0, 0), 'check non-drawable object errors')
 end
 
 
@@ -1482,6 +1623,50 @@ love.test.graphics.polygon = function(test)
   love.graphics.setCanvas()
   local imgdata = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata)
+  -- holes, with a same-winding hole staying filled under the nonzero rule
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.polygon("fill", {1, 1, 7, 1, 7, 15, 1, 15}, {{3, 4, 5, 4, 5, 12, 3, 12}})
+    love.graphics.setColor(0, 1, 0, 1)
+    love.graphics.polygon("fill", {9, 1, 15, 1, 15, 15, 9, 15}, {{11, 4, 13, 4, 13, 12, 11, 12}}, "nonzero")
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  imgdata = love.graphics.readbackTexture(canvas)
+  test:compareImg(imgdata)
+  -- a pentagram turns the same way at every corner but crosses itself, so
+  -- its center is only filled under the nonzero rule
+  local star = {8, 1.2, 11.8, 13, 1.8, 5.7, 14.2, 5.7, 4.2, 13}
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.polygon("fill", star)
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  imgdata = love.graphics.readbackTexture(canvas)
+  test:compareImg(imgdata)
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.polygon("fill", star, nil, "nonzero")
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  imgdata = love.graphics.readbackTexture(canvas)
+  test:assertEquals(1, imgdata:getPixel(7, 7), 'check nonzero star center filled')
+  -- outlines closed by repeating the first vertex fill the same as open ones
+  local hexagon = {8, 1, 14, 4.5, 14, 11.5, 8, 15, 2, 11.5, 2, 4.5}
+  local closed = {8, 1, 14, 4.5, 14, 11.5, 8, 15, 2, 11.5, 2, 4.5, 8, 1}
+  local results = {}
+  for _, outline in ipairs({ hexagon, closed }) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 1)
+      love.graphics.setColor(1, 0, 0, 1)
+      love.graphics.polygon("fill", outline)
+      love.graphics.setColor(1, 1, 1, 1)
+    love.graphics.setCanvas()
+    results[#results+1] = love.graphics.readbackTexture(canvas):getString()
+  end
+  test:assertEquals(results[1], results[2], 'check closed outline')
 end
 
 
@@ -2799,6 +2984,49 @@ love.test.graphics.getStats = function(test)
 end
 
 
+-- love.graphics.getRecordingStats
+love.test.graphics.getRecordingStats = function(test)
+  local stats = love.graphics.getRecordingStats()
+  -- only the 'none' renderer records its commands
+  if love.graphics.getRendererInfo() ~= 'None' then
+    test:assertEquals(nil, stats, 'check nil for non-recording renderers')
+    return
+  end
+  local stattypes = {
+    'frame', 'commands', 'drawcalls', 'batches', 'statechanges',
+    'vertices', 'indices', 'uploadbytes'
+  }
+  for s=1,#stattypes do
+    test:assertNotEquals(nil, stats[stattypes[s] ], 'expected a key for stat: ' .. stattypes[s])
+  end
+  test:assertRange(stats.batches, 0, stats.drawcalls, 'check batches are draw calls')
+  -- 4 rectangles split into 3 batches by 4 state changes
+  local function frame()
+    love.graphics.rectangle('fill', 0, 0, 10, 10)
+    love.graphics.rectangle('fill', 10, 0, 10, 10)
+    love.graphics.setScissor(0, 0, 5, 5)
+    love.graphics.rectangle('fill', 0, 10, 10, 10)
+    love.graphics.setScissor()
+    love.graphics.setBlendMode('add')
+    love.graphics.rectangle('fill', 10, 10, 10, 10)
+    love.graphics.setBlendMode('alpha')
+    love.graphics.present()
+  end
+  love.graphics.setCanvas()
+  love.graphics.reset()
+  love.graphics.present()
+  -- the first frame may also bind the default shader, so measure the second
+  frame()
+  local first = love.graphics.getRecordingStats()
+  frame()
+  stats = love.graphics.getRecordingStats()
+  test:assertEquals(first.frame + 1, stats.frame, 'check frame number')
+  test:assertEquals(3, stats.drawcalls, 'check draw calls')
+  test:assertEquals(3, stats.batches, 'check batched draw calls')
+  test:assertEquals(4, stats.statechanges, 'check state changes')
+end
+
+
 -- love.graphics.getSupported
 love.test.graphics.getSupported = function(test)
   -- cant check values as hardware dependent but we can check the keys in the 
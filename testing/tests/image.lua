@@ -40,6 +40,36 @@ love.test.image.CompressedImageData = function(test)
 end
 
 
+-- DecodeRequest (love.image.newImageDataAsync)
+love.test.image.DecodeRequest = function(test)
+
+  -- create new obj from a filename
+  local request = love.image.newImageDataAsync('resources/love.png')
+  test:assertObject(request)
+  test:assertTrue(request:wait(5), 'check wait')
+  test:assertTrue(request:isComplete(), 'check complete')
+  test:assertEquals('done', request:getStatus(), 'check status')
+  test:assertEquals(nil, request:getError(), 'check no error')
+  test:assertFalse(request:cancel(), 'check cancel after completion')
+
+  -- check decoded data matches a synchronous decode
+  local expected = love.image.newImageData('resources/love.png')
+  local idata = request:getImageData()
+  test:assertObject(idata)
+  test:assertEquals(expected:getWidth(), idata:getWidth(), 'check width')
+  test:assertEquals(expected:getHeight(), idata:getHeight(), 'check height')
+  test:assertEquals(expected:getString(), idata:getString(), 'check pixels')
+
+  -- check invalid data reports an error instead of throwing
+  local invalid = love.image.newImageDataAsync(love.data.newByteData('notanimage'))
+  test:assertTrue(invalid:wait(), 'check invalid wait')
+  test:assertEquals('error', invalid:getStatus(), 'check error status')
+  test:assertEquals(nil, invalid:getImageData(), 'check no image data')
+  test:assertNotEquals(nil, invalid:getError(), 'check error message')
+
+end
+
+
 -- ImageData (love.image.newImageData)
 love.test.image.ImageData = function(test)
 
@@ -89,6 +119,23 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read1)
   love.filesystem.remove('test-encode.png')
 
+  -- check png encode options all round-trip to the same pixels
+  local big = love.image.newImageData(512, 512)
+  big:mapPixel(function(x, y) return x / 512, y / 512, (x * y) % 7 / 7, 1 end)
+  local options = {
+    { level = 0 }, { level = 1, filter = 'none' }, { level = 9, filter = 'paeth' },
+    { filter = 'sub' }, { filter = 'up' }, { filter = 'average' },
+    { parallel = true }, { level = 1, parallel = true, filter = 'adaptive' }
+  }
+  for i, opts in ipairs(options) do
+    local encoded = big:encode('png', opts)
+    local decoded = love.image.newImageData(encoded)
+    test:assertEquals(big:getString(), decoded:getString(), 'check encode options ' .. i)
+  end
+  test:assertGreaterEqual(big:encode('png', { level = 9 }):getSize(),
+    big:encode('png', { level = 0 }):getSize(), 'check store is larger')
+  big:release()
+
   -- check encoding to an image (exr)
   local edata = love.image.newImageData(100, 100, 'r16f')
   edata:encode('exr', 'test-encode.exr')
@@ -96,6 +143,58 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read2)
   love.filesystem.remove('test-encode.exr')
 
+  -- check format conversion keeps pixels
+  local converted = idata2:convert('rgba32f')
+  test:assertEquals('rgba32f', converted:getFormat(), 'check converted format')
+  local back = converted:convert('rgba8')
+  test:assertEquals(idata2:getString(), back:getString(), 'check convert round trip')
+
+  -- check premultiply / unpremultiply
+  local pm = love.image.newImageData(4, 1, 'rgba32f')
+  pm:setPixel(0, 0, 1, 0.5, 0.25, 0.5)
+  pm:premultiplyAlpha()
+  local pr, pg, pb, pa = pm:getPixel(0, 0)
+  test:assertEquals(0.5, pr, 'check premultiplied r')
+  test:assertEquals(0.125, pb, 'check premultiplied b')
+  pm:unpremultiplyAlpha()
+  pr, pg, pb, pa = pm:getPixel(0, 0)
+  test:assertEquals(1, pr, 'check unpremultiplied r')
+  test:assertEquals(0.5, pa, 'check unpremultiplied a')
+
+  -- check resizing
+  local quad = love.image.newImageData(2, 2, 'rgba32f')
+  quad:setPixel(0, 0, 1, 0, 0, 1)
+  quad:setPixel(1, 1, 1, 0, 0, 1)
+  local avg = quad:resize(1, 1, 'box')
+  local ar, ag, ab, aa = avg:getPixel(0, 0)
+  test:assertEquals(0.5, ar, 'check box average r')
+  test:assertEquals(0.5, aa, 'check box average a')
+  for _, filter in ipairs({ 'box', 'bilinear', 'lanczos' }) do
+    local resized = idata:resize(100, 30, filter)
+    test:assertEquals(100, resized:getWidth(), 'check resized w ' .. filter)
+    test:assertEquals(30, resized:getHeight(), 'check resized h ' .. filter)
+  end
+
+  -- check mipmap generation
+  local mipmaps = idata:generateMipmaps()
+  test:assertEquals(6, #mipmaps, 'check mipmap count')
+  test:assertEquals(32, mipmaps[1]:getWidth(), 'check first mipmap')
+  test:assertEquals(1, mipmaps[6]:getWidth(), 'check last mipmap')
+
+  -- check blended paste
+  local dst = love.image.newImageData(4, 4, 'rgba32f')
+  dst:mapPixel(function() return 0, 0, 1, 1 end)
+  local src = love.image.newImageData(4, 4, 'rgba32f')
+  src:mapPixel(function() return 1, 0, 0, 0.5 end)
+  dst:paste(src, 0, 0, 0, 0, 4, 4, 'alpha')
+  local br, bg, bb, ba = dst:getPixel(1, 1)
+  test:assertEquals(0.5, br, 'check alpha blend r')
+  test:assertEquals(0.5, bb, 'check alpha blend b')
+  test:assertEquals(1, ba, 'check alpha blend a')
+  dst:paste(src, 0, 0, 0, 0, 4, 4, 'add')
+  br, bg, bb, ba = dst:getPixel(1, 1)
+  test:assertEquals(1, br, 'check add blend r')
+
   -- check linear
   test:assertFalse(idata:isLinear(), 'check not linear')
   idata:setLinear(true)
@@ -111,6 +210,81 @@ end
 --------------------------------------------------------------------------------
 
 
+-- love.image.compress
+love.test.image.compress = function(test)
+  local idata = love.image.newImageData('resources/love.png')
+  local formats = { 'DXT1', 'DXT5', 'BC7', 'ETC2rgb', 'ETC2rgba' }
+  for _, format in ipairs(formats) do
+    local cdata = love.image.compress(idata, format, 'fast')
+    test:assertObject(cdata)
+    test:assertEquals(format, cdata:getFormat(), 'check format ' .. format)
+    test:assertEquals(idata:getWidth(), cdata:getWidth(), 'check width ' .. format)
+    test:assertEquals(7, cdata:getMipmapCount(), 'check mipmaps ' .. format)
+    test:assertEquals(1, cdata:getWidth(7), 'check last mipmap ' .. format)
+  end
+  local single = love.image.compress(idata, 'DXT1', nil, { mipmaps = false })
+  test:assertEquals(1, single:getMipmapCount(), 'check no mipmaps')
+  -- decode a DXT1 block and compare it against the source pixels
+  local block = love.image.newImageData(4, 4)
+  block:mapPixel(function(x, y) return x / 3, 0.5, 1 - x / 3, 1 end)
+  local dxt1 = love.image.compress(block, 'DXT1', 'normal', { mipmaps = false })
+  local c0, c1, indices = love.data.unpack('<I2I2I4', dxt1:getString())
+  local function rgb565(c)
+    return { math.floor(c / 2048) / 31, math.floor(c / 32) % 64 / 63, c % 32 / 31 }
+  end
+  local p0, p1 = rgb565(c0), rgb565(c1)
+  local palette = { p0, p1, {}, { 0, 0, 0 } }
+  for i=1,3 do
+    if c0 > c1 then
+      palette[3][i] = (2 * p0[i] + p1[i]) / 3
+      palette[4][i] = (p0[i] + 2 * p1[i]) / 3
+    else
+      palette[3][i] = (p0[i] + p1[i]) / 2
+    end
+  end
+  for y=0,3 do
+    for x=0,3 do
+      local color = palette[math.floor(indices / 4^(y * 4 + x)) % 4 + 1]
+      local r, g, b = block:getPixel(x, y)
+      test:assertRange(color[1] - r, -0.02, 0.02, 'check decoded r ' .. x .. ',' .. y)
+      test:assertRange(color[2] - g, -0.02, 0.02, 'check decoded g ' .. x .. ',' .. y)
+      test:assertRange(color[3] - b, -0.02, 0.02, 'check decoded b ' .. x .. ',' .. y)
+    end
+  end
+  -- results are only cached in the save directory when asked for
+  test:assertEquals(nil, love.filesystem.getInfo('.texturecache'), 'check no cache by default')
+  local first = love.image.compress(idata, 'BC7', nil, { cache = true })
+  local second = love.image.compress(idata, 'BC7', nil, { cache = true })
+  test:assertEquals(first:getString(), second:getString(), 'check cached result')
+  test:assertEquals(1, #love.filesystem.getDirectoryItems('.texturecache'), 'check cache file')
+  for _, file in ipairs(love.filesystem.getDirectoryItems('.texturecache')) do
+    love.filesystem.remove('.texturecache/' .. file)
+  end
+  love.filesystem.remove('.texturecache')
+  test:assertFalse(pcall(love.image.compress, idata, 'rgba8'), 'check uncompressed format errors')
+  test:assertFalse(pcall(love.image.compress, idata, 'DXT1', 'slowest'), 'check invalid quality errors')
+end
+
+
+-- love.image.decodeMany
+love.test.image.decodeMany = function(test)
+  local files = { 'resources/love.png', 'resources/love2.png', 'resources/font.bmp' }
+  local sources = { files[1], love.filesystem.newFileData(files[2]), files[3] }
+  local idatas = love.image.decodeMany(sources)
+  test:assertEquals(#files, #idatas, 'check count')
+  for i, file in ipairs(files) do
+    local expected = love.image.newImageData(file)
+    test:assertEquals(expected:getString(), idatas[i]:getString(), 'check pixels ' .. i)
+  end
+  test:assertEquals(0, #love.image.decodeMany({}), 'check empty list')
+  local ok = pcall(love.image.decodeMany, { files[1], 'resources/missing.png' })
+  test:assertFalse(ok, 'check missing file errors')
+  test:assertFalse(pcall(love.image.decodeMany, { files[1], true }), 'check invalid source errors')
+  -- earlier errors must not leave anything behind to break later calls
+  test:assertEquals(1, #love.image.decodeMany({ files[1] }), 'check decode after error')
+end
+
+
 -- love.image.isCompressed
 -- @NOTE really we need to test each of the files listed here:
 -- https://love2d.org/wiki/CompressedImageFormat
@@ -134,3 +308,11 @@ love.test.image.newImageData = function(test)
   test:assertObject(love.image.newImageData('resources/love.png'))
   test:assertObject(love.image.newImageData(16, 16, 'rgba8', nil))
 end
+
+
+-- love.image.newImageDataAsync
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.image.newImageDataAsync = function(test)
+  test:assertObject(love.image.newImageDataAsync('resources/love.png'))
+  test:assertObject(love.image.newImageDataAsync(love.filesystem.newFileData('resources/love.png')))
+end
@@ -60,6 +60,16 @@ love.test.math.BezierCurve = function(test)
   test:assertEquals(196, #coords1, 'check coords')
   test:assertEquals(20, #coords2, 'check segment coords')
 
+  -- check adaptive rendering keeps the end points and splits less than the
+  -- uniform subdivision for the same curve
+  local coords3 = curve:renderAdaptive(0.1)
+  test:assertCoords({1, 1}, {coords3[1], coords3[2]}, 'check adaptive start')
+  test:assertCoords({3, 1}, {coords3[#coords3-1], coords3[#coords3]}, 'check adaptive end')
+  test:assertGreaterEqual(6, #coords3, 'check adaptive coords')
+  test:assertLessEqual(#coords1, #coords3, 'check adaptive coords less than uniform')
+  local straight = love.math.newBezierCurve(0, 0, 5, 5, 10, 10)
+  test:assertEquals(4, #straight:renderAdaptive(0.1), 'check straight curve is one segment')
+
   -- check translation values
   px, py = curve:getControlPoint(2)
   test:assertCoords({3, 2}, {px, py}, 'check pretransform x/y')
@@ -104,6 +114,60 @@ love.test.math.RandomGenerator = function(test)
   test:assertNotEquals(rng1:random(), rng2:random(), 'check not matching states')
   test:assertNotEquals(rng1:randomNormal(), rng2:randomNormal(), 'check not matching states')
 
+  -- check bulk fill gives the same sequence as single calls
+  local rng3 = love.math.newRandomGenerator(1234)
+  local rng4 = rng3:clone()
+  local data = love.data.newByteData(100 * 8)
+  rng3:fill(data, 'uniform', { type = 'double', min = -1, max = 3 })
+  for i=0,99 do
+    test:assertEquals(rng4:random() * 4 - 1, data:getDouble(i * 8), 'check fill ' .. i)
+  end
+  test:assertEquals(rng3:random(), rng4:random(), 'check fill advances state')
+  local ints = love.data.newByteData(100 * 4)
+  rng3:fill(ints, 'integer', { min = 1, max = 6 })
+  for i=0,99 do
+    test:assertEquals(rng4:random(1, 6), ints:getInt32(i * 4), 'check integer fill ' .. i)
+  end
+
+  -- check jumping ahead lets disjoint ranges be filled separately
+  local whole = love.data.newByteData(64 * 4)
+  local parts = love.data.newByteData(64 * 4)
+  local rng5 = love.math.newRandomGenerator(99)
+  local rng6 = rng5:clone()
+  local rng7 = rng5:clone()
+  rng5:fill(whole, 'normal', { mean = 2, stddev = 3 })
+  rng6:fill(parts, 'normal', { mean = 2, stddev = 3, count = 20 })
+  rng7:jump(20 * 2)
+  rng7:fill(parts, 'normal', { mean = 2, stddev = 3, offset = 20 * 4 })
+  test:assertEquals(whole:getString(), parts:getString(), 'check split fill matches')
+  test:assertEquals(rng5:random(), rng7:random(), 'check split fill state')
+
+  -- check buffers only get the requested range
+  local rng8 = love.math.newRandomGenerator(7)
+  local rng9 = rng8:clone()
+  local buffer = love.graphics.newBuffer({{ name = 'value', format = 'float' }}, 8, { vertex = true })
+  buffer:setArrayData(love.data.newByteData(love.data.pack('string', 'ffffffff', 7, 7, 7, 7, 7, 7, 7, 7)))
+  rng8:fill(buffer, 'uniform', { offset = 2 * 4, count = 2 })
+  local readback = love.graphics.readbackBuffer(buffer, 0, 32)
+  test:assertEquals(7, readback:getFloat(4), 'check buffer kept before range')
+  test:assertRange(readback:getFloat(8) - rng9:random(), -0.000001, 0.000001, 'check buffer fill 1')
+  test:assertRange(readback:getFloat(12) - rng9:random(), -0.000001, 0.000001, 'check buffer fill 2')
+  test:assertEquals(7, readback:getFloat(16), 'check buffer kept after range')
+  test:assertFalse(buffer:isMapped(), 'check buffer unmapped')
+
+  -- check float values stay below max when it's one float step above min,
+  -- and where float steps are much coarser than the double results
+  local floats = love.data.newByteData(1000 * 4)
+  for _, range in ipairs({ { 1, 1 + 2^-23 }, { 2^26 - 64, 2^26 } }) do
+    rng3:fill(floats, 'uniform', { min = range[1], max = range[2] })
+    local inrange = true
+    for i=0,999 do
+      local value = floats:getFloat(i * 4)
+      inrange = inrange and value >= range[1] and value < range[2]
+    end
+    test:assertTrue(inrange, 'check float fill below max ' .. range[2])
+  end
+
 end
 
 
@@ -164,6 +228,35 @@ love.test.math.Transform = function(test)
   transform:setMatrix(1, 3, 4, 5.5, 1, 4.5, 2, 1, 3.4, 5.1, 4.1, 13, 1, 1, 2, 3)
   test:assertFalse(transform:isAffine2DTransform(), 'check not affine')
 
+  -- check methods return the transform and still validate their arguments
+  transform:reset()
+  test:assertEquals(transform, transform:translate(1, 2):scale(2), 'check chaining')
+  px, py = transform:transformPoint(1, 1)
+  test:assertCoords({3, 4}, {px, py}, 'check chained transformation')
+  local ok = pcall(transform.translate, transform, 'a', 1)
+  test:assertFalse(ok, 'check translate invalid argument')
+  ok = pcall(transform.transformPoint, nil, 1, 1)
+  test:assertFalse(ok, 'check transformPoint without transform')
+
+  -- check transforming points in a Data in place
+  transform:reset()
+  transform:translate(10, 8):rotate(0.5):scale(2, 3)
+  local coords = { 1, 2, -3, 4, 5, -6 }
+  local points = love.data.newByteData(love.data.pack('string', 'ffffff', unpack(coords)))
+  transform:transformPoints(points)
+  for i=1,#coords,2 do
+    px, py = transform:transformPoint(coords[i], coords[i+1])
+    test:assertCoords({px, py}, {points:getFloat((i-1)*4), points:getFloat(i*4)}, 'check transformPoints ' .. i)
+  end
+  -- only the second point, selected by byte offset and count
+  transform:inverseTransformPoints(points, 8, 1)
+  px, py = transform:transformPoint(coords[1], coords[2])
+  test:assertCoords({px, py}, {points:getFloat(0), points:getFloat(4)}, 'check inverseTransformPoints range')
+  test:assertRange(points:getFloat(8), -3.001, -2.999, 'check inverseTransformPoints x')
+  test:assertRange(points:getFloat(12), 3.999, 4.001, 'check inverseTransformPoints y')
+  ok = pcall(transform.transformPoints, transform, points, 8, 3)
+  test:assertFalse(ok, 'check transformPoints count out of range')
+
 end
 
 
@@ -220,6 +313,130 @@ love.test.math.colorToBytes = function(test)
 end
 
 
+-- love.math.composeTransforms
+love.test.math.composeTransforms = function(test)
+  -- two roots, one with a child and grandchild
+  local locals = {
+    love.math.newTransform(10, 0),
+    love.math.newTransform(0, 5, math.pi / 2),
+    love.math.newTransform(2, 0, 0, 3, 3),
+    love.math.newTransform(-1, -1),
+  }
+  local worlds = love.math.composeTransforms(locals, { 0, 1, 2, 0 })
+  test:assertEquals(4 * 64, worlds:getSize(), 'check world matrix data size')
+  local expected = { locals[1], locals[1] * locals[2], locals[1] * locals[2] * locals[3], locals[4] }
+  for i=1,#expected do
+    local m = { expected[i]:getMatrix() }
+    for row=1,4 do
+      for col=1,4 do
+        -- world matrices are stored column-major
+        local actual = worlds:getFloat(((i - 1) * 16 + (col - 1) * 4 + row - 1) * 4)
+        local value = m[(row - 1) * 4 + col]
+        test:assertRange(actual, value - 0.0001, value + 0.0001, 'check world ' .. i .. ' ' .. row .. ',' .. col)
+      end
+    end
+  end
+  -- matrices and parent indices in Data, composed in place
+  local elements = {}
+  for i=1,#locals do
+    local m = { locals[i]:getMatrix() }
+    for col=1,4 do
+      for row=1,4 do
+        table.insert(elements, m[(row - 1) * 4 + col])
+      end
+    end
+  end
+  local data = love.data.newByteData(love.data.pack('string', string.rep('f', #elements), unpack(elements)))
+  local parents = love.data.newByteData(love.data.pack('string', 'i4i4i4i4', 0, 1, 2, 0))
+  test:assertEquals(data, love.math.composeTransforms(data, parents, data), 'check destination is returned')
+  test:assertEquals(worlds:getString(), data:getString(), 'check in place composition')
+  -- buffers get the world matrices at the start and keep the rest
+  local buffer = love.graphics.newBuffer({{ name = 'value', format = 'float' }}, 6 * 16, { vertex = true })
+  buffer:setArrayData(love.data.newByteData(string.rep('\0', 6 * 64)))
+  test:assertEquals(buffer, love.math.composeTransforms(locals, { 0, 1, 2, 0 }, buffer), 'check buffer is returned')
+  local readback = love.graphics.readbackBuffer(buffer, 0, 6 * 64)
+  test:assertEquals(worlds:getString(), readback:getString(0, 4 * 64), 'check buffer world matrices')
+  test:assertEquals(string.rep('\0', 2 * 64), readback:getString(4 * 64), 'check buffer kept after matrices')
+  test:assertFalse(buffer:isMapped(), 'check buffer unmapped')
+  test:assertEquals(buffer, love.math.composeTransforms({}, {}, buffer), 'check empty buffer composition')
+  -- errors leave the buffer unmapped
+  local small = love.graphics.newBuffer({{ name = 'value', format = 'float' }}, 3 * 16, { vertex = true })
+  test:assertFalse(pcall(love.math.composeTransforms, locals, { 0, 1, 2, 0 }, small), 'check buffer too small')
+  test:assertFalse(small:isMapped(), 'check small buffer unmapped')
+  test:assertFalse(pcall(love.math.composeTransforms, locals, { 0, 3, 0, 0 }, buffer), 'check buffer parent after child')
+  test:assertFalse(buffer:isMapped(), 'check buffer unmapped after error')
+  -- parents have to come before their children
+  local ok = pcall(love.math.composeTransforms, locals, { 0, 3, 0, 0 })
+  test:assertFalse(ok, 'check parent after child')
+  ok = pcall(love.math.composeTransforms, locals, { 0, 1 })
+  test:assertFalse(ok, 'check missing parents')
+end
+
+
+-- love.math.fillNoise
+love.test.math.fillNoise = function(test)
+  -- a single octave grid should match the scalar noise functions
+  local data = love.data.newByteData(16 * 8 * 4)
+  love.math.fillNoise(data, { width = 16, height = 8, x = -3, y = 5, frequency = 0.37 })
+  for y=0,7 do
+    for x=0,15 do
+      local expected = love.math.simplexNoise((x - 3) * 0.37, (y + 5) * 0.37)
+      local actual = data:getFloat((y * 16 + x) * 4)
+      test:assertRange(actual, expected - 0.0001, expected + 0.0001, 'check simplex grid ' .. x .. ',' .. y)
+    end
+  end
+  -- perlin noise at a list of points, with a z slice
+  local points = { 0.25, 0.5, -10.5, 3.75, 100.125, -42 }
+  love.math.fillNoise(data, { type = 'perlin', points = points, z = 2.5 })
+  for i=1,#points,2 do
+    local expected = love.math.perlinNoise(points[i], points[i+1], 2.5)
+    local actual = data:getFloat((i - 1) * 2)
+    test:assertRange(actual, expected - 0.0001, expected + 0.0001, 'check perlin point ' .. i)
+  end
+  -- octaves are weighted by gain and normalized by the total amplitude
+  love.math.fillNoise(data, { points = { 1.5, 2.5 }, octaves = 2, lacunarity = 3, gain = 0.25 })
+  local n1 = love.math.simplexNoise(1.5, 2.5) * 2 - 1
+  local n2 = love.math.simplexNoise(4.5, 7.5) * 2 - 1
+  local expected = (n1 + 0.25 * n2) / 1.25 * 0.5 + 0.5
+  test:assertRange(data:getFloat(0), expected - 0.0001, expected + 0.0001, 'check octaves')
+  -- buffers only get the written values, the rest keeps its contents
+  local buffer = love.graphics.newBuffer({{ name = 'value', format = 'float' }}, 8, { vertex = true })
+  buffer:setArrayData(love.data.newByteData(love.data.pack('string', 'ffffffff', 7, 7, 7, 7, 7, 7, 7, 7)))
+  love.math.fillNoise(buffer, { points = { 1.5, 2.5 } })
+  local readback = love.graphics.readbackBuffer(buffer, 0, 32)
+  expected = love.math.simplexNoise(1.5, 2.5)
+  test:assertRange(readback:getFloat(0), expected - 0.0001, expected + 0.0001, 'check buffer point')
+  test:assertEquals(7, readback:getFloat(4), 'check buffer kept after point')
+  test:assertEquals(7, readback:getFloat(28), 'check buffer kept at end')
+  -- grids fill the start of a buffer, and the buffer is left unmapped
+  love.math.fillNoise(buffer, { width = 3, height = 2, frequency = 0.5 })
+  readback = love.graphics.readbackBuffer(buffer, 0, 32)
+  expected = love.math.simplexNoise(0.5, 0.5)
+  test:assertRange(readback:getFloat(16), expected - 0.0001, expected + 0.0001, 'check buffer grid')
+  test:assertEquals(7, readback:getFloat(24), 'check buffer kept after grid')
+  test:assertFalse(buffer:isMapped(), 'check buffer unmapped')
+  -- errors are raised before anything is mapped
+  test:assertFalse(pcall(love.math.fillNoise, buffer, { width = 3, height = 3 }), 'check buffer too small')
+  test:assertFalse(pcall(love.math.fillNoise, buffer, { points = { 1, 2, 3 } }), 'check odd points')
+  test:assertFalse(buffer:isMapped(), 'check buffer unmapped after error')
+  love.math.fillNoise(buffer, { points = {} })
+  -- imagedata gets the value in every color channel and opaque alpha
+  local imgdata = love.image.newImageData(8, 4, 'rgba8')
+  love.math.fillNoise(imgdata, { frequency = 0.1 })
+  local r, g, b, a = imgdata:getPixel(5, 2)
+  local value = math.floor(love.math.simplexNoise(0.5, 0.2) * 255 + 0.5) / 255
+  test:assertRange(r, value - 1/255, value + 1/255, 'check imagedata value')
+  test:assertEquals(r, g, 'check imagedata green')
+  test:assertEquals(r, b, 'check imagedata blue')
+  test:assertEquals(1, a, 'check imagedata alpha')
+  -- destinations must be large enough
+  local ok = pcall(love.math.fillNoise, data, { width = 64, height = 64 })
+  test:assertFalse(ok, 'check grid too large')
+  ok = pcall(love.math.fillNoise, imgdata, { type = 'value' })
+  test:assertFalse(ok, 'check invalid noise type')
+end
+
+
 -- love.math.gammaToLinear
 -- @NOTE I tried doing the same formula as the source from MathModule.cpp
 -- but get test failues due to slight differences
@@ -361,8 +578,104 @@ end
 
 -- love.math.triangulate
 love.test.math.triangulate = function(test)
-  local triangles1 = love.math.triangulate({0, 0, 1, 0, 1, 1, 1, 0, 0, 0}) -- square
+  local function trianglesArea(triangles)
+    local area = 0
+    for _, t in ipairs(triangles) do
+      area = area + math.abs((t[3] - t[1]) * (t[6] - t[2]) - (t[4] - t[2]) * (t[5] - t[1])) / 2
+    end
+    return area
+  end
+  local triangles1 = love.math.triangulate({0, 0, 1, 0, 1, 1, 0, 1}) -- square
   local triangles2 = love.math.triangulate({1, 2, 2, 4, 3, 4, 2, 1, 3, 1}) -- weird shape
-  test:assertEquals(3, #triangles1, 'check polygon triangles')
-  test:assertEquals(3, #triangles2, 'check polygon triangles')
+  local triangles3 = love.math.triangulate({0, 0, 1, 0, 1, 1, 1, 0, 0, 0}) -- zero area
+  test:assertEquals(2, #triangles1, 'check polygon triangles')
+  test:assertEquals(1, trianglesArea(triangles1), 'check polygon area')
+  -- self-intersecting and degenerate polygons don't error
+  test:assertEquals(2, #triangles2, 'check self-intersecting polygon triangles')
+  test:assertEquals(0, #triangles3, 'check degenerate polygon triangles')
+  -- large noisy outline, in both windings
+  local rng = love.math.newRandomGenerator(1234)
+  local outline, reversed, area = {}, {}, 0
+  local count = 2000
+  for i=1,count do
+    local angle = (i - 1) / count * math.pi * 2
+    local radius = 100 + rng:random() * 20
+    outline[i*2-1], outline[i*2] = math.cos(angle) * radius, math.sin(angle) * radius
+  end
+  for i=1,count do
+    local j = i % count + 1
+    area = area + outline[i*2-1] * outline[j*2] - outline[j*2-1] * outline[i*2]
+    reversed[(count-i)*2+1], reversed[(count-i)*2+2] = outline[i*2-1], outline[i*2]
+  end
+  area = math.abs(area) / 2
+  for _, polygon in ipairs({ outline, reversed }) do
+    local triangles = love.math.triangulate(polygon)
+    test:assertEquals(count - 2, #triangles, 'check large polygon triangles')
+    test:assertRange(trianglesArea(triangles), area * 0.9999, area * 1.0001, 'check large polygon area')
+  end
+  -- holes are left uncovered
+  local square = {0, 0, 10, 0, 10, 10, 0, 10}
+  local holes = { {2, 2, 4, 2, 4, 4, 2, 4}, {6, 6, 6, 8, 8, 8, 8, 6} }
+  test:assertEquals(92, trianglesArea(love.math.triangulate(square, holes)), 'check area with holes')
+  -- randomized star polygons are simple, so they must be fully covered, with
+  -- and without a hole around their center
+  local function ringArea(ring)
+    local sum = 0
+    for i=1,#ring,2 do
+      local j = i % #ring + 1
+      sum = sum + ring[i] * ring[j+1] - ring[j] * ring[i+1]
+    end
+    return math.abs(sum) / 2
+  end
+  local starhole = {-5, -5, 5, -5, 5, 5, -5, 5}
+  for s=1,200 do
+    local n = rng:random(10, 60)
+    local star = {}
+    for i=1,n do
+      local angle = (i - 1 + rng:random() * 0.9) / n * math.pi * 2
+      local radius = 10 + rng:random() * 90
+      star[i*2-1], star[i*2] = math.cos(angle) * radius, math.sin(angle) * radius
+    end
+    local starea = ringArea(star)
+    local triangles = love.math.triangulate(star)
+    test:assertEquals(n - 2, #triangles, 'check random star ' .. s .. ' triangles')
+    test:assertRange(trianglesArea(triangles), starea * 0.9999, starea * 1.0001, 'check random star ' .. s .. ' area')
+    local withhole = starea - 100
+    test:assertRange(trianglesArea(love.math.triangulate(star, { starhole })), withhole * 0.9999, withhole * 1.0001, 'check random star ' .. s .. ' area with hole')
+  end
+  -- random self-intersecting rings only have to produce valid indices
+  for s=1,200 do
+    local n = rng:random(3, 40)
+    local ring = {}
+    for i=1,n*2 do
+      ring[i] = rng:random(-50, 50)
+    end
+    local indices = love.math.triangulateIndices(ring)
+    test:assertEquals(0, #indices % 3, 'check random ring ' .. s .. ' index count')
+    for i=1,#indices do
+      test:assertRange(indices[i], 1, n, 'check random ring ' .. s .. ' index range')
+    end
+  end
+end
+
+
+-- love.math.triangulateIndices
+love.test.math.triangulateIndices = function(test)
+  -- indices refer to the outer ring's vertices followed by each hole's
+  local square = {0, 0, 10, 0, 10, 10, 0, 10}
+  local hole = {3, 3, 3, 7, 7, 7, 7, 3}
+  local vertices = {}
+  for i=1,#square,2 do table.insert(vertices, { square[i], square[i+1] }) end
+  for i=1,#hole,2 do table.insert(vertices, { hole[i], hole[i+1] }) end
+  local indices = love.math.triangulateIndices(square, { hole })
+  test:assertEquals(24, #indices, 'check index count')
+  local area = 0
+  for i=1,#indices,3 do
+    local a, b, c = vertices[indices[i]], vertices[indices[i+1]], vertices[indices[i+2]]
+    test:assertNotEquals(nil, a and b and c, 'check indices in range')
+    area = area + math.abs((b[1] - a[1]) * (c[2] - a[2]) - (b[2] - a[2]) * (c[1] - a[1])) / 2
+  end
+  test:assertEquals(84, area, 'check area with hole')
+  -- without holes
+  test:assertEquals(6, #love.math.triangulateIndices({0, 0, 1, 0, 1, 1, 0, 1}), 'check square indices')
 end
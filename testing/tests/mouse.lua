@@ -41,6 +41,55 @@ love.test.mouse.getRelativeMode = function(test)
 end
 
 
+-- love.mouse.getSampleCount
+love.test.mouse.getSampleCount = function(test)
+  love.mouse.getSamples()
+  test:assertEquals(0, love.mouse.getSampleCount(), 'check samples drained')
+end
+
+
+-- love.mouse.getSamples
+love.test.mouse.getSamples = function(test)
+  love.mouse.getSamples()
+  test:assertEquals(0, love.mouse.getSampleCount(), 'check samples drained')
+  local data, count = love.mouse.getSamples()
+  test:assertEquals(nil, data, 'check no data without samples')
+  test:assertEquals(0, count, 'check no samples')
+  -- each sample is a double timestamp followed by x, y, dx, dy floats
+  local dest = love.data.newByteData(24 * 16)
+  local filled, n = love.mouse.getSamples(dest)
+  test:assertEquals(dest, filled, 'check dest returned')
+  test:assertEquals(0, n, 'check no new samples')
+  -- destinations have to fit whole samples at an aligned address
+  local unaligned = love.data.newDataView(dest, 4, 24)
+  test:assertFalse(pcall(love.mouse.getSamples, unaligned), 'check unaligned dest errors')
+  local partial = love.data.newDataView(dest, 0, 30)
+  test:assertFalse(pcall(love.mouse.getSamples, partial), 'check partial sample dest errors')
+  -- warping the cursor only produces motion events with mouse focus
+  if not love.window.hasMouseFocus() then
+    return test:skipTest('cant move the mouse without mouse focus')
+  end
+  love.mouse.setPosition(5, 5)
+  love.mouse.setPosition(15, 12)
+  love.event.pump()
+  data, count = love.mouse.getSamples()
+  test:assertGreaterEqual(1, count, 'check motion sampled')
+  test:assertEquals('ByteData', data:type(), 'check new data type')
+  test:assertEquals(24 * count, data:getSize(), 'check new data size')
+  local _, x, y = love.data.unpack('dffff', data, 24 * (count - 1) + 1)
+  test:assertEquals(15, x, 'check last sample x')
+  test:assertEquals(12, y, 'check last sample y')
+  -- samples are written into the start of a given destination
+  love.mouse.setPosition(7, 9)
+  love.event.pump()
+  filled, n = love.mouse.getSamples(dest)
+  test:assertGreaterEqual(1, n, 'check dest motion sampled')
+  _, x, y = love.data.unpack('dffff', dest, 24 * (n - 1) + 1)
+  test:assertEquals(7, x, 'check dest sample x')
+  test:assertEquals(9, y, 'check dest sample y')
+end
+
+
 -- love.mouse.getSystemCursor
 love.test.mouse.getSystemCursor = function(test)
   local hand = love.mouse.getSystemCursor('hand')
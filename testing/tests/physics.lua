@@ -208,6 +208,10 @@ love.test.physics.Body = function(test)
   test:assertFalse(body1:isDestroyed(), 'check not destroyed')
   body1:destroy()
   test:assertTrue(body1:isDestroyed(), 'check destroyed')
+  local ok = pcall(body1.getPosition, body1)
+  test:assertFalse(ok, 'check destroyed getPosition errors')
+  ok = pcall(body1.getAngle, body1)
+  test:assertFalse(ok, 'check destroyed getAngle errors')
 
 end
 
@@ -457,6 +461,12 @@ love.test.physics.Shape = function(test)
   test:assertEquals(1, cat, 'check filter cat')
   test:assertEquals(65528, mask, 'check filter mask')
   test:assertEquals(-1, group, 'check filter group')
+  test:assertEquals(0, shape2:getFilterGroup(), 'check no filter group')
+  shape2:setFilterGroup(3)
+  test:assertEquals(3, shape2:getFilterGroup(), 'check set filter group')
+  test:assertEquals(0, shape2:getOwnerID(), 'check no owner id')
+  shape2:setOwnerID(42)
+  test:assertEquals(42, shape2:getOwnerID(), 'check set owner id')
 
   -- check destroyed
   shape1:destroy()
@@ -515,6 +525,7 @@ love.test.physics.World = function(test)
 
   -- check bodies in world
   test:assertEquals(1, #world:getBodies(), 'check 1 body')
+  test:assertTrue(rawequal(body1, world:getBodies()[1]), 'check same body userdata')
   test:assertEquals(0, world:getBodies()[1]:getX(), 'check body prop x')
   test:assertEquals(0, world:getBodies()[1]:getY(), 'check body prop y')
   world:translateOrigin(-10, -10) -- check affects bodies
@@ -595,6 +606,66 @@ love.test.physics.World = function(test)
   world:update(1)
   test:assertEquals(1, collisions, 'check collision logic change')
 
+  -- check native group and owner filtering
+  local world2 = love.physics.newWorld(0, 0, false)
+  local staticbody = love.physics.newBody(world2, 0, 0, 'static')
+  local movingbody = love.physics.newBody(world2, 5, 5, 'dynamic')
+  local shapea = love.physics.newRectangleShape(staticbody, 0, 0, 10, 10)
+  local shapeb = love.physics.newRectangleShape(movingbody, 0, 0, 10, 10)
+  -- a sensor keeps overlapping, so the contact only ends through filtering
+  shapeb:setSensor(true)
+  local contacts, ended = 0, 0
+  world2:setCallbacks(function() contacts = contacts + 1 end, function() ended = ended + 1 end)
+  test:assertTrue(world2:getGroupCollision(1, 2), 'check def group collision')
+  shapea:setFilterGroup(1)
+  shapeb:setFilterGroup(2)
+  world2:update(1)
+  test:assertEquals(1, contacts, 'check groups collide by default')
+  world2:setGroupCollision(1, 2, false)
+  test:assertFalse(world2:getGroupCollision(2, 1), 'check group collision symmetric')
+  world2:update(1)
+  test:assertEquals(1, ended, 'check existing contact filtered by group')
+  test:assertFalse(staticbody:isTouching(movingbody), 'check group filtering')
+  world2:setGroupCollision(1, 2, true)
+  world2:update(1)
+  test:assertEquals(2, contacts, 'check group collision restored')
+  test:assertTrue(world2:isSameOwnerCollisionAllowed(), 'check def same owner')
+  shapea:setOwnerID(7)
+  shapeb:setOwnerID(7)
+  world2:update(1)
+  test:assertTrue(staticbody:isTouching(movingbody), 'check same owners collide by default')
+  world2:setSameOwnerCollisionAllowed(false)
+  world2:update(1)
+  test:assertEquals(2, ended, 'check existing contact filtered by owner')
+  test:assertFalse(staticbody:isTouching(movingbody), 'check owner filtering')
+  shapeb:setOwnerID(8)
+  world2:update(1)
+  test:assertEquals(3, contacts, 'check different owners collide')
+  world2:destroy()
+
+  -- check fixed step interpolation
+  local world3 = love.physics.newWorld(0, 0, false)
+  local mover = love.physics.newBody(world3, 0, 0, 'dynamic')
+  love.physics.newCircleShape(mover, 1)
+  test:assertEquals(0, world3:getFixedStep(), 'check def fixed step')
+  world3:setFixedStep(0.1, 4)
+  local step, maxsubsteps = world3:getFixedStep()
+  test:assertRange(step, 0.09, 0.11, 'check set fixed step')
+  test:assertEquals(4, maxsubsteps, 'check set max substeps')
+  mover:setLinearVelocity(10, 0)
+  world3:update(0.15)
+  test:assertRange(mover:getX(), 0.9, 1.1, 'check one fixed step taken')
+  test:assertRange(world3:getInterpolationAlpha(), 0.49, 0.51, 'check interpolation alpha')
+  local states = love.data.newByteData(3 * 4)
+  test:assertEquals(1, world3:getInterpolatedBodyStates(nil, states), 'check interpolated count')
+  test:assertRange(states:getFloat(0), 0.4, 0.6, 'check interpolated x')
+  world3:translateOrigin(-10, 0)
+  world3:getInterpolatedBodyStates(nil, states)
+  test:assertRange(states:getFloat(0), 10.4, 10.6, 'check interpolated x after origin shift')
+  world3:update(10)
+  test:assertRange(mover:getX(), 4.9, 5.1, 'check max substeps')
+  world3:destroy()
+
   -- check gravity
   world:setGravity(1, 1)
   test:assertEquals(1, world:getGravity(), 'check grav change')
@@ -0,0 +1,98 @@
+-- love.profiler
+
+
+--------------------------------------------------------------------------------
+--------------------------------------------------------------------------------
+----------------------------------METHODS---------------------------------------
+--------------------------------------------------------------------------------
+--------------------------------------------------------------------------------
+
+
+-- love.profiler.beginZone
+love.test.profiler.beginZone = function(test)
+  love.profiler.startCapture()
+  love.profiler.beginZone('outer')
+  love.profiler.beginZone('inner "quoted"')
+  love.profiler.endZone()
+  love.profiler.endZone()
+  love.profiler.stopCapture()
+  local trace = love.profiler.exportTrace()
+  test:assertNotEquals(nil, trace:find('"name":"outer"', 1, true), 'check outer zone exported')
+  test:assertNotEquals(nil, trace:find('"name":"inner \\"quoted\\""', 1, true), 'check zone name escaped')
+end
+
+
+-- love.profiler.endZone
+love.test.profiler.endZone = function(test)
+  -- unmatched endZone calls are an error
+  local ok = pcall(love.profiler.endZone)
+  test:assertFalse(ok, 'check unmatched endZone errors')
+  -- zones begun outside a capture still need to be ended, but aren't recorded
+  love.profiler.beginZone('uncaptured')
+  love.profiler.endZone()
+  test:assertEquals(nil, love.profiler.exportTrace():find('uncaptured', 1, true), 'check zone outside capture not recorded')
+end
+
+
+-- love.profiler.exportTrace
+love.test.profiler.exportTrace = function(test)
+  love.profiler.startCapture()
+  love.profiler.beginZone('export')
+  love.profiler.endZone()
+  love.profiler.stopCapture()
+  local trace = love.profiler.exportTrace()
+  test:assertEquals('{"traceEvents":[', trace:sub(1, 16), 'check trace header')
+  test:assertEquals('}', trace:sub(-1), 'check trace footer')
+  test:assertNotEquals(nil, trace:find('"ph":"X"', 1, true), 'check complete events')
+  test:assertNotEquals(nil, trace:find('"name":"thread_name"', 1, true), 'check thread metadata')
+  -- write to file
+  test:assertTrue(love.profiler.exportTrace('profiler_trace.json'), 'check write succeeded')
+  test:assertEquals(trace, love.filesystem.read('profiler_trace.json'), 'check file contents')
+  love.filesystem.remove('profiler_trace.json')
+end
+
+
+-- love.profiler.getCapturedFrames
+-- @NOTE frames are marked by love.timer.step
+love.test.profiler.getCapturedFrames = function(test)
+  love.profiler.startCapture(2)
+  test:assertEquals(0, love.profiler.getCapturedFrames(), 'check no frames')
+  love.timer.step()
+  test:assertTrue(love.profiler.isCapturing(), 'check still capturing')
+  love.timer.step()
+  test:assertEquals(2, love.profiler.getCapturedFrames(), 'check frame count')
+  test:assertFalse(love.profiler.isCapturing(), 'check capture stopped after N frames')
+  test:assertNotEquals(nil, love.profiler.exportTrace():find('"name":"Frame"', 1, true), 'check frame zones')
+end
+
+
+-- love.profiler.isCapturing
+love.test.profiler.isCapturing = function(test)
+  test:assertFalse(love.profiler.isCapturing(), 'check not capturing by default')
+  love.profiler.startCapture()
+  test:assertTrue(love.profiler.isCapturing(), 'check capturing')
+  love.profiler.stopCapture()
+  test:assertFalse(love.profiler.isCapturing(), 'check stopped')
+end
+
+
+-- love.profiler.startCapture
+love.test.profiler.startCapture = function(test)
+  love.profiler.startCapture()
+  love.profiler.beginZone('first capture')
+  love.profiler.endZone()
+  -- starting a new capture discards the previous one
+  love.profiler.startCapture()
+  love.profiler.stopCapture()
+  test:assertEquals(nil, love.profiler.exportTrace():find('first capture', 1, true), 'check previous capture discarded')
+end
+
+
+-- love.profiler.stopCapture
+love.test.profiler.stopCapture = function(test)
+  love.profiler.startCapture()
+  love.profiler.stopCapture()
+  love.profiler.beginZone('stopped')
+  love.profiler.endZone()
+  test:assertEquals(nil, love.profiler.exportTrace():find('stopped', 1, true), 'check nothing recorded after stop')
+end
@@ -123,6 +123,14 @@ love.test.thread.getChannel = function(test)
 end
 
 
+-- love.thread.getParallelism
+love.test.thread.getParallelism = function(test)
+  local count = love.thread.getParallelism()
+  test:assertGreaterEqual(1, count, 'check at least the calling thread')
+  test:assertLessEqual(love.system.getProcessorCount(), count, 'check at most one thread per core')
+end
+
+
 -- love.thread.newChannel
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.thread.newChannel = function(test)
@@ -135,3 +143,20 @@ end
 love.test.thread.newThread = function(test)
   test:assertObject(love.thread.newThread('classes/TestSuite.lua'))
 end
+
+
+-- love.thread.setParallelism
+love.test.thread.setParallelism = function(test)
+  local count = love.thread.getParallelism()
+  love.thread.setParallelism(1)
+  test:assertEquals(1, love.thread.getParallelism(), 'check limited to caller')
+  -- parallel work still completes when limited to the calling thread
+  local input = love.data.newByteData(string.rep('parallelism ', 100000))
+  local compressed = love.data.compress('data', 'lz4chunked', input)
+  test:assertEquals(input:getString(), love.data.decompress('string', compressed), 'check limited round trip')
+  love.thread.setParallelism(count + 1000)
+  test:assertEquals(count, love.thread.getParallelism(), 'check clamped to pool size')
+  love.thread.setParallelism()
+  test:assertEquals(count, love.thread.getParallelism(), 'check limit removed')
+  test:assertFalse(pcall(love.thread.setParallelism, -1), 'check negative limit errors')
+end